@@ -46,7 +46,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/IOStream.hpp>
 #include <assimp/IOSystem.hpp>
 #include <assimp/Exporter.hpp>
+#include <assimp/config.h>
 #include "ProcessHelper.h"
+#include "VertexQuantization.h"
+#include "ThreadPool.h"
 #include "Exceptional.h"
 
 #ifdef ASSIMP_BUILD_NO_OWN_ZLIB
@@ -56,6 +59,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #endif
 
 #include <time.h>
+#include <memory>
+#include <vector>
 
 
 #ifndef ASSIMP_BUILD_NO_EXPORT
@@ -225,6 +230,49 @@ inline size_t WriteBounds(IOStream * stream, const T* in, unsigned int size)
     return t + Write<T>(stream,maxc);
 }
 
+// -----------------------------------------------------------------------------------
+// Serialize positions or texture coordinates as 16 bit values relative to their bounds
+inline size_t WriteQuantizedArray(IOStream * stream, const aiVector3D* in, unsigned int size)
+{
+    const Quantization::Bounds bounds(in,size);
+    size_t t = Write<aiVector3D>(stream,bounds.mMin);
+    t += Write<aiVector3D>(stream,bounds.mMax);
+
+    uint16_t q[3];
+    for (unsigned int i = 0; i < size; ++i) {
+        bounds.Encode(in[i],q);
+        t += stream->Write(q,sizeof(uint16_t),3) * sizeof(uint16_t);
+    }
+    return t;
+}
+
+// -----------------------------------------------------------------------------------
+// Serialize unit vectors as octahedral 2x16 bit values
+inline size_t WriteOctahedralArray(IOStream * stream, const aiVector3D* in, unsigned int size)
+{
+    size_t t = 0;
+    int16_t q[2];
+    for (unsigned int i = 0; i < size; ++i) {
+        Quantization::EncodeOctahedral(in[i],q);
+        t += stream->Write(q,sizeof(int16_t),2) * sizeof(int16_t);
+    }
+    return t;
+}
+
+// -----------------------------------------------------------------------------------
+// Serialize colors as 8 bit per channel
+inline size_t WriteQuantizedArray(IOStream * stream, const aiColor4D* in, unsigned int size)
+{
+    uint8_t q[4];
+    for (unsigned int i = 0; i < size; ++i) {
+        for (unsigned int k = 0; k < 4; ++k) {
+            q[k] = Quantization::EncodeUnorm8(in[i][k]);
+        }
+        stream->Write(q,1,4);
+    }
+    return size * 4;
+}
+
 // We use this to write out non-byte arrays so that we write using the specializations.
 // This way we avoid writing out extra bytes that potentially come from struct alignment.
 template <typename T>
@@ -317,6 +365,140 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
 
     };
 
+    // ----------------------------------------------------------------------------------
+    /** @class  AssbinSizeCounter
+     *  @brief  Write-only IOStream which does nothing but count the bytes written to it.
+     *
+     *  Used to determine the size of a chunk in advance if the output stream can't be
+     *  patched afterwards.
+     */
+    class AssbinSizeCounter : public IOStream
+    {
+    private:
+        size_t cursor;
+
+    public:
+        AssbinSizeCounter()
+            : cursor(0)
+        {
+        }
+
+        // -------------------------------------------------------------------
+        virtual size_t Read(void* /*pvBuffer*/, size_t /*pSize*/, size_t /*pCount*/) { return 0; }
+        virtual aiReturn Seek(size_t /*pOffset*/, aiOrigin /*pOrigin*/) { return aiReturn_FAILURE; }
+        virtual size_t Tell() const { return cursor; }
+        virtual size_t FileSize() const { return cursor; }
+        virtual void Flush() { }
+
+        virtual size_t Write(const void* /*pvBuffer*/, size_t pSize, size_t pCount)
+        {
+            cursor += pSize * pCount;
+            return pCount;
+        }
+    };
+
+    // ----------------------------------------------------------------------------------
+    /** @class  AssbinBlockCompressor
+     *  @brief  Write-only IOStream which DEFLATE-compresses everything written to it in
+     *  independent blocks and appends these to the container stream.
+     *
+     *  The data is cut into blocks of a fixed uncompressed size. Once there is one full
+     *  block per thread, all of them are compressed in parallel and written in order, so
+     *  memory use depends on the block size and the number of threads only. Finish()
+     *  must be called to write the last, partial block and the terminating block header.
+     */
+    class AssbinBlockCompressor : public IOStream
+    {
+    private:
+        IOStream * container;
+        ThreadPool* threadPool;
+        int level;
+        size_t blockSize, numPending, cursor;
+
+        std::vector< std::vector<uint8_t> > raw, packed;
+
+    private:
+        // -------------------------------------------------------------------
+        void FlushBlocks()
+        {
+            const auto compressBlock = [this](size_t i) {
+                uLongf size = compressBound(static_cast<uLong>(raw[i].size()));
+                packed[i].resize(size);
+                if (Z_OK != compress2(&packed[i][0], &size, &raw[i][0], static_cast<uLong>(raw[i].size()), level)) {
+                    throw DeadlyExportError("ASSBIN: Failed to compress block");
+                }
+                packed[i].resize(size);
+            };
+
+            if (threadPool && numPending > 1) {
+                threadPool->ParallelFor(numPending, compressBlock);
+            }
+            else {
+                for (size_t i = 0; i < numPending; ++i) {
+                    compressBlock(i);
+                }
+            }
+
+            for (size_t i = 0; i < numPending; ++i) {
+                Assimp::Write<uint32_t>(container,static_cast<uint32_t>(raw[i].size()));
+                Assimp::Write<uint32_t>(container,static_cast<uint32_t>(packed[i].size()));
+                container->Write(&packed[i][0],1,packed[i].size());
+                raw[i].clear();
+            }
+            numPending = 0;
+        }
+
+    public:
+        AssbinBlockCompressor( IOStream * container, int level, size_t blockSize, ThreadPool* threadPool)
+            : container(container), threadPool(threadPool), level(level), blockSize(blockSize), numPending(0), cursor(0)
+            , raw(threadPool ? threadPool->GetNumThreads() : 1)
+            , packed(raw.size())
+        {
+        }
+
+        // -------------------------------------------------------------------
+        /** Compress and write all pending data */
+        void Finish()
+        {
+            FlushBlocks();
+
+            // an empty block marks the end of the stream
+            Assimp::Write<uint32_t>(container,0);
+            Assimp::Write<uint32_t>(container,0);
+        }
+
+        // -------------------------------------------------------------------
+        virtual size_t Read(void* /*pvBuffer*/, size_t /*pSize*/, size_t /*pCount*/) { return 0; }
+        virtual aiReturn Seek(size_t /*pOffset*/, aiOrigin /*pOrigin*/) { return aiReturn_FAILURE; }
+        virtual size_t Tell() const { return cursor; }
+        virtual size_t FileSize() const { return cursor; }
+        virtual void Flush() { }
+
+        // -------------------------------------------------------------------
+        virtual size_t Write(const void* pvBuffer, size_t pSize, size_t pCount)
+        {
+            const uint8_t* in = static_cast<const uint8_t*>(pvBuffer);
+            size_t remaining = pSize * pCount;
+            cursor += remaining;
+
+            while (remaining) {
+                if (!numPending || raw[numPending-1].size() == blockSize) {
+                    if (numPending == raw.size()) {
+                        FlushBlocks();
+                    }
+                    raw[numPending++].reserve(blockSize);
+                }
+
+                std::vector<uint8_t>& block = raw[numPending-1];
+                const size_t n = std::min(remaining, blockSize - block.size());
+                block.insert(block.end(), in, in + n);
+                in += n;
+                remaining -= n;
+            }
+            return pCount;
+        }
+    };
+
     // ----------------------------------------------------------------------------------
     /** @class  AssbinExport
      *  @brief  Assbin exporter class
@@ -327,7 +509,10 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
     {
     private:
         bool shortened;
-        bool compressed;
+        int compressionLevel;
+        size_t blockSize;
+        unsigned int numThreads;
+        bool quantize;
 
     protected:
 
@@ -462,18 +647,27 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
                 }
                 c |= ASSBIN_MESH_HAS_COLOR(n);
             }
+            if (quantize && !shortened) {
+                c |= ASSBIN_MESH_QUANTIZED;
+            }
             Write<unsigned int>(&chunk,c);
 
             aiVector3D minVec, maxVec;
             if (mesh->mVertices) {
                 if (shortened) {
                     WriteBounds(&chunk,mesh->mVertices,mesh->mNumVertices);
+                }
+                else if (c & ASSBIN_MESH_QUANTIZED) {
+                    WriteQuantizedArray(&chunk,mesh->mVertices,mesh->mNumVertices);
                 } // else write as usual
                 else WriteArray<aiVector3D>(&chunk,mesh->mVertices,mesh->mNumVertices);
             }
             if (mesh->mNormals) {
                 if (shortened) {
                     WriteBounds(&chunk,mesh->mNormals,mesh->mNumVertices);
+                }
+                else if (c & ASSBIN_MESH_QUANTIZED) {
+                    WriteOctahedralArray(&chunk,mesh->mNormals,mesh->mNumVertices);
                 } // else write as usual
                 else WriteArray<aiVector3D>(&chunk,mesh->mNormals,mesh->mNumVertices);
             }
@@ -481,6 +675,10 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
                 if (shortened) {
                     WriteBounds(&chunk,mesh->mTangents,mesh->mNumVertices);
                     WriteBounds(&chunk,mesh->mBitangents,mesh->mNumVertices);
+                }
+                else if (c & ASSBIN_MESH_QUANTIZED) {
+                    WriteOctahedralArray(&chunk,mesh->mTangents,mesh->mNumVertices);
+                    WriteOctahedralArray(&chunk,mesh->mBitangents,mesh->mNumVertices);
                 } // else write as usual
                 else {
                     WriteArray<aiVector3D>(&chunk,mesh->mTangents,mesh->mNumVertices);
@@ -493,6 +691,9 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
 
                 if (shortened) {
                     WriteBounds(&chunk,mesh->mColors[n],mesh->mNumVertices);
+                }
+                else if (c & ASSBIN_MESH_QUANTIZED) {
+                    WriteQuantizedArray(&chunk,mesh->mColors[n],mesh->mNumVertices);
                 } // else write as usual
                 else WriteArray<aiColor4D>(&chunk,mesh->mColors[n],mesh->mNumVertices);
             }
@@ -505,6 +706,9 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
 
                 if (shortened) {
                     WriteBounds(&chunk,mesh->mTextureCoords[n],mesh->mNumVertices);
+                }
+                else if (c & ASSBIN_MESH_QUANTIZED) {
+                    WriteQuantizedArray(&chunk,mesh->mTextureCoords[n],mesh->mNumVertices);
                 } // else write as usual
                 else WriteArray<aiVector3D>(&chunk,mesh->mTextureCoords[n],mesh->mNumVertices);
             }
@@ -677,65 +881,118 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
         }
 
         // -----------------------------------------------------------------------------------
-        void WriteBinaryScene( IOStream * container, const aiScene* scene)
+        void WriteBinarySceneContents( IOStream * chunk, const aiScene* scene)
         {
-            AssbinChunkWriter chunk( container, ASSBIN_CHUNK_AISCENE );
-
             // basic scene information
-            Write<unsigned int>(&chunk,scene->mFlags);
-            Write<unsigned int>(&chunk,scene->mNumMeshes);
-            Write<unsigned int>(&chunk,scene->mNumMaterials);
-            Write<unsigned int>(&chunk,scene->mNumAnimations);
-            Write<unsigned int>(&chunk,scene->mNumTextures);
-            Write<unsigned int>(&chunk,scene->mNumLights);
-            Write<unsigned int>(&chunk,scene->mNumCameras);
+            Write<unsigned int>(chunk,scene->mFlags);
+            Write<unsigned int>(chunk,scene->mNumMeshes);
+            Write<unsigned int>(chunk,scene->mNumMaterials);
+            Write<unsigned int>(chunk,scene->mNumAnimations);
+            Write<unsigned int>(chunk,scene->mNumTextures);
+            Write<unsigned int>(chunk,scene->mNumLights);
+            Write<unsigned int>(chunk,scene->mNumCameras);
 
             // write node graph
-            WriteBinaryNode( &chunk, scene->mRootNode );
+            WriteBinaryNode( chunk, scene->mRootNode );
 
             // write all meshes
             for (unsigned int i = 0; i < scene->mNumMeshes;++i) {
                 const aiMesh* mesh = scene->mMeshes[i];
-                WriteBinaryMesh( &chunk,mesh);
+                WriteBinaryMesh( chunk,mesh);
             }
 
             // write materials
             for (unsigned int i = 0; i< scene->mNumMaterials; ++i) {
                 const aiMaterial* mat = scene->mMaterials[i];
-                WriteBinaryMaterial(&chunk,mat);
+                WriteBinaryMaterial(chunk,mat);
             }
 
             // write all animations
             for (unsigned int i = 0; i < scene->mNumAnimations;++i) {
                 const aiAnimation* anim = scene->mAnimations[i];
-                WriteBinaryAnim(&chunk,anim);
+                WriteBinaryAnim(chunk,anim);
             }
 
 
             // write all textures
             for (unsigned int i = 0; i < scene->mNumTextures;++i) {
                 const aiTexture* mesh = scene->mTextures[i];
-                WriteBinaryTexture(&chunk,mesh);
+                WriteBinaryTexture(chunk,mesh);
             }
 
             // write lights
             for (unsigned int i = 0; i < scene->mNumLights;++i) {
                 const aiLight* l = scene->mLights[i];
-                WriteBinaryLight(&chunk,l);
+                WriteBinaryLight(chunk,l);
             }
 
             // write cameras
             for (unsigned int i = 0; i < scene->mNumCameras;++i) {
                 const aiCamera* cam = scene->mCameras[i];
-                WriteBinaryCamera(&chunk,cam);
+                WriteBinaryCamera(chunk,cam);
+            }
+
+        }
+
+        // -----------------------------------------------------------------------------------
+        // Write the scene chunk. Unlike all other chunks it is not buffered in memory, its
+        // children are streamed to the output (or the compressor) one after another.
+        void WriteBinaryScene( IOStream * out, const aiScene* scene)
+        {
+            const size_t start = out->Tell();
+            const bool seekable = out->Seek(start, aiOrigin_SET) == aiReturn_SUCCESS;
+
+            size_t size = 0;
+            if (!seekable) {
+                // the chunk size can't be patched afterwards, so determine it in advance
+                AssbinSizeCounter counter;
+                WriteBinarySceneContents(&counter,scene);
+                size = counter.Tell();
+            }
+
+            Write<uint32_t>(out,ASSBIN_CHUNK_AISCENE);
+            Write<uint32_t>(out,static_cast<uint32_t>(size));
+
+            // For compressed files, only the contents of the scene chunk are compressed.
+            if (compressionLevel > 0) {
+                std::unique_ptr<ThreadPool> threadPool;
+                if (numThreads > 1) {
+                    threadPool.reset(new ThreadPool(numThreads));
+                }
+
+                AssbinBlockCompressor blocks( out, compressionLevel, blockSize, threadPool.get() );
+                WriteBinarySceneContents(&blocks,scene);
+                blocks.Finish();
+                size = blocks.Tell();
+            }
+            else {
+                WriteBinarySceneContents(out,scene);
+                size = out->Tell() - start - 8;
             }
 
+            if (seekable) {
+                out->Seek(start + 4, aiOrigin_SET);
+                Write<uint32_t>(out,static_cast<uint32_t>(size));
+                out->Seek(0, aiOrigin_END);
+            }
         }
 
     public:
-        AssbinExport()
-            : shortened(false), compressed(false) // temporary settings until properties are introduced for exporters
+        AssbinExport(const ExportProperties* pProperties)
+            : shortened(false) // temporary setting until a property is introduced for it
+            , compressionLevel(0)
+            , blockSize(1 << 20)
+            , numThreads(1)
+            , quantize(false)
         {
+            if (pProperties) {
+                compressionLevel = std::min(std::max(pProperties->GetPropertyInteger(AI_CONFIG_EXPORT_ASSBIN_COMPRESSION_LEVEL,0),0),9);
+                blockSize = std::max(pProperties->GetPropertyInteger(AI_CONFIG_EXPORT_ASSBIN_BLOCK_SIZE,1 << 20),4096);
+                quantize = pProperties->GetPropertyBool(AI_CONFIG_EXPORT_ASSBIN_QUANTIZE,false);
+
+                const int threads = pProperties->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING,0);
+                numThreads = threads < 0 ? ThreadPool::GetHardwareConcurrency() : std::max(threads,1);
+            }
         }
 
         // -----------------------------------------------------------------------------------
@@ -764,7 +1021,7 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
             Write<unsigned int>( out, aiGetVersionRevision() );
             Write<unsigned int>( out, aiGetCompileFlags() );
             Write<uint16_t>( out, shortened );
-            Write<uint16_t>( out, compressed );
+            Write<uint16_t>( out, compressionLevel > 0 ? ASSBIN_COMPRESSION_DEFLATE_BLOCKS : ASSBIN_COMPRESSION_NONE );
             // ==  20 bytes
 
             char buff[256];
@@ -783,36 +1040,17 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
             // ==== total header size: 512 bytes
             ai_assert( out->Tell() == ASSBIN_HEADER_LENGTH );
 
-            // Up to here the data is uncompressed. For compressed files, the rest
-            // is compressed using standard DEFLATE from zlib.
-            if (compressed)
-            {
-                AssbinChunkWriter uncompressedStream( NULL, 0 );
-                WriteBinaryScene( &uncompressedStream, pScene );
-
-                uLongf uncompressedSize = static_cast<uLongf>(uncompressedStream.Tell());
-                uLongf compressedSize = (uLongf)(uncompressedStream.Tell() * 1.001 + 12.);
-                uint8_t* compressedBuffer = new uint8_t[ compressedSize ];
-
-                compress2( compressedBuffer, &compressedSize, (const Bytef*)uncompressedStream.GetBufferPointer(), uncompressedSize, 9 );
-
-                out->Write( &uncompressedSize, sizeof(uint32_t), 1 );
-                out->Write( compressedBuffer, sizeof(char), compressedSize );
-
-                delete[] compressedBuffer;
-            }
-            else
-            {
-                WriteBinaryScene( out, pScene );
-            }
+            // Up to here the data is uncompressed. For compressed files, the contents of
+            // the scene chunk are compressed in blocks using standard DEFLATE from zlib.
+            WriteBinaryScene( out, pScene );
 
             pIOSystem->Close( out );
         }
     };
 
-void ExportSceneAssbin(const char* pFile, IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* /*pProperties*/)
+void ExportSceneAssbin(const char* pFile, IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* pProperties)
 {
-    AssbinExport exporter;
+    AssbinExport exporter(pProperties);
     exporter.WriteBinaryDump( pFile, pIOSystem, pScene );
 }
 } // end of namespace Assimp
@@ -52,10 +52,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AssbinLoader.h"
 #include "assbin_chunks.h"
 #include "MemoryIOWrapper.h"
+#include "VertexQuantization.h"
+#include "ThreadPool.h"
+#include "Exceptional.h"
 #include <assimp/mesh.h>
 #include <assimp/anim.h>
 #include <assimp/scene.h>
 #include <assimp/importerdesc.h>
+#include <vector>
 
 #ifdef ASSIMP_BUILD_NO_OWN_ZLIB
 #   include <zlib.h>
@@ -192,6 +196,42 @@ void ReadArray(IOStream * stream, T * out, unsigned int size)
     for (unsigned int i=0; i<size; i++) out[i] = Read<T>(stream);
 }
 
+// Read positions or texture coordinates stored as 16 bit values relative to their bounds
+void ReadQuantizedArray(IOStream * stream, aiVector3D * out, unsigned int size)
+{
+    Quantization::Bounds bounds;
+    bounds.mMin = Read<aiVector3D>(stream);
+    bounds.mMax = Read<aiVector3D>(stream);
+
+    uint16_t q[3];
+    for (unsigned int i = 0; i < size; i++) {
+        stream->Read(q,sizeof(uint16_t),3);
+        out[i] = bounds.Decode(q);
+    }
+}
+
+// Read unit vectors stored as octahedral 2x16 bit values
+void ReadOctahedralArray(IOStream * stream, aiVector3D * out, unsigned int size)
+{
+    int16_t q[2];
+    for (unsigned int i = 0; i < size; i++) {
+        stream->Read(q,sizeof(int16_t),2);
+        out[i] = Quantization::DecodeOctahedral(q);
+    }
+}
+
+// Read colors stored as 8 bit per channel
+void ReadQuantizedArray(IOStream * stream, aiColor4D * out, unsigned int size)
+{
+    uint8_t q[4];
+    for (unsigned int i = 0; i < size; i++) {
+        stream->Read(q,1,4);
+        for (unsigned int k = 0; k < 4; ++k) {
+            out[i][k] = Quantization::DecodeUnorm8(q[k]);
+        }
+    }
+}
+
 template <typename T> void ReadBounds( IOStream * stream, T* /*p*/, unsigned int n )
 {
     // not sure what to do here, the data isn't really useful.
@@ -321,7 +361,10 @@ void AssbinImporter::ReadBinaryMesh( IOStream * stream, aiMesh* mesh )
         else
         {
             mesh->mVertices = new aiVector3D[mesh->mNumVertices];
-            ReadArray<aiVector3D>(stream,mesh->mVertices,mesh->mNumVertices);
+            if (c & ASSBIN_MESH_QUANTIZED) {
+                ReadQuantizedArray(stream,mesh->mVertices,mesh->mNumVertices);
+            }
+            else ReadArray<aiVector3D>(stream,mesh->mVertices,mesh->mNumVertices);
         }
     }
     if (c & ASSBIN_MESH_HAS_NORMALS)
@@ -332,7 +375,10 @@ void AssbinImporter::ReadBinaryMesh( IOStream * stream, aiMesh* mesh )
         else
         {
             mesh->mNormals = new aiVector3D[mesh->mNumVertices];
-            ReadArray<aiVector3D>(stream,mesh->mNormals,mesh->mNumVertices);
+            if (c & ASSBIN_MESH_QUANTIZED) {
+                ReadOctahedralArray(stream,mesh->mNormals,mesh->mNumVertices);
+            }
+            else ReadArray<aiVector3D>(stream,mesh->mNormals,mesh->mNumVertices);
         }
     }
     if (c & ASSBIN_MESH_HAS_TANGENTS_AND_BITANGENTS)
@@ -344,9 +390,15 @@ void AssbinImporter::ReadBinaryMesh( IOStream * stream, aiMesh* mesh )
         else
         {
             mesh->mTangents = new aiVector3D[mesh->mNumVertices];
-            ReadArray<aiVector3D>(stream,mesh->mTangents,mesh->mNumVertices);
             mesh->mBitangents = new aiVector3D[mesh->mNumVertices];
-            ReadArray<aiVector3D>(stream,mesh->mBitangents,mesh->mNumVertices);
+            if (c & ASSBIN_MESH_QUANTIZED) {
+                ReadOctahedralArray(stream,mesh->mTangents,mesh->mNumVertices);
+                ReadOctahedralArray(stream,mesh->mBitangents,mesh->mNumVertices);
+            }
+            else {
+                ReadArray<aiVector3D>(stream,mesh->mTangents,mesh->mNumVertices);
+                ReadArray<aiVector3D>(stream,mesh->mBitangents,mesh->mNumVertices);
+            }
         }
     }
     for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS;++n)
@@ -361,7 +413,10 @@ void AssbinImporter::ReadBinaryMesh( IOStream * stream, aiMesh* mesh )
         else
         {
             mesh->mColors[n] = new aiColor4D[mesh->mNumVertices];
-            ReadArray<aiColor4D>(stream,mesh->mColors[n],mesh->mNumVertices);
+            if (c & ASSBIN_MESH_QUANTIZED) {
+                ReadQuantizedArray(stream,mesh->mColors[n],mesh->mNumVertices);
+            }
+            else ReadArray<aiColor4D>(stream,mesh->mColors[n],mesh->mNumVertices);
         }
     }
     for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS;++n)
@@ -378,7 +433,10 @@ void AssbinImporter::ReadBinaryMesh( IOStream * stream, aiMesh* mesh )
         else
         {
             mesh->mTextureCoords[n] = new aiVector3D[mesh->mNumVertices];
-            ReadArray<aiVector3D>(stream,mesh->mTextureCoords[n],mesh->mNumVertices);
+            if (c & ASSBIN_MESH_QUANTIZED) {
+                ReadQuantizedArray(stream,mesh->mTextureCoords[n],mesh->mNumVertices);
+            }
+            else ReadArray<aiVector3D>(stream,mesh->mTextureCoords[n],mesh->mNumVertices);
         }
     }
 
@@ -687,6 +745,88 @@ void AssbinImporter::ReadBinaryScene( IOStream * stream, aiScene* scene )
 
 }
 
+// -----------------------------------------------------------------------------------
+// Read a scene chunk whose contents are stored in independently compressed blocks.
+// All blocks are inflated straight into their final place in a single buffer, in
+// parallel if a thread pool is available.
+void AssbinImporter::ReadCompressedBlocks( IOStream * stream, aiScene* pScene )
+{
+    const uint32_t chunkID = Read<uint32_t>(stream);
+    const uint32_t size = Read<uint32_t>(stream);
+
+    const size_t offset = stream->Tell();
+    const size_t available = stream->FileSize() - offset;
+
+    std::vector<uint8_t> fileData;
+    const uint8_t* data = static_cast<const uint8_t*>(stream->MapView());
+    if (data) {
+        data += offset;
+    }
+    else {
+        fileData.resize(available);
+        if (available && stream->Read(&fileData[0],1,available) != available) {
+            throw DeadlyImportError("ASSBIN: Failed to read compressed data");
+        }
+        data = fileData.empty() ? NULL : &fileData[0];
+    }
+
+    struct Block {
+        const uint8_t* src;
+        uint32_t srcSize, dstOffset, dstSize;
+    };
+    std::vector<Block> blocks;
+
+    // walk the block headers, the contents are placed behind the chunk header
+    size_t cursor = 0, total = 8;
+    for (;;) {
+        if (available - cursor < 8) {
+            throw DeadlyImportError("ASSBIN: Unexpected end of compressed data");
+        }
+        Block b;
+        memcpy(&b.dstSize,data + cursor,4);
+        memcpy(&b.srcSize,data + cursor + 4,4);
+        cursor += 8;
+        if (!b.dstSize && !b.srcSize) {
+            break;
+        }
+        if (available - cursor < b.srcSize || total + b.dstSize > size + 8u) {
+            throw DeadlyImportError("ASSBIN: Compressed block exceeds the scene chunk");
+        }
+        b.src = data + cursor;
+        b.dstOffset = static_cast<uint32_t>(total);
+        blocks.push_back(b);
+
+        cursor += b.srcSize;
+        total += b.dstSize;
+    }
+    if (total != size + 8u) {
+        throw DeadlyImportError("ASSBIN: Compressed blocks don't match the scene chunk size");
+    }
+
+    std::vector<uint8_t> uncompressedData(total);
+    memcpy(&uncompressedData[0],&chunkID,4);
+    memcpy(&uncompressedData[4],&size,4);
+
+    const auto inflateBlock = [&blocks,&uncompressedData](size_t i) {
+        const Block& b = blocks[i];
+        uLongf dstSize = b.dstSize;
+        if (Z_OK != uncompress(&uncompressedData[b.dstOffset],&dstSize,b.src,b.srcSize) || dstSize != b.dstSize) {
+            throw DeadlyImportError("ASSBIN: Failed to decompress block");
+        }
+    };
+    if (m_threadPool && blocks.size() > 1) {
+        m_threadPool->ParallelFor(blocks.size(),inflateBlock);
+    }
+    else {
+        for (size_t i = 0; i < blocks.size(); ++i) {
+            inflateBlock(i);
+        }
+    }
+
+    MemoryIOStream io( &uncompressedData[0], uncompressedData.size() );
+    ReadBinaryScene(&io,pScene);
+}
+
 void AssbinImporter::InternReadFile( const std::string& pFile, aiScene* pScene, IOSystem* pIOHandler )
 {
     IOStream * stream = pIOHandler->Open(pFile,"rb");
@@ -701,7 +841,7 @@ void AssbinImporter::InternReadFile( const std::string& pFile, aiScene* pScene,
     /*unsigned int compileFlags =*/ Read<unsigned int>(stream);
 
     shortened = Read<uint16_t>(stream) > 0;
-    compressed = Read<uint16_t>(stream) > 0;
+    compressed = Read<uint16_t>(stream);
 
     if (shortened)
         throw DeadlyImportError( "Shortened binaries are not supported!" );
@@ -710,7 +850,11 @@ void AssbinImporter::InternReadFile( const std::string& pFile, aiScene* pScene,
     stream->Seek( 128, aiOrigin_CUR ); // options
     stream->Seek( 64, aiOrigin_CUR ); // padding
 
-    if (compressed)
+    if (compressed == ASSBIN_COMPRESSION_DEFLATE_BLOCKS)
+    {
+        ReadCompressedBlocks(stream,pScene);
+    }
+    else if (compressed)
     {
         uLongf uncompressedSize = Read<uint32_t>(stream);
         uLongf compressedSize = static_cast<uLongf>(stream->FileSize() - stream->Tell());
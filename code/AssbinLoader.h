@@ -70,7 +70,7 @@ class AssbinImporter : public BaseImporter
 {
 private:
   bool shortened;
-  bool compressed;
+  uint16_t compressed;
 
 public:
   virtual bool CanRead(
@@ -85,6 +85,7 @@ public:
     IOSystem* pIOHandler
     );
   void ReadBinaryScene( IOStream * stream, aiScene* pScene );
+  void ReadCompressedBlocks( IOStream * stream, aiScene* pScene );
   void ReadBinaryNode( IOStream * stream, aiNode** mRootNode, aiNode* parent );
   void ReadBinaryMesh( IOStream * stream, aiMesh* mesh );
   void ReadBinaryBone( IOStream * stream, aiBone* bone );
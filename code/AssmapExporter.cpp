@@ -0,0 +1,518 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  AssmapExporter.cpp
+ *  @brief Writer for the memory-mappable scene cache format, see assmap_format.h
+ */
+
+// Not guarded by ASSIMP_BUILD_NO_EXPORT, the import cache (ImportCache.cpp) uses it as well
+#ifndef ASSIMP_BUILD_NO_ASSMAP_EXPORTER
+
+#include "assmap_format.h"
+#include "Exceptional.h"
+#include <assimp/ai_assert.h>
+#include <assimp/scene.h>
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
+
+#include <memory>
+#include <string.h>
+#include <vector>
+
+namespace Assimp    {
+
+class ExportProperties;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+/** Lays out an aiScene in the .assmap format.
+ *
+ *  The struct region is built in memory. The data region only consists of
+ *  a list of source arrays and their future offsets, the arrays are copied
+ *  straight from the scene to the output stream by Write(). */
+class AssmapWriter
+{
+public:
+    explicit AssmapWriter(const aiScene* pScene)
+        : mDataSize()
+    {
+        AddScene(pScene);
+    }
+
+    // -------------------------------------------------------------------
+    void Write(IOStream* out) const
+    {
+        AssmapHeader header;
+        memset(&header,0,sizeof(header));
+        strcpy(header.mMagic,ASSMAP_MAGIC);
+        header.mVersion = ASSMAP_VERSION;
+        header.mLayoutHash = AssmapLayoutHash();
+        header.mStructOffset = ASSMAP_HEADER_LENGTH;
+        header.mStructSize = mStructs.size();
+        header.mDataOffset = Align(ASSMAP_HEADER_LENGTH + mStructs.size(),ASSMAP_REGION_ALIGNMENT);
+        header.mDataSize = mDataSize;
+
+        static_assert(sizeof(AssmapHeader) == ASSMAP_HEADER_LENGTH, "unexpected header size");
+        out->Write(&header,sizeof(header),1);
+        if (!mStructs.empty()) {
+            out->Write(&mStructs[0],1,mStructs.size());
+        }
+
+        size_t cursor = static_cast<size_t>(header.mStructOffset + header.mStructSize);
+        const uint8_t padding[ASSMAP_REGION_ALIGNMENT] = {};
+        WritePadding(out,cursor,static_cast<size_t>(header.mDataOffset),padding);
+
+        for (std::vector<DataBlock>::const_iterator it = mData.begin(); it != mData.end(); ++it) {
+            WritePadding(out,cursor,static_cast<size_t>(header.mDataOffset) + it->mOffset,padding);
+            out->Write(it->mSource,1,it->mSize);
+            cursor += it->mSize;
+        }
+    }
+
+private:
+    struct DataBlock {
+        const void* mSource;
+        size_t mOffset, mSize;
+    };
+
+    // -------------------------------------------------------------------
+    static size_t Align(size_t offset, size_t alignment)
+    {
+        return (offset + alignment - 1) / alignment * alignment;
+    }
+
+    // -------------------------------------------------------------------
+    static void WritePadding(IOStream* out, size_t& cursor, size_t target, const uint8_t* padding)
+    {
+        ai_assert(target >= cursor && target - cursor <= ASSMAP_REGION_ALIGNMENT);
+        out->Write(padding,1,target - cursor);
+        cursor = target;
+    }
+
+    // -------------------------------------------------------------------
+    // Access a struct in the struct region. The reference is invalidated
+    // by the next call to AddStructs() or AddTable().
+    template <typename T>
+    T& At(size_t offset)
+    {
+        return *reinterpret_cast<T*>(&mStructs[offset]);
+    }
+
+    // -------------------------------------------------------------------
+    // Copy structs to the struct region, return their offset
+    template <typename T>
+    size_t AddStructs(const T* src, size_t count)
+    {
+        const size_t offset = Align(mStructs.size(),sizeof(uint64_t));
+        mStructs.resize(offset + sizeof(T) * count);
+        memcpy(&mStructs[offset],static_cast<const void*>(src),sizeof(T) * count);
+        return offset;
+    }
+
+    // -------------------------------------------------------------------
+    // Reserve a table of references in the struct region, return its offset
+    size_t AddTable(size_t count)
+    {
+        const size_t offset = Align(mStructs.size(),sizeof(uint64_t));
+        mStructs.resize(offset + sizeof(uintptr_t) * count,0);
+        return offset;
+    }
+
+    // -------------------------------------------------------------------
+    // Append an array to the data region, return a reference to it
+    uintptr_t AddData(const void* src, size_t size, size_t alignment = 16)
+    {
+        if (!src || !size) {
+            return 0;
+        }
+        DataBlock block;
+        block.mSource = src;
+        block.mOffset = Align(mDataSize,alignment);
+        block.mSize = size;
+        mData.push_back(block);
+
+        mDataSize = block.mOffset + size;
+        return AssmapDataRef(block.mOffset);
+    }
+
+    // -------------------------------------------------------------------
+    template <typename T>
+    static void SetRef(T*& field, uintptr_t ref)
+    {
+        field = reinterpret_cast<T*>(ref);
+    }
+
+    // -------------------------------------------------------------------
+    // Write a table of references to the structs produced by fn(i)
+    template <typename T, typename Fn>
+    uintptr_t AddObjects(T* const* src, unsigned int count, Fn fn)
+    {
+        if (!src || !count) {
+            return 0;
+        }
+        const size_t table = AddTable(count);
+        for (unsigned int i = 0; i < count; ++i) {
+            const uintptr_t ref = src[i] ? AssmapStructRef((this->*fn)(src[i])) : 0;
+            At<uintptr_t>(table + i * sizeof(uintptr_t)) = ref;
+        }
+        return AssmapStructRef(table);
+    }
+
+    // -------------------------------------------------------------------
+    void AddScene(const aiScene* pScene)
+    {
+        const size_t offset = AddStructs(pScene,1);
+        ai_assert(offset == 0);
+
+        const uintptr_t root = pScene->mRootNode ? AssmapStructRef(AddNode(pScene->mRootNode,0)) : 0;
+        const uintptr_t meshes = AddObjects(pScene->mMeshes,pScene->mNumMeshes,&AssmapWriter::AddMesh);
+        const uintptr_t materials = AddObjects(pScene->mMaterials,pScene->mNumMaterials,&AssmapWriter::AddMaterial);
+        const uintptr_t animations = AddObjects(pScene->mAnimations,pScene->mNumAnimations,&AssmapWriter::AddAnimation);
+        const uintptr_t textures = AddObjects(pScene->mTextures,pScene->mNumTextures,&AssmapWriter::AddTexture);
+        const uintptr_t lights = AddObjects(pScene->mLights,pScene->mNumLights,&AssmapWriter::AddPlain<aiLight>);
+        const uintptr_t cameras = AddObjects(pScene->mCameras,pScene->mNumCameras,&AssmapWriter::AddPlain<aiCamera>);
+
+        aiScene& s = At<aiScene>(offset);
+        SetRef(s.mRootNode,root);
+        SetRef(s.mMeshes,meshes);
+        SetRef(s.mMaterials,materials);
+        SetRef(s.mAnimations,animations);
+        SetRef(s.mTextures,textures);
+        SetRef(s.mLights,lights);
+        SetRef(s.mCameras,cameras);
+        s.mPrivate = NULL;
+    }
+
+    // -------------------------------------------------------------------
+    template <typename T>
+    size_t AddPlain(const T* obj)
+    {
+        return AddStructs(obj,1);
+    }
+
+    // -------------------------------------------------------------------
+    size_t AddNode(const aiNode* node, uintptr_t parent)
+    {
+        const size_t offset = AddStructs(node,1);
+
+        uintptr_t children = 0;
+        if (node->mChildren && node->mNumChildren) {
+            const size_t table = AddTable(node->mNumChildren);
+            for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+                const uintptr_t ref = AssmapStructRef(AddNode(node->mChildren[i],AssmapStructRef(offset)));
+                At<uintptr_t>(table + i * sizeof(uintptr_t)) = ref;
+            }
+            children = AssmapStructRef(table);
+        }
+        const uintptr_t meshes = AddData(node->mMeshes,node->mNumMeshes * sizeof(unsigned int));
+        const uintptr_t metadata = node->mMetaData ? AssmapStructRef(AddMetadata(node->mMetaData)) : 0;
+
+        aiNode& n = At<aiNode>(offset);
+        SetRef(n.mParent,parent);
+        SetRef(n.mChildren,children);
+        SetRef(n.mMeshes,meshes);
+        SetRef(n.mMetaData,metadata);
+        return offset;
+    }
+
+    // -------------------------------------------------------------------
+    size_t AddMetadata(const aiMetadata* md)
+    {
+        const size_t offset = AddStructs(md,1);
+        const uintptr_t keys = AddData(md->mKeys,md->mNumProperties * sizeof(aiString));
+
+        uintptr_t values = 0;
+        if (md->mValues && md->mNumProperties) {
+            const size_t entries = AddStructs(md->mValues,md->mNumProperties);
+            for (unsigned int i = 0; i < md->mNumProperties; ++i) {
+                const aiMetadataEntry& e = md->mValues[i];
+                const uintptr_t data = AddData(e.mData,GetMetadataSize(e.mType),8);
+                SetRef(At<aiMetadataEntry>(entries + i * sizeof(aiMetadataEntry)).mData,data);
+            }
+            values = AssmapStructRef(entries);
+        }
+
+        aiMetadata& m = At<aiMetadata>(offset);
+        SetRef(m.mKeys,keys);
+        SetRef(m.mValues,values);
+        return offset;
+    }
+
+    // -------------------------------------------------------------------
+    static size_t GetMetadataSize(aiMetadataType type)
+    {
+        switch (type) {
+        case AI_BOOL:
+            return sizeof(bool);
+        case AI_INT32:
+            return sizeof(int32_t);
+        case AI_UINT64:
+            return sizeof(uint64_t);
+        case AI_FLOAT:
+            return sizeof(float);
+        case AI_DOUBLE:
+            return sizeof(double);
+        case AI_AISTRING:
+            return sizeof(aiString);
+        case AI_AIVECTOR3D:
+            return sizeof(aiVector3D);
+        default:
+            throw DeadlyExportError("ASSMAP: Unknown metadata type");
+        }
+    }
+
+    // -------------------------------------------------------------------
+    size_t AddMesh(const aiMesh* mesh)
+    {
+        const size_t offset = AddStructs(mesh,1);
+        const unsigned int nv = mesh->mNumVertices;
+
+        // faces need to be writable to resolve their index pointers, all
+        // indices of the mesh go to a contiguous block in the data region
+        uintptr_t faces = 0;
+        if (mesh->mFaces && mesh->mNumFaces) {
+            const size_t table = AddStructs(mesh->mFaces,mesh->mNumFaces);
+            for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+                const aiFace& f = mesh->mFaces[i];
+                const uintptr_t indices = AddData(f.mIndices,f.mNumIndices * sizeof(unsigned int),sizeof(unsigned int));
+                SetRef(At<aiFace>(table + i * sizeof(aiFace)).mIndices,indices);
+            }
+            faces = AssmapStructRef(table);
+        }
+
+        const uintptr_t bones = AddObjects(mesh->mBones,mesh->mNumBones,&AssmapWriter::AddBone);
+        const uintptr_t animMeshes = AddObjects(mesh->mAnimMeshes,mesh->mNumAnimMeshes,&AssmapWriter::AddAnimMesh);
+
+        uintptr_t colors[AI_MAX_NUMBER_OF_COLOR_SETS], uvs[AI_MAX_NUMBER_OF_TEXTURECOORDS];
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i) {
+            colors[i] = AddData(mesh->mColors[i],nv * sizeof(aiColor4D));
+        }
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+            uvs[i] = AddData(mesh->mTextureCoords[i],nv * sizeof(aiVector3D));
+        }
+        const uintptr_t vertices = AddData(mesh->mVertices,nv * sizeof(aiVector3D));
+        const uintptr_t normals = AddData(mesh->mNormals,nv * sizeof(aiVector3D));
+        const uintptr_t tangents = AddData(mesh->mTangents,nv * sizeof(aiVector3D));
+        const uintptr_t bitangents = AddData(mesh->mBitangents,nv * sizeof(aiVector3D));
+        const uintptr_t meshlets = AddData(mesh->mMeshlets,mesh->mNumMeshlets * sizeof(aiMeshlet));
+        const uintptr_t meshletVertices = AddData(mesh->mMeshletVertices,mesh->mNumMeshletVertices * sizeof(unsigned int));
+        const uintptr_t meshletIndices = AddData(mesh->mMeshletIndices,mesh->mNumMeshletIndices);
+
+        aiMesh& m = At<aiMesh>(offset);
+        SetRef(m.mFaces,faces);
+        SetRef(m.mBones,bones);
+        SetRef(m.mAnimMeshes,animMeshes);
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i) {
+            SetRef(m.mColors[i],colors[i]);
+        }
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+            SetRef(m.mTextureCoords[i],uvs[i]);
+        }
+        SetRef(m.mVertices,vertices);
+        SetRef(m.mNormals,normals);
+        SetRef(m.mTangents,tangents);
+        SetRef(m.mBitangents,bitangents);
+        SetRef(m.mMeshlets,meshlets);
+        SetRef(m.mMeshletVertices,meshletVertices);
+        SetRef(m.mMeshletIndices,meshletIndices);
+        return offset;
+    }
+
+    // -------------------------------------------------------------------
+    size_t AddBone(const aiBone* bone)
+    {
+        const size_t offset = AddStructs(bone,1);
+        const uintptr_t weights = AddData(bone->mWeights,bone->mNumWeights * sizeof(aiVertexWeight));
+        SetRef(At<aiBone>(offset).mWeights,weights);
+        return offset;
+    }
+
+    // -------------------------------------------------------------------
+    size_t AddAnimMesh(const aiAnimMesh* mesh)
+    {
+        const size_t offset = AddStructs(mesh,1);
+        const unsigned int nv = mesh->mNumVertices;
+
+        uintptr_t colors[AI_MAX_NUMBER_OF_COLOR_SETS], uvs[AI_MAX_NUMBER_OF_TEXTURECOORDS];
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i) {
+            colors[i] = AddData(mesh->mColors[i],nv * sizeof(aiColor4D));
+        }
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+            uvs[i] = AddData(mesh->mTextureCoords[i],nv * sizeof(aiVector3D));
+        }
+        const uintptr_t vertices = AddData(mesh->mVertices,nv * sizeof(aiVector3D));
+        const uintptr_t normals = AddData(mesh->mNormals,nv * sizeof(aiVector3D));
+        const uintptr_t tangents = AddData(mesh->mTangents,nv * sizeof(aiVector3D));
+        const uintptr_t bitangents = AddData(mesh->mBitangents,nv * sizeof(aiVector3D));
+
+        aiAnimMesh& m = At<aiAnimMesh>(offset);
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i) {
+            SetRef(m.mColors[i],colors[i]);
+        }
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+            SetRef(m.mTextureCoords[i],uvs[i]);
+        }
+        SetRef(m.mVertices,vertices);
+        SetRef(m.mNormals,normals);
+        SetRef(m.mTangents,tangents);
+        SetRef(m.mBitangents,bitangents);
+        return offset;
+    }
+
+    // -------------------------------------------------------------------
+    size_t AddMaterial(const aiMaterial* mat)
+    {
+        const size_t offset = AddStructs(mat,1);
+        const uintptr_t properties = AddObjects(mat->mProperties,mat->mNumProperties,&AssmapWriter::AddMaterialProperty);
+
+        aiMaterial& m = At<aiMaterial>(offset);
+        SetRef(m.mProperties,properties);
+        m.mNumAllocated = m.mNumProperties;
+        return offset;
+    }
+
+    // -------------------------------------------------------------------
+    size_t AddMaterialProperty(const aiMaterialProperty* prop)
+    {
+        const size_t offset = AddStructs(prop,1);
+        const uintptr_t data = AddData(prop->mData,prop->mDataLength,8);
+        SetRef(At<aiMaterialProperty>(offset).mData,data);
+        return offset;
+    }
+
+    // -------------------------------------------------------------------
+    size_t AddTexture(const aiTexture* tex)
+    {
+        const size_t offset = AddStructs(tex,1);
+        const size_t size = tex->mHeight ? tex->mWidth * tex->mHeight * sizeof(aiTexel) : tex->mWidth;
+        const uintptr_t data = AddData(tex->pcData,size);
+        SetRef(At<aiTexture>(offset).pcData,data);
+        return offset;
+    }
+
+    // -------------------------------------------------------------------
+    size_t AddAnimation(const aiAnimation* anim)
+    {
+        const size_t offset = AddStructs(anim,1);
+        const uintptr_t channels = AddObjects(anim->mChannels,anim->mNumChannels,&AssmapWriter::AddNodeAnim);
+        const uintptr_t meshChannels = AddObjects(anim->mMeshChannels,anim->mNumMeshChannels,&AssmapWriter::AddMeshAnim);
+        const uintptr_t morphChannels = AddObjects(anim->mMorphMeshChannels,anim->mNumMorphMeshChannels,&AssmapWriter::AddMeshMorphAnim);
+
+        aiAnimation& a = At<aiAnimation>(offset);
+        SetRef(a.mChannels,channels);
+        SetRef(a.mMeshChannels,meshChannels);
+        SetRef(a.mMorphMeshChannels,morphChannels);
+        return offset;
+    }
+
+    // -------------------------------------------------------------------
+    size_t AddNodeAnim(const aiNodeAnim* anim)
+    {
+        const size_t offset = AddStructs(anim,1);
+        const uintptr_t positions = AddData(anim->mPositionKeys,anim->mNumPositionKeys * sizeof(aiVectorKey));
+        const uintptr_t rotations = AddData(anim->mRotationKeys,anim->mNumRotationKeys * sizeof(aiQuatKey));
+        const uintptr_t scalings = AddData(anim->mScalingKeys,anim->mNumScalingKeys * sizeof(aiVectorKey));
+
+        aiNodeAnim& a = At<aiNodeAnim>(offset);
+        SetRef(a.mPositionKeys,positions);
+        SetRef(a.mRotationKeys,rotations);
+        SetRef(a.mScalingKeys,scalings);
+        return offset;
+    }
+
+    // -------------------------------------------------------------------
+    size_t AddMeshAnim(const aiMeshAnim* anim)
+    {
+        const size_t offset = AddStructs(anim,1);
+        const uintptr_t keys = AddData(anim->mKeys,anim->mNumKeys * sizeof(aiMeshKey));
+        SetRef(At<aiMeshAnim>(offset).mKeys,keys);
+        return offset;
+    }
+
+    // -------------------------------------------------------------------
+    size_t AddMeshMorphAnim(const aiMeshMorphAnim* anim)
+    {
+        const size_t offset = AddStructs(anim,1);
+
+        uintptr_t keys = 0;
+        if (anim->mKeys && anim->mNumKeys) {
+            const size_t table = AddStructs(anim->mKeys,anim->mNumKeys);
+            for (unsigned int i = 0; i < anim->mNumKeys; ++i) {
+                const aiMeshMorphKey& k = anim->mKeys[i];
+                const uintptr_t values = AddData(k.mValues,k.mNumValuesAndWeights * sizeof(unsigned int));
+                const uintptr_t weights = AddData(k.mWeights,k.mNumValuesAndWeights * sizeof(double));
+
+                aiMeshMorphKey& dest = At<aiMeshMorphKey>(table + i * sizeof(aiMeshMorphKey));
+                SetRef(dest.mValues,values);
+                SetRef(dest.mWeights,weights);
+            }
+            keys = AssmapStructRef(table);
+        }
+        SetRef(At<aiMeshMorphAnim>(offset).mKeys,keys);
+        return offset;
+    }
+
+private:
+    std::vector<uint8_t> mStructs;
+    std::vector<DataBlock> mData;
+    size_t mDataSize;
+};
+
+} // end of anonymous namespace
+
+// ------------------------------------------------------------------------------------------------
+// Worker function for exporting a scene to .assmap. Prototyped and registered in Exporter.cpp
+// and used by ImportCache.cpp
+void ExportSceneAssmap(const char* pFile, IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* /*pProperties*/)
+{
+    const AssmapWriter writer(pScene);
+
+    std::unique_ptr<IOStream> out(pIOSystem->Open(pFile,"wb"));
+    if (!out) {
+        throw DeadlyExportError("ASSMAP: Could not open output file: " + std::string(pFile));
+    }
+    writer.Write(out.get());
+}
+
+} // end of namespace Assimp
+
+#endif // ASSIMP_BUILD_NO_ASSMAP_EXPORTER
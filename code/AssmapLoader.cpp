@@ -0,0 +1,109 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  AssmapLoader.cpp
+ *  @brief Implementation of the .assmap importer class
+ *
+ *  see assmap_format.h
+ */
+
+#ifndef ASSIMP_BUILD_NO_ASSMAP_IMPORTER
+
+#include "AssmapLoader.h"
+#include "assmap_format.h"
+#include "Exceptional.h"
+#include <assimp/MappedScene.hpp>
+#include <assimp/SceneCombiner.h>
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
+#include <assimp/scene.h>
+#include <assimp/importerdesc.h>
+
+#include <memory>
+#include <string.h>
+
+using namespace Assimp;
+
+static const aiImporterDesc desc = {
+    ".assmap Importer",
+    "",
+    "",
+    "Scene cache, only readable by the build which wrote it",
+    aiImporterFlags_SupportBinaryFlavour,
+    0,
+    0,
+    0,
+    0,
+    "assmap"
+};
+
+const aiImporterDesc* AssmapImporter::GetInfo() const
+{
+    return &desc;
+}
+
+bool AssmapImporter::CanRead( const std::string& pFile, IOSystem* pIOHandler, bool checkSig ) const
+{
+    const std::string extension = GetExtension(pFile);
+    if (extension == "assmap") {
+        return true;
+    }
+    if ((!extension.length() || checkSig) && pIOHandler) {
+        std::unique_ptr<IOStream> in(pIOHandler->Open(pFile));
+        char magic[16] = {};
+        return in && in->Read(magic,1,sizeof(magic)) == sizeof(magic) &&
+            !strncmp(magic,ASSMAP_MAGIC,sizeof(magic));
+    }
+    return false;
+}
+
+void AssmapImporter::InternReadFile( const std::string& pFile, aiScene* pScene, IOSystem* pIOHandler )
+{
+    MappedScene mapped;
+    const aiScene* src = mapped.Load(pFile.c_str(),pIOHandler);
+    if (!src) {
+        throw DeadlyImportError(mapped.GetErrorString());
+    }
+
+    SceneCombiner::CopyScene(&pScene,src,false);
+}
+
+#endif // !! ASSIMP_BUILD_NO_ASSMAP_IMPORTER
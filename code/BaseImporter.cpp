@@ -64,6 +64,8 @@ using namespace Assimp;
 // Constructor to be privately used by Importer
 BaseImporter::BaseImporter()
 : m_progress()
+, m_profiler()
+, m_threadPool()
 {
     // nothing to do here
 }
@@ -82,6 +84,9 @@ aiScene* BaseImporter::ReadFile(const Importer* pImp, const std::string& pFile,
     m_progress = pImp->GetProgressHandler();
     ai_assert(m_progress);
 
+    m_profiler = pImp->Pimpl()->mProfiler;
+    m_threadPool = pImp->Pimpl()->mThreadPool;
+
     // Gather configuration properties for this run
     SetupProperties( pImp );
 
@@ -60,6 +60,11 @@ class IOSystem;
 class BaseProcess;
 class SharedPostProcessInfo;
 class IOStream;
+class ThreadPool;
+
+namespace Profiling {
+    class Profiler;
+}
 
 // utility to do char4 to uint32 in a portable manner
 #define AI_MAKE_MAGIC(string) ((uint32_t)((string[0] << 24) + \
@@ -388,6 +393,11 @@ protected:
     std::string m_ErrorText;
     /// Currently set progress handler.
     ProgressHandler* m_progress;
+    /// Profiler to time the import phases with, NULL unless the
+    /// importer collects statistics.
+    Profiling::Profiler* m_profiler;
+    /// Worker pool of the importer, NULL if multithreading is disabled.
+    ThreadPool* m_threadPool;
 };
 
 
@@ -47,6 +47,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/scene.h>
 #include "Importer.h"
+#include "ThreadPool.h"
 
 using namespace Assimp;
 
@@ -54,6 +55,8 @@ using namespace Assimp;
 // Constructor to be privately used by Importer
 BaseProcess::BaseProcess()
 : shared()
+, threadPool()
+, profiler()
 , progress()
 {
 }
@@ -73,6 +76,9 @@ void BaseProcess::ExecuteOnScene( Importer* pImp)
     progress = pImp->GetProgressHandler();
     ai_assert(progress);
 
+    threadPool = pImp->Pimpl()->mThreadPool;
+    profiler = pImp->Pimpl()->mProfiler;
+
     SetupProperties( pImp );
 
     // catch exceptions thrown inside the PostProcess-Step
@@ -98,6 +104,22 @@ void BaseProcess::SetupProperties(const Importer* /*pImp*/)
     // the default implementation does nothing
 }
 
+// ------------------------------------------------------------------------------------------------
+void BaseProcess::ExecutePerMesh( aiScene* pScene, const std::function<void(unsigned int)>& fn)
+{
+    ai_assert(NULL != pScene);
+
+    if (threadPool && pScene->mNumMeshes > 1) {
+        threadPool->ParallelFor(pScene->mNumMeshes, [&fn](size_t i) {
+            fn(static_cast<unsigned int>(i));
+        });
+        return;
+    }
+    for (unsigned int a = 0; a < pScene->mNumMeshes; a++) {
+        fn(a);
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 bool BaseProcess::RequireVerboseFormat() const
 {
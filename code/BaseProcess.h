@@ -44,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define INCLUDED_AI_BASEPROCESS_H
 
 #include <map>
+#include <functional>
 #include "GenericProperty.h"
 
 struct aiScene;
@@ -51,6 +52,11 @@ struct aiScene;
 namespace Assimp    {
 
 class Importer;
+class ThreadPool;
+
+namespace Profiling {
+    class Profiler;
+}
 
 // ---------------------------------------------------------------------------
 /** Helper class to allow post-processing steps to interact with each other.
@@ -199,6 +205,7 @@ private:
 
 
 #define AI_SPP_SPATIAL_SORT "$Spat"
+#define AI_SPP_SPATIAL_GRID "$SpatGrid"
 
 // ---------------------------------------------------------------------------
 /** The BaseProcess defines a common interface for all post processing steps.
@@ -278,11 +285,49 @@ public:
         return shared;
     }
 
+    // -------------------------------------------------------------------
+    /** Assign the thread pool to be used by ExecutePerMesh(). This is
+     *  done by ExecuteOnScene() if the importer has been configured
+     *  to use more than one thread.
+     * @param pool May be NULL, meshes are processed serially then.
+    */
+    inline void SetThreadPool(ThreadPool* pool)    {
+        threadPool = pool;
+    }
+
+    // -------------------------------------------------------------------
+    /** Get the thread pool that is assigned to the step.
+    */
+    inline ThreadPool* GetThreadPool()   {
+        return threadPool;
+    }
+
+protected:
+
+    // -------------------------------------------------------------------
+    /** Invokes a function once for each mesh in the scene.
+     * If a thread pool is assigned to the step, the meshes are distributed
+     * over its threads. The function may thus only modify the mesh with the
+     * given index and write per-index results, which the caller should then
+     * reduce in mesh order to keep the output identical to a serial run.
+     * @param pScene The scene to work at.
+     * @param fn Function to be invoked for each mesh index.
+    */
+    void ExecutePerMesh( aiScene* pScene, const std::function<void(unsigned int)>& fn);
+
 protected:
 
     /** See the doc of #SharedPostProcessInfo for more details */
     SharedPostProcessInfo* shared;
 
+    /** Thread pool for per-mesh work, NULL for serial execution */
+    ThreadPool* threadPool;
+
+    /** Profiler to report counters to, NULL unless the importer
+     *  collects statistics. Not thread-safe, report from the calling
+     *  thread only (i.e. not from within ExecutePerMesh()). */
+    Profiling::Profiler* profiler;
+
     /** Currently active progress handler */
     ProgressHandler* progress;
 };
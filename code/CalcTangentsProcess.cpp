@@ -56,7 +56,8 @@ using namespace Assimp;
 // Constructor to be privately used by Importer
 CalcTangentsProcess::CalcTangentsProcess()
 : configMaxAngle( AI_DEG_TO_RAD(45.f) )
-, configSourceUV( 0 ) {
+, configSourceUV( 0 )
+, configUseGrid( false ) {
     // nothing to do here
 }
 
@@ -86,6 +87,9 @@ void CalcTangentsProcess::SetupProperties(const Importer* pImp)
     configMaxAngle = AI_DEG_TO_RAD(configMaxAngle);
 
     configSourceUV = pImp->GetPropertyInteger(AI_CONFIG_PP_CT_TEXTURE_CHANNEL_INDEX,0);
+
+    // get the current value of the AI_CONFIG_PP_USE_SPATIAL_HASH_GRID property
+    configUseGrid = pImp->GetPropertyBool(AI_CONFIG_PP_USE_SPATIAL_HASH_GRID,false);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -96,9 +100,14 @@ void CalcTangentsProcess::Execute( aiScene* pScene)
 
     DefaultLogger::get()->debug("CalcTangentsProcess begin");
 
+    std::vector<char> generated( pScene->mNumMeshes, 0 );
+    ExecutePerMesh( pScene, [&]( unsigned int a ) {
+        generated[ a ] = ProcessMesh( pScene->mMeshes[a],a);
+    });
+
     bool bHas = false;
     for ( unsigned int a = 0; a < pScene->mNumMeshes; a++ ) {
-        if(ProcessMesh( pScene->mMeshes[a],a))bHas = true;
+        if(generated[a])bHas = true;
     }
 
     if ( bHas ) {
@@ -235,26 +244,8 @@ bool CalcTangentsProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
 
     // create a helper to quickly find locally close vertices among the vertex array
     // FIX: check whether we can reuse the SpatialSort of a previous step
-    SpatialSort* vertexFinder = NULL;
-    SpatialSort  _vertexFinder;
-    float posEpsilon;
-    if (shared)
-    {
-        std::vector<std::pair<SpatialSort,float> >* avf;
-        shared->GetProperty(AI_SPP_SPATIAL_SORT,avf);
-        if (avf)
-        {
-            std::pair<SpatialSort,float>& blubb = avf->operator [] (meshIndex);
-            vertexFinder = &blubb.first;
-            posEpsilon = blubb.second;;
-        }
-    }
-    if (!vertexFinder)
-    {
-        _vertexFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof( aiVector3D));
-        vertexFinder = &_vertexFinder;
-        posEpsilon = ComputePositionEpsilon(pMesh);
-    }
+    const SpatialLookup vertexFinder(pMesh, meshIndex, shared, configUseGrid);
+    const ai_real posEpsilon = vertexFinder.GetPositionEpsilon();
     std::vector<unsigned int> verticesFound;
 
     const float fLimit = std::cos(configMaxAngle);
@@ -274,7 +265,7 @@ bool CalcTangentsProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
         closeVertices.resize( 0 );
 
         // find all vertices close to that position
-        vertexFinder->FindPositions( origPos, posEpsilon, verticesFound);
+        vertexFinder.FindPositions( origPos, posEpsilon, verticesFound);
 
         closeVertices.reserve (verticesFound.size()+5);
         closeVertices.push_back( a);
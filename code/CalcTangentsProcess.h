@@ -109,6 +109,9 @@ private:
     /** Configuration option: maximum smoothing angle, in radians*/
     float configMaxAngle;
     unsigned int configSourceUV;
+
+    /** Configuration option: use a SpatialHashGrid instead of a SpatialSort */
+    bool configUseGrid;
 };
 
 } // end of namespace Assimp
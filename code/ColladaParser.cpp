@@ -1977,20 +1977,12 @@ void ColladaParser::ReadDataArray()
             }
         } else
         {
-            data.mValues.reserve( count);
+            data.mValues.resize( count);
 
-            for( unsigned int a = 0; a < count; a++)
-            {
-                if( *content == 0)
-                    ThrowException( "Expected more values while reading float_array contents.");
-
-                ai_real value;
-                // read a number
-                content = fast_atoreal_move<ai_real>( content, value);
-                data.mValues.push_back( value);
-                // skip whitespace after it
-                SkipSpacesAndLineEnd( &content);
-            }
+            // read all numbers at once
+            const char* end = content + strlen( content);
+            if( count > 0 && fast_atoreal_array<ai_real>( content, end, &data.mValues[0], count) < count)
+                ThrowException( "Expected more values while reading float_array contents.");
         }
     }
 
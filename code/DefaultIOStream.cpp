@@ -49,11 +49,30 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <sys/types.h>
 #include <sys/stat.h>
 
+#ifdef _WIN32
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   include <windows.h>
+#   include <io.h>
+#else
+#   include <sys/mman.h>
+#endif
+
 using namespace Assimp;
 
 // ----------------------------------------------------------------------------------
 DefaultIOStream::~DefaultIOStream()
 {
+    if (mMappedView) {
+#ifdef _WIN32
+        ::UnmapViewOfFile(mMappedView);
+        ::CloseHandle(mMappingHandle);
+#else
+        ::munmap(mMappedView, mMappedSize);
+#endif
+        mMappedView = NULL;
+    }
     if (mFile) {
         ::fclose(mFile);
         mFile = nullptr;
@@ -150,3 +169,45 @@ void DefaultIOStream::Flush()
 }
 
 // ----------------------------------------------------------------------------------
+const void* DefaultIOStream::MapView()
+{
+    if (mMappedView) {
+        return mMappedView;
+    }
+
+    // empty files can't be mapped
+    const size_t size = FileSize();
+    if (!mFile || !size) {
+        return NULL;
+    }
+
+#ifdef _WIN32
+    HANDLE file = (HANDLE)::_get_osfhandle(::_fileno(mFile));
+    if (INVALID_HANDLE_VALUE == file) {
+        return NULL;
+    }
+    mMappingHandle = ::CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (NULL == mMappingHandle) {
+        return NULL;
+    }
+    mMappedView = ::MapViewOfFile(mMappingHandle, FILE_MAP_READ, 0, 0, size);
+    if (NULL == mMappedView) {
+        ::CloseHandle(mMappingHandle);
+        mMappingHandle = NULL;
+        return NULL;
+    }
+#else
+    // fails with EACCES for write-only streams, which is exactly what we want
+    void* view = ::mmap(NULL, size, PROT_READ, MAP_PRIVATE, ::fileno(mFile), 0);
+    if (MAP_FAILED == view) {
+        return NULL;
+    }
+#   ifdef POSIX_MADV_SEQUENTIAL
+    // importers typically scan the view front to back
+    ::posix_madvise(view, size, POSIX_MADV_SEQUENTIAL);
+#   endif
+    mMappedView = view;
+#endif
+    mMappedSize = size;
+    return mMappedView;
+}
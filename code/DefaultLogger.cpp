@@ -63,6 +63,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #   include <mutex>
 
 std::mutex loggerMutex;
+
+// serializes access to the streams and the repeated-message filter
+static std::mutex streamMutex;
 #endif
 
 namespace Assimp    {
@@ -381,6 +384,11 @@ void DefaultLogger::WriteToStreams(const char *message, ErrorSeverity ErrorSev )
 {
     ai_assert(NULL != message);
 
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    // messages may come from several worker threads at once
+    std::lock_guard<std::mutex> lock(streamMutex);
+#endif
+
     // Check whether this is a repeated message
     if (! ::strncmp( message,lastMsg, lastLen-1))
     {
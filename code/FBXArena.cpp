@@ -0,0 +1,116 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  FBXArena.cpp
+ *  @brief Implementation of the FBX bump allocator
+ */
+
+#ifndef ASSIMP_BUILD_NO_FBX_IMPORTER
+
+#include "FBXArena.h"
+
+namespace Assimp {
+namespace FBX {
+
+namespace {
+
+    // blocks grow from the first to the last size, so small files stay small
+    const size_t FirstBlockSize = 16 * 1024;
+    const size_t MaxBlockSize = 1024 * 1024;
+}
+
+// ------------------------------------------------------------------------------------------------
+Arena::Arena()
+: cursor()
+, blockEnd()
+, blocks()
+, destructors()
+, nextBlockSize(FirstBlockSize)
+, reserved()
+{
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+Arena::~Arena()
+{
+    for (Destructor* d = destructors; d; d = d->next) {
+        d->destroy(d->object);
+    }
+
+    while (blocks) {
+        Block* const next = blocks->next;
+        ::operator delete(blocks);
+        blocks = next;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void* Arena::AllocateSlow(size_t size, size_t align)
+{
+    // large requests get a block on their own, this keeps the remainder
+    // of the current block available for the next small requests.
+    const bool dedicated = size + align > nextBlockSize / 4;
+    const size_t blockSize = dedicated ? sizeof(Block) + size + align : nextBlockSize;
+
+    Block* const block = static_cast<Block*>(::operator new(blockSize));
+    block->next = blocks;
+    blocks = block;
+    reserved += blockSize;
+
+    char* const data = reinterpret_cast<char*>(block + 1);
+    if (dedicated) {
+        const uintptr_t p = (reinterpret_cast<uintptr_t>(data) + align - 1) & ~static_cast<uintptr_t>(align - 1);
+        return reinterpret_cast<void*>(p);
+    }
+
+    cursor = data;
+    blockEnd = reinterpret_cast<char*>(block) + blockSize;
+    if (nextBlockSize < MaxBlockSize) {
+        nextBlockSize *= 2;
+    }
+    return Allocate(size, align);
+}
+
+} // ! FBX
+} // ! Assimp
+
+#endif // !ASSIMP_BUILD_NO_FBX_IMPORTER
@@ -0,0 +1,190 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  FBXArena.h
+ *  @brief Bump allocator for the FBX tokens and parse-tree
+ */
+#ifndef INCLUDED_AI_FBX_ARENA_H
+#define INCLUDED_AI_FBX_ARENA_H
+
+#include <assimp/defs.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <new>
+#include <utility>
+#include <type_traits>
+
+namespace Assimp {
+namespace FBX {
+
+/** Bump allocator owning the tokens and the parse-tree of a single import.
+ *
+ *  Memory is handed out from large blocks and is only released as a whole,
+ *  when the arena is destroyed. Objects created with New() have their
+ *  destructors run at that point, in reverse order of creation. This saves
+ *  one heap allocation per token and per element and keeps the tree
+ *  contiguous in memory. */
+class ASSIMP_API Arena
+{
+public:
+    Arena();
+    ~Arena();
+
+    /** Get raw memory. The memory is valid until the arena is destroyed.
+     *  @param size Number of bytes, must not be 0
+     *  @param align Required alignment, a power of two */
+    void* Allocate(size_t size, size_t align) {
+        const uintptr_t p = (reinterpret_cast<uintptr_t>(cursor) + align - 1) & ~static_cast<uintptr_t>(align - 1);
+        if (p + size > reinterpret_cast<uintptr_t>(blockEnd)) {
+            return AllocateSlow(size, align);
+        }
+        cursor = reinterpret_cast<char*>(p + size);
+        return reinterpret_cast<void*>(p);
+    }
+
+    /** Construct an object in the arena. */
+    template <typename T, typename... Args>
+    T* New(Args&&... args) {
+        if (std::is_trivially_destructible<T>::value) {
+            return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+
+        // the record is only linked once the object is fully constructed
+        Destructor* const d = static_cast<Destructor*>(Allocate(sizeof(Destructor), alignof(Destructor)));
+        T* const obj = new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        d->destroy = &Destroy<T>;
+        d->object = obj;
+        d->next = destructors;
+        destructors = d;
+        return obj;
+    }
+
+    /** Get the total number of bytes reserved from the heap so far. */
+    size_t GetReservedBytes() const {
+        return reserved;
+    }
+
+private:
+    // no copying
+    Arena(const Arena&);
+    Arena& operator = (const Arena&);
+
+    struct Block {
+        Block* next;
+    };
+
+    struct Destructor {
+        void (*destroy)(void*);
+        void* object;
+        Destructor* next;
+    };
+
+    template <typename T>
+    static void Destroy(void* obj) {
+        static_cast<T*>(obj)->~T();
+    }
+
+    void* AllocateSlow(size_t size, size_t align);
+
+private:
+    char* cursor;
+    char* blockEnd;
+    Block* blocks;
+    Destructor* destructors;
+    size_t nextBlockSize;
+    size_t reserved;
+};
+
+
+/** STL allocator on top of an #Arena. A default-constructed allocator
+ *  uses the heap, so containers of the same type can live on either. */
+template <typename T>
+class ArenaAllocator
+{
+public:
+    typedef T value_type;
+
+    ArenaAllocator()
+    : arena() {
+    }
+
+    explicit ArenaAllocator(Arena& arena)
+    : arena(&arena) {
+    }
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other)
+    : arena(other.arena) {
+    }
+
+    T* allocate(size_t n) {
+        if (arena) {
+            return static_cast<T*>(arena->Allocate(n * sizeof(T), alignof(T)));
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t) {
+        // arena memory is released together with the arena
+        if (!arena) {
+            ::operator delete(p);
+        }
+    }
+
+    template <typename U>
+    bool operator == (const ArenaAllocator<U>& other) const {
+        return arena == other.arena;
+    }
+
+    template <typename U>
+    bool operator != (const ArenaAllocator<U>& other) const {
+        return arena != other.arena;
+    }
+
+private:
+    template <typename U> friend class ArenaAllocator;
+    Arena* arena;
+};
+
+} // ! FBX
+} // ! Assimp
+
+#endif // ! INCLUDED_AI_FBX_ARENA_H
@@ -53,6 +53,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FBXImportSettings.h"
 #include "FBXDocumentUtil.h"
 #include "FBXProperties.h"
+#include "ThreadPool.h"
 
 #include <memory>
 #include <functional>
@@ -408,6 +409,27 @@ void Document::ReadObjects()
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+void Document::PreloadObjects(ThreadPool& threadPool)
+{
+    std::vector<LazyObject*> preload;
+    for(const ObjectMap::value_type& v : objects) {
+        const Token& key = v.second->GetElement().KeyToken();
+        const size_t length = static_cast<size_t>(key.end()-key.begin());
+
+        // geometry resolves its skin on demand, curves don't reference anything
+        if ((length == 8 && !strncmp(key.begin(),"Geometry",8)) ||
+            (length == 14 && !strncmp(key.begin(),"AnimationCurve",14) && settings.readAnimations)) {
+            preload.push_back(v.second);
+        }
+    }
+
+    // objects only touch their own state during construction, see LazyObject::Get
+    threadPool.ParallelFor(preload.size(), [&preload](size_t i) {
+        preload[i]->Get();
+    });
+}
+
 // ------------------------------------------------------------------------------------------------
 void Document::ReadPropertyTemplates()
 {
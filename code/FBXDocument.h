@@ -55,6 +55,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define  AI_CONCAT(a,b)  _AI_CONCAT(a,b)
 
 namespace Assimp {
+
+class ThreadPool;
+
 namespace FBX {
 
 class Parser;
@@ -1129,6 +1132,12 @@ public:
 
     const std::vector<const AnimationStack*>& AnimationStacks() const;
 
+    /** Construct all objects whose construction doesn't depend on other
+     *  objects (i.e. mesh geometry and animation curves) using the given
+     *  pool. Those are the objects holding large, possibly compressed,
+     *  data arrays. Other objects are still constructed on demand. */
+    void PreloadObjects(ThreadPool& threadPool);
+
 private:
     std::vector<const Connection*> GetConnectionsSequenced(uint64_t id, const ConnectionMap&) const;
     std::vector<const Connection*> GetConnectionsSequenced(uint64_t id, bool is_src,
@@ -64,6 +64,7 @@ struct ImportSettings
         , preservePivots(true)
         , optimizeEmptyAnimationCurves(true)
 		, searchEmbeddedTextures(false)
+        , parallelDecode(true)
     {}
 
 
@@ -142,6 +143,11 @@ struct ImportSettings
 	/** search for embedded loaded textures, where no embedded texture data is provided.
 	*  The default value is false. */
 	bool searchEmbeddedTextures;
+
+    /** construct geometry and animation curves in parallel before the
+     *  conversion starts, if the importer runs multithreaded.
+     *  The default value is true. */
+    bool parallelDecode;
 };
 
 
@@ -55,6 +55,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "StreamReader.h"
 #include "MemoryIOWrapper.h"
+#include "Profiler.h"
+#include "ThreadPool.h"
 #include <assimp/Importer.hpp>
 #include <assimp/importerdesc.h>
 
@@ -69,6 +71,7 @@ namespace Assimp {
 using namespace Assimp;
 using namespace Assimp::Formatter;
 using namespace Assimp::FBX;
+using namespace Assimp::Profiling;
 
 namespace {
 static const aiImporterDesc desc = {
@@ -136,6 +139,7 @@ void FBXImporter::SetupProperties(const Importer* pImp)
     settings.preservePivots = pImp->GetPropertyBool(AI_CONFIG_IMPORT_FBX_PRESERVE_PIVOTS, true);
     settings.optimizeEmptyAnimationCurves = pImp->GetPropertyBool(AI_CONFIG_IMPORT_FBX_OPTIMIZE_EMPTY_ANIMATION_CURVES, true);
 	settings.searchEmbeddedTextures = pImp->GetPropertyBool(AI_CONFIG_IMPORT_FBX_SEARCH_EMBEDDED_TEXTURES, false);
+    settings.parallelDecode = pImp->GetPropertyBool(AI_CONFIG_IMPORT_FBX_PARALLEL_DECODE, true);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -148,46 +152,75 @@ void FBXImporter::InternReadFile( const std::string& pFile,
         ThrowException("Could not open file for reading");
     }
 
-    // read entire file into memory - no streaming for this, fbx
+    // binary files are tokenized in place if the IO system can map
+    // them into memory, tokens keep pointing into the view. The ASCII
+    // tokenizer needs a zero-terminated buffer, though.
+    ProfileRegion readRegion(m_profiler,"read");
+    const size_t fileSize = stream->FileSize();
+    const char* view = static_cast<const char*>(stream->MapView());
+    if (view && (fileSize < 18 || strncmp(view,"Kaydara FBX Binary",18))) {
+        view = NULL;
+    }
+
+    // otherwise read entire file into memory - no streaming for this, fbx
     // files can grow large, but the assimp output data structure
     // then becomes very large, too. Assimp doesn't support
     // streaming for its output data structures so the net win with
     // streaming input data would be very low.
     std::vector<char> contents;
-    contents.resize(stream->FileSize()+1);
-    stream->Read( &*contents.begin(), 1, contents.size()-1 );
-    contents[ contents.size() - 1 ] = 0;
-    const char* const begin = &*contents.begin();
+    if (!view) {
+        contents.resize(fileSize+1);
+        stream->Read( &*contents.begin(), 1, contents.size()-1 );
+        contents[ contents.size() - 1 ] = 0;
+    }
+    const char* const begin = view ? view : &*contents.begin();
+    const size_t length = view ? fileSize : contents.size();
+
+    readRegion.End();
+
+    // tokens and the parse-tree built from them are all allocated
+    // from a single arena and released together at the end.
+    Arena arena;
 
     // broadphase tokenizing pass in which we identify the core
     // syntax elements of FBX (brackets, commas, key:value mappings)
     TokenList tokens;
-    try {
+    ProfileRegion tokenizeRegion(m_profiler,"tokenize");
+    bool is_binary = false;
+    if (!strncmp(begin,"Kaydara FBX Binary",18)) {
+        is_binary = true;
+        TokenizeBinary(tokens,begin,static_cast<unsigned int>(length),arena);
+    }
+    else {
+        Tokenize(tokens,begin,arena);
+    }
+    if (m_profiler) {
+        m_profiler->AddCounter("tokens",static_cast<double>(tokens.size()));
+    }
+    tokenizeRegion.End();
 
-        bool is_binary = false;
-        if (!strncmp(begin,"Kaydara FBX Binary",18)) {
-            is_binary = true;
-            TokenizeBinary(tokens,begin,static_cast<unsigned int>(contents.size()));
-        }
-        else {
-            Tokenize(tokens,begin);
-        }
+    // use this information to construct a very rudimentary
+    // parse-tree representing the FBX scope structure
+    ProfileRegion parseRegion(m_profiler,"parse");
+    Parser parser(tokens, arena, is_binary);
 
-        // use this information to construct a very rudimentary
-        // parse-tree representing the FBX scope structure
-        Parser parser(tokens, is_binary);
+    // take the raw parse-tree and convert it to a FBX DOM
+    Document doc(parser,settings);
+    parseRegion.End();
 
-        // take the raw parse-tree and convert it to a FBX DOM
-        Document doc(parser,settings);
+    // inflate and parse the large data arrays up-front if possible
+    if (settings.parallelDecode && m_threadPool && m_threadPool->GetNumThreads() > 1) {
+        ProfileRegion decodeRegion(m_profiler,"decode");
+        doc.PreloadObjects(*m_threadPool);
+    }
 
-        // convert the FBX DOM to aiScene
-        ConvertToAssimpScene(pScene,doc);
+    // convert the FBX DOM to aiScene
+    ProfileRegion convertRegion(m_profiler,"convert");
+    ConvertToAssimpScene(pScene,doc);
+    convertRegion.End();
 
-        std::for_each(tokens.begin(),tokens.end(),Util::delete_fun<Token>());
-    }
-    catch(std::exception&) {
-        std::for_each(tokens.begin(),tokens.end(),Util::delete_fun<Token>());
-        throw;
+    if (m_profiler) {
+        m_profiler->AddCounter("arena_bytes",static_cast<double>(arena.GetReservedBytes()));
     }
 }
 
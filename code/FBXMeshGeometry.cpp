@@ -62,16 +62,11 @@ using namespace Util;
 // ------------------------------------------------------------------------------------------------
 Geometry::Geometry(uint64_t id, const Element& element, const std::string& name, const Document& doc)
     : Object(id, element,name)
+    , doc(doc)
     , skin()
+    , skinResolved()
 {
-    const std::vector<const Connection*>& conns = doc.GetConnectionsByDestinationSequenced(ID(),"Deformer");
-    for(const Connection* con : conns) {
-        const Skin* const sk = ProcessSimpleConnection<Skin>(*con, false, "Skin -> Geometry", element);
-        if(sk) {
-            skin = sk;
-            break;
-        }
-    }
+    // empty
 }
 
 
@@ -81,7 +76,20 @@ Geometry::~Geometry()
 
 }
 
+// ------------------------------------------------------------------------------------------------
 const Skin* Geometry::DeformerSkin() const {
+    if (!skinResolved) {
+        skinResolved = true;
+
+        const std::vector<const Connection*>& conns = doc.GetConnectionsByDestinationSequenced(ID(),"Deformer");
+        for(const Connection* con : conns) {
+            const Skin* const sk = ProcessSimpleConnection<Skin>(*con, false, "Skin -> Geometry", element);
+            if(sk) {
+                skin = sk;
+                break;
+            }
+        }
+    }
     return skin;
 }
 
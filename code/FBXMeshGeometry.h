@@ -64,7 +64,12 @@ public:
     const Skin* DeformerSkin() const;
 
 private:
-    const Skin* skin;
+    const Document& doc;
+
+    // resolved on first use, this keeps the construction of geometry
+    // independent of all other objects.
+    mutable const Skin* skin;
+    mutable bool skinResolved;
 };
 
 
@@ -117,6 +117,8 @@ namespace FBX {
 // ------------------------------------------------------------------------------------------------
 Element::Element(const Token& key_token, Parser& parser)
 : key_token(key_token)
+, tokens(ArenaAllocator<TokenPtr>(parser.arena))
+, compound()
 {
     TokenPtr n = NULL;
     do {
@@ -147,7 +149,7 @@ Element::Element(const Token& key_token, Parser& parser)
         }
 
         if (n->Type() == TokenType_OPEN_BRACKET) {
-            compound.reset(new Scope(parser));
+            compound = parser.arena.New<Scope>(parser);
 
             // current token should be a TOK_CLOSE_BRACKET
             n = parser.CurrentToken();
@@ -167,7 +169,7 @@ Element::Element(const Token& key_token, Parser& parser)
 // ------------------------------------------------------------------------------------------------
 Element::~Element()
 {
-     // no need to delete tokens, they are owned by the parser
+    // no need to delete tokens or the compound scope, they are owned by the arena
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -192,7 +194,7 @@ Scope::Scope(Parser& parser,bool topLevel)
         }
 
         const std::string& str = n->StringContents();
-        elements.insert(ElementMap::value_type(str,new_Element(*n,parser)));
+        elements.insert(ElementMap::value_type(str,parser.arena.New<Element>(*n,parser)));
 
         // Element() should stop at the next Key token (or right after a Close token)
         n = parser.CurrentToken();
@@ -208,21 +210,21 @@ Scope::Scope(Parser& parser,bool topLevel)
 // ------------------------------------------------------------------------------------------------
 Scope::~Scope()
 {
-    for(ElementMap::value_type& v : elements) {
-        delete v.second;
-    }
+    // no need to delete elements, they are owned by the arena
 }
 
 
 // ------------------------------------------------------------------------------------------------
-Parser::Parser (const TokenList& tokens, bool is_binary)
+Parser::Parser (const TokenList& tokens, Arena& arena, bool is_binary)
 : tokens(tokens)
+, arena(arena)
 , last()
 , current()
 , cursor(tokens.begin())
+, root()
 , is_binary(is_binary)
 {
-    root.reset(new Scope(*this,true));
+    root = arena.New<Scope>(*this,true);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -61,15 +61,12 @@ class Scope;
 class Parser;
 class Element;
 
-// XXX should use C++11's unique_ptr - but assimp's need to keep working with 03
+// scopes and elements are owned by the #Arena of the import
 typedef std::vector< Scope* > ScopeList;
 typedef std::fbx_unordered_multimap< std::string, Element* > ElementMap;
 
 typedef std::pair<ElementMap::const_iterator,ElementMap::const_iterator> ElementCollection;
 
-#   define new_Scope new Scope
-#   define new_Element new Element
-
 
 /** FBX data entity that consists of a key:value tuple.
  *
@@ -89,7 +86,7 @@ public:
     ~Element();
 
     const Scope* Compound() const {
-        return compound.get();
+        return compound;
     }
 
     const Token& KeyToken() const {
@@ -103,7 +100,7 @@ public:
 private:
     const Token& key_token;
     TokenList tokens;
-    std::unique_ptr<Scope> compound;
+    const Scope* compound;
 };
 
 /** FBX data entity that consists of a 'scope', a collection
@@ -157,12 +154,14 @@ class Parser
 {
 public:
     /** Parse given a token list. Does not take ownership of the tokens -
-     *  the objects must persist during the entire parser lifetime */
-    Parser (const TokenList& tokens,bool is_binary);
+     *  the objects must persist during the entire parser lifetime. The
+     *  parse-tree is allocated from the given arena, which must outlive
+     *  the parser and everything referencing its scopes and elements. */
+    Parser (const TokenList& tokens, Arena& arena, bool is_binary);
     ~Parser();
 
     const Scope& GetRootScope() const {
-        return *root.get();
+        return *root;
     }
 
     bool IsBinary() const {
@@ -181,10 +180,11 @@ private:
 
 private:
     const TokenList& tokens;
+    Arena& arena;
 
     TokenPtr last, current;
     TokenList::const_iterator cursor;
-    std::unique_ptr<Scope> root;
+    const Scope* root;
 
     const bool is_binary;
 };
@@ -46,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define INCLUDED_AI_FBX_TOKENIZER_H
 
 #include "FBXCompileConfig.h"
+#include "FBXArena.h"
 #include <assimp/ai_assert.h>
 #include <vector>
 #include <string>
@@ -152,11 +153,9 @@ private:
     const unsigned int column;
 };
 
-// XXX should use C++11's unique_ptr - but assimp's need to keep working with 03
+// tokens are owned by the #Arena of the import
 typedef const Token* TokenPtr;
-typedef std::vector< TokenPtr > TokenList;
-
-#define new_Token new Token
+typedef std::vector< TokenPtr, ArenaAllocator<TokenPtr> > TokenList;
 
 
 /** Main FBX tokenizer function. Transform input buffer into a list of preprocessed tokens.
@@ -165,8 +164,9 @@ typedef std::vector< TokenPtr > TokenList;
  *
  * @param output_tokens Receives a list of all tokens in the input data.
  * @param input_buffer Textual input buffer to be processed, 0-terminated.
+ * @param arena Receives the tokens, must outlive them.
  * @throw DeadlyImportError if something goes wrong */
-void Tokenize(TokenList& output_tokens, const char* input);
+void Tokenize(TokenList& output_tokens, const char* input, Arena& arena);
 
 
 /** Tokenizer function for binary FBX files.
@@ -176,8 +176,9 @@ void Tokenize(TokenList& output_tokens, const char* input);
  * @param output_tokens Receives a list of all tokens in the input data.
  * @param input_buffer Binary input buffer to be processed.
  * @param length Length of input buffer, in bytes. There is no 0-terminal.
+ * @param arena Receives the tokens, must outlive them.
  * @throw DeadlyImportError if something goes wrong */
-void TokenizeBinary(TokenList& output_tokens, const char* input, unsigned int length);
+void TokenizeBinary(TokenList& output_tokens, const char* input, unsigned int length, Arena& arena);
 
 
 } // ! FBX
@@ -46,7 +46,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 #include "FindInstancesProcess.h"
+#include "ThreadPool.h"
 #include <memory>
+#include <map>
+#include <unordered_map>
+#include <algorithm>
+#include <functional>
+#include <cmath>
 #include <stdio.h>
 
 using namespace Assimp;
@@ -114,6 +120,90 @@ void UpdateMeshIndices(aiNode* node, unsigned int* lookup)
         UpdateMeshIndices(node->mChildren[n],lookup);
 }
 
+// ------------------------------------------------------------------------------------------------
+// Check whether a mesh is an instance of another mesh with the same hash
+bool IsInstance(const aiMesh* orig, const aiMesh* inst, ai_real epsilon, bool configSpeedFlag)
+{
+    // check for hash collision .. we needn't check
+    // the vertex format, it *must* match due to the
+    // (brilliant) construction of the hash
+    if (orig->mNumBones       != inst->mNumBones      ||
+        orig->mNumFaces       != inst->mNumFaces      ||
+        orig->mNumVertices    != inst->mNumVertices   ||
+        orig->mMaterialIndex  != inst->mMaterialIndex ||
+        orig->mPrimitiveTypes != inst->mPrimitiveTypes)
+        return false;
+
+    // up to now the meshes are equal. compare vertex positions,
+    // normals, tangents and bitangents using the (squared) epsilon
+    // computed for the instance.
+    epsilon *= epsilon;
+    if (orig->HasPositions()) {
+        if(!CompareArrays(orig->mVertices,inst->mVertices,orig->mNumVertices,epsilon))
+            return false;
+    }
+    if (orig->HasNormals()) {
+        if(!CompareArrays(orig->mNormals,inst->mNormals,orig->mNumVertices,epsilon))
+            return false;
+    }
+    if (orig->HasTangentsAndBitangents()) {
+        if (!CompareArrays(orig->mTangents,inst->mTangents,orig->mNumVertices,epsilon) ||
+            !CompareArrays(orig->mBitangents,inst->mBitangents,orig->mNumVertices,epsilon))
+            return false;
+    }
+
+    // use a constant epsilon for colors and UV coordinates
+    static const float uvEpsilon = 10e-4f;
+    for (unsigned int i = 0, end = orig->GetNumUVChannels(); i < end; ++i) {
+        if (!orig->mTextureCoords[i]) {
+            continue;
+        }
+        if(!CompareArrays(orig->mTextureCoords[i],inst->mTextureCoords[i],orig->mNumVertices,uvEpsilon)) {
+            return false;
+        }
+    }
+    for (unsigned int i = 0, end = orig->GetNumColorChannels(); i < end; ++i) {
+        if (!orig->mColors[i]) {
+            continue;
+        }
+        if(!CompareArrays(orig->mColors[i],inst->mColors[i],orig->mNumVertices,uvEpsilon)) {
+            return false;
+        }
+    }
+
+    // These two checks are actually quite expensive and almost *never* required.
+    // Almost. That's why they're still here. But there's no reason to do them
+    // in speed-targeted imports.
+    if (!configSpeedFlag) {
+
+        // It seems to be strange, but we really need to check whether the
+        // bones are identical too. Although it's extremely unprobable
+        // that they're not if control reaches here, we need to deal
+        // with unprobable cases, too. It could still be that there are
+        // equal shapes which are deformed differently.
+        if (!CompareBones(orig,inst))
+            return false;
+
+        // For completeness ... compare even the index buffers for equality
+        // face order & winding order doesn't care. Input data is in verbose format.
+        std::unique_ptr<unsigned int[]> ftbl_orig(new unsigned int[orig->mNumVertices]);
+        std::unique_ptr<unsigned int[]> ftbl_inst(new unsigned int[orig->mNumVertices]);
+
+        for (unsigned int tt = 0; tt < orig->mNumFaces;++tt) {
+            aiFace& f = orig->mFaces[tt];
+            for (unsigned int nn = 0; nn < f.mNumIndices;++nn)
+                ftbl_orig[f.mIndices[nn]] = tt;
+
+            aiFace& f2 = inst->mFaces[tt];
+            for (unsigned int nn = 0; nn < f2.mNumIndices;++nn)
+                ftbl_inst[f2.mIndices[nn]] = tt;
+        }
+        if (0 != ::memcmp(ftbl_inst.get(),ftbl_orig.get(),orig->mNumVertices*sizeof(unsigned int)))
+            return false;
+    }
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void FindInstancesProcess::Execute( aiScene* pScene)
@@ -124,133 +214,134 @@ void FindInstancesProcess::Execute( aiScene* pScene)
         // use a pseudo hash for all meshes in the scene to quickly find
         // the ones which are possibly equal. This step is executed early
         // in the pipeline, so we could, depending on the file format,
-        // have several thousand small meshes. That's too much for a brute
-        // everyone-against-everyone check involving up to 10 comparisons
-        // each.
-        std::unique_ptr<uint64_t[]> hashes (new uint64_t[pScene->mNumMeshes]);
-        std::unique_ptr<unsigned int[]> remapping (new unsigned int[pScene->mNumMeshes]);
+        // have several hundred thousand small meshes. That's too much for
+        // a brute everyone-against-everyone check involving up to 10
+        // comparisons each.
+        const unsigned int numMeshes = pScene->mNumMeshes;
+        std::unique_ptr<uint64_t[]> hashes (new uint64_t[numMeshes]);
+        std::unique_ptr<ai_real[]> epsilons (new ai_real[numMeshes]);
+        ExecutePerMesh(pScene, [pScene,&hashes,&epsilons](unsigned int i) {
+            aiMesh* mesh = pScene->mMeshes[i];
+            hashes[i] = GetMeshHash(mesh);
+
+            // find an appropriate epsilon to compare position differences against
+            epsilons[i] = mesh->HasPositions() ? ComputePositionEpsilon(mesh) : ai_real( 0.0 );
+        });
+
+        // only meshes with the same hash can be instances of each other,
+        // group them into buckets (in mesh order) ...
+        std::vector< std::vector<unsigned int> > buckets;
+        {
+            std::unordered_map<uint64_t, unsigned int> bucketOfHash;
+            bucketOfHash.reserve(numMeshes);
+            for (unsigned int i = 0; i < numMeshes; ++i) {
+                std::unordered_map<uint64_t, unsigned int>::iterator it = bucketOfHash.find(hashes[i]);
+                if (it == bucketOfHash.end()) {
+                    it = bucketOfHash.insert(std::make_pair(hashes[i], static_cast<unsigned int>(buckets.size()))).first;
+                    buckets.push_back(std::vector<unsigned int>());
+                }
+                buckets[(*it).second].push_back(i);
+            }
+        }
 
-        unsigned int numMeshesOut = 0;
-        for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
-
-            aiMesh* inst = pScene->mMeshes[i];
-            hashes[i] = GetMeshHash(inst);
-
-            for (int a = i-1; a >= 0; --a) {
-                if (hashes[i] == hashes[a])
-                {
-                    aiMesh* orig = pScene->mMeshes[a];
-                    if (!orig)
-                        continue;
-
-                    // check for hash collision .. we needn't check
-                    // the vertex format, it *must* match due to the
-                    // (brilliant) construction of the hash
-                    if (orig->mNumBones       != inst->mNumBones      ||
-                        orig->mNumFaces       != inst->mNumFaces      ||
-                        orig->mNumVertices    != inst->mNumVertices   ||
-                        orig->mMaterialIndex  != inst->mMaterialIndex ||
-                        orig->mPrimitiveTypes != inst->mPrimitiveTypes)
-                        continue;
-
-                    // up to now the meshes are equal. find an appropriate
-                    // epsilon to compare position differences against
-                    float epsilon = ComputePositionEpsilon(inst);
-                    epsilon *= epsilon;
-
-                    // now compare vertex positions, normals,
-                    // tangents and bitangents using this epsilon.
-                    if (orig->HasPositions()) {
-                        if(!CompareArrays(orig->mVertices,inst->mVertices,orig->mNumVertices,epsilon))
-                            continue;
-                    }
-                    if (orig->HasNormals()) {
-                        if(!CompareArrays(orig->mNormals,inst->mNormals,orig->mNumVertices,epsilon))
-                            continue;
-                    }
-                    if (orig->HasTangentsAndBitangents()) {
-                        if (!CompareArrays(orig->mTangents,inst->mTangents,orig->mNumVertices,epsilon) ||
-                            !CompareArrays(orig->mBitangents,inst->mBitangents,orig->mNumVertices,epsilon))
-                            continue;
-                    }
+        // ... which are independent from each other. The largest ones go first,
+        // they take longest.
+        std::sort(buckets.begin(), buckets.end(), [](const std::vector<unsigned int>& a, const std::vector<unsigned int>& b) {
+            return a.size() > b.size();
+        });
+
+        // For each mesh find the last previous mesh it is an instance of.
+        std::unique_ptr<unsigned int[]> instanceOf (new unsigned int[numMeshes]);
+        const bool speedFlag = configSpeedFlag;
+        const auto findInBucket = [pScene,&buckets,&epsilons,&instanceOf,speedFlag](size_t b) {
+            const std::vector<unsigned int>& bucket = buckets[b];
+            if (bucket.size() == 1) {
+                instanceOf[bucket[0]] = bucket[0];
+                return;
+            }
 
-                    // use a constant epsilon for colors and UV coordinates
-                    static const float uvEpsilon = 10e-4f;
-                    {
-                        unsigned int i, end = orig->GetNumUVChannels();
-                        for(i = 0; i < end; ++i) {
-                            if (!orig->mTextureCoords[i]) {
-                                continue;
-                            }
-                            if(!CompareArrays(orig->mTextureCoords[i],inst->mTextureCoords[i],orig->mNumVertices,uvEpsilon)) {
-                                break;
-                            }
-                        }
-                        if (i != end) {
-                            continue;
-                        }
-                    }
-                    {
-                        unsigned int i, end = orig->GetNumColorChannels();
-                        for(i = 0; i < end; ++i) {
-                            if (!orig->mColors[i]) {
-                                continue;
-                            }
-                            if(!CompareArrays(orig->mColors[i],inst->mColors[i],orig->mNumVertices,uvEpsilon)) {
-                                break;
-                            }
-                        }
-                        if (i != end) {
-                            continue;
-                        }
+            // Instances must have their vertices within epsilon of the original,
+            // so does the first vertex. Thus, the unique meshes found so far are
+            // kept sorted by the x coordinate of their first vertex and only
+            // the ones in range are compared. Meshes without a usable first
+            // vertex are compared to all others as before.
+            std::multimap<ai_real, unsigned int> sorted;
+            std::vector<unsigned int> unsorted;
+            std::vector<unsigned int> candidates;
+            for (unsigned int i : bucket) {
+                const aiMesh* inst = pScene->mMeshes[i];
+                const ai_real epsilon = epsilons[i];
+
+                // a NaN anywhere in the first vertex makes CompareArrays() accept any
+                // difference in x, these meshes can't be sorted.
+                const bool hasKey = inst->HasPositions() && inst->mNumVertices &&
+                    std::isfinite(inst->mVertices[0].x) &&
+                    std::isfinite(inst->mVertices[0].y) &&
+                    std::isfinite(inst->mVertices[0].z);
+
+                candidates = unsorted;
+                std::multimap<ai_real, unsigned int>::const_iterator first = sorted.begin(), last = sorted.end();
+                if (hasKey) {
+                    // widen the range a bit to be safe against rounding
+                    const ai_real x = inst->mVertices[0].x;
+                    const ai_real range = epsilon + (std::fabs(x) + epsilon) * ai_real( 1e-5 );
+                    if (std::isfinite(range)) {
+                        first = sorted.lower_bound(x - range);
+                        last = sorted.upper_bound(x + range);
                     }
+                }
+                for (; first != last; ++first) {
+                    candidates.push_back((*first).second);
+                }
 
-                    // These two checks are actually quite expensive and almost *never* required.
-                    // Almost. That's why they're still here. But there's no reason to do them
-                    // in speed-targeted imports.
-                    if (!configSpeedFlag) {
-
-                        // It seems to be strange, but we really need to check whether the
-                        // bones are identical too. Although it's extremely unprobable
-                        // that they're not if control reaches here, we need to deal
-                        // with unprobable cases, too. It could still be that there are
-                        // equal shapes which are deformed differently.
-                        if (!CompareBones(orig,inst))
-                            continue;
-
-                        // For completeness ... compare even the index buffers for equality
-                        // face order & winding order doesn't care. Input data is in verbose format.
-                        std::unique_ptr<unsigned int[]> ftbl_orig(new unsigned int[orig->mNumVertices]);
-                        std::unique_ptr<unsigned int[]> ftbl_inst(new unsigned int[orig->mNumVertices]);
-
-                        for (unsigned int tt = 0; tt < orig->mNumFaces;++tt) {
-                            aiFace& f = orig->mFaces[tt];
-                            for (unsigned int nn = 0; nn < f.mNumIndices;++nn)
-                                ftbl_orig[f.mIndices[nn]] = tt;
-
-                            aiFace& f2 = inst->mFaces[tt];
-                            for (unsigned int nn = 0; nn < f2.mNumIndices;++nn)
-                                ftbl_inst[f2.mIndices[nn]] = tt;
-                        }
-                        if (0 != ::memcmp(ftbl_inst.get(),ftbl_orig.get(),orig->mNumVertices*sizeof(unsigned int)))
-                            continue;
-                    }
+                // the original implementation picked the closest previous mesh
+                std::sort(candidates.begin(), candidates.end(), std::greater<unsigned int>());
 
-                    // We're still here. Or in other words: 'inst' is an instance of 'orig'.
-                    // Place a marker in our list that we can easily update mesh indices.
-                    remapping[i] = remapping[a];
+                instanceOf[i] = i;
+                for (unsigned int a : candidates) {
+                    if (IsInstance(pScene->mMeshes[a], inst, epsilon, speedFlag)) {
+                        instanceOf[i] = a;
+                        break;
+                    }
+                }
 
-                    // Delete the instanced mesh, we don't need it anymore
-                    delete inst;
-                    pScene->mMeshes[i] = NULL;
-                    break;
+                // If we didn't find a match for the current mesh: keep it
+                if (instanceOf[i] == i) {
+                    if (hasKey) {
+                        sorted.insert(std::make_pair(inst->mVertices[0].x, i));
+                    }
+                    else {
+                        unsorted.push_back(i);
+                    }
                 }
             }
+        };
+
+        if (threadPool && buckets.size() > 1) {
+            threadPool->ParallelFor(buckets.size(), findInBucket);
+        }
+        else {
+            for (size_t b = 0; b < buckets.size(); ++b) {
+                findInBucket(b);
+            }
+        }
+        buckets.clear();
 
-            // If we didn't find a match for the current mesh: keep it
-            if (pScene->mMeshes[i]) {
+        std::unique_ptr<unsigned int[]> remapping (new unsigned int[numMeshes]);
+        unsigned int numMeshesOut = 0;
+        for (unsigned int i = 0; i < numMeshes; ++i) {
+            if (instanceOf[i] == i) {
                 remapping[i] = numMeshesOut++;
+                continue;
             }
+
+            // 'inst' is an instance of 'orig'. Place a marker in our list that
+            // we can easily update mesh indices.
+            remapping[i] = remapping[instanceOf[i]];
+
+            // Delete the instanced mesh, we don't need it anymore
+            delete pScene->mMeshes[i];
+            pScene->mMeshes[i] = NULL;
         }
         ai_assert(0 != numMeshesOut);
         if (numMeshesOut != pScene->mNumMeshes) {
@@ -106,7 +106,7 @@ inline bool CompareArrays(const aiColor4D* first, const aiColor4D* second,
 // ---------------------------------------------------------------------------
 /** @brief A post-processing steps to search for instanced meshes
 */
-class FindInstancesProcess : public BaseProcess
+class ASSIMP_API FindInstancesProcess : public BaseProcess
 {
 public:
 
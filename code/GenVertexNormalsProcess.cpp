@@ -57,7 +57,8 @@ using namespace Assimp;
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 GenVertexNormalsProcess::GenVertexNormalsProcess()
-: configMaxAngle( AI_DEG_TO_RAD( 175.f ) ) {
+: configMaxAngle( AI_DEG_TO_RAD( 175.f ) )
+, configUseGrid( false ) {
     // empty
 }
 
@@ -81,6 +82,7 @@ void GenVertexNormalsProcess::SetupProperties(const Importer* pImp)
     // Get the current value of the AI_CONFIG_PP_GSN_MAX_SMOOTHING_ANGLE property
     configMaxAngle = pImp->GetPropertyFloat(AI_CONFIG_PP_GSN_MAX_SMOOTHING_ANGLE,(ai_real)175.0);
     configMaxAngle = AI_DEG_TO_RAD(std::max(std::min(configMaxAngle,(ai_real)175.0),(ai_real)0.0));
+    configUseGrid = pImp->GetPropertyBool(AI_CONFIG_PP_USE_SPATIAL_HASH_GRID,false);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -92,10 +94,15 @@ void GenVertexNormalsProcess::Execute( aiScene* pScene)
     if (pScene->mFlags & AI_SCENE_FLAGS_NON_VERBOSE_FORMAT)
         throw DeadlyImportError("Post-processing order mismatch: expecting pseudo-indexed (\"verbose\") vertices here");
 
+    std::vector<char> generated( pScene->mNumMeshes, 0);
+    ExecutePerMesh( pScene, [&]( unsigned int a) {
+        generated[a] = GenMeshVertexNormals( pScene->mMeshes[a],a);
+    });
+
     bool bHas = false;
     for( unsigned int a = 0; a < pScene->mNumMeshes; a++)
     {
-        if(GenMeshVertexNormals( pScene->mMeshes[a],a))
+        if(generated[a])
             bHas = true;
     }
 
@@ -151,26 +158,10 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals (aiMesh* pMesh, unsigned int
         }
     }
 
-    // Set up a SpatialSort to quickly find all vertices close to a given position
-    // check whether we can reuse the SpatialSort of a previous step.
-    SpatialSort* vertexFinder = NULL;
-    SpatialSort  _vertexFinder;
-    ai_real posEpsilon = ai_real( 1e-5 );
-    if (shared) {
-        std::vector<std::pair<SpatialSort,ai_real> >* avf;
-        shared->GetProperty(AI_SPP_SPATIAL_SORT,avf);
-        if (avf)
-        {
-            std::pair<SpatialSort,ai_real>& blubb = avf->operator [] (meshIndex);
-            vertexFinder = &blubb.first;
-            posEpsilon = blubb.second;
-        }
-    }
-    if (!vertexFinder)  {
-        _vertexFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof( aiVector3D));
-        vertexFinder = &_vertexFinder;
-        posEpsilon = ComputePositionEpsilon(pMesh);
-    }
+    // Set up a SpatialSort (or hash grid) to quickly find all vertices close to a given position
+    // check whether we can reuse the one of a previous step.
+    const SpatialLookup vertexFinder(pMesh, meshIndex, shared, configUseGrid);
+    const ai_real posEpsilon = vertexFinder.GetPositionEpsilon();
     std::vector<unsigned int> verticesFound;
     aiVector3D* pcNew = new aiVector3D[pMesh->mNumVertices];
 
@@ -185,7 +176,7 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals (aiMesh* pMesh, unsigned int
             }
 
             // Get all vertices that share this one ...
-            vertexFinder->FindPositions( pMesh->mVertices[i], posEpsilon, verticesFound);
+            vertexFinder.FindPositions( pMesh->mVertices[i], posEpsilon, verticesFound);
 
             aiVector3D pcNor;
             for (unsigned int a = 0; a < verticesFound.size(); ++a) {
@@ -209,7 +200,7 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals (aiMesh* pMesh, unsigned int
         const ai_real fLimit = std::cos(configMaxAngle);
         for (unsigned int i = 0; i < pMesh->mNumVertices;++i)   {
             // Get all vertices that share this one ...
-            vertexFinder->FindPositions( pMesh->mVertices[i] , posEpsilon, verticesFound);
+            vertexFinder.FindPositions( pMesh->mVertices[i] , posEpsilon, verticesFound);
 
             aiVector3D vr = pMesh->mNormals[i];
             ai_real vrlen = vr.Length();
@@ -106,6 +106,9 @@ private:
 
     /** Configuration option: maximum smoothing angle, in radians*/
     ai_real configMaxAngle;
+
+    /** Configuration option: use a SpatialHashGrid instead of a SpatialSort */
+    bool configUseGrid;
 };
 
 } // end of namespace Assimp
@@ -0,0 +1,632 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file Implementation of the GenerateLODsProcess post processing step */
+
+#include "GenerateLODsProcess.h"
+#include "ProcessHelper.h"
+#include "Profiler.h"
+#include "VertexTriangleAdjacency.h"
+#include "ParsingUtils.h"
+#include "fast_atof.h"
+#include <assimp/postprocess.h>
+#include <assimp/DefaultLogger.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <unordered_map>
+
+using namespace Assimp;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Symmetric 4x4 error quadric, stored as its upper triangle
+struct Quadric
+{
+    double a[10];
+
+    Quadric() {
+        std::fill(a,a+10,0.0);
+    }
+
+    // Adds the squared distance to the plane ax+by+cz+d=0, scaled by w
+    void AddPlane(double pa, double pb, double pc, double pd, double w) {
+        a[0] += w*pa*pa; a[1] += w*pa*pb; a[2] += w*pa*pc; a[3] += w*pa*pd;
+        a[4] += w*pb*pb; a[5] += w*pb*pc; a[6] += w*pb*pd;
+        a[7] += w*pc*pc; a[8] += w*pc*pd;
+        a[9] += w*pd*pd;
+    }
+
+    Quadric& operator += (const Quadric& o) {
+        for (unsigned int i = 0; i < 10; ++i) {
+            a[i] += o.a[i];
+        }
+        return *this;
+    }
+
+    double Evaluate(const aiVector3D& p) const {
+        const double x = p.x, y = p.y, z = p.z;
+        return a[0]*x*x + 2*a[1]*x*y + 2*a[2]*x*z + 2*a[3]*x
+            + a[4]*y*y + 2*a[5]*y*z + 2*a[6]*y
+            + a[7]*z*z + 2*a[8]*z
+            + a[9];
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+// Candidate half-edge collapse of vertex 'from' onto vertex 'to'
+struct Collapse
+{
+    double cost;
+    unsigned int from, to;
+
+    // value of the stamp of 'from' at the time the candidate was computed
+    unsigned int stamp;
+
+    // ordering for a min-heap, ties are broken by index to be deterministic
+    bool operator > (const Collapse& o) const {
+        if (cost != o.cost) {
+            return cost > o.cost;
+        }
+        return from != o.from ? from > o.from : to > o.to;
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+// Copies the elements at the given indices to a new array, NULL if there is no source array
+template <typename T>
+T* CopySubset(const T* src, const std::vector<unsigned int>& kept)
+{
+    if (!src) {
+        return NULL;
+    }
+    T* out = new T[kept.size()];
+    for (size_t i = 0; i < kept.size(); ++i) {
+        out[i] = src[kept[i]];
+    }
+    return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Builds a mesh from the live faces of a simplified index buffer
+aiMesh* BuildMesh(const aiMesh* pMesh, const std::vector<unsigned int>& indices,
+    const std::vector<bool>& dead, unsigned int numLiveFaces, unsigned int level)
+{
+    const unsigned int missing = 0xffffffff;
+    std::vector<unsigned int> remap(pMesh->mNumVertices,missing);
+    std::vector<unsigned int> kept;
+
+    aiMesh* out = new aiMesh();
+    out->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    out->mMaterialIndex = pMesh->mMaterialIndex;
+    out->mNumFaces = numLiveFaces;
+    out->mFaces = new aiFace[numLiveFaces];
+
+    aiFace* face = out->mFaces;
+    for (size_t t = 0; t < dead.size(); ++t) {
+        if (dead[t]) {
+            continue;
+        }
+        face->mIndices = new unsigned int[face->mNumIndices = 3];
+        for (unsigned int i = 0; i < 3; ++i) {
+            unsigned int& idx = remap[indices[t*3+i]];
+            if (idx == missing) {
+                idx = (unsigned int)kept.size();
+                kept.push_back(indices[t*3+i]);
+            }
+            face->mIndices[i] = idx;
+        }
+        ++face;
+    }
+
+    char szBuff[32];
+    ai_snprintf(szBuff,32,"_LOD%u",level);
+    out->mName.Set(std::string(pMesh->mName.C_Str()) + szBuff);
+
+    out->mNumVertices = (unsigned int)kept.size();
+    out->mVertices   = CopySubset(pMesh->mVertices,kept);
+    out->mNormals    = CopySubset(pMesh->mNormals,kept);
+    out->mTangents   = CopySubset(pMesh->mTangents,kept);
+    out->mBitangents = CopySubset(pMesh->mBitangents,kept);
+    for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+        out->mColors[c] = CopySubset(pMesh->mColors[c],kept);
+    }
+    for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c) {
+        out->mTextureCoords[c] = CopySubset(pMesh->mTextureCoords[c],kept);
+        out->mNumUVComponents[c] = pMesh->mNumUVComponents[c];
+    }
+
+    // keep the weights of the remaining vertices, bones without any weights are dropped
+    if (pMesh->HasBones()) {
+        std::vector<aiBone*> bones;
+        for (unsigned int b = 0; b < pMesh->mNumBones; ++b) {
+            const aiBone* src = pMesh->mBones[b];
+            std::vector<aiVertexWeight> weights;
+            for (unsigned int w = 0; w < src->mNumWeights; ++w) {
+                const unsigned int idx = remap[src->mWeights[w].mVertexId];
+                if (idx != missing) {
+                    weights.push_back(aiVertexWeight(idx,src->mWeights[w].mWeight));
+                }
+            }
+            if (weights.empty()) {
+                continue;
+            }
+            aiBone* bone = new aiBone();
+            bone->mName = src->mName;
+            bone->mOffsetMatrix = src->mOffsetMatrix;
+            bone->mNumWeights = (unsigned int)weights.size();
+            bone->mWeights = new aiVertexWeight[bone->mNumWeights];
+            std::copy(weights.begin(),weights.end(),bone->mWeights);
+            bones.push_back(bone);
+        }
+        if (!bones.empty()) {
+            out->mNumBones = (unsigned int)bones.size();
+            out->mBones = new aiBone*[out->mNumBones];
+            std::copy(bones.begin(),bones.end(),out->mBones);
+        }
+    }
+
+    if (pMesh->mNumAnimMeshes) {
+        out->mNumAnimMeshes = pMesh->mNumAnimMeshes;
+        out->mAnimMeshes = new aiAnimMesh*[out->mNumAnimMeshes];
+        for (unsigned int a = 0; a < pMesh->mNumAnimMeshes; ++a) {
+            const aiAnimMesh* src = pMesh->mAnimMeshes[a];
+            aiAnimMesh* anim = out->mAnimMeshes[a] = new aiAnimMesh();
+            anim->mWeight = src->mWeight;
+            anim->mNumVertices = out->mNumVertices;
+            anim->mVertices   = CopySubset(src->mVertices,kept);
+            anim->mNormals    = CopySubset(src->mNormals,kept);
+            anim->mTangents   = CopySubset(src->mTangents,kept);
+            anim->mBitangents = CopySubset(src->mBitangents,kept);
+            for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+                anim->mColors[c] = CopySubset(src->mColors[c],kept);
+            }
+            for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c) {
+                anim->mTextureCoords[c] = CopySubset(src->mTextureCoords[c],kept);
+            }
+        }
+    }
+    return out;
+}
+
+} // anonymous namespace
+
+// ------------------------------------------------------------------------------------------------
+// Constructor to be privately used by Importer
+GenerateLODsProcess::GenerateLODsProcess()
+: configUseGrid( false )
+{
+    configRatios.push_back(0.5f);
+    configRatios.push_back(0.25f);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Destructor, private as well
+GenerateLODsProcess::~GenerateLODsProcess()
+{
+    // nothing to do here
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns whether the processing step is present in the given flag field.
+bool GenerateLODsProcess::IsActive( unsigned int pFlags) const
+{
+    return (pFlags & aiProcess_GenerateLODs) != 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Setup configuration properties for the step
+void GenerateLODsProcess::SetupProperties(const Importer* pImp)
+{
+    const std::string ratios = pImp->GetPropertyString(AI_CONFIG_PP_GL_LOD_RATIOS,"0.5 0.25");
+
+    configRatios.clear();
+    const char* sz = ratios.c_str();
+    while (SkipSpaces(&sz)) {
+        float f = 0.f;
+        try {
+            sz = fast_atoreal_move<float>(sz,f);
+        }
+        catch (const std::invalid_argument&) {
+            // not a number, skipped together with the rest of the token below
+        }
+        if (f > 0.f && f < 1.f) {
+            configRatios.push_back(f);
+        }
+        else {
+            DefaultLogger::get()->warn("GenerateLODsProcess: ignoring LOD ratio outside of ]0,1[");
+        }
+        while (*sz && !IsSpaceOrNewLine(*sz)) {
+            ++sz;
+        }
+    }
+    std::sort(configRatios.begin(),configRatios.end(),std::greater<float>());
+    configRatios.erase(std::unique(configRatios.begin(),configRatios.end()),configRatios.end());
+
+    configUseGrid = pImp->GetPropertyBool(AI_CONFIG_PP_USE_SPATIAL_HASH_GRID,false);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Executes the post processing step on the given imported data.
+void GenerateLODsProcess::Execute( aiScene* pScene)
+{
+    if (configRatios.empty() || !pScene->mNumMeshes) {
+        DefaultLogger::get()->debug("GenerateLODsProcess skipped; there are no meshes or LOD ratios");
+        return;
+    }
+
+    DefaultLogger::get()->debug("GenerateLODsProcess begin");
+
+    std::vector<std::vector<aiMesh*> > lods( pScene->mNumMeshes);
+    ExecutePerMesh( pScene, [&]( unsigned int a) {
+        ProcessMesh( pScene->mMeshes[a],a,lods[a]);
+    });
+
+    // append the new meshes in mesh order
+    std::vector<unsigned int> firstLOD( pScene->mNumMeshes, 0), numLODs( pScene->mNumMeshes, 0);
+    unsigned int numOut = pScene->mNumMeshes;
+    for (unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
+        firstLOD[a] = numOut;
+        numLODs[a] = (unsigned int)lods[a].size();
+        numOut += numLODs[a];
+    }
+    if (numOut == pScene->mNumMeshes) {
+        DefaultLogger::get()->debug("GenerateLODsProcess finished. There are no triangle meshes");
+        return;
+    }
+
+    aiMesh** meshes = new aiMesh*[numOut];
+    std::copy(pScene->mMeshes,pScene->mMeshes+pScene->mNumMeshes,meshes);
+    unsigned int numFaces = 0, numLODFaces = 0;
+    for (unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
+        for (unsigned int i = 0; i < numLODs[a]; ++i) {
+            meshes[firstLOD[a]+i] = lods[a][i];
+            numLODFaces += lods[a][i]->mNumFaces;
+        }
+        if (numLODs[a]) {
+            numFaces += pScene->mMeshes[a]->mNumFaces;
+            if (profiler) {
+                profiler->AddMeshCounter( a, "lod_faces_out", lods[a].back()->mNumFaces);
+            }
+        }
+    }
+    const unsigned int numIn = pScene->mNumMeshes;
+    delete[] pScene->mMeshes;
+    pScene->mMeshes = meshes;
+    pScene->mNumMeshes = numOut;
+
+    if (pScene->mRootNode) {
+        AddLODNodes( pScene->mRootNode, firstLOD, numLODs);
+    }
+
+    if (profiler) {
+        profiler->AddCounter( "lod_meshes_out", numOut - numIn);
+    }
+    if (!DefaultLogger::isNullLogger()) {
+        char szBuff[128]; // should be sufficiently large in every case
+        ai_snprintf(szBuff,128,"GenerateLODsProcess finished. Generated %u meshes with %u faces from %u faces",
+            numOut - numIn,numLODFaces,numFaces);
+        DefaultLogger::get()->info(szBuff);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Adds one child node per level to all nodes referencing simplified meshes
+void GenerateLODsProcess::AddLODNodes( aiNode* pNode, const std::vector<unsigned int>& firstLOD,
+    const std::vector<unsigned int>& numLODs)
+{
+    for (unsigned int i = 0; i < pNode->mNumChildren; ++i) {
+        AddLODNodes( pNode->mChildren[i], firstLOD, numLODs);
+    }
+
+    std::vector<aiNode*> levels;
+    for (unsigned int i = 0; i < pNode->mNumMeshes; ++i) {
+        const unsigned int m = pNode->mMeshes[i];
+        for (unsigned int l = 0; l < numLODs[m]; ++l) {
+            if (l == levels.size()) {
+                char szBuff[32];
+                ai_snprintf(szBuff,32,"_LOD%u",l+1);
+                aiNode* child = new aiNode(std::string(pNode->mName.C_Str()) + szBuff);
+                child->mParent = pNode;
+                child->mMetaData = aiMetadata::Alloc(1);
+                child->mMetaData->Set(0,"LOD",(int32_t)(l+1));
+                levels.push_back(child);
+            }
+        }
+    }
+    if (levels.empty()) {
+        return;
+    }
+
+    for (aiNode* child : levels) {
+        child->mMeshes = new unsigned int[pNode->mNumMeshes];
+    }
+    for (unsigned int i = 0; i < pNode->mNumMeshes; ++i) {
+        const unsigned int m = pNode->mMeshes[i];
+        for (unsigned int l = 0; l < numLODs[m]; ++l) {
+            aiNode* child = levels[l];
+            child->mMeshes[child->mNumMeshes++] = firstLOD[m] + l;
+        }
+    }
+
+    aiNode** children = new aiNode*[pNode->mNumChildren + levels.size()];
+    std::copy(pNode->mChildren,pNode->mChildren+pNode->mNumChildren,children);
+    std::copy(levels.begin(),levels.end(),children+pNode->mNumChildren);
+    delete[] pNode->mChildren;
+    pNode->mChildren = children;
+    pNode->mNumChildren += (unsigned int)levels.size();
+}
+
+// ------------------------------------------------------------------------------------------------
+// Generates the simplified copies of a single mesh
+void GenerateLODsProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex,
+    std::vector<aiMesh*>& out)
+{
+    if (!pMesh->mNumFaces || !pMesh->HasPositions() || configRatios.empty()) {
+        return;
+    }
+    for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
+        if (pMesh->mFaces[i].mNumIndices != 3) {
+            return;
+        }
+    }
+
+    const unsigned int numFaces = pMesh->mNumFaces, numVerts = pMesh->mNumVertices;
+    const aiVector3D* pos = pMesh->mVertices;
+
+    std::vector<unsigned int> indices( numFaces*3);
+    for (unsigned int i = 0; i < numFaces; ++i) {
+        std::copy(pMesh->mFaces[i].mIndices,pMesh->mFaces[i].mIndices+3,&indices[i*3]);
+    }
+
+    // Vertices which share their position with others are on UV or normal seams.
+    // Moving them would tear the surface apart, so they are never removed.
+    std::vector<bool> locked( numVerts, false);
+    {
+        const SpatialLookup finder( pMesh, meshIndex, shared, configUseGrid);
+        std::vector<unsigned int> found;
+        for (unsigned int v = 0; v < numVerts; ++v) {
+            if (locked[v]) {
+                continue;
+            }
+            finder.FindIdenticalPositions( pos[v], found);
+            if (found.size() > 1) {
+                for (unsigned int f : found) {
+                    locked[f] = true;
+                }
+            }
+        }
+    }
+
+    // The same goes for vertices on open borders and non-manifold edges
+    {
+        std::unordered_map<uint64_t,unsigned int> edges;
+        for (unsigned int i = 0; i < numFaces*3; ++i) {
+            const unsigned int a = indices[i], b = indices[i - i%3 + (i+1)%3];
+            ++edges[((uint64_t)std::min(a,b) << 32) | std::max(a,b)];
+        }
+        for (const std::pair<const uint64_t,unsigned int>& e : edges) {
+            if (e.second != 2) {
+                locked[(unsigned int)(e.first >> 32)] = true;
+                locked[(unsigned int)(e.first & 0xffffffff)] = true;
+            }
+        }
+    }
+
+    // Collapses are only allowed between vertices dominated by the same bone
+    const unsigned int noBone = 0xffffffff;
+    std::vector<unsigned int> dominantBone( numVerts, noBone);
+    if (pMesh->HasBones()) {
+        std::vector<float> maxWeight( numVerts, 0.f);
+        for (unsigned int b = 0; b < pMesh->mNumBones; ++b) {
+            const aiBone* bone = pMesh->mBones[b];
+            for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
+                const aiVertexWeight& vw = bone->mWeights[w];
+                if (vw.mVertexId < numVerts && vw.mWeight > maxWeight[vw.mVertexId]) {
+                    maxWeight[vw.mVertexId] = vw.mWeight;
+                    dominantBone[vw.mVertexId] = b;
+                }
+            }
+        }
+    }
+
+    // Area weighted sum of the plane quadrics of all faces around a vertex
+    std::vector<Quadric> quadrics( numVerts);
+    for (unsigned int t = 0; t < numFaces; ++t) {
+        const unsigned int* tri = &indices[t*3];
+        aiVector3D n = (pos[tri[1]] - pos[tri[0]]) ^ (pos[tri[2]] - pos[tri[0]]);
+        const double len = n.Length();
+        if (len <= 0.0) {
+            continue;
+        }
+        n /= (ai_real)len;
+        const double d = -(n * pos[tri[0]]);
+        for (unsigned int i = 0; i < 3; ++i) {
+            quadrics[tri[i]].AddPlane(n.x,n.y,n.z,d,len*0.5);
+        }
+    }
+
+    // Per-vertex lists of the adjacent faces, updated on every collapse
+    std::vector<std::vector<unsigned int> > vertexFaces( numVerts);
+    {
+        VertexTriangleAdjacency adj( pMesh->mFaces, numFaces, numVerts, true);
+        for (unsigned int v = 0; v < numVerts; ++v) {
+            const unsigned int* begin = adj.GetAdjacentTriangles(v);
+            vertexFaces[v].assign(begin,begin+adj.mLiveTriangles[v]);
+        }
+    }
+
+    std::vector<bool> dead( numFaces, false), removed( numVerts, false);
+    std::vector<unsigned int> stamps( numVerts, 0);
+    unsigned int numLiveFaces = numFaces;
+
+    auto gatherNeighbours = [&]( unsigned int v, std::vector<unsigned int>& result) {
+        result.clear();
+        for (unsigned int t : vertexFaces[v]) {
+            for (unsigned int i = 0; i < 3; ++i) {
+                if (indices[t*3+i] != v) {
+                    result.push_back(indices[t*3+i]);
+                }
+            }
+        }
+        std::sort(result.begin(),result.end());
+        result.erase(std::unique(result.begin(),result.end()),result.end());
+    };
+
+    std::priority_queue<Collapse,std::vector<Collapse>,std::greater<Collapse> > heap;
+    std::vector<unsigned int> neighbours, others;
+    auto pushCandidates = [&]( unsigned int v) {
+        if (locked[v] || removed[v]) {
+            return;
+        }
+        gatherNeighbours(v,neighbours);
+        for (unsigned int n : neighbours) {
+            if (dominantBone[n] == dominantBone[v]) {
+                const Collapse c = { quadrics[v].Evaluate(pos[n]), v, n, stamps[v] };
+                heap.push(c);
+            }
+        }
+    };
+
+    // A collapse must keep the surface manifold and must not flip any of the remaining faces
+    auto isValid = [&]( unsigned int from, unsigned int to) {
+        gatherNeighbours(from,neighbours);
+        gatherNeighbours(to,others);
+        unsigned int edgeFaces = 0, common = 0;
+        for (unsigned int t : vertexFaces[from]) {
+            const unsigned int* tri = &indices[t*3];
+            if (tri[0] == to || tri[1] == to || tri[2] == to) {
+                ++edgeFaces;
+                continue;
+            }
+            aiVector3D p[3] = { pos[tri[0]], pos[tri[1]], pos[tri[2]] };
+            const aiVector3D before = (p[1] - p[0]) ^ (p[2] - p[0]);
+            for (unsigned int i = 0; i < 3; ++i) {
+                if (tri[i] == from) {
+                    p[i] = pos[to];
+                }
+            }
+            const aiVector3D after = (p[1] - p[0]) ^ (p[2] - p[0]);
+            if (after * before <= 0.0) {
+                return false;
+            }
+        }
+        std::vector<unsigned int>::const_iterator it = others.begin();
+        for (unsigned int n : neighbours) {
+            it = std::lower_bound(it,others.cend(),n);
+            if (it != others.end() && *it == n) {
+                ++common;
+            }
+        }
+        return common == edgeFaces;
+    };
+
+    for (unsigned int v = 0; v < numVerts; ++v) {
+        pushCandidates(v);
+    }
+
+    out.reserve(configRatios.size());
+    unsigned int prevFaces = numFaces;
+    for (unsigned int l = 0; l < configRatios.size(); ++l) {
+        const unsigned int target = std::max(1u,(unsigned int)(configRatios[l] * numFaces));
+        while (numLiveFaces > target && !heap.empty()) {
+            const Collapse c = heap.top();
+            heap.pop();
+            if (removed[c.from] || removed[c.to] || stamps[c.from] != c.stamp ||
+                !isValid(c.from,c.to)) {
+                continue;
+            }
+
+            // move all faces of 'from' to 'to', the ones sharing the edge vanish
+            std::vector<unsigned int>& toFaces = vertexFaces[c.to];
+            for (unsigned int t : vertexFaces[c.from]) {
+                unsigned int* tri = &indices[t*3];
+                if (tri[0] == c.to || tri[1] == c.to || tri[2] == c.to) {
+                    dead[t] = true;
+                    --numLiveFaces;
+                    continue;
+                }
+                for (unsigned int i = 0; i < 3; ++i) {
+                    if (tri[i] == c.from) {
+                        tri[i] = c.to;
+                    }
+                }
+                toFaces.push_back(t);
+            }
+            gatherNeighbours(c.from,neighbours);
+            removed[c.from] = true;
+            vertexFaces[c.from].clear();
+
+            // drop the vanished faces from the adjacency lists of the remaining vertices
+            for (unsigned int n : neighbours) {
+                std::vector<unsigned int>& faces = vertexFaces[n];
+                faces.erase(std::remove_if(faces.begin(),faces.end(),
+                    [&]( unsigned int t) { return dead[t]; }),faces.end());
+            }
+            quadrics[c.to] += quadrics[c.from];
+
+            // all vertices around the collapsed edge got new candidates
+            const std::vector<unsigned int> changed = neighbours;
+            for (unsigned int n : changed) {
+                ++stamps[n];
+                pushCandidates(n);
+            }
+        }
+
+        if (numLiveFaces > target) {
+            DefaultLogger::get()->debug("GenerateLODsProcess: target face count not reached, "
+                "the remaining vertices are locked");
+        }
+
+        // a level which is not any smaller than the previous one is of no use,
+        // neither are the following ones then
+        if (numLiveFaces >= prevFaces) {
+            break;
+        }
+        prevFaces = numLiveFaces;
+        out.push_back(BuildMesh( pMesh, indices, dead, numLiveFaces, l+1));
+    }
+}
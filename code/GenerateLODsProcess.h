@@ -0,0 +1,136 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file Defines a post processing step to generate levels of detail for meshes */
+#ifndef AI_GENERATELODSPROCESS_H_INC
+#define AI_GENERATELODSPROCESS_H_INC
+
+#include "BaseProcess.h"
+
+#include <vector>
+
+struct aiMesh;
+struct aiNode;
+
+namespace Assimp
+{
+
+// ---------------------------------------------------------------------------
+/** The GenerateLODsProcess simplifies triangle meshes by quadric error metric
+ * edge collapses (Garland and Heckbert) and appends one simplified copy of
+ * each mesh per configured ratio to the scene.
+ *
+ * Collapses are half-edge collapses, i.e. a vertex is moved onto one of its
+ * neighbours. All vertex attributes of the surviving vertex thus stay valid.
+ * Vertices on UV or normal seams (i.e. vertices which share their position
+ * with another vertex), on open borders and collapses between vertices with
+ * differing dominant bones are rejected. Meshes need to be indexed by
+ * aiProcess_JoinIdenticalVertices, otherwise all vertices are locked.
+ *
+ * Each node that references a simplified mesh receives one child node per
+ * level, named "<node>_LOD<n>", which references the simplified copy and
+ * carries an integer "LOD" metadata entry holding the level.
+*/
+class ASSIMP_API GenerateLODsProcess : public BaseProcess
+{
+public:
+
+    GenerateLODsProcess();
+    ~GenerateLODsProcess();
+
+public:
+    // -------------------------------------------------------------------
+    /** Returns whether the processing step is present in the given flag.
+    * @param pFlags The processing flags the importer was called with.
+    *   A bitwise combination of #aiPostProcessSteps.
+    * @return true if the process is present in this flag fields,
+    *   false if not.
+    */
+    bool IsActive( unsigned int pFlags) const;
+
+    // -------------------------------------------------------------------
+    /** Called prior to ExecuteOnScene().
+    * The function is a request to the process to update its configuration
+    * basing on the Importer's configuration property list.
+    */
+    void SetupProperties(const Importer* pImp);
+
+    // -------------------------------------------------------------------
+    /** Executes the post processing step on the given imported data.
+    * At the moment a process is not supposed to fail.
+    * @param pScene The imported data to work at.
+    */
+    void Execute( aiScene* pScene);
+
+public:
+    // -------------------------------------------------------------------
+    /** Generates the simplified copies of a single mesh.
+    * @param pMesh The mesh to simplify. It is not modified.
+    * @param meshIndex Index of the mesh in the scene
+    * @param out Receives one mesh per configured ratio, ordered from the
+    *   finest to the coarsest level. Levels which would not have fewer
+    *   faces than the previous level are left out, so this stays empty if
+    *   the mesh can't be simplified (i.e. it does not consist of triangles
+    *   only or all of its vertices are locked).
+    */
+    void ProcessMesh( aiMesh* pMesh, unsigned int meshIndex,
+        std::vector<aiMesh*>& out);
+
+    // -------------------------------------------------------------------
+    /** Get the target ratios of the levels, in descending order */
+    const std::vector<float>& GetRatios() const {
+        return configRatios;
+    }
+
+private:
+    void AddLODNodes( aiNode* pNode, const std::vector<unsigned int>& firstLOD,
+        const std::vector<unsigned int>& numLODs);
+
+    /** Target face count ratios of the levels, descending */
+    std::vector<float> configRatios;
+
+    /** Use SpatialHashGrid instead of SpatialSort to find seams */
+    bool configUseGrid;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_GENERATELODSPROCESS_H_INC
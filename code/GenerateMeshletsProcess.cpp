@@ -0,0 +1,340 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file Implementation of the GenerateMeshletsProcess post processing step */
+
+#include "GenerateMeshletsProcess.h"
+#include "Profiler.h"
+#include "StringUtils.h"
+#include "VertexTriangleAdjacency.h"
+#include <assimp/postprocess.h>
+#include <assimp/DefaultLogger.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace Assimp;
+
+namespace {
+
+const unsigned int Missing = 0xffffffff;
+
+// ------------------------------------------------------------------------------------------------
+// Computes the bounding sphere of a meshlet (Ritter) and the cone bounding its face normals
+void ComputeBounds(const aiMesh* pMesh, aiMeshlet& meshlet,
+    const unsigned int* verts, const unsigned char* indices)
+{
+    const aiVector3D* pos = pMesh->mVertices;
+
+    // start with the sphere through two distant points, grow it to include all others
+    const aiVector3D& p0 = pos[verts[0]];
+    unsigned int a = 0, b = 0;
+    for (unsigned int i = 1; i < meshlet.mNumVertices; ++i) {
+        if ((pos[verts[i]] - p0).SquareLength() > (pos[verts[a]] - p0).SquareLength()) {
+            a = i;
+        }
+    }
+    for (unsigned int i = 1; i < meshlet.mNumVertices; ++i) {
+        if ((pos[verts[i]] - pos[verts[a]]).SquareLength() > (pos[verts[b]] - pos[verts[a]]).SquareLength()) {
+            b = i;
+        }
+    }
+    aiVector3D center = (pos[verts[a]] + pos[verts[b]]) * (ai_real)0.5;
+    ai_real radius = (pos[verts[a]] - center).Length();
+    for (unsigned int i = 0; i < meshlet.mNumVertices; ++i) {
+        const aiVector3D d = pos[verts[i]] - center;
+        const ai_real dist = d.Length();
+        if (dist > radius) {
+            const ai_real grow = (dist - radius) * (ai_real)0.5;
+            center += d * (grow / dist);
+            radius += grow;
+        }
+    }
+    meshlet.mCenter = center;
+    meshlet.mRadius = radius;
+
+    // the cone axis is the average face normal, degenerate faces can't be seen
+    std::vector<aiVector3D> normals;
+    normals.reserve(meshlet.mNumTriangles);
+    aiVector3D axis;
+    for (unsigned int t = 0; t < meshlet.mNumTriangles; ++t) {
+        const unsigned char* tri = indices + t*3;
+        const aiVector3D& v0 = pos[verts[tri[0]]];
+        aiVector3D n = (pos[verts[tri[1]]] - v0) ^ (pos[verts[tri[2]]] - v0);
+        const ai_real len = n.Length();
+        if (len > 0) {
+            n /= len;
+            normals.push_back(n);
+            axis += n;
+        }
+    }
+
+    meshlet.mConeApex = center;
+    meshlet.mConeCutoff = 1;
+    const ai_real axisLen = axis.Length();
+    if (normals.empty() || axisLen <= 0) {
+        meshlet.mConeAxis = aiVector3D(0, 0, 1);
+        return;
+    }
+    axis /= axisLen;
+    meshlet.mConeAxis = axis;
+
+    ai_real minDot = 1;
+    for (const aiVector3D& n : normals) {
+        minDot = std::min(minDot, n * axis);
+    }
+    // the normals span more than a hemisphere (or nearly so), culling would never succeed
+    if (minDot <= (ai_real)0.1) {
+        return;
+    }
+
+    // move the apex back along the axis until it lies behind all face planes
+    ai_real maxT = 0;
+    for (unsigned int t = 0, k = 0; t < meshlet.mNumTriangles; ++t) {
+        const unsigned char* tri = indices + t*3;
+        const aiVector3D& v0 = pos[verts[tri[0]]];
+        const aiVector3D n = (pos[verts[tri[1]]] - v0) ^ (pos[verts[tri[2]]] - v0);
+        if (n.Length() <= 0) {
+            continue;
+        }
+        const aiVector3D& nn = normals[k++];
+        maxT = std::max(maxT, ((center - v0) * nn) / (axis * nn));
+    }
+    meshlet.mConeApex = center - axis * maxT;
+    meshlet.mConeCutoff = std::sqrt(1 - minDot * minDot);
+}
+
+} // anonymous namespace
+
+// ------------------------------------------------------------------------------------------------
+// Constructor to be privately used by Importer
+GenerateMeshletsProcess::GenerateMeshletsProcess()
+: configMaxVertices( PP_GM_MAX_VERTICES )
+, configMaxTriangles( PP_GM_MAX_TRIANGLES )
+{
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+// Destructor, private as well
+GenerateMeshletsProcess::~GenerateMeshletsProcess()
+{
+    // nothing to do here
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns whether the processing step is present in the given flag field.
+bool GenerateMeshletsProcess::IsActive( unsigned int pFlags) const
+{
+    return (pFlags & aiProcess_GenerateMeshlets) != 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Setup configuration properties for the step
+void GenerateMeshletsProcess::SetupProperties(const Importer* pImp)
+{
+    const int maxVertices = pImp->GetPropertyInteger(AI_CONFIG_PP_GM_MAX_VERTICES,PP_GM_MAX_VERTICES);
+    const int maxTriangles = pImp->GetPropertyInteger(AI_CONFIG_PP_GM_MAX_TRIANGLES,PP_GM_MAX_TRIANGLES);
+
+    configMaxVertices = (unsigned int)std::min(std::max(maxVertices,3),256);
+    configMaxTriangles = (unsigned int)std::max(maxTriangles,1);
+    if (maxVertices != (int)configMaxVertices || maxTriangles != (int)configMaxTriangles) {
+        DefaultLogger::get()->warn("GenerateMeshletsProcess: meshlet limits out of range, clamped");
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Executes the post processing step on the given imported data.
+void GenerateMeshletsProcess::Execute( aiScene* pScene)
+{
+    if (!pScene->mNumMeshes) {
+        DefaultLogger::get()->debug("GenerateMeshletsProcess skipped; there are no meshes");
+        return;
+    }
+
+    DefaultLogger::get()->debug("GenerateMeshletsProcess begin");
+
+    std::vector<char> results( pScene->mNumMeshes, 0);
+    ExecutePerMesh( pScene, [&]( unsigned int a) {
+        results[a] = ProcessMesh( pScene->mMeshes[a]);
+    });
+
+    unsigned int numm = 0, numMeshlets = 0;
+    for (unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
+        if (results[a]) {
+            ++numm;
+            numMeshlets += pScene->mMeshes[a]->mNumMeshlets;
+            if (profiler) {
+                profiler->AddMeshCounter( a, "meshlets_out", pScene->mMeshes[a]->mNumMeshlets);
+            }
+        }
+    }
+    if (profiler) {
+        profiler->AddCounter( "meshlets_out", numMeshlets);
+    }
+    if (!DefaultLogger::isNullLogger()) {
+        char szBuff[128]; // should be sufficiently large in every case
+        ai_snprintf(szBuff,128,"GenerateMeshletsProcess finished. Partitioned %u meshes into %u meshlets",
+            numm,numMeshlets);
+        DefaultLogger::get()->info(szBuff);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Partitions a single mesh into meshlets
+bool GenerateMeshletsProcess::ProcessMesh( aiMesh* pMesh) const
+{
+    if (!pMesh->HasFaces() || !pMesh->HasPositions()) {
+        return false;
+    }
+    for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
+        if (pMesh->mFaces[i].mNumIndices != 3) {
+            return false;
+        }
+    }
+
+    const unsigned int numFaces = pMesh->mNumFaces;
+    VertexTriangleAdjacency adj( pMesh->mFaces, numFaces, pMesh->mNumVertices, true);
+
+    std::vector<aiMeshlet> meshlets;
+    std::vector<unsigned int> verts;
+    std::vector<unsigned char> indices;
+    verts.reserve(pMesh->mNumVertices);
+    indices.reserve(numFaces*3);
+
+    // local index of each mesh vertex in the current meshlet, Missing if not referenced
+    std::vector<unsigned int> local( pMesh->mNumVertices, Missing);
+
+    // faces adjacent to the current meshlet, 'listed' holds the meshlet they were added for
+    std::vector<unsigned int> candidates;
+    std::vector<unsigned int> listed( numFaces, Missing);
+    std::vector<bool> emitted( numFaces, false);
+
+    aiMeshlet cur;
+    auto countNewVertices = [&]( unsigned int t) {
+        const unsigned int* idx = pMesh->mFaces[t].mIndices;
+        return (local[idx[0]] == Missing) + (local[idx[1]] == Missing) + (local[idx[2]] == Missing);
+    };
+    auto flush = [&]() {
+        ComputeBounds( pMesh, cur, &verts[cur.mVertexOffset], &indices[cur.mIndexOffset]);
+        for (unsigned int i = 0; i < cur.mNumVertices; ++i) {
+            local[verts[cur.mVertexOffset+i]] = Missing;
+        }
+        meshlets.push_back(cur);
+        cur = aiMeshlet();
+        cur.mVertexOffset = (unsigned int)verts.size();
+        cur.mIndexOffset = (unsigned int)indices.size();
+        candidates.clear();
+    };
+
+    unsigned int nextSeed = 0;
+    for (unsigned int n = 0; n < numFaces; ++n) {
+        // prefer the adjacent face that adds the fewest vertices, ties go to the earlier face
+        unsigned int best = Missing, bestNew = 4;
+        for (size_t i = 0; i < candidates.size(); ) {
+            const unsigned int t = candidates[i];
+            if (emitted[t]) {
+                candidates[i] = candidates.back();
+                candidates.pop_back();
+                continue;
+            }
+            const unsigned int numNew = countNewVertices(t);
+            if (numNew < bestNew || (numNew == bestNew && t < best)) {
+                best = t;
+                bestNew = numNew;
+            }
+            ++i;
+        }
+        if (best == Missing) {
+            while (emitted[nextSeed]) {
+                ++nextSeed;
+            }
+            best = nextSeed;
+            bestNew = countNewVertices(best);
+        }
+
+        if (cur.mNumVertices + bestNew > configMaxVertices || cur.mNumTriangles == configMaxTriangles) {
+            flush();
+        }
+
+        emitted[best] = true;
+        const unsigned int* idx = pMesh->mFaces[best].mIndices;
+        for (unsigned int i = 0; i < 3; ++i) {
+            unsigned int& l = local[idx[i]];
+            if (l == Missing) {
+                l = cur.mNumVertices++;
+                verts.push_back(idx[i]);
+            }
+            indices.push_back((unsigned char)l);
+
+            const unsigned int* adjacent = adj.GetAdjacentTriangles(idx[i]);
+            for (unsigned int a = 0; a < adj.mLiveTriangles[idx[i]]; ++a) {
+                const unsigned int t = adjacent[a];
+                if (!emitted[t] && listed[t] != meshlets.size()) {
+                    listed[t] = (unsigned int)meshlets.size();
+                    candidates.push_back(t);
+                }
+            }
+        }
+        ++cur.mNumTriangles;
+    }
+    flush();
+
+    delete[] pMesh->mMeshlets;
+    delete[] pMesh->mMeshletVertices;
+    delete[] pMesh->mMeshletIndices;
+
+    pMesh->mNumMeshlets = (unsigned int)meshlets.size();
+    pMesh->mMeshlets = new aiMeshlet[pMesh->mNumMeshlets];
+    std::copy(meshlets.begin(),meshlets.end(),pMesh->mMeshlets);
+
+    pMesh->mNumMeshletVertices = (unsigned int)verts.size();
+    pMesh->mMeshletVertices = new unsigned int[pMesh->mNumMeshletVertices];
+    std::copy(verts.begin(),verts.end(),pMesh->mMeshletVertices);
+
+    pMesh->mNumMeshletIndices = (unsigned int)indices.size();
+    pMesh->mMeshletIndices = new unsigned char[pMesh->mNumMeshletIndices];
+    std::copy(indices.begin(),indices.end(),pMesh->mMeshletIndices);
+    return true;
+}
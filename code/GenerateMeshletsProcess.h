@@ -0,0 +1,113 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file Defines a post processing step to partition meshes into meshlets */
+#ifndef AI_GENERATEMESHLETSPROCESS_H_INC
+#define AI_GENERATEMESHLETSPROCESS_H_INC
+
+#include "BaseProcess.h"
+
+struct aiMesh;
+
+namespace Assimp
+{
+
+// ---------------------------------------------------------------------------
+/** The GenerateMeshletsProcess partitions the triangles of each mesh into
+ * meshlets of a bounded number of vertices and triangles.
+ *
+ * Meshlets are grown greedily: starting at the first unassigned face, the
+ * adjacent face adding the fewest new vertices is appended until one of the
+ * limits is reached. Faces are visited in their order in the mesh, so an
+ * earlier #aiProcess_ImproveCacheLocality pass yields more compact meshlets.
+ * Each meshlet gets a bounding sphere and a normal cone for culling.
+*/
+class ASSIMP_API GenerateMeshletsProcess : public BaseProcess
+{
+public:
+
+    GenerateMeshletsProcess();
+    ~GenerateMeshletsProcess();
+
+public:
+    // -------------------------------------------------------------------
+    /** Returns whether the processing step is present in the given flag.
+    * @param pFlags The processing flags the importer was called with.
+    *   A bitwise combination of #aiPostProcessSteps.
+    * @return true if the process is present in this flag fields,
+    *   false if not.
+    */
+    bool IsActive( unsigned int pFlags) const;
+
+    // -------------------------------------------------------------------
+    /** Called prior to ExecuteOnScene().
+    * The function is a request to the process to update its configuration
+    * basing on the Importer's configuration property list.
+    */
+    void SetupProperties(const Importer* pImp);
+
+    // -------------------------------------------------------------------
+    /** Executes the post processing step on the given imported data.
+    * At the moment a process is not supposed to fail.
+    * @param pScene The imported data to work at.
+    */
+    void Execute( aiScene* pScene);
+
+public:
+    // -------------------------------------------------------------------
+    /** Partitions a single mesh into meshlets, replacing any existing ones.
+    * @param pMesh The mesh to process.
+    * @return false if the mesh doesn't consist of triangles only and
+    *   has been left untouched.
+    */
+    bool ProcessMesh( aiMesh* pMesh) const;
+
+private:
+    /** Maximum number of vertices per meshlet, 3 to 256 */
+    unsigned int configMaxVertices;
+
+    /** Maximum number of triangles per meshlet */
+    unsigned int configMaxTriangles;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_GENERATEMESHLETSPROCESS_H_INC
@@ -43,6 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_HASH_H_INCLUDED
 
 #include <stdint.h>
+#include <stddef.h>
 #include <string.h>
 
 // ------------------------------------------------------------------------------------------------
@@ -114,4 +115,52 @@ int rem;
     return hash;
 }
 
+// ------------------------------------------------------------------------------------------------
+// MurmurHash64A by Austin Appleby, placed in the public domain.
+// https://github.com/aappleby/smhasher
+//
+// 64 bit hash for large inputs, i.e. file contents, where the 32 bit hash above would collide
+// too easily. The seed can be used to hash data incrementally.
+// ------------------------------------------------------------------------------------------------
+inline uint64_t MurmurHash64A (const void * key, size_t len, uint64_t seed = 0) {
+    const uint64_t m = 0xc6a4a7935bd1e995ULL;
+    const int r = 47;
+
+    uint64_t hash = seed ^ (len * m);
+
+    const uint8_t * data = (const uint8_t *)key;
+    const uint8_t * end = data + (len / 8) * 8;
+
+    /* Main loop */
+    for (; data != end; data += 8) {
+        uint64_t k;
+        ::memcpy(&k, data, 8);
+
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+
+        hash ^= k;
+        hash *= m;
+    }
+
+    /* Handle end cases */
+    switch (len & 7) {
+        case 7: hash ^= uint64_t(data[6]) << 48; /* fall through */
+        case 6: hash ^= uint64_t(data[5]) << 40; /* fall through */
+        case 5: hash ^= uint64_t(data[4]) << 32; /* fall through */
+        case 4: hash ^= uint64_t(data[3]) << 24; /* fall through */
+        case 3: hash ^= uint64_t(data[2]) << 16; /* fall through */
+        case 2: hash ^= uint64_t(data[1]) << 8;  /* fall through */
+        case 1: hash ^= uint64_t(data[0]);
+                hash *= m;
+    }
+
+    hash ^= hash >> r;
+    hash *= m;
+    hash ^= hash >> r;
+
+    return hash;
+}
+
 #endif // !! AI_HASH_H_INCLUDED
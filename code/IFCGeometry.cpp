@@ -46,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #ifndef ASSIMP_BUILD_NO_IFC_IMPORTER
 #include "IFCUtil.h"
+#include "STEPFileReader.h"
 #include "PolyTools.h"
 #include "ProcessHelper.h"
 
@@ -837,26 +838,53 @@ void AssignAddedMeshes(std::vector<unsigned int>& mesh_indices,aiNode* nd,
 }
 
 // ------------------------------------------------------------------------------------------------
-bool TryQueryMeshCache(const IfcRepresentationItem& item,
-    std::vector<unsigned int>& mesh_indices, unsigned int mat_index,
+bool TryQueryMeshCache(const ConversionData::MeshCacheIndex& idx,
+    std::vector<unsigned int>& mesh_indices,
     ConversionData& conv)
 {
-    ConversionData::MeshCacheIndex idx(&item, mat_index);
     ConversionData::MeshCache::const_iterator it = conv.cached_meshes.find(idx);
     if (it != conv.cached_meshes.end()) {
         std::copy((*it).second.begin(),(*it).second.end(),std::back_inserter(mesh_indices));
         return true;
     }
-    return false;
+    if (!conv.shared) {
+        return false;
+    }
+
+    // look the item up in the shared context, which knows the material by its style
+    const IFC::IfcSurfaceStyle* style = NULL;
+    for(const ConversionData::MaterialCache::value_type& v : conv.cached_materials) {
+        if (v.second == idx.matindex) {
+            style = v.first;
+            break;
+        }
+    }
+    unsigned int matindex;
+    if (!FindMaterial(style,*conv.materials[idx.matindex],*conv.shared,matindex)) {
+        return false;
+    }
+    it = conv.shared->cached_meshes.find(ConversionData::MeshCacheIndex(idx.contents,matindex));
+    if (it == conv.shared->cached_meshes.end()) {
+        return false;
+    }
+
+    std::vector<unsigned int>& indices = conv.cached_meshes[idx];
+    for(unsigned int index : (*it).second) {
+        indices.push_back(static_cast<unsigned int>(conv.meshes.size()));
+        conv.shared_meshes[indices.back()] = index;
+        conv.meshes.push_back(NULL);
+    }
+    std::copy(indices.begin(),indices.end(),std::back_inserter(mesh_indices));
+    return true;
 }
 
 // ------------------------------------------------------------------------------------------------
-void PopulateMeshCache(const IfcRepresentationItem& item,
-    const std::vector<unsigned int>& mesh_indices, unsigned int mat_index,
+void PopulateMeshCache(const ConversionData::MeshCacheIndex& idx,
+    std::vector<unsigned int>::const_iterator begin,
+    std::vector<unsigned int>::const_iterator end,
     ConversionData& conv)
 {
-    ConversionData::MeshCacheIndex idx(&item, mat_index);
-    conv.cached_meshes[idx] = mesh_indices;
+    conv.cached_meshes[idx].assign(begin,end);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -867,13 +895,26 @@ bool ProcessRepresentationItem(const IfcRepresentationItem& item, unsigned int m
     // determine material
     unsigned int localmatid = ProcessMaterials(item.GetID(), matid, conv, true);
 
-    if (!TryQueryMeshCache(item,mesh_indices,localmatid,conv)) {
-        if(ProcessGeometricItem(item,localmatid,mesh_indices,conv)) {
-            if(mesh_indices.size()) {
-                PopulateMeshCache(item,mesh_indices,localmatid,conv);
-            }
+    // geometry which is an opening or gets openings subtracted is specific to its product
+    if (conv.collect_openings || (conv.apply_openings && conv.apply_openings->size())) {
+        return ProcessGeometricItem(item,localmatid,mesh_indices,conv);
+    }
+
+    const ConversionData::MeshCacheIndex idx(STEP::HashEntityContents(conv.db,item.GetID(),conv.content_hashes),localmatid);
+    if (!TryQueryMeshCache(idx,mesh_indices,conv)) {
+        const size_t first = mesh_indices.size();
+        const size_t first_message = conv.messages ? conv.messages->size() : 0;
+        const bool ok = ProcessGeometricItem(item,localmatid,mesh_indices,conv);
+        if (conv.cache_misses) {
+            const ConversionData::CacheMiss miss = { idx, first_message, conv.messages ? conv.messages->size() : 0 };
+            conv.cache_misses->push_back(miss);
+        }
+        if (!ok) {
+            return false;
+        }
+        if(mesh_indices.size() > first) {
+            PopulateMeshCache(idx,mesh_indices.begin() + first,mesh_indices.end(),conv);
         }
-        else return false;
     }
     return true;
 }
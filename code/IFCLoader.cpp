@@ -46,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #ifndef ASSIMP_BUILD_NO_IFC_IMPORTER
 
+#include <algorithm>
 #include <iterator>
 #include <limits>
 #include <tuple>
@@ -60,6 +61,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "IFCUtil.h"
 
 #include "MemoryIOWrapper.h"
+#include "ThreadPool.h"
 #include <assimp/scene.h>
 #include <assimp/Importer.hpp>
 #include <assimp/importerdesc.h>
@@ -97,12 +99,14 @@ namespace {
 // forward declarations
 void SetUnits(ConversionData& conv);
 void SetCoordinateSpace(ConversionData& conv);
-void ProcessSpatialStructures(ConversionData& conv);
+void ProcessSpatialStructures(ConversionData& conv, ThreadPool* pool);
 void MakeTreeRelative(ConversionData& conv);
 void ConvertUnit(const EXPRESS::DataType& dt,ConversionData& conv);
 
 } // anon
 
+static const int IfcDefaultParallelChunkSize = 4 * 1024 * 1024;
+
 static const aiImporterDesc desc = {
     "Industry Foundation Classes (IFC) Importer",
     "",
@@ -162,6 +166,10 @@ void IFCImporter::SetupProperties(const Importer* pImp)
     settings.conicSamplingAngle = std::min(std::max((float) pImp->GetPropertyFloat(AI_CONFIG_IMPORT_IFC_SMOOTHING_ANGLE, AI_IMPORT_IFC_DEFAULT_SMOOTHING_ANGLE), 5.0f), 120.0f);
 	settings.cylindricalTessellation = std::min(std::max(pImp->GetPropertyInteger(AI_CONFIG_IMPORT_IFC_CYLINDRICAL_TESSELLATION, AI_IMPORT_IFC_DEFAULT_CYLINDRICAL_TESSELLATION), 3), 180);
 	settings.skipAnnotations = true;
+
+    const int chunkSize = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_IFC_PARALLEL_CHUNK_SIZE, IfcDefaultParallelChunkSize);
+    settings.parallelChunkSize = chunkSize > 0 ? static_cast<size_t>(chunkSize) : IfcDefaultParallelChunkSize;
+    settings.parallelGeometry = pImp->GetPropertyBool(AI_CONFIG_IMPORT_IFC_PARALLEL_GEOMETRY,true);
 }
 
 
@@ -267,7 +275,7 @@ void IFCImporter::InternReadFile( const std::string& pFile,
     };
 
     // feed the IFC schema into the reader and pre-parse all lines
-    STEP::ReadFile(*db, schema, types_to_track, inverse_indices_to_track);
+    STEP::ReadFile(*db, schema, types_to_track, inverse_indices_to_track, m_threadPool, settings.parallelChunkSize);
     const STEP::LazyObject* proj =  db->GetObject("ifcproject");
     if (!proj) {
         ThrowException("missing IfcProject entity");
@@ -276,7 +284,7 @@ void IFCImporter::InternReadFile( const std::string& pFile,
     ConversionData conv(*db,proj->To<IfcProject>(),pScene,settings);
     SetUnits(conv);
     SetCoordinateSpace(conv);
-    ProcessSpatialStructures(conv);
+    ProcessSpatialStructures(conv,m_threadPool);
     MakeTreeRelative(conv);
 
     // NOTE - this is a stress test for the importer, but it works only
@@ -665,7 +673,336 @@ void ProcessMetadata(uint64_t relDefinesByPropertiesID, ConversionData& conv, Me
 }
 
 // ------------------------------------------------------------------------------------------------
-aiNode* ProcessSpatialStructure(aiNode* parent, const IfcProduct& el, ConversionData& conv, std::vector<TempOpening>* collect_openings = NULL)
+// Geometry conversion of a single product. The jobs are recorded by ProcessSpatialStructure()
+// in the order in which the products have always been converted, i.e. children and opening
+// elements first, and executed once the node graph is complete (see ProcessProductGeometry()).
+struct ProductJob
+{
+    ProductJob(const IfcProduct& el, aiNode* nd, bool collect)
+        : el(el)
+        , nd(nd)
+        , collect(collect)
+        , rerun()
+    {}
+
+    ~ProductJob() {
+        std::for_each(subnodes.begin(),subnodes.end(),delete_fun<aiNode>());
+    }
+
+    const IfcProduct& el;
+    aiNode* const nd;
+
+    // true if this is an opening element whose geometry is preserved for its parent
+    const bool collect;
+
+    // opening jobs whose geometry is poured into this element, along with the
+    // transformation which brings them into the local space of this element
+    std::vector< std::pair<size_t,IfcMatrix4> > openings_from;
+
+    // output: collected openings, a temporary node holding the meshes of the
+    // product itself and the nodes generated for IfcMappedItems
+    std::vector<TempOpening> openings;
+    std::unique_ptr<aiNode> meshes;
+    std::vector<aiNode*> subnodes;
+
+    // result of a speculative conversion against an empty context
+    std::unique_ptr<ConversionData> local;
+    std::vector<ConversionData::CacheMiss> misses;
+    IFCImporter::Messages messages;
+
+    // set if the product was (or needs to be) converted against the shared context
+    bool rerun;
+
+private:
+    ProductJob(const ProductJob&);
+    ProductJob& operator = (const ProductJob&);
+};
+
+typedef std::vector< std::unique_ptr<ProductJob> > ProductJobs;
+
+// ------------------------------------------------------------------------------------------------
+void ConvertProduct(ProductJob& job, const ProductJobs& jobs, ConversionData& conv)
+{
+    // openings get modified while they are applied, so work on a copy of them
+    std::vector<TempOpening> openings;
+    for(const std::pair<size_t,IfcMatrix4>& src : job.openings_from) {
+        for(const TempOpening& op : jobs[src.first]->openings) {
+            openings.push_back(op);
+            TempOpening& copy = openings.back();
+            if (op.profileMesh) {
+                copy.profileMesh = std::make_shared<TempMesh>(*op.profileMesh);
+            }
+            if (op.profileMesh2D) {
+                copy.profileMesh2D = std::make_shared<TempMesh>(*op.profileMesh2D);
+            }
+            copy.Transform(src.second);
+        }
+    }
+
+    job.openings.clear();
+    job.meshes.reset(new aiNode());
+    job.meshes->mTransformation = job.nd->mTransformation;
+
+    conv.collect_openings = job.collect ? &job.openings : NULL;
+    conv.apply_openings = job.collect ? NULL : &openings;
+    ProcessProductRepresentation(job.el,job.meshes.get(),job.subnodes,conv);
+    conv.apply_openings = conv.collect_openings = NULL;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ConvertProductSpeculative(ProductJob& job, const ProductJobs& jobs, const ConversionData& conv)
+{
+    for(const std::pair<size_t,IfcMatrix4>& src : job.openings_from) {
+        if (jobs[src.first]->rerun) {
+            job.rerun = true;
+            return;
+        }
+    }
+
+    std::unique_ptr<ConversionData> local(new ConversionData(conv.db,conv.proj,conv.out,conv.settings));
+    local->len_scale = conv.len_scale;
+    local->angle_scale = conv.angle_scale;
+    local->wcs = conv.wcs;
+    local->cache_misses = &job.misses;
+    local->messages = &job.messages;
+    local->shared = &conv;
+
+    // hold the messages back until MergeProduct() knows whether the result is used
+    IFCImporter::Messages* const prev = IFCImporter::CaptureMessages(&job.messages);
+    bool failed = false;
+    try {
+        ConvertProduct(job,jobs,*local);
+    }
+    catch(...) {
+        failed = true;
+    }
+    IFCImporter::CaptureMessages(prev);
+
+    if (failed) {
+        // leave it to the serial conversion to raise the error, if any
+        std::for_each(job.subnodes.begin(),job.subnodes.end(),delete_fun<aiNode>());
+        job.subnodes.clear();
+        job.rerun = true;
+        return;
+    }
+    job.local = std::move(local);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Get the indices the materials of a speculative conversion have in the shared context. New
+// materials receive the indices they are going to be appended at, in order of creation.
+void MapMaterials(const ConversionData& local, const ConversionData& conv,
+    std::vector<unsigned int>& matmap,
+    std::vector<const IfcSurfaceStyle*>& styles)
+{
+    styles.assign(local.materials.size(),NULL);
+    for(const ConversionData::MaterialCache::value_type& v : local.cached_materials) {
+        styles[v.second] = v.first;
+    }
+
+    unsigned int next = static_cast<unsigned int>(conv.materials.size());
+    matmap.resize(local.materials.size());
+    for(size_t i = 0; i < local.materials.size(); ++i) {
+        if (!FindMaterial(styles[i],*local.materials[i],conv,matmap[i])) {
+            matmap[i] = next++;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Map the mesh indices of a node to the shared context. Indices stay sorted and unique, as
+// AssignAddedMeshes() leaves them.
+void RemapMeshIndices(aiNode* nd, const std::vector<unsigned int>& meshmap)
+{
+    for(unsigned int i = 0; i < nd->mNumMeshes; ++i) {
+        nd->mMeshes[i] = meshmap[nd->mMeshes[i]];
+    }
+    std::sort(nd->mMeshes,nd->mMeshes + nd->mNumMeshes);
+    nd->mNumMeshes = static_cast<unsigned int>(std::unique(nd->mMeshes,nd->mMeshes + nd->mNumMeshes) - nd->mMeshes);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Find the meshes of a speculative conversion which the shared context holds already, i.e. the
+// items the product would have found in the mesh cache if it had been converted serially. These
+// meshes are mapped to the cached ones and the messages logged while converting them are dropped.
+// Returns false if the conversions don't match up, the product needs to be converted again then.
+bool MapCachedMeshes(const ProductJob& job, const std::vector<unsigned int>& matmap,
+    const ConversionData& conv, std::vector<unsigned int>& meshmap,
+    std::vector<bool>& dropped_messages)
+{
+    const ConversionData& local = *job.local;
+    const unsigned int missing = std::numeric_limits<unsigned int>::max();
+    meshmap.assign(local.meshes.size(),missing);
+    dropped_messages.assign(job.messages.size(),false);
+
+    for(const std::pair<const unsigned int,unsigned int>& v : local.shared_meshes) {
+        meshmap[v.first] = v.second;
+    }
+
+    for(const ConversionData::CacheMiss& miss : job.misses) {
+        ConversionData::MeshCache::const_iterator it = conv.cached_meshes.find(
+            ConversionData::MeshCacheIndex(miss.idx.contents,matmap[miss.idx.matindex]));
+        if (it == conv.cached_meshes.end()) {
+            continue;
+        }
+
+        ConversionData::MeshCache::const_iterator own = local.cached_meshes.find(miss.idx);
+        if (own == local.cached_meshes.end() || (*own).second.size() != (*it).second.size()) {
+            return false;
+        }
+        for(size_t i = 0; i < (*it).second.size(); ++i) {
+            meshmap[(*own).second[i]] = (*it).second[i];
+        }
+        std::fill(dropped_messages.begin() + miss.first_message,dropped_messages.begin() + miss.end_message,true);
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Move the result of a product job into the shared context and the node graph. Meshes of the
+// speculative result which the mesh cache of the shared context holds already are replaced by
+// the cached ones, so the output is the same as if all products had been converted serially.
+// The same goes for the log, which only receives the messages of taken results. Products whose
+// speculative conversion failed or depends on failed openings are converted again.
+void MergeProduct(ProductJob& job, const ProductJobs& jobs, ConversionData& conv)
+{
+    bool rerun = job.rerun || !job.local;
+    for(const std::pair<size_t,IfcMatrix4>& src : job.openings_from) {
+        rerun = rerun || jobs[src.first]->rerun;
+    }
+
+    std::vector<unsigned int> matmap, meshmap;
+    std::vector<const IfcSurfaceStyle*> styles;
+    std::vector<bool> dropped_messages;
+    if (!rerun) {
+        MapMaterials(*job.local,conv,matmap,styles);
+        rerun = !MapCachedMeshes(job,matmap,conv,meshmap,dropped_messages);
+    }
+
+    if (rerun) {
+        job.local.reset();
+        job.messages.clear();
+        std::for_each(job.subnodes.begin(),job.subnodes.end(),delete_fun<aiNode>());
+        job.subnodes.clear();
+        job.rerun = true;
+
+        ConvertProduct(job,jobs,conv);
+    }
+    else {
+        IFCImporter::Messages messages;
+        for(size_t i = 0; i < job.messages.size(); ++i) {
+            if (!dropped_messages[i]) {
+                messages.push_back(job.messages[i]);
+            }
+        }
+        IFCImporter::LogMessages(messages);
+        job.messages.clear();
+
+        ConversionData& local = *job.local;
+        for(size_t i = 0; i < local.materials.size(); ++i) {
+            if (matmap[i] == conv.materials.size()) {
+                conv.materials.push_back(local.materials[i]);
+                local.materials[i] = NULL;
+                if (styles[i]) {
+                    conv.cached_materials[styles[i]] = matmap[i];
+                }
+            }
+        }
+
+        // meshes which are cached already are dropped, all others are appended in order
+        for(size_t i = 0; i < local.meshes.size(); ++i) {
+            aiMesh* const mesh = local.meshes[i];
+            if (meshmap[i] != std::numeric_limits<unsigned int>::max()) {
+                delete mesh;
+                continue;
+            }
+            mesh->mMaterialIndex = matmap[mesh->mMaterialIndex];
+            meshmap[i] = static_cast<unsigned int>(conv.meshes.size());
+            conv.meshes.push_back(mesh);
+        }
+        local.meshes.clear();
+
+        for(const ConversionData::MeshCache::value_type& v : local.cached_meshes) {
+            std::vector<unsigned int>& indices = conv.cached_meshes[ConversionData::MeshCacheIndex(v.first.contents,matmap[v.first.matindex])];
+            indices = v.second;
+            for(unsigned int& index : indices) {
+                index = meshmap[index];
+            }
+        }
+
+        RemapMeshIndices(job.meshes.get(),meshmap);
+        for(aiNode* nd : job.subnodes) {
+            RemapMeshIndices(nd,meshmap);
+        }
+        job.local.reset();
+    }
+
+    aiNode* const nd = job.nd;
+    std::swap(nd->mNumMeshes,job.meshes->mNumMeshes);
+    std::swap(nd->mMeshes,job.meshes->mMeshes);
+    job.meshes.reset();
+
+    if (job.subnodes.size()) {
+        aiNode** const children = new aiNode*[nd->mNumChildren + job.subnodes.size()]();
+        std::copy(nd->mChildren,nd->mChildren + nd->mNumChildren,children);
+        delete[] nd->mChildren;
+        nd->mChildren = children;
+
+        for(aiNode* nd2 : job.subnodes) {
+            nd->mChildren[nd->mNumChildren++] = nd2;
+            nd2->mParent = nd;
+        }
+        job.subnodes.clear();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ProcessProductGeometry(ProductJobs& jobs, ConversionData& conv, ThreadPool* pool)
+{
+    if (!pool || pool->GetNumThreads() < 2 || !conv.settings.parallelGeometry || jobs.size() < 2) {
+        for(const std::unique_ptr<ProductJob>& job : jobs) {
+            MergeProduct(*job,jobs,conv);
+        }
+        return;
+    }
+
+    // opening elements go first as their geometry is needed to convert their parents
+    std::vector<ProductJob*> collect;
+    for(const std::unique_ptr<ProductJob>& job : jobs) {
+        if (job->collect) {
+            collect.push_back(job.get());
+        }
+    }
+    pool->ParallelFor(collect.size(), [&](size_t i) {
+        ConvertProductSpeculative(*collect[i],jobs,conv);
+    });
+
+    // all other products are converted in batches. Each batch is merged before the next one
+    // starts, so items shared between products (i.e. mapped items) are found in the mesh cache
+    // and only converted by the first batch using them.
+    const size_t batch = pool->GetNumThreads() * 8;
+    std::vector<ProductJob*> apply;
+    for(size_t begin = 0; begin < jobs.size(); begin += batch) {
+        const size_t end = std::min(begin + batch,jobs.size());
+
+        apply.clear();
+        for(size_t i = begin; i < end; ++i) {
+            if (!jobs[i]->collect) {
+                apply.push_back(jobs[i].get());
+            }
+        }
+        pool->ParallelFor(apply.size(), [&](size_t i) {
+            ConvertProductSpeculative(*apply[i],jobs,conv);
+        });
+
+        for(size_t i = begin; i < end; ++i) {
+            MergeProduct(*jobs[i],jobs,conv);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+aiNode* ProcessSpatialStructure(aiNode* parent, const IfcProduct& el, ConversionData& conv, ProductJobs& jobs, size_t* collect_job = NULL)
 {
     const STEP::DB::RefMap& refs = conv.db.GetRefs();
 
@@ -722,7 +1059,7 @@ aiNode* ProcessSpatialStructure(aiNode* parent, const IfcProduct& el, Conversion
         ResolveObjectPlacement(nd->mTransformation,el.ObjectPlacement.Get(),conv);
     }
 
-    std::vector<TempOpening> openings;
+    std::vector< std::pair<size_t,IfcMatrix4> > openings_from;
 
     IfcMatrix4 myInv;
     bool didinv = false;
@@ -757,7 +1094,7 @@ aiNode* ProcessSpatialStructure(aiNode* parent, const IfcProduct& el, Conversion
                         continue;
                     }
 
-                    aiNode* const ndnew = ProcessSpatialStructure(nd.get(),pro,conv,NULL);
+                    aiNode* const ndnew = ProcessSpatialStructure(nd.get(),pro,conv,jobs,NULL);
                     if(ndnew) {
                         subnodes.push_back( ndnew );
                     }
@@ -775,8 +1112,8 @@ aiNode* ProcessSpatialStructure(aiNode* parent, const IfcProduct& el, Conversion
 
                     nd_aggr->mTransformation = nd->mTransformation;
 
-                    std::vector<TempOpening> openings_local;
-                    aiNode* const ndnew = ProcessSpatialStructure( nd_aggr.get(),open, conv,&openings_local);
+                    size_t open_job = std::numeric_limits<size_t>::max();
+                    aiNode* const ndnew = ProcessSpatialStructure( nd_aggr.get(),open, conv,jobs,&open_job);
                     if (ndnew) {
 
                         nd_aggr->mNumChildren = 1;
@@ -785,17 +1122,15 @@ aiNode* ProcessSpatialStructure(aiNode* parent, const IfcProduct& el, Conversion
 
                         nd_aggr->mChildren[0] = ndnew;
 
-                        if(openings_local.size()) {
+                        if(open_job != std::numeric_limits<size_t>::max()) {
                             if (!didinv) {
                                 myInv = aiMatrix4x4(nd->mTransformation ).Inverse();
                                 didinv = true;
                             }
 
-                            // we need all openings to be in the local space of *this* node, so transform them
-                            for(TempOpening& op :openings_local) {
-                                op.Transform( myInv*nd_aggr->mChildren[0]->mTransformation);
-                                openings.push_back(op);
-                            }
+                            // we need all openings to be in the local space of *this* node, so they
+                            // get transformed once they have been generated
+                            openings_from.push_back(std::make_pair(open_job,myInv*nd_aggr->mChildren[0]->mTransformation));
                         }
                         subnodes.push_back( nd_aggr.release() );
                     }
@@ -824,7 +1159,7 @@ aiNode* ProcessSpatialStructure(aiNode* parent, const IfcProduct& el, Conversion
                 for(const IfcObjectDefinition& def : aggr->RelatedObjects) {
                     if(const IfcProduct* const prod = def.ToPtr<IfcProduct>()) {
 
-                        aiNode* const ndnew = ProcessSpatialStructure(nd_aggr.get(),*prod,conv,NULL);
+                        aiNode* const ndnew = ProcessSpatialStructure(nd_aggr.get(),*prod,conv,jobs,NULL);
                         if(ndnew) {
                             nd_aggr->mChildren[nd_aggr->mNumChildren++] = ndnew;
                         }
@@ -835,14 +1170,15 @@ aiNode* ProcessSpatialStructure(aiNode* parent, const IfcProduct& el, Conversion
             }
         }
 
-        conv.collect_openings = collect_openings;
-        if(!conv.collect_openings) {
-            conv.apply_openings = &openings;
-        }
-
-        if (!skipGeometry) {
-          ProcessProductRepresentation(el,nd.get(),subnodes,conv);
-          conv.apply_openings = conv.collect_openings = NULL;
+        // the geometry is converted once the whole node graph is known
+        if (!skipGeometry && el.Representation) {
+            jobs.push_back(std::unique_ptr<ProductJob>(new ProductJob(el,nd.get(),collect_job != NULL)));
+            if (collect_job) {
+                *collect_job = jobs.size() - 1;
+            }
+            else {
+                jobs.back()->openings_from.swap(openings_from);
+            }
         }
 
         if (subnodes.size()) {
@@ -865,7 +1201,7 @@ aiNode* ProcessSpatialStructure(aiNode* parent, const IfcProduct& el, Conversion
 }
 
 // ------------------------------------------------------------------------------------------------
-void ProcessSpatialStructures(ConversionData& conv)
+void ProcessSpatialStructures(ConversionData& conv, ThreadPool* pool)
 {
     // XXX add support for multiple sites (i.e. IfcSpatialStructureElements with composition == COMPLEX)
 
@@ -887,6 +1223,7 @@ void ProcessSpatialStructures(ConversionData& conv)
     }
 
 	std::vector<aiNode*> nodes;
+    ProductJobs jobs;
 
     for(const STEP::LazyObject* lz : *range) {
         const IfcSpatialStructureElement* const prod = lz->ToPtr<IfcSpatialStructureElement>();
@@ -907,7 +1244,7 @@ void ProcessSpatialStructures(ConversionData& conv)
                     if (def.GetID() == prod->GetID()) {
                         IFCImporter::LogDebug("selecting this spatial structure as root structure");
                         // got it, this is one primary site.
-						nodes.push_back(ProcessSpatialStructure(NULL, *prod, conv, NULL));
+						nodes.push_back(ProcessSpatialStructure(NULL, *prod, conv, jobs, NULL));
                     }
                 }
 
@@ -925,7 +1262,7 @@ void ProcessSpatialStructures(ConversionData& conv)
 				continue;
 			}
 
-			nodes.push_back(ProcessSpatialStructure(NULL, *prod, conv, NULL));
+			nodes.push_back(ProcessSpatialStructure(NULL, *prod, conv, jobs, NULL));
 		}
 
 		nb_nodes = nodes.size();
@@ -951,6 +1288,8 @@ void ProcessSpatialStructures(ConversionData& conv)
 	else {
 		IFCImporter::ThrowException("failed to determine primary site element");
 	}
+
+    ProcessProductGeometry(jobs,conv,pool);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -112,6 +112,8 @@ public:
             , skipAnnotations()
             , conicSamplingAngle(10.f)
 			, cylindricalTessellation(32)
+            , parallelChunkSize()
+            , parallelGeometry(true)
         {}
 
 
@@ -120,6 +122,8 @@ public:
         bool skipAnnotations;
         float conicSamplingAngle;
 		int cylindricalTessellation;
+        size_t parallelChunkSize;
+        bool parallelGeometry;
     };
 
 
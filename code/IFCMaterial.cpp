@@ -199,6 +199,32 @@ unsigned int ProcessMaterials(uint64_t id, unsigned int prevMatId, ConversionDat
     return (unsigned int) conv.materials.size() - 1;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Find the index a material created by ProcessMaterials() for another context has in conv, if
+// any. Materials are identified by their surface style, default materials by their name.
+bool FindMaterial(const IFC::IfcSurfaceStyle* style, const aiMaterial& mat, const ConversionData& conv, unsigned int& matindex) {
+    if ( style ) {
+        ConversionData::MaterialCache::const_iterator it = conv.cached_materials.find(style);
+        if ( it == conv.cached_materials.end() ) {
+            return false;
+        }
+        matindex = it->second;
+        return true;
+    }
+
+    aiString name;
+    mat.Get(AI_MATKEY_NAME, name);
+    for( size_t a = 0; a < conv.materials.size(); ++a ) {
+        aiString mname;
+        conv.materials[a]->Get(AI_MATKEY_NAME, mname);
+        if ( name == mname ) {
+            matindex = ( unsigned int )a;
+            return true;
+        }
+    }
+    return false;
+}
+
 } // ! IFC
 } // ! Assimp
 
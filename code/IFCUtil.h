@@ -180,6 +180,9 @@ struct ConversionData
         , db(db)
         , proj(proj)
         , out(out)
+        , cache_misses()
+        , messages()
+        , shared()
         , settings(settings)
         , apply_openings()
         , collect_openings()
@@ -201,16 +204,39 @@ struct ConversionData
     std::vector<aiMesh*> meshes;
     std::vector<aiMaterial*> materials;
 
+    // meshes are shared between all representation items with the same contents
+    // (see STEP::HashEntityContents()) and material, i.e. mapped items and
+    // repeated geometry are converted only once.
     struct MeshCacheIndex {
-        const IFC::IfcRepresentationItem* item; unsigned int matindex;
-        MeshCacheIndex() : item(NULL), matindex(0) { }
-        MeshCacheIndex(const IFC::IfcRepresentationItem* i, unsigned int mi) : item(i), matindex(mi) { }
-        bool operator == (const MeshCacheIndex& o) const { return item == o.item && matindex == o.matindex; }
-        bool operator < (const MeshCacheIndex& o) const { return item < o.item || (item == o.item && matindex < o.matindex); }
+        uint64_t contents; unsigned int matindex;
+        MeshCacheIndex() : contents(0), matindex(0) { }
+        MeshCacheIndex(uint64_t c, unsigned int mi) : contents(c), matindex(mi) { }
+        bool operator == (const MeshCacheIndex& o) const { return contents == o.contents && matindex == o.matindex; }
+        bool operator < (const MeshCacheIndex& o) const { return contents < o.contents || (contents == o.contents && matindex < o.matindex); }
     };
     typedef std::map<MeshCacheIndex, std::vector<unsigned int> > MeshCache;
     MeshCache cached_meshes;
 
+    // content hashes of all entities seen so far, by entity id
+    std::map<uint64_t,uint64_t> content_hashes;
+
+    // if present, receives all mesh cache lookups which failed along with the
+    // range of the messages which were captured while converting the item
+    // (see IFCImporter::CaptureMessages()). This is used to merge a product
+    // converted against an empty cache into the cache of the whole conversion.
+    struct CacheMiss {
+        MeshCacheIndex idx;
+        size_t first_message, end_message;
+    };
+    std::vector<CacheMiss>* cache_misses;
+    const IFCImporter::Messages* messages;
+
+    // if present, items missing in the mesh cache are looked up in the cache of
+    // this context, which must not change meanwhile. Meshes found there get NULL
+    // placeholders in meshes, shared_meshes maps them to their actual indices.
+    const ConversionData* shared;
+    std::map<unsigned int, unsigned int> shared_meshes;
+
     typedef std::map<const IFC::IfcSurfaceStyle*, unsigned int> MaterialCache;
     MaterialCache cached_materials;
 
@@ -281,6 +307,7 @@ bool ProcessCurve(const IfcCurve& curve,  TempMesh& meshout, ConversionData& con
 
 // IFCMaterial.cpp
 unsigned int ProcessMaterials(uint64_t id, unsigned int prevMatId, ConversionData& conv, bool forceDefaultMat);
+bool FindMaterial(const IFC::IfcSurfaceStyle* style, const aiMaterial& mat, const ConversionData& conv, unsigned int& matindex);
 
 // IFCGeometry.cpp
 IfcMatrix3 DerivePlaneCoordinateSpace(const TempMesh& curmesh, bool& ok, IfcVector3& norOut);
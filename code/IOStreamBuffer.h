@@ -105,12 +105,38 @@ public:
     /// @return true if successful.
     bool getNextLine(std::vector<T> &buffer);
 
+    /// @brief  Will return the next data line without copying it, if possible.
+    ///
+    /// Continued lines are joined, i.e. a continuation token directly followed
+    /// by the line end is removed together with the line end. The view is
+    /// terminated by a '\n' which is not included in the length. It points
+    /// into the cache or, for lines straddling a block boundary or being
+    /// continued, into an internal line buffer and stays valid until the next
+    /// call to any of the reading functions.
+    /// @param  line                Receives the begin of the line.
+    /// @param  length              Receives the length of the line.
+    /// @param  continuationToken   The line continuation token.
+    /// @return false if the end of the stream has been reached.
+    bool getNextDataLineView( const T* &line, size_t &length, T continuationToken );
+
+    /// @brief  Will return the next line without copying it, if possible.
+    ///
+    /// Behaves like getNextLine(), the view follows the same rules as the
+    /// one returned by getNextDataLineView().
+    /// @param  line        Receives the begin of the line.
+    /// @param  length      Receives the length of the line.
+    /// @return false if the end of the stream has been reached.
+    bool getNextLineView( const T* &line, size_t &length );
+
     /// @brief  Will read the next block.
     /// @param  buffer      The buffer for the next block.
     /// @return true if successful.
     bool getNextBlock( std::vector<T> &buffer );
 
 private:
+    /// @brief  Copies the rest of a line which doesn't end in the current block.
+    bool assembleLine( size_t pos, bool useContinuation, T continuationToken, const T* &line, size_t &length );
+
     IOStream *m_stream;
     size_t m_filesize;
     size_t m_cacheSize;
@@ -119,6 +145,7 @@ private:
     std::vector<T> m_cache;
     size_t m_cachePos;
     size_t m_filePos;
+    std::vector<T> m_lineBuffer;
 };
 
 template<class T>
@@ -131,8 +158,7 @@ IOStreamBuffer<T>::IOStreamBuffer( size_t cache )
 , m_blockIdx( 0 )
 , m_cachePos( 0 )
 , m_filePos( 0 ) {
-    m_cache.resize( cache );
-    std::fill( m_cache.begin(), m_cache.end(), '\n' );
+    // the cache is allocated by open(), once the file size is known
 }
 
 template<class T>
@@ -163,6 +189,10 @@ bool IOStreamBuffer<T>::open( IOStream *stream ) {
         m_cacheSize = m_filesize;
     }
 
+    // one more element for a line end behind the data of each block
+    m_cache.resize( m_cacheSize + 1 );
+    std::fill( m_cache.begin(), m_cache.end(), '\n' );
+
     m_numBlocks = m_filesize / m_cacheSize;
     if ( ( m_filesize % m_cacheSize ) > 0 ) {
         m_numBlocks++;
@@ -212,6 +242,7 @@ bool IOStreamBuffer<T>::readNextBlock() {
     if ( readLen < m_cacheSize ) {
         m_cacheSize = readLen;
     }
+    m_cache[ m_cacheSize ] = '\n';
     m_filePos += m_cacheSize;
     m_cachePos = 0;
     m_blockIdx++;
@@ -330,19 +361,138 @@ bool IOStreamBuffer<T>::getNextLine(std::vector<T> &buffer) {
     return true;
 }
 
+template<class T>
+inline
+bool IOStreamBuffer<T>::getNextDataLineView( const T* &line, size_t &length, T continuationToken ) {
+    if ( m_cachePos >= m_cacheSize || 0 == m_filePos ) {
+        if ( !readNextBlock() ) {
+            return false;
+        }
+    }
+
+    // usually the line ends within the current block, return a view into the cache then
+    size_t pos = m_cachePos;
+    while ( pos < m_cacheSize && !IsLineEnd( m_cache[ pos ] ) && continuationToken != m_cache[ pos ] ) {
+        ++pos;
+    }
+    if ( pos == m_cacheSize || continuationToken == m_cache[ pos ] ) {
+        return assembleLine( pos, true, continuationToken, line, length );
+    }
+
+    m_cache[ pos ] = '\n';
+    line = &m_cache[ m_cachePos ];
+    length = pos - m_cachePos;
+    m_cachePos = pos + 1;
+
+    return true;
+}
+
+template<class T>
+inline
+bool IOStreamBuffer<T>::getNextLineView( const T* &line, size_t &length ) {
+    if ( isEndOfCache( m_cachePos, m_cacheSize ) || 0 == m_filePos ) {
+        if ( !readNextBlock() ) {
+            return false;
+        }
+    }
+
+    // skip the rest of the previous line end, e.g. the '\n' of "\r\n"
+    if ( IsLineEnd( m_cache[ m_cachePos ] ) ) {
+        while ( m_cache[ m_cachePos ] != '\n' ) {
+            ++m_cachePos;
+            if ( isEndOfCache( m_cachePos, m_cacheSize ) && !readNextBlock() ) {
+                return false;
+            }
+        }
+        ++m_cachePos;
+        if ( isEndOfCache( m_cachePos, m_cacheSize ) && !readNextBlock() ) {
+            return false;
+        }
+    }
+
+    size_t pos = m_cachePos;
+    while ( pos < m_cacheSize && !IsLineEnd( m_cache[ pos ] ) ) {
+        ++pos;
+    }
+    if ( pos == m_cacheSize ) {
+        return assembleLine( pos, false, T(), line, length );
+    }
+
+    m_cache[ pos ] = '\n';
+    line = &m_cache[ m_cachePos ];
+    length = pos - m_cachePos;
+    m_cachePos = pos + 1;
+
+    return true;
+}
+
+template<class T>
+inline
+bool IOStreamBuffer<T>::assembleLine( size_t pos, bool useContinuation, T continuationToken, const T* &line, size_t &length ) {
+    m_lineBuffer.assign( m_cache.begin() + m_cachePos, m_cache.begin() + pos );
+    m_cachePos = pos;
+
+    // 0: inside the line, 1: behind a continuation token, 2: behind token and '\r'
+    int state = 0;
+    for ( ;; ) {
+        if ( m_cachePos >= m_cacheSize && !readNextBlock() ) {
+            // the last line of the file has no line end
+            break;
+        }
+
+        const T c = m_cache[ m_cachePos ];
+        if ( 1 == state ) {
+            if ( '\n' == c || '\r' == c ) {
+                state = '\r' == c ? 2 : 0;
+                ++m_cachePos;
+                continue;
+            }
+            // not a continuation, keep the token
+            m_lineBuffer.push_back( continuationToken );
+            state = 0;
+        } else if ( 2 == state ) {
+            state = 0;
+            if ( '\n' == c ) {
+                ++m_cachePos;
+                continue;
+            }
+        }
+
+        ++m_cachePos;
+        if ( useContinuation && continuationToken == c ) {
+            state = 1;
+        } else if ( IsLineEnd( c ) ) {
+            break;
+        } else {
+            m_lineBuffer.push_back( c );
+        }
+    }
+    if ( 1 == state ) {
+        m_lineBuffer.push_back( continuationToken );
+    }
+
+    // keep one element behind the line end readable, as in the cache
+    m_lineBuffer.push_back( '\n' );
+    m_lineBuffer.push_back( '\n' );
+    line = &m_lineBuffer[ 0 ];
+    length = m_lineBuffer.size() - 2;
+
+    return true;
+}
+
 template<class T>
 inline
 bool IOStreamBuffer<T>::getNextBlock( std::vector<T> &buffer) {
   //just return the last blockvalue if getNextLine was used before
   if ( m_cachePos !=  0) {      
-      buffer = std::vector<T>(m_cache.begin() + m_cachePos, m_cache.end());
+      buffer = std::vector<T>(m_cache.begin() + m_cachePos, m_cache.begin() + m_cacheSize);
       m_cachePos = 0;
   }
   else {
       if ( !readNextBlock() )
           return false;
 
-      buffer = std::vector<T>(m_cache.begin(), m_cache.end());
+      buffer = std::vector<T>(m_cache.begin(), m_cache.begin() + m_cacheSize);
   }
   return true;
 }
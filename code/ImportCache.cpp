@@ -0,0 +1,454 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file ImportCache.cpp
+ *  @brief Implementation of the on-disk import cache
+ */
+
+#ifndef ASSIMP_BUILD_NO_ASSMAP_EXPORTER
+
+#include "ImportCache.h"
+#include "Hash.h"
+#include "StringUtils.h"
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/DefaultLogger.hpp>
+#include <assimp/IOStream.hpp>
+#include <assimp/MappedScene.hpp>
+#include <assimp/SceneCombiner.h>
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+using namespace Assimp;
+
+namespace Assimp {
+    class ExportProperties;
+
+    // AssmapExporter.cpp
+    void ExportSceneAssmap(const char*, IOSystem*, const aiScene*, const ExportProperties*);
+}
+
+// Name of the index file in the cache directory and the tag on its first line
+static const char* const IndexFileName = "index.txt";
+static const char* const IndexTag = "assimp-import-cache";
+
+// Placeholder for the hash of a dependency which did not exist
+static const char* const MissingHash = "----------------";
+
+// ------------------------------------------------------------------------------------------------
+// Read a whole file into a string. Returns false if it does not exist.
+static bool ReadTextFile(IOSystem& io, const std::string& path, std::string& out)
+{
+    IOStream* stream = io.Open(path.c_str(), "rb");
+    if (!stream) {
+        return false;
+    }
+    out.resize(stream->FileSize());
+    const size_t read = out.empty() ? 0 : stream->Read(&out[0], 1, out.size());
+    io.Close(stream);
+    out.resize(read);
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Get a name to write a file under before it is moved into place. Concurrent writers of the
+// same file must not share it.
+static std::string GetTempPath(const std::string& path)
+{
+    static std::atomic<unsigned int> counter(0);
+    std::ostringstream tmp;
+    tmp << path << '.' << std::hex << static_cast<unsigned long long>(time(NULL)) << '-'
+        << reinterpret_cast<uintptr_t>(&tmp) << '-' << clock() << '-' << counter++ << ".tmp";
+    return tmp.str();
+}
+
+// ------------------------------------------------------------------------------------------------
+// Move a file into place, replacing the old one. Readers never see a partial file this way.
+static bool MoveIntoPlace(const std::string& tmp, const std::string& path)
+{
+    if (::rename(tmp.c_str(), path.c_str()) != 0) {
+        // Windows won't rename onto an existing file
+        ::remove(path.c_str());
+        if (::rename(tmp.c_str(), path.c_str()) != 0) {
+            ::remove(tmp.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+static bool WriteTextFile(IOSystem& io, const std::string& path, const std::string& contents)
+{
+    const std::string tmp = GetTempPath(path);
+    IOStream* stream = io.Open(tmp.c_str(), "wb");
+    if (!stream) {
+        return false;
+    }
+    const size_t written = contents.empty() ? 0 : stream->Write(contents.data(), 1, contents.size());
+    io.Close(stream);
+
+    if (written != contents.size()) {
+        ::remove(tmp.c_str());
+        return false;
+    }
+    return MoveIntoPlace(tmp, path);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Directory part of a path, including the trailing separator
+static std::string GetDirectory(const std::string& path)
+{
+    const std::string::size_type pos = path.find_last_of("/\\");
+    return pos == std::string::npos ? std::string() : path.substr(0, pos + 1);
+}
+
+// ------------------------------------------------------------------------------------------------
+IOStream* ImportCache::RecordingIOSystem::Open( const char* pFile, const char* pMode)
+{
+    IOStream* stream = mWrapped->Open(pFile, pMode);
+    if (pMode && !strchr(pMode, 'w') && !strchr(pMode, 'a')) {
+        if (!stream) {
+            RecordMissing(pFile);
+        }
+        else if (std::find(mFiles.begin(), mFiles.end(), pFile) == mFiles.end()) {
+            mFiles.push_back(pFile);
+        }
+    }
+    return stream;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ImportCache::RecordingIOSystem::Exists( const char* pFile) const
+{
+    if (!mWrapped->Exists(pFile)) {
+        RecordMissing(pFile);
+        return false;
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportCache::RecordingIOSystem::RecordMissing( const char* pFile) const
+{
+    if (std::find(mMissing.begin(), mMissing.end(), pFile) == mMissing.end()) {
+        mMissing.push_back(pFile);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+ImportCache::ImportCache(const std::string& directory, uint64_t maxSize)
+    : mDirectory(directory)
+    , mMaxSize(maxSize)
+{
+    if (!mDirectory.empty() && mDirectory[mDirectory.length()-1] != '/' &&
+        mDirectory[mDirectory.length()-1] != '\\') {
+        mDirectory += '/';
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+std::string ImportCache::GetPath(uint64_t key, const char* extension) const
+{
+    char name[32];
+    ::ai_snprintf(name, sizeof(name), "%016llx%s", static_cast<unsigned long long>(key), extension);
+    return mDirectory + name;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ImportCache::HashFile(IOSystem* pIOHandler, const std::string& pFile, uint64_t& hash)
+{
+    IOStream* stream = pIOHandler->Open(pFile.c_str(), "rb");
+    if (!stream) {
+        return false;
+    }
+
+    const size_t size = stream->FileSize();
+    bool ok = true;
+    hash = MurmurHash64A(NULL, 0, size);
+    if (const void* view = stream->MapView()) {
+        hash = MurmurHash64A(view, size, hash);
+    }
+    else {
+        std::vector<char> chunk(std::min(size, static_cast<size_t>(1u << 20)));
+        for (size_t remaining = size; remaining && ok; ) {
+            const size_t n = std::min(remaining, chunk.size());
+            ok = stream->Read(&chunk[0], 1, n) == n;
+            hash = MurmurHash64A(&chunk[0], n, hash);
+            remaining -= n;
+        }
+    }
+    pIOHandler->Close(stream);
+    return ok;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportCache::ReadIndex(std::vector<Entry>& entries, uint64_t& nextStamp) const
+{
+    entries.clear();
+    nextStamp = 0;
+
+    DefaultIOSystem io;
+    std::string text;
+    if (!ReadTextFile(io, mDirectory + IndexFileName, text)) {
+        return;
+    }
+
+    std::istringstream in(text);
+    std::string tag;
+    if (!(in >> tag >> nextStamp) || tag != IndexTag) {
+        DefaultLogger::get()->warn("ImportCache: Ignoring invalid index file");
+        nextStamp = 0;
+        return;
+    }
+    Entry e;
+    while (in >> std::hex >> e.mKey >> std::dec >> e.mSize >> e.mStamp) {
+        entries.push_back(e);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportCache::WriteIndex(const std::vector<Entry>& entries, uint64_t nextStamp) const
+{
+    std::ostringstream out;
+    out << IndexTag << ' ' << nextStamp << '\n';
+    for (std::vector<Entry>::const_iterator it = entries.begin(); it != entries.end(); ++it) {
+        out << std::hex << std::setw(16) << std::setfill('0') << (*it).mKey << std::dec << ' ' << (*it).mSize << ' ' << (*it).mStamp << '\n';
+    }
+
+    DefaultIOSystem io;
+    if (!WriteTextFile(io, mDirectory + IndexFileName, out.str())) {
+        DefaultLogger::get()->warn("ImportCache: Failed to write the index file");
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportCache::Remove(uint64_t key) const
+{
+    ::remove(GetPath(key, ".assmap").c_str());
+    ::remove(GetPath(key, ".deps").c_str());
+}
+
+// ------------------------------------------------------------------------------------------------
+// Mark an entry as most recently used and evict the least recently used ones. A size of 0
+// keeps the recorded size of an existing entry.
+void ImportCache::UpdateIndex(uint64_t key, uint64_t size)
+{
+    std::vector<Entry> entries;
+    uint64_t nextStamp;
+    ReadIndex(entries, nextStamp);
+
+    std::vector<Entry>::iterator it = entries.begin();
+    for (; it != entries.end() && (*it).mKey != key; ++it);
+    if (it == entries.end()) {
+        if (!size) {
+            // entry written by a concurrent process whose index update got lost
+            size = 1;
+        }
+        Entry e = { key, size, 0 };
+        it = entries.insert(entries.end(), e);
+    }
+    if (size) {
+        (*it).mSize = size;
+    }
+    (*it).mStamp = nextStamp++;
+
+    uint64_t total = 0;
+    for (it = entries.begin(); it != entries.end(); ++it) {
+        total += (*it).mSize;
+    }
+
+    // evict in order of use, but never the entry which was just used
+    while (total > mMaxSize && entries.size() > 1) {
+        std::vector<Entry>::iterator oldest = entries.begin();
+        for (it = entries.begin(); it != entries.end(); ++it) {
+            if ((*it).mStamp < (*oldest).mStamp) {
+                oldest = it;
+            }
+        }
+        if ((*oldest).mKey == key) {
+            break;
+        }
+        Remove((*oldest).mKey);
+        total -= (*oldest).mSize;
+        entries.erase(oldest);
+    }
+    WriteIndex(entries, nextStamp);
+}
+
+// ------------------------------------------------------------------------------------------------
+aiScene* ImportCache::Load(uint64_t key, const std::string& pFile, IOSystem* pIOHandler)
+{
+    DefaultIOSystem io;
+
+    // the .deps file is written last, an entry without it is incomplete
+    std::string deps;
+    if (!ReadTextFile(io, GetPath(key, ".deps"), deps)) {
+        return NULL;
+    }
+
+    // each line holds the hash of a file, 'r' or 'a' and its path - relative to the
+    // directory of the imported file if it is located inside it, absolute otherwise.
+    // Files which did not exist have dashes instead of a hash.
+    const std::string base = GetDirectory(pFile);
+    std::istringstream in(deps);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.length() < 19 || line[16] != ' ' || line[18] != ' ') {
+            continue;
+        }
+        std::string path = line.substr(19);
+        if (line[17] == 'r') {
+            path = base + path;
+        }
+
+        if (line.compare(0, 16, MissingHash) == 0) {
+            if (pIOHandler->Exists(path.c_str())) {
+                DefaultLogger::get()->info("ImportCache: Entry is out of date, " + path + " has been created");
+                return NULL;
+            }
+            continue;
+        }
+
+        const uint64_t expected = strtoull(line.substr(0, 16).c_str(), NULL, 16);
+        uint64_t hash;
+        if (!HashFile(pIOHandler, path, hash) || hash != expected) {
+            DefaultLogger::get()->info("ImportCache: Entry is out of date, " + path + " has changed");
+            return NULL;
+        }
+    }
+
+    MappedScene mapped;
+    const aiScene* src = mapped.Load(GetPath(key, ".assmap").c_str(), &io);
+    if (!src) {
+        DefaultLogger::get()->warn(std::string("ImportCache: Dropping unreadable entry: ") + mapped.GetErrorString());
+        Remove(key);
+        return NULL;
+    }
+
+    aiScene* scene = NULL;
+    SceneCombiner::CopyScene(&scene, src);
+    mapped.Free();
+
+    UpdateIndex(key, 0);
+    return scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportCache::Store(uint64_t key, const aiScene* pScene, const std::string& pFile,
+    const std::vector<std::string>& files, const std::vector<std::string>& missing,
+    IOSystem* pIOHandler)
+{
+    // hash the dependencies first - they might have been removed already
+    const std::string base = GetDirectory(pFile);
+    std::ostringstream deps;
+    for (size_t i = 0; i < files.size() + missing.size(); ++i) {
+        const bool found = i < files.size();
+        const std::string& file = found ? files[i] : missing[i - files.size()];
+        if (pIOHandler->ComparePaths(file.c_str(), pFile.c_str())) {
+            continue;
+        }
+        if (found) {
+            uint64_t hash;
+            if (!HashFile(pIOHandler, file, hash)) {
+                DefaultLogger::get()->warn("ImportCache: Not caching the scene, failed to read " + file);
+                return;
+            }
+            char hex[20];
+            ::ai_snprintf(hex, sizeof(hex), "%016llx ", static_cast<unsigned long long>(hash));
+            deps << hex;
+        }
+        else if (std::find(files.begin(), files.end(), file) == files.end()) {
+            deps << MissingHash << ' ';
+        }
+        else {
+            // created while importing, it has been recorded already
+            continue;
+        }
+        if (!base.empty() && file.compare(0, base.length(), base) == 0) {
+            deps << "r " << file.substr(base.length());
+        }
+        else {
+            deps << "a " << file;
+        }
+        deps << '\n';
+    }
+
+    DefaultIOSystem io;
+    const std::string path = GetPath(key, ".assmap");
+    const std::string tmp = GetTempPath(path);
+
+    // a stale .deps file must not pair up with the new scene
+    ::remove(GetPath(key, ".deps").c_str());
+    try {
+        ExportSceneAssmap(tmp.c_str(), &io, pScene, NULL);
+    }
+    catch (const std::exception& e) {
+        ::remove(tmp.c_str());
+        DefaultLogger::get()->warn(std::string("ImportCache: Not caching the scene: ") + e.what());
+        return;
+    }
+    if (!MoveIntoPlace(tmp, path)) {
+        DefaultLogger::get()->warn("ImportCache: Failed to write " + path);
+        return;
+    }
+    if (!WriteTextFile(io, GetPath(key, ".deps"), deps.str())) {
+        DefaultLogger::get()->warn("ImportCache: Failed to write the dependencies of " + path);
+        return;
+    }
+
+    uint64_t size = 1;
+    if (IOStream* stream = io.Open(path.c_str(), "rb")) {
+        size = std::max(static_cast<uint64_t>(stream->FileSize()), size);
+        io.Close(stream);
+    }
+    UpdateIndex(key, size);
+}
+
+#endif // ASSIMP_BUILD_NO_ASSMAP_EXPORTER
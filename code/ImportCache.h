@@ -0,0 +1,177 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file ImportCache.h
+ *  @brief On-disk cache of imported and post-processed scenes
+ */
+#ifndef AI_IMPORTCACHE_H_INC
+#define AI_IMPORTCACHE_H_INC
+
+#include <assimp/IOSystem.hpp>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+struct aiScene;
+
+namespace Assimp    {
+
+// ---------------------------------------------------------------------------
+/** Content-addressed cache of import results, see #AI_CONFIG_IMPORT_CACHE_DIRECTORY.
+ *
+ *  Each entry is an .assmap file named after its key, plus a list of the
+ *  other files the importer read (i.e. material libraries or buffers) and
+ *  the hashes of their contents, as well as the files it looked for but
+ *  did not find. An entry is only used if none of these changed and none
+ *  of the missing files has been created since. A text index in the cache directory keeps track of the size and
+ *  the last use of all entries, the least recently used ones are evicted
+ *  once the cache grows beyond its maximum size.
+ *
+ *  Processes may share a cache directory. Entries are replaced atomically,
+ *  but updates of the index are not synchronized - concurrent updates can
+ *  make the cache forget entries, which are then neither used nor evicted.
+ */
+class ImportCache
+{
+public:
+    // -------------------------------------------------------------------
+    /** IO system wrapper which records the files opened for reading and
+     *  the files which were looked for, but did not exist */
+    class RecordingIOSystem : public IOSystem
+    {
+    public:
+        explicit RecordingIOSystem(IOSystem* wrapped)
+            : mWrapped(wrapped)
+        {
+        }
+
+        bool Exists( const char* pFile) const;
+        char getOsSeparator() const {
+            return mWrapped->getOsSeparator();
+        }
+        IOStream* Open( const char* pFile, const char* pMode = "rb");
+        void Close( IOStream* pFile) {
+            mWrapped->Close(pFile);
+        }
+        bool ComparePaths( const char* one, const char* second) const {
+            return mWrapped->ComparePaths(one,second);
+        }
+        bool PushDirectory( const std::string &path ) {
+            return mWrapped->PushDirectory(path);
+        }
+        const std::string &CurrentDirectory() const {
+            return mWrapped->CurrentDirectory();
+        }
+        size_t StackSize() const {
+            return mWrapped->StackSize();
+        }
+        bool PopDirectory() {
+            return mWrapped->PopDirectory();
+        }
+
+        /** Get the paths of all files opened for reading, in order, without duplicates */
+        const std::vector<std::string>& GetFiles() const {
+            return mFiles;
+        }
+
+        /** Get the paths of all files which were not found, in order, without duplicates */
+        const std::vector<std::string>& GetMissingFiles() const {
+            return mMissing;
+        }
+
+    private:
+        void RecordMissing( const char* pFile) const;
+
+        IOSystem* mWrapped;
+        std::vector<std::string> mFiles;
+        mutable std::vector<std::string> mMissing;
+    };
+
+public:
+    // -------------------------------------------------------------------
+    /** @param directory Existing directory to store the entries in
+     *  @param maxSize Maximum total size of all entries, in bytes */
+    ImportCache(const std::string& directory, uint64_t maxSize);
+
+    // -------------------------------------------------------------------
+    /** Look up an entry.
+     *  @param key Key of the import, see Importer::ReadFile()
+     *  @param pFile Path of the imported file
+     *  @param pIOHandler IO system to check the other files of the entry with
+     *  @return A copy of the cached scene, NULL if there is no valid entry */
+    aiScene* Load(uint64_t key, const std::string& pFile, IOSystem* pIOHandler);
+
+    // -------------------------------------------------------------------
+    /** Add or replace an entry and evict old entries if necessary.
+     *  Failures are logged, but not reported otherwise.
+     *  @param key Key of the import
+     *  @param pScene The imported and post-processed scene
+     *  @param pFile Path of the imported file
+     *  @param files All files read by the importer, see RecordingIOSystem
+     *  @param missing All files the importer did not find
+     *  @param pIOHandler IO system to hash the files with */
+    void Store(uint64_t key, const aiScene* pScene, const std::string& pFile,
+        const std::vector<std::string>& files, const std::vector<std::string>& missing,
+        IOSystem* pIOHandler);
+
+    // -------------------------------------------------------------------
+    /** Hash the contents of a file.
+     *  @return false if the file can't be read */
+    static bool HashFile(IOSystem* pIOHandler, const std::string& pFile, uint64_t& hash);
+
+private:
+    struct Entry {
+        uint64_t mKey, mSize, mStamp;
+    };
+
+    std::string GetPath(uint64_t key, const char* extension) const;
+    void ReadIndex(std::vector<Entry>& entries, uint64_t& nextStamp) const;
+    void WriteIndex(const std::vector<Entry>& entries, uint64_t nextStamp) const;
+    void UpdateIndex(uint64_t key, uint64_t size);
+    void Remove(uint64_t key) const;
+
+    std::string mDirectory;
+    uint64_t mMaxSize;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_IMPORTCACHE_H_INC
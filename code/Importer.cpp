@@ -76,10 +76,17 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Profiler.h"
 #include "TinyFormatter.h"
 #include "Exceptional.h"
-#include "Profiler.h"
+#include "ThreadPool.h"
+#include "ImportCache.h"
+#include "Hash.h"
 #include <set>
+#include <algorithm>
 #include <memory>
 #include <cctype>
+#include <typeinfo>
+#ifdef __GNUG__
+#   include <cxxabi.h>
+#endif
 
 #include <assimp/DefaultIOStream.h>
 #include <assimp/DefaultIOSystem.h>
@@ -157,6 +164,10 @@ Importer::Importer()
     pimpl->mIOHandler = new DefaultIOSystem;
     pimpl->mIsDefaultHandler = true;
     pimpl->bExtraVerbose     = false; // disable extra verbose mode by default
+    pimpl->mThreadPool       = NULL;  // run single-threaded by default
+    pimpl->mStatistics       = NULL;
+    pimpl->mProfiler         = NULL;
+    pimpl->mAllocationCounter = NULL;
 
     pimpl->mProgressHandler = new DefaultProgressHandler();
     pimpl->mIsDefaultProgressHandler = true;
@@ -195,6 +206,11 @@ Importer::~Importer()
     // Delete shared post-processing data
     delete pimpl->mPPShared;
 
+    // Stop all worker threads
+    delete pimpl->mThreadPool;
+
+    delete pimpl->mStatistics;
+
     // and finally the pimpl itself
     delete pimpl;
 }
@@ -393,6 +409,10 @@ bool _ValidateFlags(unsigned int pFlags)
         DefaultLogger::get()->error("#aiProcess_OptimizeGraph and #aiProcess_PreTransformVertices are incompatible");
         return false;
     }
+    if (pFlags & aiProcess_GenerateLODs && !(pFlags & aiProcess_JoinIdenticalVertices))    {
+        DefaultLogger::get()->error("#aiProcess_GenerateLODs requires #aiProcess_JoinIdenticalVertices");
+        return false;
+    }
     return true;
 }
 
@@ -404,6 +424,9 @@ void Importer::FreeScene( )
     delete pimpl->mScene;
     pimpl->mScene = NULL;
 
+    delete pimpl->mStatistics;
+    pimpl->mStatistics = NULL;
+
     pimpl->mErrorString = "";
     ASSIMP_END_EXCEPTION_REGION(void);
 }
@@ -423,6 +446,20 @@ void Importer::SetExtraVerbose(bool bDo)
     pimpl->bExtraVerbose = bDo;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Get the profiling tree of the last import
+const ImportStatistics* Importer::GetLastImportStatistics() const
+{
+    return pimpl->mStatistics;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Set the callback to sample allocation counters
+void Importer::SetAllocationCounter(AllocationCounter counter)
+{
+    pimpl->mAllocationCounter = counter;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Get the current scene
 const aiScene* Importer::GetScene() const
@@ -581,6 +618,133 @@ void WriteLogOpening(const std::string& file)
         );
 }
 
+// ------------------------------------------------------------------------------------------------
+// Create, resize or drop the worker threads as requested by AI_CONFIG_GLOB_MULTITHREADING
+static void SetupThreadPool(const Importer* pImp, ImporterPimpl* pimpl)
+{
+    const int config = pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING,0);
+    const unsigned int numThreads = config < 0 ? ThreadPool::GetHardwareConcurrency() : static_cast<unsigned int>(config);
+
+    if (numThreads <= 1) {
+        delete pimpl->mThreadPool;
+        pimpl->mThreadPool = NULL;
+        return;
+    }
+    if (pimpl->mThreadPool && pimpl->mThreadPool->GetNumThreads() == numThreads) {
+        return;
+    }
+    delete pimpl->mThreadPool;
+    pimpl->mThreadPool = new ThreadPool(numThreads);
+    DefaultLogger::get()->info((format(),"Using ",pimpl->mThreadPool->GetNumThreads()," threads"));
+}
+
+// ------------------------------------------------------------------------------------------------
+namespace {
+    // Makes a profiler the active one of an importer for the lifetime of the object,
+    // so importers and post-processing steps can add their regions to it.
+    class ActiveProfiler {
+    public:
+        ActiveProfiler(ImporterPimpl* pimpl, Profiler* profiler)
+            : pimpl(pimpl)
+            , previous(pimpl->mProfiler) {
+            if (profiler) {
+                pimpl->mProfiler = profiler;
+            }
+        }
+
+        ~ActiveProfiler() {
+            pimpl->mProfiler = previous;
+        }
+
+    private:
+        ImporterPimpl* pimpl;
+        Profiler* previous;
+    };
+}
+
+// ------------------------------------------------------------------------------------------------
+// Get the class name of a post-processing step to label its profiling region
+static std::string GetStepName(const BaseProcess* process)
+{
+    std::string name = typeid(*process).name();
+#ifdef __GNUG__
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(name.c_str(), NULL, NULL, &status);
+    if (demangled) {
+        if (0 == status) {
+            name = demangled;
+        }
+        ::free(demangled);
+    }
+#endif
+    // strip namespaces and MSVC's 'class ' prefix
+    const std::string::size_type pos = name.find_last_of(": ");
+    if (pos != std::string::npos) {
+        name = name.substr(pos + 1);
+    }
+    return name;
+}
+
+#ifndef ASSIMP_BUILD_NO_ASSMAP_EXPORTER
+// ------------------------------------------------------------------------------------------------
+// Hash a property map into the key of an import cache entry, skipping the settings which
+// don't affect the imported scene
+template <class T>
+static uint64_t HashPropertyMap(const std::map<ImporterPimpl::KeyType, T>& map, uint64_t hash)
+{
+    static const ImporterPimpl::KeyType ignored[] = {
+        SuperFastHash(AI_CONFIG_IMPORT_CACHE_DIRECTORY),
+        SuperFastHash(AI_CONFIG_IMPORT_CACHE_MAX_SIZE),
+        SuperFastHash(AI_CONFIG_GLOB_MULTITHREADING),
+        SuperFastHash(AI_CONFIG_GLOB_MEASURE_TIME)
+    };
+    for (typename std::map<ImporterPimpl::KeyType, T>::const_iterator it = map.begin(); it != map.end(); ++it) {
+        if (std::find(ignored, ignored + sizeof(ignored) / sizeof(ignored[0]), (*it).first) == ignored + sizeof(ignored) / sizeof(ignored[0])) {
+            hash = MurmurHash64A(&(*it).first, sizeof((*it).first), hash);
+            hash = MurmurHash64A(&(*it).second, sizeof((*it).second), hash);
+        }
+    }
+    return hash;
+}
+
+template <>
+uint64_t HashPropertyMap(const ImporterPimpl::StringPropertyMap& map, uint64_t hash)
+{
+    for (ImporterPimpl::StringPropertyMap::const_iterator it = map.begin(); it != map.end(); ++it) {
+        if ((*it).first != SuperFastHash(AI_CONFIG_IMPORT_CACHE_DIRECTORY)) {
+            hash = MurmurHash64A(&(*it).first, sizeof((*it).first), hash);
+            hash = MurmurHash64A((*it).second.data(), (*it).second.length(), hash);
+        }
+    }
+    return hash;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Compute the key of a file in the import cache. Covers the contents of the file, its extension,
+// which selects the importer, the post processing flags, all settings and the Assimp build.
+static bool GetImportCacheKey(ImporterPimpl* pimpl, const std::string& pFile, unsigned int pFlags, uint64_t& key)
+{
+    if (!ImportCache::HashFile(pimpl->mIOHandler, pFile, key)) {
+        return false;
+    }
+
+    const std::string::size_type pos = pFile.find_last_of("./\\");
+    std::string ext = pos != std::string::npos && pFile[pos] == '.' ? pFile.substr(pos + 1) : std::string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+
+    const unsigned int build[] = {
+        pFlags, aiGetVersionMajor(), aiGetVersionMinor(), aiGetVersionRevision(), aiGetCompileFlags()
+    };
+    key = MurmurHash64A(ext.data(), ext.length(), key);
+    key = MurmurHash64A(build, sizeof(build), key);
+    key = HashPropertyMap(pimpl->mIntProperties, key);
+    key = HashPropertyMap(pimpl->mFloatProperties, key);
+    key = HashPropertyMap(pimpl->mStringProperties, key);
+    key = HashPropertyMap(pimpl->mMatrixProperties, key);
+    return true;
+}
+#endif // ASSIMP_BUILD_NO_ASSMAP_EXPORTER
+
 // ------------------------------------------------------------------------------------------------
 // Reads the given file and returns its contents if successful.
 const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
@@ -607,6 +771,8 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
             DefaultLogger::get()->debug("(Deleting previous scene)");
             FreeScene();
         }
+        delete pimpl->mStatistics;
+        pimpl->mStatistics = NULL;
 
         // First check if the file is accessible at all
         if( !pimpl->mIOHandler->Exists( pFile)) {
@@ -616,10 +782,45 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
             return NULL;
         }
 
-        std::unique_ptr<Profiler> profiler(GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME,0)?new Profiler():NULL);
-        if (profiler) {
-            profiler->BeginRegion("total");
+#ifndef ASSIMP_BUILD_NO_ASSMAP_EXPORTER
+        // Look the file up in the import cache, if enabled. Files in memory are never cached.
+        std::unique_ptr<ImportCache> cache;
+        uint64_t cacheKey = 0;
+        const std::string cacheDir = GetPropertyString(AI_CONFIG_IMPORT_CACHE_DIRECTORY,"");
+        if (!cacheDir.empty() && pFile.compare(0,AI_MEMORYIO_MAGIC_FILENAME_LENGTH,AI_MEMORYIO_MAGIC_FILENAME) != 0) {
+            try {
+                if (GetImportCacheKey(pimpl,pFile,pFlags,cacheKey)) {
+                    const int maxSize = std::max(GetPropertyInteger(AI_CONFIG_IMPORT_CACHE_MAX_SIZE,1024),0);
+                    cache.reset(new ImportCache(cacheDir,static_cast<uint64_t>(maxSize) << 20));
+                    pimpl->mScene = cache->Load(cacheKey,pFile,pimpl->mIOHandler);
+                }
+            }
+            catch (const std::exception& e) {
+                DefaultLogger::get()->warn(std::string("Import cache lookup failed: ") + e.what());
+                delete pimpl->mScene;
+                pimpl->mScene = NULL;
+            }
+            if (pimpl->mScene) {
+                ScenePriv(pimpl->mScene)->mPPStepsApplied = pFlags;
+                DefaultLogger::get()->info("Loaded the scene from the import cache");
+                return pimpl->mScene;
+            }
         }
+        ImportCache::RecordingIOSystem recorder(pimpl->mIOHandler);
+        IOSystem* const ioHandler = cache ? &recorder : pimpl->mIOHandler;
+#else
+        IOSystem* const ioHandler = pimpl->mIOHandler;
+#endif // ASSIMP_BUILD_NO_ASSMAP_EXPORTER
+
+        SetupThreadPool(this,pimpl);
+
+        std::unique_ptr<Profiler> profiler;
+        if (GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME,0)) {
+            pimpl->mStatistics = new ImportStatistics();
+            pimpl->mStatistics->mName = pFile;
+            profiler.reset(new Profiler(*pimpl->mStatistics,pimpl->mAllocationCounter));
+        }
+        ActiveProfiler activeProfiler(pimpl,profiler.get());
 
         // Find an worker class which can handle the file
         BaseImporter* imp = NULL;
@@ -672,9 +873,10 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
 
         if (profiler) {
             profiler->BeginRegion("import");
+            profiler->AddCounter("file_size",fileSize);
         }
 
-        pimpl->mScene = imp->ReadFile( this, pFile, pimpl->mIOHandler);
+        pimpl->mScene = imp->ReadFile( this, pFile, ioHandler);
         pimpl->mProgressHandler->UpdateFileRead( fileSize, fileSize );
 
         if (profiler) {
@@ -688,6 +890,7 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
             // The ValidateDS process is an exception. It is executed first, even before ScenePreprocessor is called.
             if (pFlags & aiProcess_ValidateDataStructure)
             {
+                ProfileRegion region(profiler.get(),"ValidateDSProcess");
                 ValidateDSProcess ds;
                 ds.ExecuteOnScene (this);
                 if (!pimpl->mScene) {
@@ -710,6 +913,18 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
 
             // Ensure that the validation process won't be called twice
             ApplyPostProcessing(pFlags & (~aiProcess_ValidateDataStructure));
+
+#ifndef ASSIMP_BUILD_NO_ASSMAP_EXPORTER
+            // A failing cache must never fail the import
+            if (cache && pimpl->mScene) {
+                try {
+                    cache->Store(cacheKey,pimpl->mScene,pFile,recorder.GetFiles(),recorder.GetMissingFiles(),pimpl->mIOHandler);
+                }
+                catch (const std::exception& e) {
+                    DefaultLogger::get()->warn(std::string("Failed to store the scene in the import cache: ") + e.what());
+                }
+            }
+#endif // ASSIMP_BUILD_NO_ASSMAP_EXPORTER
         }
         // if failed, extract the error string
         else if( !pimpl->mScene) {
@@ -718,10 +933,6 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
 
         // clear any data allocated by post-process steps
         pimpl->mPPShared->Clean();
-
-        if (profiler) {
-            profiler->EndRegion("total");
-        }
     }
 #ifdef ASSIMP_CATCH_GLOBAL_EXCEPTIONS
     catch (std::exception &e)
@@ -789,22 +1000,28 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags)
     }
 #endif // ! DEBUG
 
-    std::unique_ptr<Profiler> profiler(GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME,0)?new Profiler():NULL);
+    SetupThreadPool(this,pimpl);
+
+    // Append to the profiling tree of the current import, or the one of the bound scene
+    std::unique_ptr<Profiler> profiler;
+    if (!pimpl->mProfiler && GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME,0)) {
+        if (!pimpl->mStatistics) {
+            pimpl->mStatistics = new ImportStatistics();
+        }
+        profiler.reset(new Profiler(*pimpl->mStatistics,pimpl->mAllocationCounter));
+    }
+    ActiveProfiler activeProfiler(pimpl,profiler.get());
+    ProfileRegion postProcessRegion(pimpl->mProfiler,"postprocess");
+
     for( unsigned int a = 0; a < pimpl->mPostProcessingSteps.size(); a++)   {
 
         BaseProcess* process = pimpl->mPostProcessingSteps[a];
         pimpl->mProgressHandler->UpdatePostProcess(static_cast<int>(a), static_cast<int>(pimpl->mPostProcessingSteps.size()) );
         if( process->IsActive( pFlags)) {
 
-            if (profiler) {
-                profiler->BeginRegion("postprocess");
-            }
-
+            const std::string name = pimpl->mProfiler ? GetStepName(process) : std::string();
+            ProfileRegion stepRegion(pimpl->mProfiler,name.c_str());
             process->ExecuteOnScene ( this );
-
-            if (profiler) {
-                profiler->EndRegion("postprocess");
-            }
         }
         if( !pimpl->mScene) {
             break;
@@ -884,16 +1101,20 @@ const aiScene* Importer::ApplyCustomizedPostProcessing( BaseProcess *rootProcess
     }
 #endif // ! DEBUG
 
-    std::unique_ptr<Profiler> profiler( GetPropertyInteger( AI_CONFIG_GLOB_MEASURE_TIME, 0 ) ? new Profiler() : NULL );
+    SetupThreadPool( this, pimpl );
 
-    if ( profiler ) {
-        profiler->BeginRegion( "postprocess" );
+    std::unique_ptr<Profiler> profiler;
+    if ( !pimpl->mProfiler && GetPropertyInteger( AI_CONFIG_GLOB_MEASURE_TIME, 0 ) ) {
+        if ( !pimpl->mStatistics ) {
+            pimpl->mStatistics = new ImportStatistics();
+        }
+        profiler.reset( new Profiler( *pimpl->mStatistics, pimpl->mAllocationCounter ) );
     }
+    ActiveProfiler activeProfiler( pimpl, profiler.get() );
 
-    rootProcess->ExecuteOnScene( this );
-
-    if ( profiler ) {
-        profiler->EndRegion( "postprocess" );
+    {
+        ProfileRegion region( pimpl->mProfiler, "postprocess" );
+        rootProcess->ExecuteOnScene( this );
     }
 
     // If the extra verbose mode is active, execute the ValidateDataStructureStep again - after each step
@@ -1146,6 +1367,11 @@ void Importer::GetMemoryRequirements(aiMemoryInfo& in) const
                 in.meshes += mScene->mMeshes[i]->mBones[p]->mNumWeights * sizeof(aiVertexWeight);
             }
         }
+        if (mScene->mMeshes[i]->HasMeshlets()) {
+            in.meshes += sizeof(aiMeshlet) * mScene->mMeshes[i]->mNumMeshlets;
+            in.meshes += sizeof(unsigned int) * mScene->mMeshes[i]->mNumMeshletVertices;
+            in.meshes += mScene->mMeshes[i]->mNumMeshletIndices;
+        }
         in.meshes += (sizeof(aiFace) + 3 * sizeof(unsigned int))*mScene->mMeshes[i]->mNumFaces;
     }
     in.total += in.meshes;
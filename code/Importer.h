@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <vector>
 #include <string>
 #include <assimp/matrix4x4.h>
+#include <assimp/Importer.hpp>
 
 struct aiScene;
 
@@ -57,6 +58,12 @@ namespace Assimp    {
     class BaseImporter;
     class BaseProcess;
     class SharedPostProcessInfo;
+    class ThreadPool;
+    struct ImportStatistics;
+
+    namespace Profiling {
+        class Profiler;
+    }
 
 
 //! @cond never
@@ -121,6 +128,21 @@ public:
 
     /** Used by post-process steps to share data */
     SharedPostProcessInfo* mPPShared;
+
+    /** Worker threads for parallel processing, NULL unless
+     *  #AI_CONFIG_GLOB_MULTITHREADING requests more than one thread */
+    ThreadPool* mThreadPool;
+
+    /** Profiling tree of the last import, NULL unless
+     *  #AI_CONFIG_GLOB_MEASURE_TIME is set */
+    ImportStatistics* mStatistics;
+
+    /** Profiler collecting into mStatistics while the importer
+     *  is working, NULL otherwise */
+    Profiling::Profiler* mProfiler;
+
+    /** Application callback to sample allocation counters, may be NULL */
+    AllocationCounter mAllocationCounter;
 };
 //! @endcond
 
@@ -180,6 +180,9 @@ corresponding preprocessor flag to selectively disable formats.
 #ifndef ASSIMP_BUILD_NO_ASSBIN_IMPORTER
 #   include "AssbinLoader.h"
 #endif
+#ifndef ASSIMP_BUILD_NO_ASSMAP_IMPORTER
+#   include "AssmapLoader.h"
+#endif
 #ifndef ASSIMP_BUILD_NO_GLTF_IMPORTER
 #   include "glTFImporter.h"
 #   include "glTF2Importer.h"
@@ -335,6 +338,9 @@ void GetImporterInstanceList(std::vector< BaseImporter* >& out)
 #if ( !defined ASSIMP_BUILD_NO_ASSBIN_IMPORTER )
     out.push_back( new AssbinImporter() );
 #endif
+#if ( !defined ASSIMP_BUILD_NO_ASSMAP_IMPORTER )
+    out.push_back( new AssmapImporter() );
+#endif
 #if ( !defined ASSIMP_BUILD_NO_GLTF_IMPORTER )
     out.push_back( new glTFImporter() );
     out.push_back( new glTF2Importer() );
@@ -44,7 +44,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * <br>
  * The algorithm is roughly basing on this paper:
  * http://www.cs.princeton.edu/gfx/pubs/Sander_2007_%3ETR/tipsy.pdf
- *   .. although overdraw rduction isn't implemented yet ...
+ * Alternatively, the triangles are ordered for an LRU cache model as described in
+ * https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html
+ * Both can be followed by a pass to reduce overdraw and by reordering the vertices
+ * for fetch locality.
  */
 
 
@@ -56,15 +59,24 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
+#include "Profiler.h"
 #include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <algorithm>
+#include <cmath>
 #include <stack>
 
 using namespace Assimp;
 
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
-ImproveCacheLocalityProcess::ImproveCacheLocalityProcess() {
-    configCacheDepth = PP_ICL_PTCACHE_SIZE;
+ImproveCacheLocalityProcess::ImproveCacheLocalityProcess()
+: configCacheDepth( PP_ICL_PTCACHE_SIZE )
+, configAlgorithm( AI_ICL_ALGORITHM_TIPSIFY )
+, configOverdrawThreshold( 0.f )
+, configReorderVertices( false ) {
+    // empty
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -87,6 +99,10 @@ void ImproveCacheLocalityProcess::SetupProperties(const Importer* pImp)
 {
     // AI_CONFIG_PP_ICL_PTCACHE_SIZE controls the target cache size for the optimizer
     configCacheDepth = pImp->GetPropertyInteger(AI_CONFIG_PP_ICL_PTCACHE_SIZE,PP_ICL_PTCACHE_SIZE);
+
+    configAlgorithm = pImp->GetPropertyInteger(AI_CONFIG_PP_ICL_ALGORITHM,AI_ICL_ALGORITHM_TIPSIFY);
+    configOverdrawThreshold = pImp->GetPropertyFloat(AI_CONFIG_PP_ICL_OVERDRAW_THRESHOLD,0.f);
+    configReorderVertices = pImp->GetPropertyBool(AI_CONFIG_PP_ICL_REORDER_VERTICES,false);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -100,16 +116,34 @@ void ImproveCacheLocalityProcess::Execute( aiScene* pScene)
 
     DefaultLogger::get()->debug("ImproveCacheLocalityProcess begin");
 
-    float out = 0.f;
+    std::vector<float> results( pScene->mNumMeshes, 0.f);
+    std::vector<MeshStatistics> stats( pScene->mNumMeshes);
+    ExecutePerMesh( pScene, [&]( unsigned int a) {
+        results[a] = ProcessMesh( pScene->mMeshes[a],a,&stats[a]);
+    });
+
+    float out = 0.f, fetch = 0.f;
     unsigned int numf = 0, numm = 0;
     for( unsigned int a = 0; a < pScene->mNumMeshes; a++){
-        const float res = ProcessMesh( pScene->mMeshes[a],a);
+        const float res = results[a];
         if (res) {
             numf += pScene->mMeshes[a]->mNumFaces;
             out  += res;
+            fetch += stats[a].fetchRatioOut * pScene->mMeshes[a]->mNumFaces;
             ++numm;
+
+            if (profiler) {
+                profiler->AddMeshCounter( a, "acmr_in", stats[a].acmrIn);
+                profiler->AddMeshCounter( a, "acmr_out", res / pScene->mMeshes[a]->mNumFaces);
+                profiler->AddMeshCounter( a, "atvr_out", stats[a].atvrOut);
+                profiler->AddMeshCounter( a, "fetch_ratio_out", stats[a].fetchRatioOut);
+            }
         }
     }
+    if (profiler && numf) {
+        profiler->AddCounter( "acmr_out", out / numf);
+        profiler->AddCounter( "fetch_ratio_out", fetch / numf);
+    }
     if (!DefaultLogger::isNullLogger()) {
         char szBuff[128]; // should be sufficiently large in every case
         ai_snprintf(szBuff,128,"Cache relevant are %u meshes (%u faces). Average output ACMR is %f",
@@ -120,11 +154,173 @@ void ImproveCacheLocalityProcess::Execute( aiScene* pScene)
     }
 }
 
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Size of the cache lines and number of lines of the cache used to estimate vertex fetch costs.
+const unsigned int FetchCacheLineSize = 64;
+const unsigned int FetchCacheLines = 64;
+
+// Largest cache the LRU ordering models, the score tables are sized for it.
+const unsigned int MaxLRUCacheSize = 64;
+
+// Scores of a vertex with this many remaining triangles are precomputed.
+const unsigned int MaxValenceScore = 32;
+
+// ------------------------------------------------------------------------------------------------
+// Counts the cache misses of an index buffer for a FIFO post-transform cache of the given size.
+// A vertex is in the cache if less than cacheDepth misses occurred since it was loaded.
+unsigned int CountCacheMisses( const unsigned int* indices, size_t numIndices,
+    unsigned int numVertices, unsigned int cacheDepth)
+{
+    std::vector<unsigned int> stamps( numVertices, 0);
+    unsigned int stamp = cacheDepth + 1, misses = 0;
+    for (size_t i = 0; i < numIndices; ++i) {
+        const unsigned int dp = indices[i];
+        if (stamp - stamps[dp] > cacheDepth) {
+            stamps[dp] = stamp++;
+            ++misses;
+        }
+    }
+    return misses;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Number of bytes a vertex occupies if all of its components are stored interleaved.
+unsigned int GetVertexSize( const aiMesh* pMesh)
+{
+    unsigned int size = sizeof(aiVector3D);
+    if (pMesh->HasNormals()) {
+        size += sizeof(aiVector3D);
+    }
+    if (pMesh->HasTangentsAndBitangents()) {
+        size += 2 * sizeof(aiVector3D);
+    }
+    for (unsigned int a = 0; pMesh->HasTextureCoords(a); ++a) {
+        size += pMesh->mNumUVComponents[a] * sizeof(ai_real);
+    }
+    for (unsigned int a = 0; pMesh->HasVertexColors(a); ++a) {
+        size += sizeof(aiColor4D);
+    }
+    return size;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Ratio of the bytes fetched from memory to the size of the vertex buffer, estimated with a
+// small FIFO cache of cache lines. 1.0 means every vertex is fetched exactly once.
+float ComputeFetchRatio( const unsigned int* indices, size_t numIndices,
+    unsigned int numVertices, unsigned int vertexSize)
+{
+    const size_t bufferSize = size_t( numVertices) * vertexSize;
+    std::vector<unsigned int> stamps( (bufferSize + FetchCacheLineSize - 1) / FetchCacheLineSize, 0);
+    unsigned int stamp = FetchCacheLines + 1;
+    size_t fetched = 0;
+    for (size_t i = 0; i < numIndices; ++i) {
+        const size_t first = size_t( indices[i]) * vertexSize / FetchCacheLineSize;
+        const size_t last = (size_t( indices[i]) * vertexSize + vertexSize - 1) / FetchCacheLineSize;
+        for (size_t line = first; line <= last; ++line) {
+            if (stamp - stamps[line] > FetchCacheLines) {
+                stamps[line] = stamp++;
+                fetched += FetchCacheLineSize;
+            }
+        }
+    }
+    return bufferSize ? (float)fetched / bufferSize : 0.f;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Replaces a vertex component array by its entries in the given order.
+template <typename T>
+void ReorderArray( T*& data, const std::vector<unsigned int>& order)
+{
+    if (!data) {
+        return;
+    }
+    T* out = new T[ order.size()];
+    for (size_t a = 0; a < order.size(); ++a) {
+        out[a] = data[ order[a]];
+    }
+    delete[] data;
+    data = out;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Sorts the vertices of a mesh by the order in which the faces use them first, so that the
+// vertex fetches of a renderer walk through memory mostly linearly. Unreferenced vertices are
+// moved to the end.
+void ReorderVerticesByFirstUse( aiMesh* pMesh)
+{
+    std::vector<unsigned int> remap( pMesh->mNumVertices, UINT_MAX);
+    std::vector<unsigned int> order;
+    order.reserve( pMesh->mNumVertices);
+    for (unsigned int a = 0; a < pMesh->mNumFaces; ++a) {
+        const aiFace& face = pMesh->mFaces[a];
+        for (unsigned int b = 0; b < face.mNumIndices; ++b) {
+            unsigned int& dst = remap[ face.mIndices[b]];
+            if (dst == UINT_MAX) {
+                dst = (unsigned int)order.size();
+                order.push_back( face.mIndices[b]);
+            }
+        }
+    }
+    for (unsigned int a = 0; a < pMesh->mNumVertices; ++a) {
+        if (remap[a] == UINT_MAX) {
+            remap[a] = (unsigned int)order.size();
+            order.push_back(a);
+        }
+    }
+
+    // vertex components
+    ReorderArray( pMesh->mVertices, order);
+    ReorderArray( pMesh->mNormals, order);
+    ReorderArray( pMesh->mTangents, order);
+    ReorderArray( pMesh->mBitangents, order);
+    for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS; ++a) {
+        ReorderArray( pMesh->mColors[a], order);
+    }
+    for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++a) {
+        ReorderArray( pMesh->mTextureCoords[a], order);
+    }
+
+    // morph targets share the vertex layout of the mesh
+    for (unsigned int a = 0; a < pMesh->mNumAnimMeshes; ++a) {
+        aiAnimMesh* anim = pMesh->mAnimMeshes[a];
+        if (anim->mNumVertices != pMesh->mNumVertices) {
+            continue;
+        }
+        ReorderArray( anim->mVertices, order);
+        ReorderArray( anim->mNormals, order);
+        ReorderArray( anim->mTangents, order);
+        ReorderArray( anim->mBitangents, order);
+        for (unsigned int b = 0; b < AI_MAX_NUMBER_OF_COLOR_SETS; ++b) {
+            ReorderArray( anim->mColors[b], order);
+        }
+        for (unsigned int b = 0; b < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++b) {
+            ReorderArray( anim->mTextureCoords[b], order);
+        }
+    }
+
+    // indices and bone weights
+    for (unsigned int a = 0; a < pMesh->mNumFaces; ++a) {
+        aiFace& face = pMesh->mFaces[a];
+        for (unsigned int b = 0; b < face.mNumIndices; ++b) {
+            face.mIndices[b] = remap[ face.mIndices[b]];
+        }
+    }
+    for (unsigned int a = 0; a < pMesh->mNumBones; ++a) {
+        aiBone* bone = pMesh->mBones[a];
+        for (unsigned int b = 0; b < bone->mNumWeights; ++b) {
+            bone->mWeights[b].mVertexId = remap[ bone->mWeights[b].mVertexId];
+        }
+    }
+}
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 // Improves the cache coherency of a specific mesh
-float ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshNum)
+float ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshNum, MeshStatistics* pStats)
 {
-    // TODO: rewrite this to use std::vector or boost::shared_array
     ai_assert(NULL != pMesh);
 
     // Check whether the input data is valid
@@ -142,42 +338,21 @@ float ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int mesh
         return 0.f;
     }
 
-    float fACMR = 3.f;
-    const aiFace* const pcEnd = pMesh->mFaces+pMesh->mNumFaces;
-
-    // Input ACMR is for logging purposes only
-    if (!DefaultLogger::isNullLogger())     {
-
-        unsigned int* piFIFOStack = new unsigned int[configCacheDepth];
-        memset(piFIFOStack,0xff,configCacheDepth*sizeof(unsigned int));
-        unsigned int* piCur = piFIFOStack;
-        const unsigned int* const piCurEnd = piFIFOStack + configCacheDepth;
-
-        // count the number of cache misses
-        unsigned int iCacheMisses = 0;
-        for (const aiFace* pcFace = pMesh->mFaces;pcFace != pcEnd;++pcFace) {
-
-            for (unsigned int qq = 0; qq < 3;++qq) {
-                bool bInCache = false;
+    // the input faces as one large index buffer
+    const unsigned int iIdxCnt = pMesh->mNumFaces*3;
+    std::vector<unsigned int> indices(iIdxCnt);
+    for (unsigned int a = 0; a < pMesh->mNumFaces; ++a) {
+        ::memcpy(&indices[a*3],pMesh->mFaces[a].mIndices,3*sizeof(unsigned int));
+    }
 
-                for (unsigned int* pp = piFIFOStack;pp < piCurEnd;++pp) {
-                    if (*pp == pcFace->mIndices[qq])    {
-                        // the vertex is in cache
-                        bInCache = true;
-                        break;
-                    }
-                }
-                if (!bInCache)  {
-                    ++iCacheMisses;
-                    if (piCurEnd == piCur) {
-                        piCur = piFIFOStack;
-                    }
-                    *piCur++ = pcFace->mIndices[qq];
-                }
-            }
+    // Input ACMR is for logging and profiling purposes only
+    float fACMR = 3.f;
+    const bool computeACMR = !DefaultLogger::isNullLogger() || profiler;
+    if (computeACMR)     {
+        fACMR = (float)CountCacheMisses(&indices[0],iIdxCnt,pMesh->mNumVertices,configCacheDepth) / pMesh->mNumFaces;
+        if (pStats) {
+            pStats->acmrIn = fACMR;
         }
-        delete[] piFIFOStack;
-        fACMR = (float)iCacheMisses / pMesh->mNumFaces;
         if (3.0 == fACMR)   {
             char szBuff[128]; // should be sufficiently large in every case
 
@@ -190,19 +365,69 @@ float ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int mesh
         }
     }
 
+    // reorder the triangles for the post-transform cache, then for overdraw
+    if (configAlgorithm == AI_ICL_ALGORITHM_LRU) {
+        OptimizeLRU(pMesh,indices);
+    } else {
+        OptimizeTipsify(pMesh,indices);
+    }
+    if (configOverdrawThreshold > 0.f) {
+        OptimizeOverdraw(pMesh,indices);
+    }
+
+    // sort the output index buffer back to the input array
+    for (unsigned int a = 0; a < pMesh->mNumFaces; ++a) {
+        ::memcpy(pMesh->mFaces[a].mIndices,&indices[a*3],3*sizeof(unsigned int));
+    }
+
+    // finally make the vertex fetches follow the triangle order
+    if (configReorderVertices) {
+        ReorderVerticesByFirstUse(pMesh);
+    }
+
+    float fACMR2 = 0.0f;
+    if (computeACMR) {
+        if (configReorderVertices) {
+            for (unsigned int a = 0; a < pMesh->mNumFaces; ++a) {
+                ::memcpy(&indices[a*3],pMesh->mFaces[a].mIndices,3*sizeof(unsigned int));
+            }
+        }
+        const unsigned int iCacheMisses = CountCacheMisses(&indices[0],iIdxCnt,pMesh->mNumVertices,configCacheDepth);
+        fACMR2 = (float)iCacheMisses / pMesh->mNumFaces;
+        const float fATVR = (float)iCacheMisses / pMesh->mNumVertices;
+        const float fFetch = ComputeFetchRatio(&indices[0],iIdxCnt,pMesh->mNumVertices,GetVertexSize(pMesh));
+        if (pStats) {
+            pStats->atvrOut = fATVR;
+            pStats->fetchRatioOut = fFetch;
+        }
+
+        // very intense verbose logging ... prepare for much text if there are many meshes
+        if ( DefaultLogger::get()->getLogSeverity() == Logger::VERBOSE) {
+            char szBuff[192]; // should be sufficiently large in every case
+
+            ai_snprintf(szBuff,192,"Mesh %u | ACMR in: %f out: %f | ~%.1f%% | ATVR out: %f | fetch ratio out: %f",
+                meshNum,fACMR,fACMR2,((fACMR - fACMR2) / fACMR) * 100.f,fATVR,fFetch);
+            DefaultLogger::get()->debug(szBuff);
+        }
+
+        fACMR2 *= pMesh->mNumFaces;
+    }
+    return fACMR2;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Reorders the triangles to fans of adjacent triangles, see the paper referenced above
+void ImproveCacheLocalityProcess::OptimizeTipsify( aiMesh* pMesh, std::vector<unsigned int>& indices) const
+{
     // first we need to build a vertex-triangle adjacency list
     VertexTriangleAdjacency adj(pMesh->mFaces,pMesh->mNumFaces, pMesh->mNumVertices,true);
 
     // build a list to store per-vertex caching time stamps
-    unsigned int* const piCachingStamps = new unsigned int[pMesh->mNumVertices];
-    memset(piCachingStamps,0x0,pMesh->mNumVertices*sizeof(unsigned int));
+    std::vector<unsigned int> piCachingStamps(pMesh->mNumVertices,0);
 
-    // allocate an empty output index buffer. We store the output indices in one large array.
-    // Since the number of triangles won't change the input faces can be reused. This is how
-    // we save thousands of redundant mini allocations for aiFace::mIndices
-    const unsigned int iIdxCnt = pMesh->mNumFaces*3;
-    unsigned int* const piIBOutput = new unsigned int[iIdxCnt];
-    unsigned int* piCSIter = piIBOutput;
+    // the output index buffer replaces the input one. Since the number of triangles
+    // won't change, it has the same size.
+    unsigned int* piCSIter = &indices[0];
 
     // allocate the flag array to hold the information
     // whether a face has already been emitted or not
@@ -223,9 +448,7 @@ float ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int mesh
             iMaxRefTris = std::max(iMaxRefTris,*piCur);
         }
     }
-    unsigned int* piCandidates = new unsigned int[iMaxRefTris*3];
-    unsigned int iCacheMisses = 0;
-
+    std::vector<unsigned int> piCandidates(iMaxRefTris*3+1);
     // ...................................................................................
     /** PSEUDOCODE for the algorithm
 
@@ -263,7 +486,7 @@ float ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int mesh
 
         unsigned int icnt = piNumTriPtrNoModify[ivdx];
         unsigned int* piList = adj.GetAdjacentTriangles(ivdx);
-        unsigned int* piCurCandidate = piCandidates;
+        unsigned int* piCurCandidate = &piCandidates[0];
 
         // get all triangles in the neighborhood
         for (unsigned int tri = 0; tri < icnt;++tri)    {
@@ -295,7 +518,6 @@ float ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int mesh
                     // if the vertex is not yet in cache, set its cache count
                     if (iStampCnt-piCachingStamps[dp] > configCacheDepth) {
                         piCachingStamps[dp] = iStampCnt++;
-                        ++iCacheMisses;
                     }
                 }
                 // flag triangle as emitted
@@ -309,7 +531,7 @@ float ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int mesh
         // get next fanning vertex
         ivdx = -1;
         int max_priority = -1;
-        for (unsigned int* piCur = piCandidates;piCur != piCurCandidate;++piCur)    {
+        for (unsigned int* piCur = &piCandidates[0];piCur != piCurCandidate;++piCur)    {
             const unsigned int dp = *piCur;
 
             // must have live triangles
@@ -355,33 +577,233 @@ float ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int mesh
             }
         }
     }
-    float fACMR2 = 0.0f;
-    if (!DefaultLogger::isNullLogger()) {
-        fACMR2 = (float)iCacheMisses / pMesh->mNumFaces;
+}
 
-        // very intense verbose logging ... prepare for much text if there are many meshes
-        if ( DefaultLogger::get()->getLogSeverity() == Logger::VERBOSE) {
-            char szBuff[128]; // should be sufficiently large in every case
+// ------------------------------------------------------------------------------------------------
+// Reorders the triangles greedily by the score of their vertices in a modeled LRU cache
+// (T. Forsyth, "Linear-Speed Vertex Cache Optimisation"). Vertices score high if they are
+// recently used and if only few triangles still use them, so that they can leave the cache.
+void ImproveCacheLocalityProcess::OptimizeLRU( aiMesh* pMesh, std::vector<unsigned int>& indices) const
+{
+    const unsigned int numFaces = pMesh->mNumFaces;
+    const unsigned int cacheSize = std::min(std::max(configCacheDepth,4u),MaxLRUCacheSize);
+
+    // score tables for cache positions and remaining triangle counts
+    float positionScores[MaxLRUCacheSize];
+    for (unsigned int i = 0; i < cacheSize; ++i) {
+        // the vertices of the last triangle are scored lower so that the next one
+        // does not just reuse the same edge
+        positionScores[i] = i < 3 ? 0.75f : std::pow(1.f - float(i - 3) / (cacheSize - 3), 1.5f);
+    }
+    float valenceScores[MaxValenceScore];
+    for (unsigned int i = 1; i < MaxValenceScore; ++i) {
+        valenceScores[i] = 2.f / std::sqrt(float(i));
+    }
+    valenceScores[0] = 0.f;
 
-            ai_snprintf(szBuff,128,"Mesh %u | ACMR in: %f out: %f | ~%.1f%%",meshNum,fACMR,fACMR2,
-                ((fACMR - fACMR2) / fACMR) * 100.f);
-            DefaultLogger::get()->debug(szBuff);
+    // vertices without remaining triangles never affect the order again
+    auto vertexScore = [&](int cachePos, unsigned int numLive) -> float {
+        if (!numLive) {
+            return -1.f;
         }
+        const float score = numLive < MaxValenceScore ? valenceScores[numLive] : 2.f / std::sqrt(float(numLive));
+        return cachePos >= 0 ? score + positionScores[cachePos] : score;
+    };
 
-        fACMR2 *= pMesh->mNumFaces;
+    VertexTriangleAdjacency adj(pMesh->mFaces,numFaces,pMesh->mNumVertices,true);
+    unsigned int* const piNumTriPtr = adj.mLiveTriangles;
+    const std::vector<unsigned int> piNumTriPtrNoModify(piNumTriPtr, piNumTriPtr + pMesh->mNumVertices);
+
+    std::vector<int> cachePos(pMesh->mNumVertices,-1);
+    std::vector<float> vertexScores(pMesh->mNumVertices);
+    for (unsigned int v = 0; v < pMesh->mNumVertices; ++v) {
+        vertexScores[v] = vertexScore(-1,piNumTriPtr[v]);
     }
-    // sort the output index buffer back to the input array
-    piCSIter = piIBOutput;
-    for (aiFace* pcFace = pMesh->mFaces; pcFace != pcEnd;++pcFace)  {
-        pcFace->mIndices[0] = *piCSIter++;
-        pcFace->mIndices[1] = *piCSIter++;
-        pcFace->mIndices[2] = *piCSIter++;
+    std::vector<float> faceScores(numFaces);
+    for (unsigned int f = 0; f < numFaces; ++f) {
+        const unsigned int* idx = pMesh->mFaces[f].mIndices;
+        faceScores[f] = vertexScores[idx[0]] + vertexScores[idx[1]] + vertexScores[idx[2]];
     }
 
-    // delete temporary storage
-    delete[] piCachingStamps;
-    delete[] piIBOutput;
-    delete[] piCandidates;
+    std::vector<bool> abEmitted(numFaces,false);
+    std::vector<unsigned int> cache, newCache;
+    cache.reserve(cacheSize+3);
+    newCache.reserve(cacheSize+3);
 
-    return fACMR2;
+    unsigned int* piCSIter = &indices[0];
+    unsigned int cursor = 0;
+    int best = -1;
+    for (unsigned int emitted = 0; emitted < numFaces; ++emitted) {
+
+        // nothing in the cache has live triangles left, continue with the first face not yet emitted
+        if (best < 0) {
+            while (abEmitted[cursor]) {
+                ++cursor;
+            }
+            best = cursor;
+        }
+
+        // emit the triangle and put its vertices in front of the cache
+        const unsigned int* idx = pMesh->mFaces[best].mIndices;
+        abEmitted[best] = true;
+        newCache.clear();
+        for (unsigned int i = 0; i < 3; ++i) {
+            *piCSIter++ = idx[i];
+            piNumTriPtr[idx[i]]--;
+            if (std::find(newCache.begin(),newCache.end(),idx[i]) == newCache.end()) {
+                newCache.push_back(idx[i]);
+            }
+        }
+        for (size_t i = 0; i < cache.size(); ++i) {
+            if (cache[i] != idx[0] && cache[i] != idx[1] && cache[i] != idx[2]) {
+                newCache.push_back(cache[i]);
+            }
+        }
+
+        // update the scores of all vertices which moved, including those falling out of the cache
+        for (size_t i = 0; i < newCache.size(); ++i) {
+            const unsigned int v = newCache[i];
+            cachePos[v] = i < cacheSize ? (int)i : -1;
+            vertexScores[v] = vertexScore(cachePos[v],piNumTriPtr[v]);
+        }
+
+        // rescore their remaining triangles and pick the best one
+        best = -1;
+        float bestScore = -1.f;
+        for (size_t i = 0; i < newCache.size(); ++i) {
+            const unsigned int v = newCache[i];
+            const unsigned int* piList = adj.GetAdjacentTriangles(v);
+            for (unsigned int tri = 0; tri < piNumTriPtrNoModify[v]; ++tri) {
+                const unsigned int fidx = piList[tri];
+                if (abEmitted[fidx]) {
+                    continue;
+                }
+                const unsigned int* fi = pMesh->mFaces[fidx].mIndices;
+                faceScores[fidx] = vertexScores[fi[0]] + vertexScores[fi[1]] + vertexScores[fi[2]];
+                if (faceScores[fidx] > bestScore) {
+                    bestScore = faceScores[fidx];
+                    best = (int)fidx;
+                }
+            }
+        }
+
+        if (newCache.size() > cacheSize) {
+            newCache.resize(cacheSize);
+        }
+        cache.swap(newCache);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Splits the cache optimized triangle order into clusters and sorts them so that triangles
+// which are likely to occlude others are drawn first. Clusters start wherever the cache
+// optimizer had to restart anyway, and additionally wherever the ACMR of the clusters stays
+// within configOverdrawThreshold times the one of the unsplit order.
+void ImproveCacheLocalityProcess::OptimizeOverdraw( const aiMesh* pMesh, std::vector<unsigned int>& indices) const
+{
+    const size_t numFaces = indices.size() / 3;
+    const float threshold = std::max(configOverdrawThreshold,1.f);
+
+    // per-triangle cache misses of the current order
+    std::vector<unsigned int> stamps(pMesh->mNumVertices,0);
+    unsigned int stamp = configCacheDepth + 1;
+    auto countMisses = [&](size_t f) -> unsigned int {
+        unsigned int misses = 0;
+        for (size_t i = f*3; i < f*3+3; ++i) {
+            if (stamp - stamps[indices[i]] > configCacheDepth) {
+                stamps[indices[i]] = stamp++;
+                ++misses;
+            }
+        }
+        return misses;
+    };
+    auto resetCache = [&]() {
+        stamp += configCacheDepth + 1;
+    };
+
+    // hard boundaries: triangles which miss the cache with all of their vertices
+    std::vector<unsigned int> faceMisses(numFaces);
+    std::vector<size_t> hardClusters;
+    for (size_t f = 0; f < numFaces; ++f) {
+        faceMisses[f] = countMisses(f);
+        if (!f || faceMisses[f] == 3) {
+            hardClusters.push_back(f);
+        }
+    }
+    hardClusters.push_back(numFaces);
+
+    // soft boundaries: split further as long as the ACMR does not get much worse
+    std::vector<size_t> clusters;
+    for (size_t c = 0; c + 1 < hardClusters.size(); ++c) {
+        const size_t start = hardClusters[c], end = hardClusters[c+1];
+        unsigned int hardMisses = 0;
+        for (size_t f = start; f < end; ++f) {
+            hardMisses += faceMisses[f];
+        }
+        const float limit = threshold * hardMisses / (end - start);
+
+        resetCache();
+        clusters.push_back(start);
+        size_t clusterStart = start;
+        unsigned int misses = 0;
+        for (size_t f = start; f + 1 < end; ++f) {
+            misses += countMisses(f);
+            if ((float)misses / (f + 1 - clusterStart) <= limit) {
+                clusters.push_back(f + 1);
+                clusterStart = f + 1;
+                misses = 0;
+                resetCache();
+            }
+        }
+    }
+    clusters.push_back(numFaces);
+
+    // centroid and mean normal of each cluster, weighted by area
+    const size_t numClusters = clusters.size() - 1;
+    std::vector<aiVector3D> centroids(numClusters), normals(numClusters);
+    aiVector3D meshCentroid;
+    ai_real meshArea = 0;
+    for (size_t c = 0; c < numClusters; ++c) {
+        ai_real area = 0;
+        for (size_t f = clusters[c]; f < clusters[c+1]; ++f) {
+            const aiVector3D& v0 = pMesh->mVertices[indices[f*3]];
+            const aiVector3D& v1 = pMesh->mVertices[indices[f*3+1]];
+            const aiVector3D& v2 = pMesh->mVertices[indices[f*3+2]];
+            const aiVector3D n = (v1 - v0) ^ (v2 - v0);
+            const ai_real a = n.Length();
+            centroids[c] += (v0 + v1 + v2) * (a / 3);
+            normals[c] += n;
+            area += a;
+        }
+        meshCentroid += centroids[c];
+        meshArea += area;
+        if (area > 0) {
+            centroids[c] /= area;
+        }
+        const ai_real len = normals[c].Length();
+        if (len > 0) {
+            normals[c] /= len;
+        }
+    }
+    if (meshArea > 0) {
+        meshCentroid /= meshArea;
+    }
+
+    // clusters facing away from the center are in front of those facing towards it
+    std::vector<float> sortKeys(numClusters);
+    std::vector<unsigned int> order(numClusters);
+    for (size_t c = 0; c < numClusters; ++c) {
+        sortKeys[c] = (centroids[c] - meshCentroid) * normals[c];
+        order[c] = (unsigned int)c;
+    }
+    std::stable_sort(order.begin(),order.end(),[&](unsigned int a, unsigned int b) {
+        return sortKeys[a] > sortKeys[b];
+    });
+
+    std::vector<unsigned int> out;
+    out.reserve(indices.size());
+    for (size_t c = 0; c < numClusters; ++c) {
+        out.insert(out.end(),indices.begin() + clusters[order[c]]*3,indices.begin() + clusters[order[c]+1]*3);
+    }
+    indices.swap(out);
 }
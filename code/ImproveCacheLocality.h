@@ -46,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "BaseProcess.h"
 #include <assimp/types.h>
+#include <vector>
 
 struct aiMesh;
 
@@ -57,9 +58,12 @@ namespace Assimp
  *  cache locality. It tries to arrange all faces to fans and to render
  *  faces which share vertices directly one after the other.
  *
+ *  Optionally, the triangle order is refined to reduce overdraw and the
+ *  vertices are reordered by their first use for better fetch locality.
+ *
  *  @note This step expects triagulated input data.
  */
-class ImproveCacheLocalityProcess : public BaseProcess
+class ASSIMP_API ImproveCacheLocalityProcess : public BaseProcess
 {
 public:
 
@@ -81,17 +85,54 @@ public:
     void SetupProperties(const Importer* pImp);
 
 protected:
+    //! Cache statistics of a mesh, filled in if statistics are enabled
+    struct MeshStatistics {
+        //! Average cache miss ratio (misses per triangle) of the input
+        float acmrIn;
+        //! Average transformed vertex ratio (misses per vertex) of the output
+        float atvrOut;
+        //! Bytes fetched from the vertex buffer per byte of its size
+        float fetchRatioOut;
+
+        MeshStatistics() : acmrIn(0.f), atvrOut(0.f), fetchRatioOut(0.f) {}
+    };
+
     // -------------------------------------------------------------------
     /** Executes the postprocessing step on the given mesh
      * @param pMesh The mesh to process.
      * @param meshNum Index of the mesh to process
+     * @param pStats Receives the cache statistics if they have been computed
+     * @return Output ACMR multiplied by the number of faces, 0 if the
+     *   mesh has not been processed or statistics are disabled
      */
-    float ProcessMesh( aiMesh* pMesh, unsigned int meshNum);
+    float ProcessMesh( aiMesh* pMesh, unsigned int meshNum, MeshStatistics* pStats = NULL);
+
+    // -------------------------------------------------------------------
+    /** Triangle orderings, they replace the index buffer of the mesh
+     *  (given in @p indices) by the reordered one. */
+    void OptimizeTipsify( aiMesh* pMesh, std::vector<unsigned int>& indices) const;
+    void OptimizeLRU( aiMesh* pMesh, std::vector<unsigned int>& indices) const;
+
+    // -------------------------------------------------------------------
+    /** Reorders clusters of an already cache optimized index buffer
+     *  to reduce overdraw */
+    void OptimizeOverdraw( const aiMesh* pMesh, std::vector<unsigned int>& indices) const;
 
 private:
     //! Configuration parameter: specifies the size of the cache to
     //! optimize the vertex data for.
     unsigned int configCacheDepth;
+
+    //! Configuration parameter: triangle ordering, one of the
+    //! AI_ICL_ALGORITHM_XXX values
+    int configAlgorithm;
+
+    //! Configuration parameter: ACMR the overdraw pass may trade
+    //! for better sorting, relative to the input. 0 disables the pass.
+    float configOverdrawThreshold;
+
+    //! Configuration parameter: reorder the vertices by first use
+    bool configReorderVertices;
 };
 
 } // end of namespace Assimp
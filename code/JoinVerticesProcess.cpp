@@ -51,12 +51,17 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ProcessHelper.h"
 #include "Vertex.h"
 #include "TinyFormatter.h"
+#include "Profiler.h"
+#include "Hash.h"
 #include <stdio.h>
+#include <string.h>
 
 using namespace Assimp;
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 JoinVerticesProcess::JoinVerticesProcess()
+: configUseGrid(false)
+, configExactMatch(false)
 {
     // nothing to do here
 }
@@ -74,6 +79,14 @@ bool JoinVerticesProcess::IsActive( unsigned int pFlags) const
 {
     return (pFlags & aiProcess_JoinIdenticalVertices) != 0;
 }
+// ------------------------------------------------------------------------------------------------
+// Setup import configuration
+void JoinVerticesProcess::SetupProperties(const Importer* pImp)
+{
+    configUseGrid = pImp->GetPropertyBool(AI_CONFIG_PP_USE_SPATIAL_HASH_GRID,false);
+    configExactMatch = pImp->GetPropertyBool(AI_CONFIG_PP_JIV_EXACT_MATCH,false);
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void JoinVerticesProcess::Execute( aiScene* pScene)
@@ -82,16 +95,34 @@ void JoinVerticesProcess::Execute( aiScene* pScene)
 
     // get the total number of vertices BEFORE the step is executed
     int iNumOldVertices = 0;
-    if (!DefaultLogger::isNullLogger()) {
+    std::vector<int> numOldVertices;
+    if (!DefaultLogger::isNullLogger() || profiler) {
+        numOldVertices.resize( pScene->mNumMeshes);
         for( unsigned int a = 0; a < pScene->mNumMeshes; a++)   {
-            iNumOldVertices +=  pScene->mMeshes[a]->mNumVertices;
+            numOldVertices[a] = pScene->mMeshes[a]->mNumVertices;
+            iNumOldVertices +=  numOldVertices[a];
         }
     }
 
     // execute the step
+    std::vector<int> numVertices( pScene->mNumMeshes, 0);
+    ExecutePerMesh( pScene, [&]( unsigned int a) {
+        numVertices[a] = ProcessMesh( pScene->mMeshes[a],a);
+    });
+
     int iNumVertices = 0;
     for( unsigned int a = 0; a < pScene->mNumMeshes; a++)
-        iNumVertices += ProcessMesh( pScene->mMeshes[a],a);
+        iNumVertices += numVertices[a];
+
+    // report per-mesh statistics to the profiler, if any
+    if (profiler) {
+        for( unsigned int a = 0; a < pScene->mNumMeshes; a++) {
+            profiler->AddMeshCounter( a, "vertices_in", numOldVertices[a]);
+            profiler->AddMeshCounter( a, "vertices_out", numVertices[a]);
+        }
+        profiler->AddCounter( "vertices_in", iNumOldVertices);
+        profiler->AddCounter( "vertices_out", iNumVertices);
+    }
 
     // if logging is active, print detailed statistics
     if (!DefaultLogger::isNullLogger())
@@ -113,53 +144,18 @@ void JoinVerticesProcess::Execute( aiScene* pScene)
     pScene->mFlags |= AI_SCENE_FLAGS_NON_VERBOSE_FORMAT;
 }
 
+namespace {
+
 // ------------------------------------------------------------------------------------------------
-// Unites identical vertices in the given mesh
-int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
+// Finds vertices whose components all match the ones of a previous vertex within a small epsilon.
+void JoinSimilarVertices( const aiMesh* pMesh, const SpatialLookup& vertexFinder,
+    std::vector<unsigned int>& replaceIndex, std::vector<unsigned int>& uniqueSource)
 {
-    static_assert( AI_MAX_NUMBER_OF_COLOR_SETS    == 8, "AI_MAX_NUMBER_OF_COLOR_SETS    == 8");
-	static_assert( AI_MAX_NUMBER_OF_TEXTURECOORDS == 8, "AI_MAX_NUMBER_OF_TEXTURECOORDS == 8");
-
-    // Return early if we don't have any positions
-    if (!pMesh->HasPositions() || !pMesh->HasFaces()) {
-        return 0;
-    }
-
     // We'll never have more vertices afterwards.
     std::vector<Vertex> uniqueVertices;
     uniqueVertices.reserve( pMesh->mNumVertices);
 
-    // For each vertex the index of the vertex it was replaced by.
-    // Since the maximal number of vertices is 2^31-1, the most significand bit can be used to mark
-    //  whether a new vertex was created for the index (true) or if it was replaced by an existing
-    //  unique vertex (false). This saves an additional std::vector<bool> and greatly enhances
-    //  branching performance.
-    static_assert(AI_MAX_VERTICES == 0x7fffffff, "AI_MAX_VERTICES == 0x7fffffff");
-    std::vector<unsigned int> replaceIndex( pMesh->mNumVertices, 0xffffffff);
-
-    // A little helper to find locally close vertices faster.
-    // Try to reuse the lookup table from the last step.
     const static float epsilon = 1e-5f;
-    // float posEpsilonSqr;
-    SpatialSort* vertexFinder = NULL;
-    SpatialSort _vertexFinder;
-
-    typedef std::pair<SpatialSort,float> SpatPair;
-    if (shared) {
-        std::vector<SpatPair >* avf;
-        shared->GetProperty(AI_SPP_SPATIAL_SORT,avf);
-        if (avf)    {
-            SpatPair& blubb = (*avf)[meshIndex];
-            vertexFinder  = &blubb.first;
-            // posEpsilonSqr = blubb.second;
-        }
-    }
-    if (!vertexFinder)  {
-        // bad, need to compute it.
-        _vertexFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof( aiVector3D));
-        vertexFinder = &_vertexFinder;
-        // posEpsilonSqr = ComputePositionEpsilon(pMesh);
-    }
 
     // Squared because we check against squared length of the vector difference
     static const float squareEpsilon = epsilon * epsilon;
@@ -178,7 +174,7 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
         Vertex v(pMesh,a);
 
         // collect all vertices that are close enough to the given position
-        vertexFinder->FindIdenticalPositions( v.position, verticesFound);
+        vertexFinder.FindIdenticalPositions( v.position, verticesFound);
         unsigned int matchIndex = 0xffffffff;
 
         // check all unique vertices close to the position if this vertex is already present among them
@@ -269,8 +265,131 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
             // no unique vertex matches it up to now -> so add it
             replaceIndex[a] = (unsigned int)uniqueVertices.size();
             uniqueVertices.push_back( v);
+            uniqueSource.push_back( a);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Finds vertices whose components are bit-identical to the ones of a previous vertex. Only
+// needs a single pass with a hash table lookup per vertex.
+void JoinExactVertices( const aiMesh* pMesh,
+    std::vector<unsigned int>& replaceIndex, std::vector<unsigned int>& uniqueSource)
+{
+    // collect all vertex components present in the mesh
+    std::vector<const aiVector3D*> vectors;
+    std::vector<const aiColor4D*> colors;
+    vectors.push_back( pMesh->mVertices);
+    if( pMesh->HasNormals()) {
+        vectors.push_back( pMesh->mNormals);
+    }
+    if( pMesh->HasTangentsAndBitangents()) {
+        vectors.push_back( pMesh->mTangents);
+        vectors.push_back( pMesh->mBitangents);
+    }
+    for( unsigned int a = 0; pMesh->HasTextureCoords(a); a++) {
+        vectors.push_back( pMesh->mTextureCoords[a]);
+    }
+    for( unsigned int a = 0; pMesh->HasVertexColors(a); a++) {
+        colors.push_back( pMesh->mColors[a]);
+    }
+
+    // open addressing table of unique vertex indices, kept at most half full
+    size_t tableSize = 1;
+    while( tableSize < size_t( pMesh->mNumVertices) * 2) {
+        tableSize <<= 1;
+    }
+    const size_t mask = tableSize - 1;
+    std::vector<unsigned int> table( tableSize, 0xffffffff);
+    std::vector<uint32_t> uniqueHashes;
+    uniqueHashes.reserve( pMesh->mNumVertices);
+
+    for( unsigned int a = 0; a < pMesh->mNumVertices; a++) {
+        uint32_t hash = 0;
+        for( size_t n = 0; n < vectors.size(); n++) {
+            hash = SuperFastHash( reinterpret_cast<const char*>( &vectors[n][a]), sizeof( aiVector3D), hash);
+        }
+        for( size_t n = 0; n < colors.size(); n++) {
+            hash = SuperFastHash( reinterpret_cast<const char*>( &colors[n][a]), sizeof( aiColor4D), hash);
+        }
+
+        for( size_t slot = hash & mask; ; slot = (slot + 1) & mask) {
+            const unsigned int uidx = table[ slot];
+            if( uidx == 0xffffffff) {
+                // no unique vertex matches it up to now -> so add it
+                table[ slot] = replaceIndex[a] = (unsigned int)uniqueSource.size();
+                uniqueSource.push_back( a);
+                uniqueHashes.push_back( hash);
+                break;
+            }
+            if( uniqueHashes[ uidx] != hash) {
+                continue;
+            }
+
+            const unsigned int b = uniqueSource[ uidx];
+            bool match = true;
+            for( size_t n = 0; match && n < vectors.size(); n++) {
+                match = !::memcmp( &vectors[n][a], &vectors[n][b], sizeof( aiVector3D));
+            }
+            for( size_t n = 0; match && n < colors.size(); n++) {
+                match = !::memcmp( &colors[n][a], &colors[n][b], sizeof( aiColor4D));
+            }
+            if( match) {
+                replaceIndex[a] = uidx | 0x80000000;
+                break;
+            }
         }
     }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Replaces a vertex component array by the entries of the unique vertices.
+template <typename T>
+void GatherUniqueVertices( T*& data, const std::vector<unsigned int>& uniqueSource)
+{
+    T* out = new T[ uniqueSource.size()];
+    for( size_t a = 0; a < uniqueSource.size(); a++) {
+        out[a] = data[ uniqueSource[a]];
+    }
+    delete [] data;
+    data = out;
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+// Unites identical vertices in the given mesh
+int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
+{
+    static_assert( AI_MAX_NUMBER_OF_COLOR_SETS    == 8, "AI_MAX_NUMBER_OF_COLOR_SETS    == 8");
+	static_assert( AI_MAX_NUMBER_OF_TEXTURECOORDS == 8, "AI_MAX_NUMBER_OF_TEXTURECOORDS == 8");
+
+    // Return early if we don't have any positions
+    if (!pMesh->HasPositions() || !pMesh->HasFaces()) {
+        return 0;
+    }
+
+    // For each unique vertex, the index of the input vertex it was taken from.
+    // We'll never have more vertices afterwards.
+    std::vector<unsigned int> uniqueSource;
+    uniqueSource.reserve( pMesh->mNumVertices);
+
+    // For each vertex the index of the vertex it was replaced by.
+    // Since the maximal number of vertices is 2^31-1, the most significand bit can be used to mark
+    //  whether a new vertex was created for the index (true) or if it was replaced by an existing
+    //  unique vertex (false). This saves an additional std::vector<bool> and greatly enhances
+    //  branching performance.
+    static_assert(AI_MAX_VERTICES == 0x7fffffff, "AI_MAX_VERTICES == 0x7fffffff");
+    std::vector<unsigned int> replaceIndex( pMesh->mNumVertices, 0xffffffff);
+
+    if (configExactMatch) {
+        JoinExactVertices( pMesh, replaceIndex, uniqueSource);
+    } else {
+        // A little helper to find locally close vertices faster.
+        // Try to reuse the lookup table from the last step.
+        const SpatialLookup vertexFinder(pMesh, meshIndex, shared, configUseGrid);
+        JoinSimilarVertices( pMesh, vertexFinder, replaceIndex, uniqueSource);
+    }
 
     if (!DefaultLogger::isNullLogger() && DefaultLogger::get()->getLogSeverity() == Logger::VERBOSE)    {
         DefaultLogger::get()->debug((Formatter::format(),
@@ -279,72 +398,39 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
             (pMesh->mName.length ? pMesh->mName.data : "unnamed"),
             ") | Verts in: ",pMesh->mNumVertices,
             " out: ",
-            uniqueVertices.size(),
+            uniqueSource.size(),
             " | ~",
-            ((pMesh->mNumVertices - uniqueVertices.size()) / (float)pMesh->mNumVertices) * 100.f,
+            ((pMesh->mNumVertices - uniqueSource.size()) / (float)pMesh->mNumVertices) * 100.f,
             "%"
         ));
     }
 
-    // replace vertex data with the unique data sets
-    pMesh->mNumVertices = (unsigned int)uniqueVertices.size();
-
-    // ----------------------------------------------------------------------------
-    // NOTE - we're *not* calling Vertex::SortBack() because it would check for
-    // presence of every single vertex component once PER VERTEX. And our CPU
-    // dislikes branches, even if they're easily predictable.
-    // ----------------------------------------------------------------------------
+    // replace vertex data with the unique data sets. Unique vertices are copies of
+    // the input vertex they were first seen at, so the data can be gathered from there.
+    pMesh->mNumVertices = (unsigned int)uniqueSource.size();
 
     // Position
-    delete [] pMesh->mVertices;
-    pMesh->mVertices = new aiVector3D[pMesh->mNumVertices];
-    for( unsigned int a = 0; a < pMesh->mNumVertices; a++)
-        pMesh->mVertices[a] = uniqueVertices[a].position;
+    GatherUniqueVertices( pMesh->mVertices, uniqueSource);
 
     // Normals, if present
-    if( pMesh->mNormals)
-    {
-        delete [] pMesh->mNormals;
-        pMesh->mNormals = new aiVector3D[pMesh->mNumVertices];
-        for( unsigned int a = 0; a < pMesh->mNumVertices; a++) {
-            pMesh->mNormals[a] = uniqueVertices[a].normal;
-        }
+    if( pMesh->mNormals) {
+        GatherUniqueVertices( pMesh->mNormals, uniqueSource);
     }
     // Tangents, if present
-    if( pMesh->mTangents)
-    {
-        delete [] pMesh->mTangents;
-        pMesh->mTangents = new aiVector3D[pMesh->mNumVertices];
-        for( unsigned int a = 0; a < pMesh->mNumVertices; a++) {
-            pMesh->mTangents[a] = uniqueVertices[a].tangent;
-        }
+    if( pMesh->mTangents) {
+        GatherUniqueVertices( pMesh->mTangents, uniqueSource);
     }
     // Bitangents as well
-    if( pMesh->mBitangents)
-    {
-        delete [] pMesh->mBitangents;
-        pMesh->mBitangents = new aiVector3D[pMesh->mNumVertices];
-        for( unsigned int a = 0; a < pMesh->mNumVertices; a++) {
-            pMesh->mBitangents[a] = uniqueVertices[a].bitangent;
-        }
+    if( pMesh->mBitangents) {
+        GatherUniqueVertices( pMesh->mBitangents, uniqueSource);
     }
     // Vertex colors
-    for( unsigned int a = 0; pMesh->HasVertexColors(a); a++)
-    {
-        delete [] pMesh->mColors[a];
-        pMesh->mColors[a] = new aiColor4D[pMesh->mNumVertices];
-        for( unsigned int b = 0; b < pMesh->mNumVertices; b++) {
-            pMesh->mColors[a][b] = uniqueVertices[b].colors[a];
-        }
+    for( unsigned int a = 0; pMesh->HasVertexColors(a); a++) {
+        GatherUniqueVertices( pMesh->mColors[a], uniqueSource);
     }
     // Texture coords
-    for( unsigned int a = 0; pMesh->HasTextureCoords(a); a++)
-    {
-        delete [] pMesh->mTextureCoords[a];
-        pMesh->mTextureCoords[a] = new aiVector3D[pMesh->mNumVertices];
-        for( unsigned int b = 0; b < pMesh->mNumVertices; b++) {
-            pMesh->mTextureCoords[a][b] = uniqueVertices[b].texcoords[a];
-        }
+    for( unsigned int a = 0; pMesh->HasTextureCoords(a); a++) {
+        GatherUniqueVertices( pMesh->mTextureCoords[a], uniqueSource);
     }
 
     // adjust the indices in all faces
@@ -82,6 +82,13 @@ public:
     */
     void Execute( aiScene* pScene);
 
+    // -------------------------------------------------------------------
+    /** Called prior to ExecuteOnScene().
+    * The function is a request to the process to update its configuration
+    * basing on the Importer's configuration property list.
+    */
+    void SetupProperties(const Importer* pImp);
+
 public:
     // -------------------------------------------------------------------
     /** Unites identical vertices in the given mesh.
@@ -91,6 +98,11 @@ public:
     int ProcessMesh( aiMesh* pMesh, unsigned int meshIndex);
 
 private:
+    /** Use a SpatialHashGrid instead of a SpatialSort to find identical positions */
+    bool configUseGrid;
+
+    /** Only join vertices whose components are bit-identical */
+    bool configExactMatch;
 };
 
 } // end of namespace Assimp
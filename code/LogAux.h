@@ -49,6 +49,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Exceptional.h"
 #include <assimp/DefaultLogger.hpp>
 
+#include <string>
+#include <utility>
+#include <vector>
+
 namespace Assimp {
 
 template <class TDeriving>
@@ -57,6 +61,8 @@ class LogFunctions
 
 public:
 
+    typedef std::vector< std::pair<Logger::ErrorSeverity,std::string> > Messages;
+
     // ------------------------------------------------------------------------------------------------
     static void ThrowException(const std::string& msg)
     {
@@ -66,28 +72,28 @@ public:
     // ------------------------------------------------------------------------------------------------
     static void LogWarn(const Formatter::format& message)   {
         if (!DefaultLogger::isNullLogger()) {
-            DefaultLogger::get()->warn(Prefix()+(std::string)message);
+            Log(Logger::Warn,message);
         }
     }
 
     // ------------------------------------------------------------------------------------------------
     static void LogError(const Formatter::format& message)  {
         if (!DefaultLogger::isNullLogger()) {
-            DefaultLogger::get()->error(Prefix()+(std::string)message);
+            Log(Logger::Err,message);
         }
     }
 
     // ------------------------------------------------------------------------------------------------
     static void LogInfo(const Formatter::format& message)   {
         if (!DefaultLogger::isNullLogger()) {
-            DefaultLogger::get()->info(Prefix()+(std::string)message);
+            Log(Logger::Info,message);
         }
     }
 
     // ------------------------------------------------------------------------------------------------
     static void LogDebug(const Formatter::format& message)  {
         if (!DefaultLogger::isNullLogger()) {
-            DefaultLogger::get()->debug(Prefix()+(std::string)message);
+            Log(Logger::Debugging,message);
         }
     }
 
@@ -124,9 +130,55 @@ public:
 
 #endif
 
+    // ------------------------------------------------------------------------------------------------
+    /** Keep the messages logged by the calling thread in a buffer instead of passing them to the
+     *  DefaultLogger, e.g. while doing work whose result may be discarded. Pass NULL to stop.
+     *  @return The buffer which was in use before. */
+    static Messages* CaptureMessages(Messages* messages) {
+        std::swap(messages,Captured());
+        return messages;
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    /** Pass messages collected by CaptureMessages() on to the DefaultLogger */
+    static void LogMessages(const Messages& messages) {
+        for(typename Messages::const_iterator it = messages.begin(); it != messages.end(); ++it) {
+            Log((*it).first,(*it).second);
+        }
+    }
+
 private:
     static const char* Prefix();
 
+    // ------------------------------------------------------------------------------------------------
+    static Messages*& Captured() {
+        static thread_local Messages* messages = NULL;
+        return messages;
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    static void Log(Logger::ErrorSeverity severity, const std::string& message) {
+        if (Captured()) {
+            Captured()->push_back(std::make_pair(severity,message));
+            return;
+        }
+        Logger* const logger = DefaultLogger::get();
+        switch(severity) {
+        case Logger::Debugging:
+            logger->debug(Prefix()+message);
+            break;
+        case Logger::Info:
+            logger->info(Prefix()+message);
+            break;
+        case Logger::Warn:
+            logger->warn(Prefix()+message);
+            break;
+        default:
+            logger->error(Prefix()+message);
+            break;
+        }
+    }
+
 };
 
 } // ! Assimp
@@ -0,0 +1,479 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  MappedScene.cpp
+ *  @brief Implementation of the zero-copy .assmap loader, see assmap_format.h
+ */
+
+#include <assimp/MappedScene.hpp>
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/DefaultLogger.hpp>
+#include <assimp/IOStream.hpp>
+#include <assimp/scene.h>
+#include "assmap_format.h"
+#include "Exceptional.h"
+
+#include <string.h>
+
+using namespace Assimp;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+/** Resolves all references in the struct region of an .assmap file */
+class AssmapResolver
+{
+public:
+    AssmapResolver(uint8_t* structs, size_t structSize, const uint8_t* data, size_t dataSize)
+        : mStructs(structs)
+        , mStructSize(structSize)
+        , mData(data)
+        , mDataSize(dataSize)
+    {
+    }
+
+    // -------------------------------------------------------------------
+    void ResolveScene(aiScene* s)
+    {
+        s->mPrivate = NULL;
+
+        ResolveNodes(s->mRootNode);
+
+        ResolveTable(s->mMeshes,s->mNumMeshes);
+        for (unsigned int i = 0; s->mMeshes && i < s->mNumMeshes; ++i) {
+            ResolveMesh(s->mMeshes[i]);
+        }
+        ResolveTable(s->mMaterials,s->mNumMaterials);
+        for (unsigned int i = 0; s->mMaterials && i < s->mNumMaterials; ++i) {
+            ResolveMaterial(s->mMaterials[i]);
+        }
+        ResolveTable(s->mAnimations,s->mNumAnimations);
+        for (unsigned int i = 0; s->mAnimations && i < s->mNumAnimations; ++i) {
+            ResolveAnimation(s->mAnimations[i]);
+        }
+        ResolveTable(s->mTextures,s->mNumTextures);
+        for (unsigned int i = 0; s->mTextures && i < s->mNumTextures; ++i) {
+            ResolveTexture(s->mTextures[i]);
+        }
+        ResolveTable(s->mLights,s->mNumLights);
+        ResolveTable(s->mCameras,s->mNumCameras);
+    }
+
+private:
+    // -------------------------------------------------------------------
+    // Turn a reference into a pointer to size bytes in the expected region
+    const uint8_t* Resolve(uintptr_t ref, size_t size, size_t alignment, bool inStructs) const
+    {
+        if (!ref) {
+            return NULL;
+        }
+        if (((ref & 1) == 0) != inStructs) {
+            throw DeadlyImportError("ASSMAP: Reference into the wrong region");
+        }
+        const size_t offset = static_cast<size_t>(ref >> 1) - 1;
+        const size_t regionSize = inStructs ? mStructSize : mDataSize;
+        if (offset > regionSize || size > regionSize - offset) {
+            throw DeadlyImportError("ASSMAP: Reference out of range, the file is truncated or corrupt");
+        }
+        if (offset % alignment) {
+            throw DeadlyImportError("ASSMAP: Misaligned reference");
+        }
+        return (inStructs ? mStructs : mData) + offset;
+    }
+
+    // -------------------------------------------------------------------
+    // Resolve a pointer to count elements stored in the struct region
+    template <typename T>
+    void Struct(T*& p, size_t count)
+    {
+        if (count > mStructSize / sizeof(T)) {
+            throw DeadlyImportError("ASSMAP: Array size out of range");
+        }
+        const uint8_t* ptr = Resolve(reinterpret_cast<uintptr_t>(p),count * sizeof(T),alignof(T),true);
+        p = reinterpret_cast<T*>(const_cast<uint8_t*>(ptr));
+    }
+
+    // -------------------------------------------------------------------
+    // Resolve a pointer to count elements stored in the data region
+    template <typename T>
+    void Data(T*& p, size_t count)
+    {
+        if (count > mDataSize / sizeof(T)) {
+            throw DeadlyImportError("ASSMAP: Array size out of range");
+        }
+        const uint8_t* ptr = Resolve(reinterpret_cast<uintptr_t>(p),count * sizeof(T),alignof(T),false);
+        p = reinterpret_cast<T*>(const_cast<uint8_t*>(ptr));
+    }
+
+    // -------------------------------------------------------------------
+    // Resolve a table of pointers to structs and all of its entries
+    template <typename T>
+    void ResolveTable(T**& table, unsigned int count)
+    {
+        Struct(table,count);
+        for (unsigned int i = 0; table && i < count; ++i) {
+            Struct(table[i],1);
+        }
+    }
+
+    // -------------------------------------------------------------------
+    // The node graph is walked iteratively, a corrupt file could create
+    // cycles or exceedingly deep hierarchies.
+    void ResolveNodes(aiNode*& root)
+    {
+        Struct(root,1);
+
+        std::vector<aiNode*> stack;
+        if (root) {
+            stack.push_back(root);
+        }
+        size_t budget = mStructSize / sizeof(aiNode);
+        while (!stack.empty()) {
+            aiNode* node = stack.back();
+            stack.pop_back();
+            if (!budget--) {
+                throw DeadlyImportError("ASSMAP: Node graph is corrupt");
+            }
+
+            Struct(node->mParent,1);
+            Data(node->mMeshes,node->mNumMeshes);
+            Struct(node->mMetaData,1);
+            if (node->mMetaData) {
+                ResolveMetadata(node->mMetaData);
+            }
+
+            ResolveTable(node->mChildren,node->mNumChildren);
+            for (unsigned int i = 0; node->mChildren && i < node->mNumChildren; ++i) {
+                if (node->mChildren[i]) {
+                    stack.push_back(node->mChildren[i]);
+                }
+            }
+        }
+    }
+
+    // -------------------------------------------------------------------
+    void ResolveMetadata(aiMetadata* md)
+    {
+        Data(md->mKeys,md->mNumProperties);
+        Struct(md->mValues,md->mNumProperties);
+        for (unsigned int i = 0; md->mValues && i < md->mNumProperties; ++i) {
+            aiMetadataEntry& e = md->mValues[i];
+            switch (e.mType) {
+            case AI_BOOL:
+                ResolveAs<bool>(e.mData);
+                break;
+            case AI_INT32:
+                ResolveAs<int32_t>(e.mData);
+                break;
+            case AI_UINT64:
+                ResolveAs<uint64_t>(e.mData);
+                break;
+            case AI_FLOAT:
+                ResolveAs<float>(e.mData);
+                break;
+            case AI_DOUBLE:
+                ResolveAs<double>(e.mData);
+                break;
+            case AI_AISTRING:
+                ResolveAs<aiString>(e.mData);
+                break;
+            case AI_AIVECTOR3D:
+                ResolveAs<aiVector3D>(e.mData);
+                break;
+            default:
+                throw DeadlyImportError("ASSMAP: Unknown metadata type");
+            }
+        }
+    }
+
+    // -------------------------------------------------------------------
+    template <typename T>
+    void ResolveAs(void*& p)
+    {
+        T* typed = static_cast<T*>(p);
+        Data(typed,1);
+        p = typed;
+    }
+
+    // -------------------------------------------------------------------
+    void ResolveMesh(aiMesh* mesh)
+    {
+        const unsigned int nv = mesh->mNumVertices;
+        Data(mesh->mVertices,nv);
+        Data(mesh->mNormals,nv);
+        Data(mesh->mTangents,nv);
+        Data(mesh->mBitangents,nv);
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i) {
+            Data(mesh->mColors[i],nv);
+        }
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+            Data(mesh->mTextureCoords[i],nv);
+        }
+
+        Struct(mesh->mFaces,mesh->mNumFaces);
+        for (unsigned int i = 0; mesh->mFaces && i < mesh->mNumFaces; ++i) {
+            Data(mesh->mFaces[i].mIndices,mesh->mFaces[i].mNumIndices);
+        }
+
+        ResolveTable(mesh->mBones,mesh->mNumBones);
+        for (unsigned int i = 0; mesh->mBones && i < mesh->mNumBones; ++i) {
+            Data(mesh->mBones[i]->mWeights,mesh->mBones[i]->mNumWeights);
+        }
+
+        ResolveTable(mesh->mAnimMeshes,mesh->mNumAnimMeshes);
+        for (unsigned int i = 0; mesh->mAnimMeshes && i < mesh->mNumAnimMeshes; ++i) {
+            aiAnimMesh* am = mesh->mAnimMeshes[i];
+            Data(am->mVertices,am->mNumVertices);
+            Data(am->mNormals,am->mNumVertices);
+            Data(am->mTangents,am->mNumVertices);
+            Data(am->mBitangents,am->mNumVertices);
+            for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+                Data(am->mColors[c],am->mNumVertices);
+            }
+            for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c) {
+                Data(am->mTextureCoords[c],am->mNumVertices);
+            }
+        }
+
+        Data(mesh->mMeshlets,mesh->mNumMeshlets);
+        Data(mesh->mMeshletVertices,mesh->mNumMeshletVertices);
+        Data(mesh->mMeshletIndices,mesh->mNumMeshletIndices);
+    }
+
+    // -------------------------------------------------------------------
+    void ResolveMaterial(aiMaterial* mat)
+    {
+        ResolveTable(mat->mProperties,mat->mNumProperties);
+        for (unsigned int i = 0; mat->mProperties && i < mat->mNumProperties; ++i) {
+            aiMaterialProperty* prop = mat->mProperties[i];
+            Data(prop->mData,prop->mDataLength);
+        }
+        mat->mNumAllocated = mat->mNumProperties;
+    }
+
+    // -------------------------------------------------------------------
+    void ResolveTexture(aiTexture* tex)
+    {
+        if (tex->mHeight) {
+            if (tex->mWidth > mDataSize / tex->mHeight) {
+                throw DeadlyImportError("ASSMAP: Texture size out of range");
+            }
+            Data(tex->pcData,static_cast<size_t>(tex->mWidth) * tex->mHeight);
+        }
+        else {
+            // compressed textures store their size in bytes in mWidth
+            Data(tex->pcData,(tex->mWidth + sizeof(aiTexel) - 1) / sizeof(aiTexel));
+        }
+    }
+
+    // -------------------------------------------------------------------
+    void ResolveAnimation(aiAnimation* anim)
+    {
+        ResolveTable(anim->mChannels,anim->mNumChannels);
+        for (unsigned int i = 0; anim->mChannels && i < anim->mNumChannels; ++i) {
+            aiNodeAnim* na = anim->mChannels[i];
+            Data(na->mPositionKeys,na->mNumPositionKeys);
+            Data(na->mRotationKeys,na->mNumRotationKeys);
+            Data(na->mScalingKeys,na->mNumScalingKeys);
+        }
+
+        ResolveTable(anim->mMeshChannels,anim->mNumMeshChannels);
+        for (unsigned int i = 0; anim->mMeshChannels && i < anim->mNumMeshChannels; ++i) {
+            Data(anim->mMeshChannels[i]->mKeys,anim->mMeshChannels[i]->mNumKeys);
+        }
+
+        ResolveTable(anim->mMorphMeshChannels,anim->mNumMorphMeshChannels);
+        for (unsigned int i = 0; anim->mMorphMeshChannels && i < anim->mNumMorphMeshChannels; ++i) {
+            aiMeshMorphAnim* ma = anim->mMorphMeshChannels[i];
+            Struct(ma->mKeys,ma->mNumKeys);
+            for (unsigned int k = 0; ma->mKeys && k < ma->mNumKeys; ++k) {
+                Data(ma->mKeys[k].mValues,ma->mKeys[k].mNumValuesAndWeights);
+                Data(ma->mKeys[k].mWeights,ma->mKeys[k].mNumValuesAndWeights);
+            }
+        }
+    }
+
+private:
+    uint8_t* mStructs;
+    size_t mStructSize;
+    const uint8_t* mData;
+    size_t mDataSize;
+};
+
+} // end of anonymous namespace
+
+// ------------------------------------------------------------------------------------------------
+MappedScene::MappedScene()
+    : mIOHandler()
+    , mOwnIOHandler()
+    , mStream()
+    , mScene()
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+MappedScene::~MappedScene()
+{
+    Free();
+}
+
+// ------------------------------------------------------------------------------------------------
+void MappedScene::Free()
+{
+    mScene = NULL;
+    std::vector<uint64_t>().swap(mStructs);
+    std::vector<uint64_t>().swap(mFileCopy);
+
+    if (mStream) {
+        mIOHandler->Close(mStream);
+        mStream = NULL;
+    }
+    if (mOwnIOHandler) {
+        delete mIOHandler;
+        mOwnIOHandler = false;
+    }
+    mIOHandler = NULL;
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiScene* MappedScene::Load(const char* pFile, IOSystem* pIOHandler)
+{
+    Free();
+    mErrorString.clear();
+
+    mIOHandler = pIOHandler;
+    if (!mIOHandler) {
+        mIOHandler = new DefaultIOSystem();
+        mOwnIOHandler = true;
+    }
+
+    mStream = mIOHandler->Open(pFile,"rb");
+    if (!mStream) {
+        mErrorString = std::string("Unable to open file \"") + pFile + "\".";
+        DefaultLogger::get()->error(mErrorString);
+        Free();
+        return NULL;
+    }
+
+    const size_t size = mStream->FileSize();
+    const uint8_t* data = static_cast<const uint8_t*>(mStream->MapView());
+    if (!data) {
+        mFileCopy.resize((size + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+        if (size && mStream->Read(&mFileCopy[0],1,size) != size) {
+            mErrorString = std::string("Failed to read file \"") + pFile + "\".";
+            DefaultLogger::get()->error(mErrorString);
+            Free();
+            return NULL;
+        }
+        data = mFileCopy.empty() ? NULL : reinterpret_cast<const uint8_t*>(&mFileCopy[0]);
+
+        // the stream is not needed anymore
+        mIOHandler->Close(mStream);
+        mStream = NULL;
+    }
+    return Setup(data,size);
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiScene* MappedScene::Load(const void* pBuffer, size_t pLength)
+{
+    Free();
+    mErrorString.clear();
+
+    const uint8_t* data = static_cast<const uint8_t*>(pBuffer);
+    if (reinterpret_cast<uintptr_t>(data) % sizeof(uint64_t)) {
+        mFileCopy.resize((pLength + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+        if (pLength) {
+            memcpy(&mFileCopy[0],pBuffer,pLength);
+        }
+        data = mFileCopy.empty() ? NULL : reinterpret_cast<const uint8_t*>(&mFileCopy[0]);
+    }
+    return Setup(data,pLength);
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiScene* MappedScene::Setup(const uint8_t* pData, size_t pLength)
+{
+    try {
+        AssmapHeader header;
+        if (!pData || pLength < sizeof(header)) {
+            throw DeadlyImportError("ASSMAP: File is too small");
+        }
+        memcpy(&header,pData,sizeof(header));
+
+        if (strncmp(header.mMagic,ASSMAP_MAGIC,sizeof(header.mMagic))) {
+            throw DeadlyImportError("ASSMAP: Not an .assmap file");
+        }
+        if (header.mVersion != ASSMAP_VERSION) {
+            throw DeadlyImportError("ASSMAP: Unsupported format version");
+        }
+        if (header.mLayoutHash != AssmapLayoutHash()) {
+            throw DeadlyImportError("ASSMAP: File was written by an incompatible build of Assimp");
+        }
+        if (header.mStructOffset > pLength || header.mStructSize > pLength - header.mStructOffset ||
+            header.mDataOffset > pLength || header.mDataSize > pLength - header.mDataOffset ||
+            header.mStructOffset % ASSMAP_REGION_ALIGNMENT || header.mDataOffset % ASSMAP_REGION_ALIGNMENT) {
+            throw DeadlyImportError("ASSMAP: File is truncated or corrupt");
+        }
+        if (header.mStructSize < sizeof(aiScene)) {
+            throw DeadlyImportError("ASSMAP: File does not contain a scene");
+        }
+
+        // only the structs are copied, they are small compared to the data
+        const size_t structSize = static_cast<size_t>(header.mStructSize);
+        mStructs.resize((structSize + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+        memcpy(&mStructs[0],pData + header.mStructOffset,structSize);
+
+        uint8_t* structs = reinterpret_cast<uint8_t*>(&mStructs[0]);
+        AssmapResolver resolver(structs,structSize,pData + header.mDataOffset,static_cast<size_t>(header.mDataSize));
+
+        aiScene* scene = reinterpret_cast<aiScene*>(structs);
+        resolver.ResolveScene(scene);
+        mScene = scene;
+    }
+    catch (const DeadlyImportError& e) {
+        mErrorString = e.what();
+        DefaultLogger::get()->error(mErrorString);
+        Free();
+        return NULL;
+    }
+    return mScene;
+}
@@ -49,11 +49,79 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "MaterialSystem.h"
 #include <assimp/types.h>
 #include <assimp/material.h>
+#include <assimp/MaterialIndex.hpp>
 #include <assimp/DefaultLogger.hpp>
 #include "Macros.h"
 
 using namespace Assimp;
 
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Compare a property key. The key length is checked first, it rules out almost
+// all other properties without touching the key strings.
+inline bool IsSameKey(const aiMaterialProperty* prop, const char* pKey, size_t keyLength)
+{
+    return prop->mKey.length == keyLength && 0 == memcmp( prop->mKey.data, pKey, keyLength );
+}
+
+// ------------------------------------------------------------------------------------------------
+// Allocate and fill a new material property
+aiMaterialProperty* NewMaterialProperty(const void* pInput,
+    unsigned int pSizeInBytes,
+    const char* pKey,
+    unsigned int type,
+    unsigned int index,
+    aiPropertyTypeInfo pType)
+{
+    aiMaterialProperty* pcNew = new aiMaterialProperty();
+
+    // .. and fill it
+    pcNew->mType = pType;
+    pcNew->mSemantic = type;
+    pcNew->mIndex = index;
+
+    pcNew->mDataLength = pSizeInBytes;
+    pcNew->mData = new char[pSizeInBytes];
+    memcpy (pcNew->mData,pInput,pSizeInBytes);
+
+    pcNew->mKey.length = ::strlen(pKey);
+    ai_assert ( MAXLEN > pcNew->mKey.length);
+    strcpy( pcNew->mKey.data, pKey );
+    return pcNew;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Append a property to the property array of a material
+aiReturn AppendMaterialProperty(aiMaterial* pMat, aiMaterialProperty* pcNew)
+{
+    // resize the array ... double the storage allocated
+    if (pMat->mNumProperties == pMat->mNumAllocated)    {
+        const unsigned int iOld = pMat->mNumAllocated;
+        pMat->mNumAllocated *= 2;
+
+        aiMaterialProperty** ppTemp;
+        try {
+            ppTemp = new aiMaterialProperty*[pMat->mNumAllocated];
+        } catch (std::bad_alloc&) {
+            pMat->mNumAllocated = iOld;
+            delete pcNew;
+            return AI_OUTOFMEMORY;
+        }
+
+        // just copy all items over; then replace the old array
+        memcpy (ppTemp,pMat->mProperties,iOld * sizeof(void*));
+
+        delete[] pMat->mProperties;
+        pMat->mProperties = ppTemp;
+    }
+    // push back ...
+    pMat->mProperties[pMat->mNumProperties++] = pcNew;
+    return AI_SUCCESS;
+}
+
+} // !anon namespace
+
 // ------------------------------------------------------------------------------------------------
 // Get a specific property from a material
 aiReturn aiGetMaterialProperty(const aiMaterial* pMat,
@@ -67,14 +135,15 @@ aiReturn aiGetMaterialProperty(const aiMaterial* pMat,
     ai_assert (pPropOut != NULL);
 
     /*  Just search for a property with exactly this name ..
-     *  could be improved by hashing, but it's possibly
-     *  no worth the effort (we're bound to C structures,
-     *  thus std::map or derivates are not applicable. */
+     *  we're bound to C structures, so there is no room for a
+     *  hash table here. Assimp::MaterialIndex provides one for
+     *  users doing lots of lookups on the same material. */
+    const size_t keyLength = ::strlen( pKey );
     for ( unsigned int i = 0; i < pMat->mNumProperties; ++i ) {
         aiMaterialProperty* prop = pMat->mProperties[i];
 
         if (prop /* just for safety ... */
-            && 0 == strcmp( prop->mKey.data, pKey )
+            && IsSameKey( prop, pKey, keyLength )
             && (UINT_MAX == type  || prop->mSemantic == type) /* UINT_MAX is a wildcard, but this is undocumented :-) */
             && (UINT_MAX == index || prop->mIndex == index))
         {
@@ -422,10 +491,11 @@ aiReturn aiMaterial::RemoveProperty (const char* pKey,unsigned int type,
 {
     ai_assert(NULL != pKey);
 
+    const size_t keyLength = ::strlen( pKey );
     for (unsigned int i = 0; i < mNumProperties;++i) {
         aiMaterialProperty* prop = mProperties[i];
 
-        if (prop && !strcmp( prop->mKey.data, pKey ) &&
+        if (prop && IsSameKey( prop, pKey, keyLength ) &&
             prop->mSemantic == type && prop->mIndex == index)
         {
             // Delete this entry
@@ -460,11 +530,12 @@ aiReturn aiMaterial::AddBinaryProperty (const void* pInput,
 
     }
     // first search the list whether there is already an entry with this key
+    const size_t keyLength = ::strlen( pKey );
     unsigned int iOutIndex = UINT_MAX;
     for (unsigned int i = 0; i < mNumProperties;++i)    {
         aiMaterialProperty* prop = mProperties[i];
 
-        if (prop /* just for safety */ && !strcmp( prop->mKey.data, pKey ) &&
+        if (prop /* just for safety */ && IsSameKey( prop, pKey, keyLength ) &&
             prop->mSemantic == type && prop->mIndex == index){
 
             delete mProperties[i];
@@ -473,48 +544,14 @@ aiReturn aiMaterial::AddBinaryProperty (const void* pInput,
     }
 
     // Allocate a new material property
-    aiMaterialProperty* pcNew = new aiMaterialProperty();
-
-    // .. and fill it
-    pcNew->mType = pType;
-    pcNew->mSemantic = type;
-    pcNew->mIndex = index;
-
-    pcNew->mDataLength = pSizeInBytes;
-    pcNew->mData = new char[pSizeInBytes];
-    memcpy (pcNew->mData,pInput,pSizeInBytes);
-
-    pcNew->mKey.length = ::strlen(pKey);
-    ai_assert ( MAXLEN > pcNew->mKey.length);
-    strcpy( pcNew->mKey.data, pKey );
+    aiMaterialProperty* pcNew = NewMaterialProperty(pInput,pSizeInBytes,pKey,type,index,pType);
 
     if (UINT_MAX != iOutIndex)  {
         mProperties[iOutIndex] = pcNew;
         return AI_SUCCESS;
     }
 
-    // resize the array ... double the storage allocated
-    if (mNumProperties == mNumAllocated)    {
-        const unsigned int iOld = mNumAllocated;
-        mNumAllocated *= 2;
-
-        aiMaterialProperty** ppTemp;
-        try {
-            ppTemp = new aiMaterialProperty*[mNumAllocated];
-        } catch (std::bad_alloc&) {
-            delete pcNew;
-            return AI_OUTOFMEMORY;
-        }
-
-        // just copy all items over; then replace the old array
-        memcpy (ppTemp,mProperties,iOld * sizeof(void*));
-
-        delete[] mProperties;
-        mProperties = ppTemp;
-    }
-    // push back ...
-    mProperties[mNumProperties++] = pcNew;
-    return AI_SUCCESS;
+    return AppendMaterialProperty(this,pcNew);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -625,3 +662,143 @@ void aiMaterial::CopyPropertyList(aiMaterial* pcDest,
         memcpy(prop->mData,propSrc->mData,prop->mDataLength);
     }
 }
+
+// ------------------------------------------------------------------------------------------------
+MaterialIndex::MaterialIndex(aiMaterial* material)
+: mMaterial(material)
+{
+    ai_assert(NULL != material);
+    Rebuild();
+}
+
+// ------------------------------------------------------------------------------------------------
+MaterialIndex::~MaterialIndex()
+{
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+void MaterialIndex::Rebuild()
+{
+    // keep the load factor at or below 1/2, probe sequences stay short
+    size_t numSlots = 16;
+    while (numSlots < mMaterial->mNumProperties * 2) {
+        numSlots *= 2;
+    }
+
+    Slot empty;
+    empty.mHash = 0;
+    empty.mPosition = UINT_MAX;
+    mSlots.assign(numSlots,empty);
+
+    for (unsigned int i = 0; i < mMaterial->mNumProperties; ++i) {
+        const aiMaterialProperty* prop = mMaterial->mProperties[i];
+        if (prop) {
+            Insert(SuperFastHash(prop->mKey.data,static_cast<uint32_t>(prop->mKey.length)),i);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void MaterialIndex::Insert(uint32_t hash, unsigned int position)
+{
+    const size_t mask = mSlots.size() - 1;
+    size_t i = hash & mask;
+    while (mSlots[i].mPosition != UINT_MAX) {
+        i = (i + 1) & mask;
+    }
+    mSlots[i].mHash = hash;
+    mSlots[i].mPosition = position;
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int MaterialIndex::Find(const char* pKey, unsigned int type, unsigned int index) const
+{
+    ai_assert(NULL != pKey);
+
+    // all properties with the same key end up in the same probe sequence.
+    // Take the first one in the property array, like aiGetMaterialProperty.
+    const size_t keyLength = ::strlen(pKey);
+    const uint32_t hash = SuperFastHash(pKey,static_cast<uint32_t>(keyLength));
+    const size_t mask = mSlots.size() - 1;
+
+    unsigned int found = UINT_MAX;
+    for (size_t i = hash & mask; mSlots[i].mPosition != UINT_MAX; i = (i + 1) & mask) {
+        const Slot& slot = mSlots[i];
+        if (slot.mHash != hash || slot.mPosition >= found) {
+            continue;
+        }
+
+        const aiMaterialProperty* prop = mMaterial->mProperties[slot.mPosition];
+        if (IsSameKey(prop,pKey,keyLength)
+            && (UINT_MAX == type  || prop->mSemantic == type)
+            && (UINT_MAX == index || prop->mIndex == index)) {
+            found = slot.mPosition;
+        }
+    }
+    return found;
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiMaterialProperty* MaterialIndex::Get(const char* pKey,
+    unsigned int type, unsigned int idx) const
+{
+    const unsigned int position = Find(pKey,type,idx);
+    return UINT_MAX == position ? NULL : mMaterial->mProperties[position];
+}
+
+// ------------------------------------------------------------------------------------------------
+aiReturn MaterialIndex::AddBinaryProperty(const void* pInput,
+    unsigned int pSizeInBytes,
+    const char* pKey,
+    unsigned int type,
+    unsigned int index,
+    aiPropertyTypeInfo pType)
+{
+    ai_assert (pInput != NULL);
+    ai_assert (0 != pSizeInBytes);
+
+    // wildcards are only allowed for lookups
+    ai_assert (UINT_MAX != type && UINT_MAX != index);
+
+    aiMaterialProperty* pcNew = NewMaterialProperty(pInput,pSizeInBytes,pKey,type,index,pType);
+
+    const unsigned int position = Find(pKey,type,index);
+    if (UINT_MAX != position) {
+        delete mMaterial->mProperties[position];
+        mMaterial->mProperties[position] = pcNew;
+        return AI_SUCCESS;
+    }
+
+    const aiReturn ret = AppendMaterialProperty(mMaterial,pcNew);
+    if (AI_SUCCESS != ret) {
+        return ret;
+    }
+
+    if (mMaterial->mNumProperties * 2 > mSlots.size()) {
+        Rebuild();
+    }
+    else {
+        Insert(SuperFastHash(pcNew->mKey.data,static_cast<uint32_t>(pcNew->mKey.length)),mMaterial->mNumProperties - 1);
+    }
+    return AI_SUCCESS;
+}
+
+// ------------------------------------------------------------------------------------------------
+aiReturn MaterialIndex::RemoveProperty(const char* pKey, unsigned int type, unsigned int index)
+{
+    const unsigned int position = Find(pKey,type,index);
+    if (UINT_MAX == position) {
+        return AI_FAILURE;
+    }
+
+    delete mMaterial->mProperties[position];
+
+    // collapse the array behind, all following positions change
+    --mMaterial->mNumProperties;
+    for (unsigned int a = position; a < mMaterial->mNumProperties; ++a) {
+        mMaterial->mProperties[a] = mMaterial->mProperties[a + 1];
+    }
+    Rebuild();
+    return AI_SUCCESS;
+}
@@ -46,6 +46,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ObjFileParser.h"
 #include "ObjFileData.h"
 #include "IOStreamBuffer.h"
+#include "Profiler.h"
+#include "ThreadPool.h"
 #include <memory>
 #include <assimp/DefaultIOSystem.h>
 #include <assimp/Importer.hpp>
@@ -53,6 +55,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/ai_assert.h>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/importerdesc.h>
+#include <assimp/config.h>
 
 static const aiImporterDesc desc = {
     "Wavefront Object Importer",
@@ -69,16 +72,20 @@ static const aiImporterDesc desc = {
 
 static const unsigned int ObjMinSize = 16;
 
+static const int ObjDefaultParallelChunkSize = 4 * 1024 * 1024;
+
 namespace Assimp {
 
 using namespace std;
+using namespace Profiling;
 
 // ------------------------------------------------------------------------------------------------
 //  Default constructor
 ObjFileImporter::ObjFileImporter() :
     m_Buffer(),
     m_pRootObject( NULL ),
-    m_strAbsPath( "" )
+    m_strAbsPath( "" ),
+    m_parallelChunkSize( ObjDefaultParallelChunkSize )
 {
     DefaultIOSystem io;
     m_strAbsPath = io.getOsSeparator();
@@ -107,6 +114,13 @@ bool ObjFileImporter::CanRead( const std::string& pFile, IOSystem*  pIOHandler ,
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+void ObjFileImporter::SetupProperties(const Importer* pImp)
+{
+    const int chunkSize = pImp->GetPropertyInteger( AI_CONFIG_IMPORT_OBJ_PARALLEL_CHUNK_SIZE, ObjDefaultParallelChunkSize );
+    m_parallelChunkSize = chunkSize > 0 ? static_cast<size_t>( chunkSize ) : ObjDefaultParallelChunkSize;
+}
+
 // ------------------------------------------------------------------------------------------------
 const aiImporterDesc* ObjFileImporter::GetInfo () const
 {
@@ -129,9 +143,6 @@ void ObjFileImporter::InternReadFile( const std::string &file, aiScene* pScene,
         throw DeadlyImportError( "OBJ-file is too small.");
     }
 
-    IOStreamBuffer<char> streamedBuffer;
-    streamedBuffer.open( fileStream.get() );
-
     // Allocate buffer and read file into it
     //TextFileToBuffer( fileStream.get(),m_Buffer);
 
@@ -180,13 +191,39 @@ void ObjFileImporter::InternReadFile( const std::string &file, aiScene* pScene,
     // 1/3rd progress
     m_progress->UpdateFileRead(1, 3);
 
-    // parse the file into a temporary representation
-    ObjFileParser parser( streamedBuffer, modelName, pIOHandler, m_progress, file);
+    // parse the file into a temporary representation. Large files are split
+    // into chunks which are parsed in parallel, this needs the entire file in
+    // memory. Otherwise the file is streamed.
+    std::unique_ptr<ObjFileParser> parser;
+    if ( m_threadPool && m_threadPool->GetNumThreads() > 1 && fileSize / 2 >= m_parallelChunkSize ) {
+        ProfileRegion readRegion( m_profiler, "read" );
+        const char *data = static_cast<const char*>( fileStream->MapView() );
+        if ( !data ) {
+            m_Buffer.resize( fileSize );
+            if ( fileStream->Read( &m_Buffer[ 0 ], 1, fileSize ) != fileSize ) {
+                throw DeadlyImportError( "OBJ: Failed to read file " + file + "." );
+            }
+            data = &m_Buffer[ 0 ];
+        }
+        readRegion.End();
+
+        ProfileRegion parseRegion( m_profiler, "parse" );
+        parser.reset( new ObjFileParser( data, fileSize, m_parallelChunkSize, m_threadPool, modelName, pIOHandler, m_progress, file ) );
+    } else {
+        IOStreamBuffer<char> streamedBuffer;
+        streamedBuffer.open( fileStream.get() );
 
-    // And create the proper return structures out of it
-    CreateDataFromImport(parser.GetModel(), pScene);
+        ProfileRegion parseRegion( m_profiler, "parse" );
+        parser.reset( new ObjFileParser( streamedBuffer, modelName, pIOHandler, m_progress, file ) );
+        parseRegion.End();
 
-    streamedBuffer.close();
+        streamedBuffer.close();
+    }
+
+    // And create the proper return structures out of it
+    ProfileRegion convertRegion( m_profiler, "convert" );
+    CreateDataFromImport(parser->GetModel(), pScene);
+    convertRegion.End();
 
     // Clean up allocated storage for the next import
     m_Buffer.clear();
@@ -72,6 +72,9 @@ public:
     /// \remark See BaseImporter::CanRead() for details.
     bool CanRead( const std::string& pFile, IOSystem* pIOHandler, bool checkSig) const;
 
+    //! \brief  Reads the configuration properties of the importer.
+    void SetupProperties(const Importer* pImp);
+
 private:
     //! \brief  Appends the supported extension.
     const aiImporterDesc* GetInfo () const;
@@ -113,6 +116,8 @@ private:
     ObjFile::Object *m_pRootObject;
     //! Absolute pathname of model in file system
     std::string m_strAbsPath;
+    //! Size of the chunks parsed in parallel, see AI_CONFIG_IMPORT_OBJ_PARALLEL_CHUNK_SIZE
+    size_t m_parallelChunkSize;
 };
 
 // ------------------------------------------------------------------------------------------------
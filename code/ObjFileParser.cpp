@@ -47,11 +47,16 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ObjFileData.h"
 #include "ParsingUtils.h"
 #include "BaseImporter.h"
+#include "MemoryIOWrapper.h"
+#include "ThreadPool.h"
 #include <assimp/DefaultIOSystem.h>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/material.h>
 #include <assimp/Importer.hpp>
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
+#include <memory>
 
 namespace Assimp {
 
@@ -64,7 +69,11 @@ ObjFileParser::ObjFileParser()
 , m_uiLine( 0 )
 , m_pIO( nullptr )
 , m_progress( nullptr )
-, m_originalObjFileName() {
+, m_originalObjFileName()
+, m_numPrecedingVertices( 0 )
+, m_numPrecedingTextureCoords( 0 )
+, m_numPrecedingNormals( 0 )
+, m_deferStatements( false ) {
     // empty
 }
 
@@ -77,10 +86,54 @@ ObjFileParser::ObjFileParser( IOStreamBuffer<char> &streamBuffer, const std::str
     m_uiLine(0),
     m_pIO( io ),
     m_progress(progress),
-    m_originalObjFileName(originalObjFileName)
+    m_originalObjFileName(originalObjFileName),
+    m_numPrecedingVertices(0),
+    m_numPrecedingTextureCoords(0),
+    m_numPrecedingNormals(0),
+    m_deferStatements(false)
 {
     std::fill_n(m_buffer,Buffersize,0);
 
+    createModel( modelName );
+
+    // Start parsing the file
+    parseFile( streamBuffer );
+}
+
+ObjFileParser::ObjFileParser( const char *data, size_t length, size_t chunkSize, ThreadPool* pool,
+                              const std::string &modelName, IOSystem *io, ProgressHandler* progress,
+                              const std::string &originalObjFileName) :
+    m_DataIt(),
+    m_DataItEnd(),
+    m_pModel(NULL),
+    m_uiLine(0),
+    m_pIO( io ),
+    m_progress(progress),
+    m_originalObjFileName(originalObjFileName),
+    m_numPrecedingVertices(0),
+    m_numPrecedingTextureCoords(0),
+    m_numPrecedingNormals(0),
+    m_deferStatements(false)
+{
+    std::fill_n(m_buffer,Buffersize,0);
+
+    createModel( modelName );
+
+    // Start parsing the file
+    parseChunks( data, length, chunkSize, pool );
+}
+
+ObjFileParser::~ObjFileParser() {
+    delete m_pModel;
+    m_pModel = NULL;
+
+    // faces which were not handed over to a mesh
+    for ( size_t i = 0; i < m_deferredFaces.size(); ++i ) {
+        delete m_deferredFaces[ i ];
+    }
+}
+
+void ObjFileParser::createModel( const std::string &modelName ) {
     // Create the model instance to store all the data
     m_pModel = new ObjFile::Model();
     m_pModel->m_ModelName = modelName;
@@ -90,25 +143,24 @@ ObjFileParser::ObjFileParser( IOStreamBuffer<char> &streamBuffer, const std::str
     m_pModel->m_pDefaultMaterial->MaterialName.Set( DEFAULT_MATERIAL );
     m_pModel->m_MaterialLib.push_back( DEFAULT_MATERIAL );
     m_pModel->m_MaterialMap[ DEFAULT_MATERIAL ] = m_pModel->m_pDefaultMaterial;
-
-    // Start parsing the file
-    parseFile( streamBuffer );
-}
-
-ObjFileParser::~ObjFileParser() {
-    delete m_pModel;
-    m_pModel = NULL;
 }
 
 void ObjFileParser::setBuffer( std::vector<char> &buffer ) {
-    m_DataIt = buffer.begin();
-    m_DataItEnd = buffer.end();
+    m_DataIt = buffer.empty() ? NULL : &buffer[ 0 ];
+    m_DataItEnd = m_DataIt + buffer.size();
 }
 
 ObjFile::Model *ObjFileParser::GetModel() const {
     return m_pModel;
 }
 
+// -------------------------------------------------------------------
+//  Returns true for statements which depend on or change the current
+//  object, group or material of the model.
+static bool isStateStatement( char c ) {
+    return c == 'u' || c == 'm' || c == 'g' || c == 'o';
+}
+
 void ObjFileParser::parseFile( IOStreamBuffer<char> &streamBuffer ) {
     // only update every 100KB or it'll be too slow
     //const unsigned int updateProgressEveryBytes = 100 * 1024;
@@ -119,10 +171,14 @@ void ObjFileParser::parseFile( IOStreamBuffer<char> &streamBuffer ) {
     unsigned int processed = 0;
     size_t lastFilePos( 0 );
 
-    std::vector<char> buffer;
-    while ( streamBuffer.getNextDataLine( buffer, '\\' ) ) {
-        m_DataIt = buffer.begin();
-        m_DataItEnd = buffer.end();
+    // lines are parsed in place, each one is terminated by a '\n'. The stream
+    // buffer keeps one more element readable, so the line end stays in range
+    // of isEndOfBuffer() which treats the last element as end.
+    const char* line = NULL;
+    size_t length = 0;
+    while ( streamBuffer.getNextDataLineView( line, length, '\\' ) ) {
+        m_DataIt = line;
+        m_DataItEnd = line + length + 2;
 
         // Handle progress reporting
         const size_t filePos( streamBuffer.getFilePos() );
@@ -130,113 +186,289 @@ void ObjFileParser::parseFile( IOStreamBuffer<char> &streamBuffer ) {
             processed += static_cast<unsigned int>(filePos);
             lastFilePos = filePos;
             progressCounter++;
-            m_progress->UpdateFileRead( progressOffset + processed * 2, progressTotal );
+            if ( m_progress ) {
+                m_progress->UpdateFileRead( progressOffset + processed * 2, progressTotal );
+            }
         }
 
-        // parse line
-        switch (*m_DataIt) {
-        case 'v': // Parse a vertex texture coordinate
-            {
-                ++m_DataIt;
-                if (*m_DataIt == ' ' || *m_DataIt == '\t') {
-                    size_t numComponents = getNumComponentsInDataDefinition();
-                    if (numComponents == 3) {
-                        // read in vertex definition
-                        getVector3(m_pModel->m_Vertices);
-                    } else if (numComponents == 4) {
-                        // read in vertex definition (homogeneous coords)
-                        getHomogeneousVector3(m_pModel->m_Vertices);
-                    } else if (numComponents == 6) {
-                        // read vertex and vertex-color
-                        getTwoVectors3(m_pModel->m_Vertices, m_pModel->m_VertexColors);
-                    }
-                } else if (*m_DataIt == 't') {
-                    // read in texture coordinate ( 2D or 3D )
-                    ++m_DataIt;
-                    getVector( m_pModel->m_TextureCoord );
-                } else if (*m_DataIt == 'n') {
-                    // Read in normal vector definition
-                    ++m_DataIt;
-                    getVector3( m_pModel->m_Normals );
+        // statements changing the state of the model are replayed in file
+        // order once all chunks have been parsed
+        if ( m_deferStatements && isStateStatement( *m_DataIt ) ) {
+            m_deferredStatements.push_back( std::make_pair( m_deferredFaces.size(), std::string( line, length ) + "\n\n" ) );
+            continue;
+        }
+
+        parseLine();
+    }
+}
+
+void ObjFileParser::parseLine() {
+    switch (*m_DataIt) {
+    case 'v': // Parse a vertex texture coordinate
+        {
+            ++m_DataIt;
+            if (*m_DataIt == ' ' || *m_DataIt == '\t') {
+                size_t numComponents = getNumComponentsInDataDefinition();
+                if (numComponents == 3) {
+                    // read in vertex definition
+                    getVector3(m_pModel->m_Vertices);
+                } else if (numComponents == 4) {
+                    // read in vertex definition (homogeneous coords)
+                    getHomogeneousVector3(m_pModel->m_Vertices);
+                } else if (numComponents == 6) {
+                    // read vertex and vertex-color
+                    getTwoVectors3(m_pModel->m_Vertices, m_pModel->m_VertexColors);
                 }
+            } else if (*m_DataIt == 't') {
+                // read in texture coordinate ( 2D or 3D )
+                ++m_DataIt;
+                getVector( m_pModel->m_TextureCoord );
+            } else if (*m_DataIt == 'n') {
+                // Read in normal vector definition
+                ++m_DataIt;
+                getVector3( m_pModel->m_Normals );
             }
-            break;
+        }
+        break;
 
-        case 'p': // Parse a face, line or point statement
-        case 'l':
-        case 'f':
-            {
-                getFace(*m_DataIt == 'f' ? aiPrimitiveType_POLYGON : (*m_DataIt == 'l'
-                    ? aiPrimitiveType_LINE : aiPrimitiveType_POINT));
-            }
-            break;
+    case 'p': // Parse a face, line or point statement
+    case 'l':
+    case 'f':
+        {
+            getFace(*m_DataIt == 'f' ? aiPrimitiveType_POLYGON : (*m_DataIt == 'l'
+                ? aiPrimitiveType_LINE : aiPrimitiveType_POINT));
+        }
+        break;
 
-        case '#': // Parse a comment
-            {
-                getComment();
-            }
-            break;
+    case '#': // Parse a comment
+        {
+            getComment();
+        }
+        break;
 
-        case 'u': // Parse a material desc. setter
-            {
-                std::string name;
+    case 'u': // Parse a material desc. setter
+        {
+            std::string name;
 
-                getNameNoSpace(m_DataIt, m_DataItEnd, name);
+            getNameNoSpace(m_DataIt, m_DataItEnd, name);
 
-                size_t nextSpace = name.find(" ");
-                if (nextSpace != std::string::npos)
-                    name = name.substr(0, nextSpace);
+            size_t nextSpace = name.find(" ");
+            if (nextSpace != std::string::npos)
+                name = name.substr(0, nextSpace);
 
-                if(name == "usemtl")
-                {
-                    getMaterialDesc();
-                }
+            if(name == "usemtl")
+            {
+                getMaterialDesc();
             }
-            break;
+        }
+        break;
 
-        case 'm': // Parse a material library or merging group ('mg')
-            {
-                std::string name;
+    case 'm': // Parse a material library or merging group ('mg')
+        {
+            std::string name;
 
-                getNameNoSpace(m_DataIt, m_DataItEnd, name);
+            getNameNoSpace(m_DataIt, m_DataItEnd, name);
 
-                size_t nextSpace = name.find(" ");
-                if (nextSpace != std::string::npos)
-                    name = name.substr(0, nextSpace);
+            size_t nextSpace = name.find(" ");
+            if (nextSpace != std::string::npos)
+                name = name.substr(0, nextSpace);
 
-                if (name == "mg")
-                    getGroupNumberAndResolution();
-                else if(name == "mtllib")
-                    getMaterialLib();
+            if (name == "mg")
+                getGroupNumberAndResolution();
+            else if(name == "mtllib")
+                getMaterialLib();
 				else
 					goto pf_skip_line;
-            }
-            break;
+        }
+        break;
 
-        case 'g': // Parse group name
-            {
-                getGroupName();
-            }
-            break;
+    case 'g': // Parse group name
+        {
+            getGroupName();
+        }
+        break;
 
-        case 's': // Parse group number
-            {
-                getGroupNumber();
-            }
+    case 's': // Parse group number
+        {
+            getGroupNumber();
+        }
+        break;
+
+    case 'o': // Parse object name
+        {
+            getObjectName();
+        }
+        break;
+
+    default:
+        {
+pf_skip_line:
+            m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
+        }
+        break;
+    }
+}
+
+// -------------------------------------------------------------------
+//  Returns the start of the first line behind pos. Lines joined by a
+//  trailing '\\' are kept together.
+static const char *findLineBoundary( const char *begin, const char *pos, const char *end ) {
+    while ( pos != end ) {
+        const char *lineEnd = static_cast<const char*>( ::memchr( pos, '\n', end - pos ) );
+        if ( NULL == lineEnd ) {
+            return end;
+        }
+        pos = lineEnd + 1;
+
+        const char *prev = lineEnd;
+        if ( prev != begin && prev[ -1 ] == '\r' ) {
+            --prev;
+        }
+        if ( prev == begin || prev[ -1 ] != '\\' ) {
             break;
+        }
+    }
+    return pos;
+}
 
-        case 'o': // Parse object name
-            {
-                getObjectName();
+struct ObjFileParser::Chunk {
+    const char *m_begin;
+    const char *m_end;
+    size_t m_numVertices;
+    size_t m_numTextureCoords;
+    size_t m_numNormals;
+    std::unique_ptr<ObjFileParser> m_parser;
+
+    Chunk( const char *begin, const char *end )
+    : m_begin( begin )
+    , m_end( end )
+    , m_numVertices( 0 )
+    , m_numTextureCoords( 0 )
+    , m_numNormals( 0 )
+    , m_parser( new ObjFileParser() ) {
+        m_parser->m_pModel = new ObjFile::Model();
+        m_parser->m_deferStatements = true;
+    }
+};
+
+template<class T>
+static void appendChunkData( std::vector<T> &dest, size_t offset, const std::vector<T> &data ) {
+    std::copy( data.begin(), data.end(), dest.begin() + offset );
+}
+
+void ObjFileParser::parseChunks( const char *data, size_t length, size_t chunkSize, ThreadPool* pool ) {
+    ai_assert( NULL != pool );
+    ai_assert( 0 != chunkSize );
+
+    // split the file into chunks at line boundaries
+    std::vector<Chunk> chunks;
+    const char *end = data + length;
+    const char *pos = data;
+    while ( pos != end ) {
+        const char *next = static_cast<size_t>( end - pos ) > chunkSize ? findLineBoundary( data, pos + chunkSize - 1, end ) : end;
+        chunks.push_back( Chunk( pos, next ) );
+        pos = next;
+    }
+
+    // Each chunk is streamed through its own buffer, which takes care
+    // of continued lines. The first pass counts the vertex data in front
+    // of each chunk, so relative face indices can be resolved while the
+    // chunks are parsed in the second pass.
+    pool->ParallelFor( chunks.size(), [&chunks]( size_t i ) {
+        Chunk &chunk = chunks[ i ];
+        MemoryIOStream stream( reinterpret_cast<const uint8_t*>( chunk.m_begin ), chunk.m_end - chunk.m_begin );
+        IOStreamBuffer<char> streamBuffer;
+        streamBuffer.open( &stream );
+        chunk.m_parser->countDataDefinitions( streamBuffer, chunk );
+    } );
+
+    size_t numVertices( 0 ), numTextureCoords( 0 ), numNormals( 0 );
+    for ( size_t i = 0; i < chunks.size(); ++i ) {
+        ObjFileParser &parser = *chunks[ i ].m_parser;
+        parser.m_numPrecedingVertices = numVertices;
+        parser.m_numPrecedingTextureCoords = numTextureCoords;
+        parser.m_numPrecedingNormals = numNormals;
+        numVertices += chunks[ i ].m_numVertices;
+        numTextureCoords += chunks[ i ].m_numTextureCoords;
+        numNormals += chunks[ i ].m_numNormals;
+    }
+
+    pool->ParallelFor( chunks.size(), [&chunks]( size_t i ) {
+        Chunk &chunk = chunks[ i ];
+        MemoryIOStream stream( reinterpret_cast<const uint8_t*>( chunk.m_begin ), chunk.m_end - chunk.m_begin );
+        IOStreamBuffer<char> streamBuffer;
+        streamBuffer.open( &stream );
+        chunk.m_parser->parseFile( streamBuffer );
+    } );
+
+    // join the vertex data in file order
+    std::vector<size_t> numVertexColors( chunks.size() + 1, 0 );
+    for ( size_t i = 0; i < chunks.size(); ++i ) {
+        numVertexColors[ i + 1 ] = numVertexColors[ i ] + chunks[ i ].m_parser->m_pModel->m_VertexColors.size();
+    }
+    m_pModel->m_Vertices.resize( numVertices );
+    m_pModel->m_TextureCoord.resize( numTextureCoords );
+    m_pModel->m_Normals.resize( numNormals );
+    m_pModel->m_VertexColors.resize( numVertexColors.back() );
+
+    ObjFile::Model *model = m_pModel;
+    pool->ParallelFor( chunks.size(), [&chunks, &numVertexColors, model]( size_t i ) {
+        ObjFileParser &parser = *chunks[ i ].m_parser;
+        appendChunkData( model->m_Vertices, parser.m_numPrecedingVertices, parser.m_pModel->m_Vertices );
+        appendChunkData( model->m_TextureCoord, parser.m_numPrecedingTextureCoords, parser.m_pModel->m_TextureCoord );
+        appendChunkData( model->m_Normals, parser.m_numPrecedingNormals, parser.m_pModel->m_Normals );
+        appendChunkData( model->m_VertexColors, numVertexColors[ i ], parser.m_pModel->m_VertexColors );
+        delete parser.m_pModel;
+        parser.m_pModel = NULL;
+    } );
+
+    // assign the faces to meshes, materials, groups and objects
+    for ( size_t i = 0; i < chunks.size(); ++i ) {
+        ObjFileParser &parser = *chunks[ i ].m_parser;
+        size_t face = 0;
+        for ( size_t j = 0; j < parser.m_deferredStatements.size(); ++j ) {
+            for ( ; face < parser.m_deferredStatements[ j ].first; ++face ) {
+                storeFace( parser.m_deferredFaces[ face ] );
+                parser.m_deferredFaces[ face ] = NULL;
             }
-            break;
+            const std::string &statement = parser.m_deferredStatements[ j ].second;
+            m_DataIt = statement.c_str();
+            m_DataItEnd = m_DataIt + statement.size();
+            parseLine();
+        }
+        for ( ; face < parser.m_deferredFaces.size(); ++face ) {
+            storeFace( parser.m_deferredFaces[ face ] );
+            parser.m_deferredFaces[ face ] = NULL;
+        }
+        chunks[ i ].m_parser.reset();
+    }
 
-        default:
-            {
-pf_skip_line:
-                m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
+    if ( m_progress ) {
+        m_progress->UpdateFileRead( 3, 3 );
+    }
+}
+
+void ObjFileParser::countDataDefinitions( IOStreamBuffer<char> &streamBuffer, Chunk &chunk ) {
+    const char* line = NULL;
+    size_t length = 0;
+    while ( streamBuffer.getNextDataLineView( line, length, '\\' ) ) {
+        m_DataIt = line;
+        m_DataItEnd = line + length + 2;
+        if ( *m_DataIt != 'v' ) {
+            continue;
+        }
+
+        // mirrors the vertex data cases of parseLine()
+        ++m_DataIt;
+        if ( *m_DataIt == ' ' || *m_DataIt == '\t' ) {
+            const size_t numComponents = getNumComponentsInDataDefinition();
+            if ( numComponents == 3 || numComponents == 4 || numComponents == 6 ) {
+                ++chunk.m_numVertices;
             }
-            break;
+        } else if ( *m_DataIt == 't' ) {
+            ++chunk.m_numTextureCoords;
+        } else if ( *m_DataIt == 'n' ) {
+            ++chunk.m_numNormals;
         }
     }
 }
@@ -262,6 +494,23 @@ void ObjFileParser::copyNextWord(char *pBuffer, size_t length) {
     pBuffer[index] = '\0';
 }
 
+ai_real ObjFileParser::parseNextReal() {
+    m_DataIt = getNextWord<DataArrayIt>(m_DataIt, m_DataItEnd);
+    if ( *m_DataIt == '\\' ) {
+        m_DataIt++;
+        m_DataIt++;
+        m_DataIt = getNextWord<DataArrayIt>( m_DataIt, m_DataItEnd );
+    }
+
+    // parse in place, trailing characters of the word are ignored
+    ai_real value;
+    m_DataIt = fast_atoreal_move<ai_real>( m_DataIt, m_DataItEnd, value );
+    while( m_DataIt != m_DataItEnd && !IsSpaceOrNewLine( *m_DataIt ) ) {
+        ++m_DataIt;
+    }
+    return value;
+}
+
 static bool isDataDefinitionEnd( const char *tmp ) {
     if ( *tmp == '\\' ) {
         tmp++;
@@ -302,21 +551,13 @@ void ObjFileParser::getVector( std::vector<aiVector3D> &point3d_array ) {
     size_t numComponents = getNumComponentsInDataDefinition();
     ai_real x, y, z;
     if( 2 == numComponents ) {
-        copyNextWord( m_buffer, Buffersize );
-        x = ( ai_real ) fast_atof( m_buffer );
-
-        copyNextWord( m_buffer, Buffersize );
-        y = ( ai_real ) fast_atof( m_buffer );
+        x = parseNextReal();
+        y = parseNextReal();
         z = 0.0;
     } else if( 3 == numComponents ) {
-        copyNextWord( m_buffer, Buffersize );
-        x = ( ai_real ) fast_atof( m_buffer );
-
-        copyNextWord( m_buffer, Buffersize );
-        y = ( ai_real ) fast_atof( m_buffer );
-
-        copyNextWord( m_buffer, Buffersize );
-        z = ( ai_real ) fast_atof( m_buffer );
+        x = parseNextReal();
+        y = parseNextReal();
+        z = parseNextReal();
     } else {
         throw DeadlyImportError( "OBJ: Invalid number of components" );
     }
@@ -326,14 +567,9 @@ void ObjFileParser::getVector( std::vector<aiVector3D> &point3d_array ) {
 
 void ObjFileParser::getVector3( std::vector<aiVector3D> &point3d_array ) {
     ai_real x, y, z;
-    copyNextWord(m_buffer, Buffersize);
-    x = (ai_real) fast_atof(m_buffer);
-
-    copyNextWord(m_buffer, Buffersize);
-    y = (ai_real) fast_atof(m_buffer);
-
-    copyNextWord( m_buffer, Buffersize );
-    z = ( ai_real ) fast_atof( m_buffer );
+    x = parseNextReal();
+    y = parseNextReal();
+    z = parseNextReal();
 
     point3d_array.push_back( aiVector3D( x, y, z ) );
     m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
@@ -341,17 +577,10 @@ void ObjFileParser::getVector3( std::vector<aiVector3D> &point3d_array ) {
 
 void ObjFileParser::getHomogeneousVector3( std::vector<aiVector3D> &point3d_array ) {
     ai_real x, y, z, w;
-    copyNextWord(m_buffer, Buffersize);
-    x = (ai_real) fast_atof(m_buffer);
-
-    copyNextWord(m_buffer, Buffersize);
-    y = (ai_real) fast_atof(m_buffer);
-
-    copyNextWord( m_buffer, Buffersize );
-    z = ( ai_real ) fast_atof( m_buffer );
-
-    copyNextWord( m_buffer, Buffersize );
-    w = ( ai_real ) fast_atof( m_buffer );
+    x = parseNextReal();
+    y = parseNextReal();
+    z = parseNextReal();
+    w = parseNextReal();
 
     ai_assert( w != 0 );
 
@@ -361,25 +590,15 @@ void ObjFileParser::getHomogeneousVector3( std::vector<aiVector3D> &point3d_arra
 
 void ObjFileParser::getTwoVectors3( std::vector<aiVector3D> &point3d_array_a, std::vector<aiVector3D> &point3d_array_b ) {
     ai_real x, y, z;
-    copyNextWord(m_buffer, Buffersize);
-    x = (ai_real) fast_atof(m_buffer);
-
-    copyNextWord(m_buffer, Buffersize);
-    y = (ai_real) fast_atof(m_buffer);
-
-    copyNextWord( m_buffer, Buffersize );
-    z = ( ai_real ) fast_atof( m_buffer );
+    x = parseNextReal();
+    y = parseNextReal();
+    z = parseNextReal();
 
     point3d_array_a.push_back( aiVector3D( x, y, z ) );
 
-    copyNextWord(m_buffer, Buffersize);
-    x = (ai_real) fast_atof(m_buffer);
-
-    copyNextWord(m_buffer, Buffersize);
-    y = (ai_real) fast_atof(m_buffer);
-
-    copyNextWord( m_buffer, Buffersize );
-    z = ( ai_real ) fast_atof( m_buffer );
+    x = parseNextReal();
+    y = parseNextReal();
+    z = parseNextReal();
 
     point3d_array_b.push_back( aiVector3D( x, y, z ) );
 
@@ -388,11 +607,8 @@ void ObjFileParser::getTwoVectors3( std::vector<aiVector3D> &point3d_array_a, st
 
 void ObjFileParser::getVector2( std::vector<aiVector2D> &point2d_array ) {
     ai_real x, y;
-    copyNextWord(m_buffer, Buffersize);
-    x = (ai_real) fast_atof(m_buffer);
-
-    copyNextWord(m_buffer, Buffersize);
-    y = (ai_real) fast_atof(m_buffer);
+    x = parseNextReal();
+    y = parseNextReal();
 
     point2d_array.push_back(aiVector2D(x, y));
 
@@ -408,14 +624,13 @@ void ObjFileParser::getFace( aiPrimitiveType type ) {
     }
 
     ObjFile::Face *face = new ObjFile::Face( type );
-    bool hasNormal = false;
 
-    const int vSize = static_cast<unsigned int>(m_pModel->m_Vertices.size());
-    const int vtSize = static_cast<unsigned int>(m_pModel->m_TextureCoord.size());
-    const int vnSize = static_cast<unsigned int>(m_pModel->m_Normals.size());
+    const int vSize = static_cast<unsigned int>(m_numPrecedingVertices + m_pModel->m_Vertices.size());
+    const int vtSize = static_cast<unsigned int>(m_numPrecedingTextureCoords + m_pModel->m_TextureCoord.size());
+    const int vnSize = static_cast<unsigned int>(m_numPrecedingNormals + m_pModel->m_Normals.size());
 
-    const bool vt = (!m_pModel->m_TextureCoord.empty());
-    const bool vn = (!m_pModel->m_Normals.empty());
+    const bool vt = (vtSize != 0);
+    const bool vn = (vnSize != 0);
     int iStep = 0, iPos = 0;
     while ( m_DataIt != m_DataItEnd ) {
         iStep = 1;
@@ -459,7 +674,6 @@ void ObjFileParser::getFace( aiPrimitiveType type ) {
                     face->m_texturCoords.push_back( iVal - 1 );
                 } else if ( 2 == iPos ) {
                     face->m_normals.push_back( iVal - 1 );
-                    hasNormal = true;
                 } else {
                     reportErrorTokenInFace();
                 }
@@ -471,7 +685,6 @@ void ObjFileParser::getFace( aiPrimitiveType type ) {
                     face->m_texturCoords.push_back( vtSize + iVal );
                 } else if ( 2 == iPos ) {
                     face->m_normals.push_back( vnSize + iVal );
-                    hasNormal = true;
                 } else {
                     reportErrorTokenInFace();
                 }
@@ -495,6 +708,17 @@ void ObjFileParser::getFace( aiPrimitiveType type ) {
         return;
     }
 
+    if ( m_deferStatements ) {
+        m_deferredFaces.push_back( face );
+    } else {
+        storeFace( face );
+    }
+
+    // Skip the rest of the line
+    m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
+}
+
+void ObjFileParser::storeFace( ObjFile::Face *face ) {
     // Set active material, if one set
     if( NULL != m_pModel->m_pCurrentMaterial ) {
         face->m_pMaterial = m_pModel->m_pCurrentMaterial;
@@ -516,11 +740,9 @@ void ObjFileParser::getFace( aiPrimitiveType type ) {
     m_pModel->m_pCurrentMesh->m_Faces.push_back( face );
     m_pModel->m_pCurrentMesh->m_uiNumIndices += (unsigned int) face->m_vertices.size();
     m_pModel->m_pCurrentMesh->m_uiUVCoordinates[ 0 ] += (unsigned int) face->m_texturCoords.size();
-    if( !m_pModel->m_pCurrentMesh->m_hasNormals && hasNormal ) {
+    if( !m_pModel->m_pCurrentMesh->m_hasNormals && !face->m_normals.empty() ) {
         m_pModel->m_pCurrentMesh->m_hasNormals = true;
     }
-    // Skip the rest of the line
-    m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
 }
 
 void ObjFileParser::getMaterialDesc() {
@@ -530,7 +752,7 @@ void ObjFileParser::getMaterialDesc() {
         return;
     }
 
-    char *pStart = &(*m_DataIt);
+    const char *pStart = &(*m_DataIt);
     while( m_DataIt != m_DataItEnd && !IsLineEnd( *m_DataIt ) ) {
         ++m_DataIt;
     }
@@ -594,7 +816,7 @@ void ObjFileParser::getMaterialLib() {
         return;
     }
 
-    char *pStart = &(*m_DataIt);
+    const char *pStart = &(*m_DataIt);
     while( m_DataIt != m_DataItEnd && !IsLineEnd( *m_DataIt ) ) {
         ++m_DataIt;
     }
@@ -653,7 +875,7 @@ void ObjFileParser::getNewMaterial() {
         return;
     }
 
-    char *pStart = &(*m_DataIt);
+    const char *pStart = &(*m_DataIt);
     std::string strMat( pStart, *m_DataIt );
     while( m_DataIt != m_DataItEnd && IsSpaceOrNewLine( *m_DataIt ) ) {
         ++m_DataIt;
@@ -755,7 +977,7 @@ void ObjFileParser::getObjectName()
     if( m_DataIt == m_DataItEnd ) {
         return;
     }
-    char *pStart = &(*m_DataIt);
+    const char *pStart = &(*m_DataIt);
     while( m_DataIt != m_DataItEnd && !IsSpaceOrNewLine( *m_DataIt ) ) {
         ++m_DataIt;
     }
@@ -57,11 +57,13 @@ namespace ObjFile {
     struct Material;
     struct Point3;
     struct Point2;
+    struct Face;
 }
 
 class ObjFileImporter;
 class IOSystem;
 class ProgressHandler;
+class ThreadPool;
 
 /// \class  ObjFileParser
 /// \brief  Parser for a obj waveform file
@@ -69,14 +71,17 @@ class ASSIMP_API ObjFileParser {
 public:
     static const size_t Buffersize = 4096;
     typedef std::vector<char> DataArray;
-    typedef std::vector<char>::iterator DataArrayIt;
-    typedef std::vector<char>::const_iterator ConstDataArrayIt;
+    typedef const char* DataArrayIt;
+    typedef const char* ConstDataArrayIt;
 
 public:
     /// @brief  The default constructor.
     ObjFileParser();
     /// @brief  Constructor with data array.
     ObjFileParser( IOStreamBuffer<char> &streamBuffer, const std::string &modelName, IOSystem* io, ProgressHandler* progress, const std::string &originalObjFileName);
+    /// @brief  Constructor with an in-core buffer, which is split into chunks of
+    ///         chunkSize bytes at line boundaries. The chunks are parsed on the pool.
+    ObjFileParser( const char *data, size_t length, size_t chunkSize, ThreadPool* pool, const std::string &modelName, IOSystem* io, ProgressHandler* progress, const std::string &originalObjFileName);
     /// @brief  Destructor
     ~ObjFileParser();
     /// @brief  If you want to load in-core data.
@@ -87,8 +92,14 @@ public:
 protected:
     /// Parse the loaded file
     void parseFile( IOStreamBuffer<char> &streamBuffer );
+    /// Parse the in-core file chunk by chunk in parallel.
+    void parseChunks( const char *data, size_t length, size_t chunkSize, ThreadPool* pool );
+    /// Parse the statement at the current position.
+    void parseLine();
     /// Method to copy the new delimited word in the current line.
     void copyNextWord(char *pBuffer, size_t length);
+    /// Method to parse the next word as real number.
+    ai_real parseNextReal();
     /// Method to copy the new line.
 //    void copyNextLine(char *pBuffer, size_t length);
     /// Get the number of components in a line.
@@ -105,6 +116,8 @@ protected:
     void getVector2(std::vector<aiVector2D> &point2d_array);
     /// Stores the following face.
     void getFace(aiPrimitiveType type);
+    /// Assigns a face to the current mesh.
+    void storeFace( ObjFile::Face *face );
     /// Reads the material description.
     void getMaterialDesc();
     /// Gets a comment.
@@ -138,6 +151,13 @@ private:
     ObjFileParser(const ObjFileParser& rhs);
     ObjFileParser& operator=(const ObjFileParser& rhs);
 
+    struct Chunk;
+
+    /// Creates the model instance and its default material.
+    void createModel( const std::string &modelName );
+    /// Count the vertex data definitions of a chunk.
+    void countDataDefinitions( IOStreamBuffer<char> &streamBuffer, Chunk &chunk );
+
     /// Default material name
     static const std::string DEFAULT_MATERIAL;
     //! Iterator to current position in buffer
@@ -156,6 +176,17 @@ private:
     ProgressHandler* m_progress;
     /// Path to the current model, name of the obj file where the buffer comes from
     const std::string m_originalObjFileName;
+    //! Number of vertices, texture coordinates and normals in front of the parsed chunk
+    size_t m_numPrecedingVertices;
+    size_t m_numPrecedingTextureCoords;
+    size_t m_numPrecedingNormals;
+    //! Set while parsing a chunk, faces and statements which depend on the
+    //! state of the model are kept until the chunks are joined in file order
+    bool m_deferStatements;
+    //! Faces of the chunk
+    std::vector<ObjFile::Face*> m_deferredFaces;
+    //! Statements of the chunk along with the number of faces in front of them
+    std::vector<std::pair<size_t, std::string> > m_deferredStatements;
 };
 
 }   // Namespace Assimp
@@ -195,8 +195,8 @@ void PLYImporter::InternReadFile(const std::string& pFile,
       SkipLine(szMe, (const char**)&szMe);
       if (!PLY::DOM::ParseInstance(streamedBuffer, &sPlyDom, this))
       {
-        if (mGeneratedMesh != NULL)
-          delete(mGeneratedMesh);
+        delete mGeneratedMesh;
+        mGeneratedMesh = NULL;
 
         streamedBuffer.close();
         throw DeadlyImportError("Invalid .ply file: Unable to build DOM (#1)");
@@ -210,8 +210,8 @@ void PLYImporter::InternReadFile(const std::string& pFile,
       // skip the line, parse the rest of the header and build the DOM
       if (!PLY::DOM::ParseInstanceBinary(streamedBuffer, &sPlyDom, this, bIsBE))
       {
-        if (mGeneratedMesh != NULL)
-          delete(mGeneratedMesh);
+        delete mGeneratedMesh;
+        mGeneratedMesh = NULL;
 
         streamedBuffer.close();
         throw DeadlyImportError("Invalid .ply file: Unable to build DOM (#2)");
@@ -219,8 +219,8 @@ void PLYImporter::InternReadFile(const std::string& pFile,
     }
     else
     {
-      if (mGeneratedMesh != NULL)
-        delete(mGeneratedMesh);
+      delete mGeneratedMesh;
+      mGeneratedMesh = NULL;
 
       streamedBuffer.close();
       throw DeadlyImportError("Invalid .ply file: Unknown file format");
@@ -229,8 +229,8 @@ void PLYImporter::InternReadFile(const std::string& pFile,
   else
   {
     AI_DEBUG_INVALIDATE_PTR(this->mBuffer);
-    if (mGeneratedMesh != NULL)
-      delete(mGeneratedMesh);
+    delete mGeneratedMesh;
+    mGeneratedMesh = NULL;
 
     streamedBuffer.close();
     throw DeadlyImportError("Invalid .ply file: Missing format specification");
@@ -251,8 +251,8 @@ void PLYImporter::InternReadFile(const std::string& pFile,
   {
     if (mGeneratedMesh->mNumVertices < 3)
     {
-      if (mGeneratedMesh != NULL)
-        delete(mGeneratedMesh);
+      delete mGeneratedMesh;
+      mGeneratedMesh = NULL;
 
       streamedBuffer.close();
       throw DeadlyImportError("Invalid .ply file: Not enough "
@@ -289,6 +289,7 @@ void PLYImporter::InternReadFile(const std::string& pFile,
   pScene->mNumMeshes = 1;
   pScene->mMeshes = new aiMesh*[pScene->mNumMeshes];
   pScene->mMeshes[0] = mGeneratedMesh;
+  mGeneratedMesh = NULL;
 
   // generate a simple node structure
   pScene->mRootNode = new aiNode();
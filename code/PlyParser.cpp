@@ -555,18 +555,21 @@ bool PLY::DOM::ParseElementInstanceLists(IOStreamBuffer<char> &streamBuffer, std
   std::vector<PLY::Element>::const_iterator i = alElements.begin();
   std::vector<PLY::ElementInstanceList>::iterator a = alElementData.begin();
 
+  // the buffer holds the first line behind the header
+  const char* pCur = buffer.empty() ? NULL : (const char*)&buffer[0];
+
   // parse all element instances
   //construct vertices and faces
   for (; i != alElements.end(); ++i, ++a)
   {
     if ((*i).eSemantic == EEST_Vertex || (*i).eSemantic == EEST_Face || (*i).eSemantic == EEST_TriStrip)
     {
-      PLY::ElementInstanceList::ParseInstanceList(streamBuffer, buffer, &(*i), NULL, loader);
+      PLY::ElementInstanceList::ParseInstanceList(streamBuffer, pCur, &(*i), NULL, loader);
     }
     else
     {
       (*a).alInstances.resize((*i).NumOccur);
-      PLY::ElementInstanceList::ParseInstanceList(streamBuffer, buffer, &(*i), &(*a), NULL);
+      PLY::ElementInstanceList::ParseInstanceList(streamBuffer, pCur, &(*i), &(*a), NULL);
     }
   }
 
@@ -662,28 +665,36 @@ bool PLY::DOM::ParseInstance(IOStreamBuffer<char> &streamBuffer, DOM* p_pcOut, P
   return true;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Get a view of the next line, an empty line once the stream has been exhausted
+static void NextLine(IOStreamBuffer<char> &streamBuffer, const char* &pCur)
+{
+  static const char emptyLine[] = "\n\n";
+
+  size_t length = 0;
+  if (!streamBuffer.getNextLineView(pCur, length)) {
+    pCur = emptyLine;
+  }
+}
+
 // ------------------------------------------------------------------------------------------------
 bool PLY::ElementInstanceList::ParseInstanceList(
   IOStreamBuffer<char> &streamBuffer,
-  std::vector<char> &buffer,
+  const char* &pCur,
   const PLY::Element* pcElement,
   PLY::ElementInstanceList* p_pcOut,
   PLYImporter* loader)
 {
   ai_assert(NULL != pcElement);
-  const char* pCur = (const char*)&buffer[0];
 
   // parse all elements
   if (EEST_INVALID == pcElement->eSemantic || pcElement->alProperties.empty())
   {
-    // if the element has an unknown semantic we can skip all lines
-    // However, there could be comments
+    // if the element has an unknown semantic we can skip all lines,
+    // comments included
     for (unsigned int i = 0; i < pcElement->NumOccur; ++i)
     {
-      PLY::DOM::SkipComments(buffer);
-      PLY::DOM::SkipLine(buffer);
-      streamBuffer.getNextLine(buffer);
-      pCur = (buffer.empty()) ? NULL : (const char*)&buffer[0];
+      NextLine(streamBuffer, pCur);
     }
   }
   else
@@ -716,8 +727,7 @@ bool PLY::ElementInstanceList::ParseInstanceList(
         }
       }
 
-      streamBuffer.getNextLine(buffer);
-      pCur = (buffer.empty()) ? NULL : (const char*)&buffer[0];
+      NextLine(streamBuffer, pCur);
     }
   }
   return true;
@@ -399,8 +399,10 @@ public:
     std::vector< ElementInstance > alInstances;
 
     // -------------------------------------------------------------------
-    //! Parse an element instance list
-    static bool ParseInstanceList(IOStreamBuffer<char> &streamBuffer, std::vector<char> &buffer,
+    //! Parse an element instance list. pCur points to the first line of
+    //! the list and receives the first line behind it, lines are read
+    //! in place from the stream buffer.
+    static bool ParseInstanceList(IOStreamBuffer<char> &streamBuffer, const char* &pCur,
         const Element* pcElement, ElementInstanceList* p_pcOut, PLYImporter* loader);
 
     // -------------------------------------------------------------------
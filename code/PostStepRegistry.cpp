@@ -82,9 +82,18 @@ corresponding preprocessor flag to selectively disable steps.
 #ifndef ASSIMP_BUILD_NO_VALIDATEDS_PROCESS
 #   include "ValidateDataStructure.h"
 #endif
+#ifndef ASSIMP_BUILD_NO_GENERATELODS_PROCESS
+#   include "GenerateLODsProcess.h"
+#endif
 #ifndef ASSIMP_BUILD_NO_IMPROVECACHELOCALITY_PROCESS
 #   include "ImproveCacheLocality.h"
 #endif
+#ifndef ASSIMP_BUILD_NO_QUANTIZEVERTICES_PROCESS
+#   include "QuantizeVerticesProcess.h"
+#endif
+#ifndef ASSIMP_BUILD_NO_GENERATEMESHLETS_PROCESS
+#   include "GenerateMeshletsProcess.h"
+#endif
 #ifndef ASSIMP_BUILD_NO_FIXINFACINGNORMALS_PROCESS
 #   include "FixNormalsStep.h"
 #endif
@@ -222,9 +231,18 @@ void GetPostProcessingStepInstanceList(std::vector< BaseProcess* >& out)
 #if (!defined ASSIMP_BUILD_NO_LIMITBONEWEIGHTS_PROCESS)
     out.push_back( new LimitBoneWeightsProcess());
 #endif
+#if (!defined ASSIMP_BUILD_NO_GENERATELODS_PROCESS)
+    out.push_back( new GenerateLODsProcess());
+#endif
 #if (!defined ASSIMP_BUILD_NO_IMPROVECACHELOCALITY_PROCESS)
     out.push_back( new ImproveCacheLocalityProcess());
 #endif
+#if (!defined ASSIMP_BUILD_NO_QUANTIZEVERTICES_PROCESS)
+    out.push_back( new QuantizeVerticesProcess());
+#endif
+#if (!defined ASSIMP_BUILD_NO_GENERATEMESHLETS_PROCESS)
+    out.push_back( new GenerateMeshletsProcess());
+#endif
 }
 
 }
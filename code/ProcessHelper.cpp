@@ -175,6 +175,55 @@ ai_real ComputePositionEpsilon(const aiMesh* const* pMeshes, size_t num)
 }
 
 
+// -------------------------------------------------------------------------------
+SpatialLookup::SpatialLookup(const aiMesh* pMesh, unsigned int meshIndex,
+    SharedPostProcessInfo* shared, bool useGrid)
+    : mMesh(pMesh)
+    , mSort(NULL)
+    , mGrid(NULL)
+    , mEpsilon()
+    , mShared(false)
+{
+    // check whether we can reuse the index of a previous step
+    if (shared) {
+        if (useGrid) {
+            std::vector<std::pair<SpatialHashGrid,ai_real> >* avf;
+            shared->GetProperty(AI_SPP_SPATIAL_GRID,avf);
+            if (avf) {
+                mGrid = &(*avf)[meshIndex].first;
+                mEpsilon = (*avf)[meshIndex].second;
+                mShared = true;
+            }
+        } else {
+            std::vector<std::pair<SpatialSort,ai_real> >* avf;
+            shared->GetProperty(AI_SPP_SPATIAL_SORT,avf);
+            if (avf) {
+                mSort = &(*avf)[meshIndex].first;
+                mEpsilon = (*avf)[meshIndex].second;
+                mShared = true;
+            }
+        }
+    }
+    if (mShared) {
+        return;
+    }
+
+    // bad, need to compute it.
+    if (useGrid) {
+        mOwnGrid.Fill(pMesh->mVertices,pMesh->mNumVertices,sizeof(aiVector3D));
+        mGrid = &mOwnGrid;
+    } else {
+        mOwnSort.Fill(pMesh->mVertices,pMesh->mNumVertices,sizeof(aiVector3D));
+        mSort = &mOwnSort;
+    }
+}
+
+// -------------------------------------------------------------------------------
+ai_real SpatialLookup::GetPositionEpsilon() const
+{
+    return mShared ? mEpsilon : ComputePositionEpsilon(mMesh);
+}
+
 // -------------------------------------------------------------------------------
 unsigned int GetMeshVFormatUnique(const aiMesh* pcMesh)
 {
@@ -48,8 +48,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/material.h>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/scene.h>
+#include <assimp/Importer.hpp>
+#include <assimp/config.h>
 
 #include "SpatialSort.h"
+#include "SpatialHashGrid.h"
 #include "BaseProcess.h"
 #include "ParsingUtils.h"
 
@@ -333,24 +336,74 @@ const char* MappingTypeToString(aiTextureMapping in);
 // Split a mesh given a list of faces to be contained in the sub mesh
 aiMesh* MakeSubmesh(const aiMesh *superMesh, const std::vector<unsigned int> &subMeshFaces, unsigned int subFlags);
 
+// -------------------------------------------------------------------------------
+// Finds vertices close to a given position of a mesh, using either a SpatialSort
+// or, if #AI_CONFIG_PP_USE_SPATIAL_HASH_GRID is set, a SpatialHashGrid. The
+// index shared by ComputeSpatialSortProcess is reused if there is one, otherwise
+// a private one is built for the mesh.
+class SpatialLookup
+{
+public:
+    SpatialLookup(const aiMesh* pMesh, unsigned int meshIndex,
+        SharedPostProcessInfo* shared, bool useGrid);
+
+    void FindPositions( const aiVector3D& pPosition, ai_real pRadius,
+        std::vector<unsigned int>& poResults) const
+    {
+        if (mGrid) {
+            mGrid->FindPositions(pPosition,pRadius,poResults);
+        } else {
+            mSort->FindPositions(pPosition,pRadius,poResults);
+        }
+    }
+
+    void FindIdenticalPositions( const aiVector3D& pPosition,
+        std::vector<unsigned int>& poResults) const
+    {
+        if (mGrid) {
+            mGrid->FindIdenticalPositions(pPosition,poResults);
+        } else {
+            mSort->FindIdenticalPositions(pPosition,poResults);
+        }
+    }
+
+    // Position epsilon of the mesh, computed only if it was not shared
+    ai_real GetPositionEpsilon() const;
+
+private:
+    const aiMesh* mMesh;
+    const SpatialSort* mSort;
+    const SpatialHashGrid* mGrid;
+    SpatialSort mOwnSort;
+    SpatialHashGrid mOwnGrid;
+    ai_real mEpsilon;
+    bool mShared;
+};
+
 // -------------------------------------------------------------------------------
 // Utility postprocess step to share the spatial sort tree between
 // all steps which use it to speedup its computations.
 class ComputeSpatialSortProcess : public BaseProcess
 {
+    bool configUseGrid;
+
     bool IsActive( unsigned int pFlags) const
     {
         return NULL != shared && 0 != (pFlags & (aiProcess_CalcTangentSpace |
             aiProcess_GenNormals | aiProcess_JoinIdenticalVertices));
     }
 
-    void Execute( aiScene* pScene)
+    void SetupProperties(const Importer* pImp)
     {
-        typedef std::pair<SpatialSort, ai_real> _Type;
-        DefaultLogger::get()->debug("Generate spatially-sorted vertex cache");
+        configUseGrid = pImp->GetPropertyBool(AI_CONFIG_PP_USE_SPATIAL_HASH_GRID,false);
+    }
 
+    template <typename T>
+    void Compute( aiScene* pScene, const char* name)
+    {
+        typedef std::pair<T, ai_real> _Type;
         std::vector<_Type>* p = new std::vector<_Type>(pScene->mNumMeshes);
-        std::vector<_Type>::iterator it = p->begin();
+        typename std::vector<_Type>::iterator it = p->begin();
 
         for (unsigned int i = 0; i < pScene->mNumMeshes; ++i, ++it) {
             aiMesh* mesh = pScene->mMeshes[i];
@@ -359,7 +412,23 @@ class ComputeSpatialSortProcess : public BaseProcess
             blubb.second = ComputePositionEpsilon(mesh);
         }
 
-        shared->AddProperty(AI_SPP_SPATIAL_SORT,p);
+        shared->AddProperty(name,p);
+    }
+
+public:
+    ComputeSpatialSortProcess()
+        : configUseGrid(false)
+    {}
+
+    void Execute( aiScene* pScene)
+    {
+        DefaultLogger::get()->debug("Generate spatially-sorted vertex cache");
+
+        if (configUseGrid) {
+            Compute<SpatialHashGrid>(pScene,AI_SPP_SPATIAL_GRID);
+        } else {
+            Compute<SpatialSort>(pScene,AI_SPP_SPATIAL_SORT);
+        }
     }
 };
 
@@ -367,15 +436,27 @@ class ComputeSpatialSortProcess : public BaseProcess
 // ... and the same again to cleanup the whole stuff
 class DestroySpatialSortProcess : public BaseProcess
 {
+    bool configUseGrid;
+
     bool IsActive( unsigned int pFlags) const
     {
         return NULL != shared && 0 != (pFlags & (aiProcess_CalcTangentSpace |
             aiProcess_GenNormals | aiProcess_JoinIdenticalVertices));
     }
 
+    void SetupProperties(const Importer* pImp)
+    {
+        configUseGrid = pImp->GetPropertyBool(AI_CONFIG_PP_USE_SPATIAL_HASH_GRID,false);
+    }
+
+public:
+    DestroySpatialSortProcess()
+        : configUseGrid(false)
+    {}
+
     void Execute( aiScene* /*pScene*/)
     {
-        shared->RemoveProperty(AI_SPP_SPATIAL_SORT);
+        shared->RemoveProperty(configUseGrid ? AI_SPP_SPATIAL_GRID : AI_SPP_SPATIAL_SORT);
     }
 };
 
@@ -39,6 +39,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ----------------------------------------------------------------------
 */
 
+
 /** @file Profiler.h
  *  @brief Utility to measure the respective runtime of each import step
  */
@@ -47,9 +48,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <chrono>
 #include <assimp/DefaultLogger.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/ImportStatistics.hpp>
 #include "TinyFormatter.h"
 
-#include <map>
+#include <vector>
 
 namespace Assimp {
 namespace Profiling {
@@ -57,42 +60,159 @@ namespace Profiling {
 using namespace Formatter;
 
 // ------------------------------------------------------------------------------------------------
-/** Simple wrapper around boost::timer to simplify reporting. Timings are automatically
- *  dumped to the log file.
+/** Collects a tree of named timing regions into an #ImportStatistics structure.
+ *  Regions nest in the order they are begun. Timings are also dumped to the log file.
+ *  The profiler may only be used by one thread at a time.
  */
 class Profiler {
 public:
-    Profiler() {
-        // empty
+    /** Construct a profiler which appends its regions to the given root node.
+     *  The root node itself is timed until the profiler is destroyed.
+     *  @param root Node to collect the regions in
+     *  @param counter Optional callback to sample allocation counters */
+    explicit Profiler(ImportStatistics& root, AllocationCounter counter = NULL)
+        : counter(counter) {
+        Push(&root);
+    }
+
+    ~Profiler() {
+        while (!regions.empty()) {
+            Pop();
+        }
     }
 
 public:
 
-    /** Start a named timer */
+    /** Start a named timer, nested into the current one */
     void BeginRegion(const std::string& region) {
-        regions[region] = std::chrono::system_clock::now();
+        ImportStatistics* parent = regions.back().node;
+        parent->mChildren.push_back(ImportStatistics());
+        parent->mChildren.back().mName = region;
+
+        Push(&parent->mChildren.back());
         DefaultLogger::get()->debug((format("START `"),region,"`"));
     }
 
 
-    /** End a specific named timer and write its end time to the log */
+    /** End a specific named timer and write its end time to the log.
+     *  Regions nested into it which have not been ended yet, e.g. because
+     *  an exception was thrown, are ended as well. */
     void EndRegion(const std::string& region) {
-        RegionMap::const_iterator it = regions.find(region);
-        if (it == regions.end()) {
+        size_t index = regions.size();
+        while (index > 1 && regions[index-1].node->mName != region) {
+            --index;
+        }
+        if (index <= 1) {
             return;
         }
 
-        std::chrono::duration<double> elapsedSeconds = std::chrono::system_clock::now() - regions[region];
-        DefaultLogger::get()->debug((format("END   `"),region,"`, dt= ", elapsedSeconds.count()," s"));
+        while (regions.size() >= index) {
+            const double elapsedSeconds = Pop();
+            if (regions.size() < index) {
+                DefaultLogger::get()->debug((format("END   `"),region,"`, dt= ", elapsedSeconds," s"));
+            }
+        }
+    }
+
+    /** Add a value to a named counter of the current region */
+    void AddCounter(const std::string& name, double value) {
+        regions.back().node->mCounters[name] += value;
+    }
+
+    /** Add a value to a named counter of a mesh within the current region.
+     *  The counters of each mesh are kept in a 'mesh <index>' child node. */
+    void AddMeshCounter(unsigned int mesh, const std::string& name, double value) {
+        const std::string meshName = (format("mesh "), mesh);
+        ImportStatistics* parent = regions.back().node;
+
+        ImportStatistics* node = NULL;
+        if (!parent->mChildren.empty() && parent->mChildren.back().mName == meshName) {
+            node = &parent->mChildren.back();
+        }
+        else {
+            node = const_cast<ImportStatistics*>(parent->FindChild(meshName));
+            if (!node) {
+                parent->mChildren.push_back(ImportStatistics());
+                node = &parent->mChildren.back();
+                node->mName = meshName;
+            }
+        }
+        node->mCounters[name] += value;
     }
 
 private:
-    typedef std::map<std::string,std::chrono::time_point<std::chrono::system_clock>> RegionMap;
-    RegionMap regions;
+
+    struct Region {
+        ImportStatistics* node;
+        std::chrono::time_point<std::chrono::steady_clock> start;
+        uint64_t allocations;
+        uint64_t bytes;
+    };
+
+    void Push(ImportStatistics* node) {
+        Region r;
+        r.node = node;
+        SampleAllocations(r.allocations, r.bytes);
+        r.start = std::chrono::steady_clock::now();
+        regions.push_back(r);
+    }
+
+    double Pop() {
+        const Region& r = regions.back();
+        const std::chrono::duration<double> elapsedSeconds = std::chrono::steady_clock::now() - r.start;
+
+        uint64_t allocations, bytes;
+        SampleAllocations(allocations, bytes);
+
+        r.node->mSeconds += elapsedSeconds.count();
+        r.node->mAllocations += allocations - r.allocations;
+        r.node->mAllocatedBytes += bytes - r.bytes;
+        regions.pop_back();
+        return elapsedSeconds.count();
+    }
+
+    void SampleAllocations(uint64_t& allocations, uint64_t& bytes) const {
+        allocations = bytes = 0;
+        if (counter) {
+            counter(&allocations, &bytes);
+        }
+    }
+
+private:
+    AllocationCounter counter;
+    std::vector<Region> regions;
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Scoped helper to time a region if a profiler is given */
+class ProfileRegion {
+public:
+    ProfileRegion(Profiler* profiler, const char* region)
+        : profiler(profiler)
+        , region(region) {
+        if (profiler) {
+            profiler->BeginRegion(region);
+        }
+    }
+
+    ~ProfileRegion() {
+        End();
+    }
+
+    /** End the region before the object goes out of scope */
+    void End() {
+        if (profiler) {
+            profiler->EndRegion(region);
+            profiler = NULL;
+        }
+    }
+
+private:
+    Profiler* profiler;
+    const char* region;
 };
 
 }
 }
 
 #endif
-
@@ -0,0 +1,156 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file Implementation of the QuantizeVerticesProcess post processing step */
+
+#include "QuantizeVerticesProcess.h"
+#include "VertexQuantization.h"
+#include "StringUtils.h"
+#include "qnan.h"
+#include <assimp/postprocess.h>
+#include <assimp/DefaultLogger.hpp>
+#include <assimp/scene.h>
+
+using namespace Assimp;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+void QuantizeInBounds(aiVector3D* v, unsigned int num)
+{
+    const Quantization::Bounds bounds(v,num);
+    uint16_t q[3];
+    for (unsigned int i = 0; i < num; ++i) {
+        bounds.Encode(v[i],q);
+        v[i] = bounds.Decode(q);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void QuantizeDirections(aiVector3D* v, unsigned int num)
+{
+    int16_t q[2];
+    for (unsigned int i = 0; i < num; ++i) {
+        // keep the qNaNs of point and line vertices
+        if (is_qnan(v[i].x)) {
+            continue;
+        }
+        Quantization::EncodeOctahedral(v[i],q);
+        v[i] = Quantization::DecodeOctahedral(q);
+    }
+}
+
+} // anonymous namespace
+
+// ------------------------------------------------------------------------------------------------
+// Constructor to be privately used by Importer
+QuantizeVerticesProcess::QuantizeVerticesProcess()
+{
+    // nothing to do here
+}
+
+// ------------------------------------------------------------------------------------------------
+// Destructor, private as well
+QuantizeVerticesProcess::~QuantizeVerticesProcess()
+{
+    // nothing to do here
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns whether the processing step is present in the given flag field.
+bool QuantizeVerticesProcess::IsActive( unsigned int pFlags) const
+{
+    return (pFlags & aiProcess_QuantizeVertices) != 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Executes the post processing step on the given imported data.
+void QuantizeVerticesProcess::Execute( aiScene* pScene)
+{
+    if (!pScene->mNumMeshes) {
+        DefaultLogger::get()->debug("QuantizeVerticesProcess skipped; there are no meshes");
+        return;
+    }
+
+    DefaultLogger::get()->debug("QuantizeVerticesProcess begin");
+
+    ExecutePerMesh( pScene, [&]( unsigned int a) {
+        ProcessMesh( pScene->mMeshes[a]);
+    });
+
+    if (!DefaultLogger::isNullLogger()) {
+        unsigned int numVertices = 0;
+        for (unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
+            numVertices += pScene->mMeshes[a]->mNumVertices;
+        }
+        char szBuff[128]; // should be sufficiently large in every case
+        ai_snprintf(szBuff,128,"QuantizeVerticesProcess finished. Quantized %u vertices",numVertices);
+        DefaultLogger::get()->info(szBuff);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Quantizes the vertex components of a single mesh
+void QuantizeVerticesProcess::ProcessMesh( aiMesh* pMesh)
+{
+    const unsigned int num = pMesh->mNumVertices;
+    if (pMesh->mVertices) {
+        QuantizeInBounds(pMesh->mVertices,num);
+    }
+    if (pMesh->mNormals) {
+        QuantizeDirections(pMesh->mNormals,num);
+    }
+    if (pMesh->mTangents && pMesh->mBitangents) {
+        QuantizeDirections(pMesh->mTangents,num);
+        QuantizeDirections(pMesh->mBitangents,num);
+    }
+    for (unsigned int c = 0; pMesh->HasTextureCoords(c); ++c) {
+        QuantizeInBounds(pMesh->mTextureCoords[c],num);
+    }
+    for (unsigned int c = 0; pMesh->HasVertexColors(c); ++c) {
+        aiColor4D* colors = pMesh->mColors[c];
+        for (unsigned int i = 0; i < num; ++i) {
+            for (unsigned int k = 0; k < 4; ++k) {
+                colors[i][k] = Quantization::DecodeUnorm8(Quantization::EncodeUnorm8(colors[i][k]));
+            }
+        }
+    }
+}
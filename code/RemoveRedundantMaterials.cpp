@@ -50,6 +50,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ProcessHelper.h"
 #include "MaterialSystem.h"
 #include <stdio.h>
+#include <unordered_map>
 
 using namespace Assimp;
 
@@ -135,10 +136,11 @@ void RemoveRedundantMatsProcess::Execute( aiScene* pScene)
         unsigned int iNewNum = 0;
 
         // Iterate through all materials and calculate a hash for them
-        // store all hashes in a list and so a quick search whether
-        // we do already have a specific hash. This allows us to
-        // determine which materials are identical.
-        uint32_t *aiHashes = new uint32_t[ pScene->mNumMaterials ];;
+        // and keep the first material for each hash in a map, so we
+        // can quickly search whether we do already have a specific hash.
+        // This allows us to determine which materials are identical.
+        std::unordered_map<uint32_t, unsigned int> firstByHash;
+        firstByHash.reserve(pScene->mNumMaterials);
         for (unsigned int i = 0; i < pScene->mNumMaterials;++i)
         {
             // No mesh is referencing this material, remove it.
@@ -150,21 +152,18 @@ void RemoveRedundantMatsProcess::Execute( aiScene* pScene)
 
             // Check all previously mapped materials for a matching hash.
             // On a match we can delete this material and just make it ref to the same index.
-            uint32_t me = aiHashes[i] = ComputeMaterialHash(pScene->mMaterials[i]);
-            for (unsigned int a = 0; a < i;++a)
-            {
-                if (abReferenced[a] && me == aiHashes[a]) {
-                    ++redundantRemoved;
-                    me = 0;
-                    aiMappingTable[i] = aiMappingTable[a];
-                    delete pScene->mMaterials[i];
-                    break;
-                }
+            const uint32_t me = ComputeMaterialHash(pScene->mMaterials[i]);
+            std::unordered_map<uint32_t, unsigned int>::const_iterator it = firstByHash.find(me);
+            if (it != firstByHash.end()) {
+                ++redundantRemoved;
+                aiMappingTable[i] = aiMappingTable[(*it).second];
+                delete pScene->mMaterials[i];
+                continue;
             }
+
             // This is a new material that is referenced, add to the map.
-            if (me) {
-                aiMappingTable[i] = iNewNum++;
-            }
+            firstByHash[me] = i;
+            aiMappingTable[i] = iNewNum++;
         }
         // If the new material count differs from the original,
         // we need to rebuild the material list and remap mesh material indexes.
@@ -202,7 +201,6 @@ void RemoveRedundantMatsProcess::Execute( aiScene* pScene)
             pScene->mNumMaterials = iNewNum;
         }
         // delete temporary storage
-        delete[] aiHashes;
         delete[] aiMappingTable;
     }
     if (redundantRemoved == 0 && unreferencedRemoved == 0)
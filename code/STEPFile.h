@@ -42,6 +42,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef INCLUDED_AI_STEPFILE_H
 #define INCLUDED_AI_STEPFILE_H
 
+#include <atomic>
 #include <bitset>
 #include <memory>
 #include <typeinfo>
@@ -81,6 +82,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace Assimp {
 
+class ThreadPool;
+
 // ********************************************************************************
 // before things get complicated, this is the basic outline:
 
@@ -592,25 +595,29 @@ namespace STEP {
         friend class DB;
     public:
 
-        LazyObject(DB& db, uint64_t id, uint64_t line, const char* type,const char* args);
+        // args points to the argument tuple in the file buffer of the DB, which
+        // stays alive as long as the DB. It is parsed in place on first access.
+        LazyObject(DB& db, uint64_t id, const char* type,const char* args);
         ~LazyObject();
 
     public:
 
         Object& operator * () {
-            if (!obj) {
-                LazyInit();
-                ai_assert(obj);
+            Object* o = obj.load(std::memory_order_acquire);
+            if (!o) {
+                o = LazyInit();
+                ai_assert(o);
             }
-            return *obj;
+            return *o;
         }
 
         const Object& operator * () const {
-            if (!obj) {
-                LazyInit();
-                ai_assert(obj);
+            Object* o = obj.load(std::memory_order_acquire);
+            if (!o) {
+                o = LazyInit();
+                ai_assert(o);
             }
-            return *obj;
+            return *o;
         }
 
         template <typename T>
@@ -653,9 +660,20 @@ namespace STEP {
             return id;
         }
 
+        const char* GetType() const {
+            return type;
+        }
+
+        // the unparsed argument tuple of the record, as found in the file
+        const char* GetArgs() const {
+            return args;
+        }
+
     private:
 
-        void LazyInit() const;
+        // may be entered by several threads at once, the first object
+        // to be published wins and all threads return that one.
+        Object* LazyInit() const;
 
     private:
 
@@ -663,8 +681,8 @@ namespace STEP {
         const char* const type;
         DB& db;
 
-        mutable const char* args;
-        mutable Object* obj;
+        const char* const args;
+        mutable std::atomic<Object*> obj;
     };
 
     template <typename T>
@@ -828,7 +846,8 @@ namespace STEP {
         friend DB* ReadFileHeader(std::shared_ptr<IOStream> stream);
         friend void ReadFile(DB& db,const EXPRESS::ConversionSchema& scheme,
             const char* const* types_to_track, size_t len,
-            const char* const* inverse_indices_to_track, size_t len2
+            const char* const* inverse_indices_to_track, size_t len2,
+            ThreadPool* pool, size_t chunk_size
         );
 
         friend class LazyObject;
@@ -858,6 +877,7 @@ namespace STEP {
         DB(std::shared_ptr<StreamReaderLE> reader)
             : reader(reader)
             , splitter(*reader,true,true)
+            , data_begin()
             , evaluated_count()
             , schema( NULL )
         {}
@@ -877,7 +897,7 @@ namespace STEP {
         }
 
         uint64_t GetEvaluatedObjectCount() const {
-            return evaluated_count;
+            return evaluated_count.load();
         }
 
         const HeaderInfo& GetHeader() const {
@@ -964,13 +984,18 @@ namespace STEP {
             return splitter;
         }
 
-        void InternInsert(const LazyObject* lz) {
-            objects[lz->GetID()] = lz;
+        // returns false if an object with the same id was replaced. Objects
+        // are usually inserted in ascending order, so hint at the end.
+        bool InternInsert(const LazyObject* lz) {
+            const ObjectMap::iterator oit = objects.insert(objects.end(), ObjectMap::value_type(lz->GetID(), lz));
+            const bool inserted = (*oit).second == lz;
+            (*oit).second = lz;
 
             const ObjectMapByType::iterator it = objects_bytype.find( lz->type );
             if (it != objects_bytype.end()) {
                 (*it).second.insert(lz);
             }
+            return inserted;
         }
 
         void SetSchema(const EXPRESS::ConversionSchema& _schema) {
@@ -1008,7 +1033,9 @@ namespace STEP {
         InverseWhitelist inv_whitelist;
         std::shared_ptr<StreamReaderLE> reader;
         LineSplitter splitter;
-        uint64_t evaluated_count;
+        // start of the DATA section in the buffer of the reader
+        char* data_begin;
+        std::atomic<uint64_t> evaluated_count;
         const EXPRESS::ConversionSchema* schema;
     };
 
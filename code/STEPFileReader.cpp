@@ -48,7 +48,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "STEPFileEncoding.h"
 #include "TinyFormatter.h"
 #include "fast_atof.h"
+#include "ThreadPool.h"
+#include "Hash.h"
+#include <algorithm>
 #include <memory>
+#include <string.h>
 
 
 using namespace Assimp;
@@ -100,8 +104,10 @@ STEP::DB* STEP::ReadFileHeader(std::shared_ptr<IOStream> stream)
     for(++splitter; splitter; ++splitter) {
         const std::string& s = *splitter;
         if (s == "DATA;") {
-            // here we go, header done, start of data section
-            ++splitter;
+            // here we go, header done, start of data section. The splitter
+            // already stands behind the line, the entities are scanned
+            // directly in the buffer of the reader by ReadFile().
+            db->data_begin = reinterpret_cast<char*>(reader->GetPtr());
             break;
         }
 
@@ -138,6 +144,9 @@ STEP::DB* STEP::ReadFileHeader(std::shared_ptr<IOStream> stream)
         // XXX handle more header fields
     }
 
+    if (!db->data_begin) {
+        throw STEP::SyntaxError("expected DATA section");
+    }
     return db.release();
 }
 
@@ -145,155 +154,310 @@ STEP::DB* STEP::ReadFileHeader(std::shared_ptr<IOStream> stream)
 namespace {
 
 // ------------------------------------------------------------------------------------------------
-// check whether the given line contains an entity definition (i.e. starts with "#<number>=")
-bool IsEntityDef(const std::string& snext)
+// check whether the line starting at the given position contains an entity definition (i.e.
+// starts with "#<number>="). Entity records never continue past such a line, which is what
+// allows splitting the DATA section into chunks without parsing it.
+bool IsEntityDef(const char* cur, const char* end)
 {
-    if (snext[0] == '#') {
-        // it is only a new entity if it has a '=' after the
-        // entity ID.
-        for(std::string::const_iterator it = snext.begin()+1; it != snext.end(); ++it) {
-            if (*it == '=') {
-                return true;
-            }
-            if ((*it < '0' || *it > '9') && *it != ' ') {
-                break;
-            }
+    for(; cur != end && IsSpace(*cur); ++cur);
+    if (cur == end || *cur != '#') {
+        return false;
+    }
+    // it is only a new entity if it has a '=' after the
+    // entity ID.
+    for(++cur; cur != end; ++cur) {
+        if (*cur == '=') {
+            return true;
+        }
+        if ((*cur < '0' || *cur > '9') && *cur != ' ') {
+            break;
         }
     }
     return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+// get the beginning of the next line
+inline char* NextLine(char* cur, const char* end)
+{
+    char* const eol = static_cast<char*>(::memchr(cur,'\n',static_cast<size_t>(end-cur)));
+    return eol ? eol+1 : const_cast<char*>(end);
 }
 
+// ------------------------------------------------------------------------------------------------
+// find the first line at or after the given position which contains an entity definition
+char* FindEntityDef(const char* begin, char* cur, const char* end)
+{
+    if (cur != begin && cur[-1] != '\n') {
+        cur = NextLine(cur,end);
+    }
+    while (cur != end && !IsEntityDef(cur,end)) {
+        cur = NextLine(cur,end);
+    }
+    return cur;
+}
 
 // ------------------------------------------------------------------------------------------------
-void STEP::ReadFile(DB& db,const EXPRESS::ConversionSchema& scheme,
-    const char* const* types_to_track, size_t len,
-    const char* const* inverse_indices_to_track, size_t len2)
+// collect the references of an entity to simulate STEPs INVERSE fields
+void CollectRefs(const char* a, uint64_t id, std::vector< std::pair<uint64_t,uint64_t> >& refs)
 {
-    db.SetSchema(scheme);
-    db.SetTypesToTrack(types_to_track,len);
-    db.SetInverseIndicesToTrack(inverse_indices_to_track,len2);
+    // do a quick scan through the argument tuple and watch out for entity references
+    int64_t skip_depth = 0;
+    while(*a) {
+        if (*a == '(') {
+            ++skip_depth;
+        }
+        else if (*a == ')') {
+            --skip_depth;
+        }
 
-    const DB::ObjectMap& map = db.GetObjects();
-    LineSplitter& splitter = db.GetSplitter();
+        if (skip_depth >= 1 && *a=='#') {
+            const char* tmp;
+            const int64_t num = static_cast<int64_t>( strtoul10_64(a+1,&tmp) );
+            refs.push_back(std::make_pair(num,id));
+        }
+        ++a;
+    }
+}
 
-    while (splitter) {
-        bool has_next = false;
-        std::string s = *splitter;
-        if (s == "ENDSEC;") {
-            break;
+// ------------------------------------------------------------------------------------------------
+// A part of the DATA section, starting with an entity definition. The entities of a chunk
+// are collected first and inserted into the DB in file order once all chunks are scanned.
+struct EntityChunk
+{
+    struct Record {
+        STEP::LazyObject* obj;
+        uint64_t line;
+    };
+
+    EntityChunk(char* begin, char* end)
+        : begin(begin)
+        , end(end)
+        , lines()
+        , endsec()
+    {}
+
+    char* begin;
+    char* end;
+
+    std::vector<Record> records;
+    std::vector< std::pair<uint64_t,uint64_t> > refs;
+
+    // warnings, prefixed by the number of the line in the chunk
+    std::vector< std::pair<uint64_t,std::string> > warnings;
+
+    // number of line breaks in the chunk, to compute line numbers
+    uint64_t lines;
+
+    // true if the chunk contains the end of the DATA section
+    bool endsec;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Scan the entity records of a chunk in place. The argument tuples are terminated in the buffer
+// by replacing the ';' behind them, so neither the records nor their lines are copied.
+void ScanEntities(STEP::DB& db, const EXPRESS::ConversionSchema& scheme, EntityChunk& chunk, const char* data_end)
+{
+    char* cur = chunk.begin;
+    char* const end = chunk.end;
+    uint64_t line = 0;
+
+    // reused for all type names, so this doesn't allocate per entity
+    std::string type;
+    type.reserve(64);
+
+    while (cur != end) {
+        if (*cur == '\n') {
+            ++line;
+        }
+        if (IsSpaceOrNewLine(*cur)) {
+            ++cur;
+            continue;
         }
-        s.erase(std::remove(s.begin(), s.end(), ' '), s.end());
 
-        // want one-based line numbers for human readers, so +1
-        const uint64_t line = splitter.get_index()+1;
-        // LineSplitter already ignores empty lines
-        ai_assert(s.length());
-        if (s[0] != '#') {
-            DefaultLogger::get()->warn(AddLineNumber("expected token \'#\'",line));
-            ++splitter;
+        const uint64_t first_line = line;
+        if (*cur != '#') {
+            if (end - cur >= 7 && !::strncmp(cur,"ENDSEC;",7)) {
+                chunk.endsec = true;
+                break;
+            }
+            chunk.warnings.push_back(std::make_pair(line,std::string("expected token \'#\'")));
+            cur = NextLine(cur,end);
+            ++line;
             continue;
         }
+
         // ---
         // extract id, entity class name and argument string,
         // but don't create the actual object yet.
         // ---
-        const std::string::size_type n0 = s.find_first_of('=');
-        if (n0 == std::string::npos) {
-            DefaultLogger::get()->warn(AddLineNumber("expected token \'=\'",line));
-            ++splitter;
+        uint64_t id = 0;
+        for(++cur; cur != end && ((*cur >= '0' && *cur <= '9') || *cur == ' '); ++cur) {
+            if (*cur != ' ') {
+                id = id * 10 + static_cast<uint64_t>(*cur - '0');
+            }
+        }
+        if (cur == end || *cur != '=') {
+            chunk.warnings.push_back(std::make_pair(line,std::string("expected token \'=\'")));
+            if (cur != end) {
+                cur = NextLine(cur,end);
+                ++line;
+            }
             continue;
         }
-
-        const uint64_t id = strtoul10_64(s.substr(1,n0-1).c_str());
         if (!id) {
-            DefaultLogger::get()->warn(AddLineNumber("expected positive, numeric entity id",line));
-            ++splitter;
+            chunk.warnings.push_back(std::make_pair(line,std::string("expected positive, numeric entity id")));
+            cur = NextLine(cur,end);
+            ++line;
             continue;
         }
-        std::string::size_type n1 = s.find_first_of('(',n0);
-        if (n1 == std::string::npos) {
-            has_next = true;
-            bool ok = false;
-            for( ++splitter; splitter; ++splitter) {
-                const std::string& snext = *splitter;
-                if (snext.empty()) {
-                    continue;
-                }
 
-                // the next line doesn't start an entity, so maybe it is
-                // just a continuation  for this line, keep going
-                if (!IsEntityDef(snext)) {
-                    s.append(snext);
-                    n1 = s.find_first_of('(',n0);
-                    ok = (n1 != std::string::npos);
-                }
-                else {
+        // find the argument tuple and the ';' terminating the record. String literals may contain
+        // parentheses, but a record never continues past a line holding an entity definition.
+        char* const type_begin = ++cur;
+        char* args = NULL;
+        char* args_end = NULL;
+        int depth = 0;
+        bool literal = false;
+        for(; cur != end; ++cur) {
+            const char c = *cur;
+            if (c == '\n') {
+                ++line;
+                if (IsEntityDef(cur+1,data_end)) {
+                    ++cur;
                     break;
                 }
             }
-
-            if(!ok) {
-                DefaultLogger::get()->warn(AddLineNumber("expected token \'(\'",line));
+            else if (c == '\'') {
+                literal = !literal;
+            }
+            else if (literal) {
                 continue;
             }
-        }
-
-        std::string::size_type n2 = s.find_last_of(')');
-        if (n2 == std::string::npos || n2 < n1 || n2 == s.length() - 1 || s[n2 + 1] != ';') {
-
-            has_next = true;
-            bool ok = false;
-            for( ++splitter; splitter; ++splitter) {
-                const std::string& snext = *splitter;
-                if (snext.empty()) {
-                    continue;
+            else if (c == '(') {
+                if (!depth++ && !args) {
+                    args = cur;
                 }
-                // the next line doesn't start an entity, so maybe it is
-                // just a continuation  for this line, keep going
-                if (!IsEntityDef(snext)) {
-                    s.append(snext);
-                    n2 = s.find_last_of(')');
-                    ok = !(n2 == std::string::npos || n2 < n1 || n2 == s.length() - 1 || s[n2 + 1] != ';');
-                }
-                else {
-                    break;
+            }
+            else if (c == ')') {
+                if (depth && !--depth) {
+                    args_end = cur;
                 }
             }
-            if(!ok) {
-                DefaultLogger::get()->warn(AddLineNumber("expected token \')\'",line));
-                continue;
+            else if (c == ';' && !depth && args_end) {
+                break;
             }
         }
 
-        if (map.find(id) != map.end()) {
-            DefaultLogger::get()->warn(AddLineNumber((Formatter::format(),"an object with the id #",id," already exists"),line));
+        if (!args) {
+            chunk.warnings.push_back(std::make_pair(first_line,std::string("expected token \'(\'")));
+            continue;
+        }
+        if (cur == end || *cur != ';') {
+            chunk.warnings.push_back(std::make_pair(first_line,std::string("expected token \')\'")));
+            continue;
         }
+        *cur++ = '\0';
 
-        std::string::size_type ns = n0;
-        do ++ns; while( IsSpace(s.at(ns)));
-        std::string::size_type ne = n1;
-        do --ne; while( IsSpace(s.at(ne)));
-        std::string type = s.substr(ns,ne-ns+1);
+        const char* ns = type_begin;
+        while (IsSpaceOrNewLine(*ns)) {
+            ++ns;
+        }
+        const char* ne = args;
+        while (ne != ns && IsSpaceOrNewLine(ne[-1])) {
+            --ne;
+        }
+        type.assign(ns,ne);
         std::transform( type.begin(), type.end(), type.begin(), &Assimp::ToLower<char>  );
+
         const char* sz = scheme.GetStaticStringForToken(type);
         if(sz) {
-            const std::string::size_type len = n2-n1+1;
-            char* const copysz = new char[len+1];
-            std::copy(s.c_str()+n1,s.c_str()+n2+1,copysz);
-            copysz[len] = '\0';
-            db.InternInsert(new LazyObject(db,id,line,sz,copysz));
+            EntityChunk::Record record = { new STEP::LazyObject(db,id,sz,args), first_line };
+            chunk.records.push_back(record);
+            if (db.KeepInverseIndicesForType(sz)) {
+                CollectRefs(args,id,chunk.refs);
+            }
         }
-        if(!has_next) {
-            ++splitter;
+    }
+
+    // count the remaining line breaks, this is only relevant if the chunk
+    // ended early - the line numbers of the following chunks are not used then.
+    chunk.lines = line + static_cast<uint64_t>(std::count(cur, end, '\n'));
+}
+
+}
+
+
+// ------------------------------------------------------------------------------------------------
+void STEP::ReadFile(DB& db,const EXPRESS::ConversionSchema& scheme,
+    const char* const* types_to_track, size_t len,
+    const char* const* inverse_indices_to_track, size_t len2,
+    ThreadPool* pool, size_t chunk_size)
+{
+    db.SetSchema(scheme);
+    db.SetTypesToTrack(types_to_track,len);
+    db.SetInverseIndicesToTrack(inverse_indices_to_track,len2);
+
+    StreamReaderLE& reader = *db.reader;
+    char* const data_begin = db.data_begin;
+    char* const data_end = reinterpret_cast<char*>(reader.GetPtr()) + reader.GetRemainingSize();
+    const char* const file_begin = reinterpret_cast<const char*>(reader.GetPtr()) - reader.GetCurrentPos();
+
+    // split the DATA section at lines starting with an entity definition
+    std::vector<EntityChunk> chunks;
+    if (pool && chunk_size && static_cast<size_t>(data_end - data_begin) >= 2 * chunk_size) {
+        char* pos = data_begin;
+        while (pos != data_end) {
+            char* const next = static_cast<size_t>(data_end - pos) > chunk_size ? FindEntityDef(data_begin, pos + chunk_size, data_end) : data_end;
+            chunks.push_back(EntityChunk(pos,next));
+            pos = next;
+        }
+    }
+    else {
+        chunks.push_back(EntityChunk(data_begin,data_end));
+    }
+
+    if (chunks.size() > 1) {
+        pool->ParallelFor(chunks.size(), [&db, &scheme, &chunks, data_end](size_t i) {
+            ScanEntities(db, scheme, chunks[i], data_end);
+        });
+    }
+    else {
+        ScanEntities(db, scheme, chunks[0], data_end);
+    }
+
+    // insert the objects and references in file order and report all issues with
+    // one-based line numbers for human readers
+    uint64_t line = static_cast<uint64_t>(std::count(file_begin, static_cast<const char*>(data_begin), '\n')) + 1;
+    bool endsec = false;
+    for(EntityChunk& chunk : chunks) {
+        if (endsec) {
+            // nothing behind ENDSEC is part of the DATA section
+            for(EntityChunk::Record& record : chunk.records) {
+                delete record.obj;
+            }
+            continue;
+        }
+        for(const std::pair<uint64_t,std::string>& warning : chunk.warnings) {
+            DefaultLogger::get()->warn(AddLineNumber(warning.second,line + warning.first));
         }
+        for(const EntityChunk::Record& record : chunk.records) {
+            if (!db.InternInsert(record.obj)) {
+                DefaultLogger::get()->warn(AddLineNumber((Formatter::format(),"an object with the id #",record.obj->GetID()," already exists"),line + record.line));
+            }
+        }
+        for(const std::pair<uint64_t,uint64_t>& ref : chunk.refs) {
+            db.MarkRef(ref.first,ref.second);
+        }
+        line += chunk.lines;
+        endsec = chunk.endsec;
     }
 
-    if (!splitter) {
+    if (!endsec) {
         DefaultLogger::get()->warn("STEP: ignoring unexpected EOF");
     }
 
+    const DB::ObjectMap& map = db.GetObjects();
     if ( !DefaultLogger::isNullLogger()){
         DefaultLogger::get()->debug((Formatter::format(),"STEP: got ",map.size()," object records with ",
             db.GetRefs().size()," inverse index entries"));
@@ -303,8 +467,9 @@ void STEP::ReadFile(DB& db,const EXPRESS::ConversionSchema& scheme,
 // ------------------------------------------------------------------------------------------------
 std::shared_ptr<const EXPRESS::DataType> EXPRESS::DataType::Parse(const char*& inout,uint64_t line, const EXPRESS::ConversionSchema* schema /*= NULL*/)
 {
+    // records are parsed in place, so they may contain line breaks
     const char* cur = inout;
-    SkipSpaces(&cur);
+    SkipSpacesAndLineEnd(&cur);
     if (*cur == ',' || IsSpaceOrNewLine(*cur)) {
         throw STEP::SyntaxError("unexpected token, expected parameter",line);
     }
@@ -317,7 +482,7 @@ std::shared_ptr<const EXPRESS::DataType> EXPRESS::DataType::Parse(const char*& i
                 if (!ok) {
                     break;
                 }
-                for(--t;IsSpace(*t);--t);
+                for(--t;IsSpaceOrNewLine(*t);--t);
                 std::string s(cur,static_cast<size_t>(t-cur+1));
                 std::transform(s.begin(),s.end(),s.begin(),&ToLower<char> );
                 if (schema->IsKnownToken(s)) {
@@ -328,7 +493,7 @@ std::shared_ptr<const EXPRESS::DataType> EXPRESS::DataType::Parse(const char*& i
                 }
                 break;
             }
-            else if (!IsSpace(*t)) {
+            else if (!IsSpaceOrNewLine(*t)) {
                 ok = true;
             }
         }
@@ -389,6 +554,10 @@ std::shared_ptr<const EXPRESS::DataType> EXPRESS::DataType::Parse(const char*& i
         // assimp is supposed to output UTF8 strings, so we have to deal
         // with foreign encodings.
         std::string stemp = std::string(start, static_cast<size_t>(cur - start));
+
+        // line breaks are not part of the literal, they stem from wrapped lines
+        stemp.erase(std::remove(stemp.begin(), stemp.end(), '\n'), stemp.end());
+        stemp.erase(std::remove(stemp.begin(), stemp.end(), '\r'), stemp.end());
         if(!StringToUTF8(stemp)) {
             // TODO: route this to a correct logger with line numbers etc., better error messages
             DefaultLogger::get()->error("an error occurred reading escape sequences in ASCII text");
@@ -403,7 +572,7 @@ std::shared_ptr<const EXPRESS::DataType> EXPRESS::DataType::Parse(const char*& i
     // else -- must be a number. if there is a decimal dot in it,
     // parse it as real value, otherwise as integer.
     const char* start = cur;
-    for(;*cur  && *cur != ',' && *cur != ')' && !IsSpace(*cur);++cur) {
+    for(;*cur  && *cur != ',' && *cur != ')' && !IsSpaceOrNewLine(*cur);++cur) {
         if (*cur == '.') {
             double f;
             inout = fast_atoreal_move<double>(start,f);
@@ -447,13 +616,13 @@ std::shared_ptr<const EXPRESS::LIST> EXPRESS::LIST::Parse(const char*& inout,uin
         if (!*cur) {
             throw STEP::SyntaxError("unexpected end of line while reading list");
         }
-        SkipSpaces(cur,&cur);
+        SkipSpacesAndLineEnd(cur,&cur);
         if (*cur == ')') {
             break;
         }
 
         members.push_back( EXPRESS::DataType::Parse(cur,line,schema));
-        SkipSpaces(cur,&cur);
+        SkipSpacesAndLineEnd(cur,&cur);
 
         if (*cur != ',') {
             if (*cur == ')') {
@@ -469,51 +638,80 @@ std::shared_ptr<const EXPRESS::LIST> EXPRESS::LIST::Parse(const char*& inout,uin
 
 
 // ------------------------------------------------------------------------------------------------
-STEP::LazyObject::LazyObject(DB& db, uint64_t id,uint64_t /*line*/, const char* const type,const char* args)
-    : id(id)
-    , type(type)
-    , db(db)
-    , args(args)
-    , obj()
+uint64_t STEP::HashEntityContents(const DB& db, uint64_t id, std::map<uint64_t,uint64_t>& memo)
 {
-    // find any external references and store them in the database.
-    // this helps us emulate STEPs INVERSE fields.
-    if (db.KeepInverseIndicesForType(type)) {
-        const char* a  = args;
-
-        // do a quick scan through the argument tuple and watch out for entity references
-        int64_t skip_depth = 0;
-        while(*a) {
-            if (*a == '(') {
-                ++skip_depth;
-            }
-            else if (*a == ')') {
-                --skip_depth;
-            }
+    const std::map<uint64_t,uint64_t>::const_iterator it = memo.find(id);
+    if (it != memo.end()) {
+        return (*it).second;
+    }
+
+    const LazyObject* const lz = db.GetObject(id);
+    if (!lz) {
+        // dangling reference, keep it apart from everything else
+        return MurmurHash64A(&id,sizeof id);
+    }
 
-            if (skip_depth >= 1 && *a=='#') {
-                const char* tmp;
-                const int64_t num = static_cast<int64_t>( strtoul10_64(a+1,&tmp) );
-                db.MarkRef(num,id);
+    // this is what a reference cycle would see. There are none in
+    // geometric data, but the recursion needs to end anyway.
+    memo[id] = 0;
+
+    std::string buffer = lz->GetType();
+    for(const char* cur = lz->GetArgs(); *cur; ++cur) {
+        if (*cur == '\'') {
+            // string literals are taken verbatim, they may contain anything
+            buffer += *cur;
+            while (*++cur) {
+                buffer += *cur;
+                if (*cur == '\'') {
+                    if (cur[1] != '\'') {
+                        break;
+                    }
+                    buffer += *++cur;
+                }
+            }
+            if (!*cur) {
+                break;
             }
-            ++a;
         }
+        else if (*cur == '#' && cur[1] >= '0' && cur[1] <= '9') {
+            const uint64_t ref = strtoul10_64(cur+1,&cur);
+            --cur;
 
+            const uint64_t hash = HashEntityContents(db,ref,memo);
+            buffer += '#';
+            buffer.append(reinterpret_cast<const char*>(&hash),sizeof hash);
+        }
+        else if (!IsSpaceOrNewLine(*cur)) {
+            buffer += *cur;
+        }
     }
+
+    const uint64_t hash = MurmurHash64A(buffer.data(),buffer.length());
+    memo[id] = hash;
+    return hash;
+}
+
+// ------------------------------------------------------------------------------------------------
+STEP::LazyObject::LazyObject(DB& db, uint64_t id, const char* const type,const char* args)
+    : id(id)
+    , type(type)
+    , db(db)
+    , args(args)
+    , obj()
+{
+    // references to this object are collected by ReadFile()
 }
 
 // ------------------------------------------------------------------------------------------------
 STEP::LazyObject::~LazyObject()
 {
-    // make sure the right dtor/operator delete get called
-    if (obj) {
-        delete obj;
-    }
-    else delete[] args;
+    // make sure the right dtor/operator delete get called. The
+    // arguments are part of the file buffer owned by the DB.
+    delete obj.load();
 }
 
 // ------------------------------------------------------------------------------------------------
-void STEP::LazyObject::LazyInit() const
+STEP::Object* STEP::LazyObject::LazyInit() const
 {
     const EXPRESS::ConversionSchema& schema = db.GetSchema();
     STEP::ConvertObjectProc proc = schema.GetConverterProc(type);
@@ -524,21 +722,28 @@ void STEP::LazyObject::LazyInit() const
 
     const char* acopy = args;
     std::shared_ptr<const EXPRESS::LIST> conv_args = EXPRESS::LIST::Parse(acopy,STEP::SyntaxError::LINE_NOT_SPECIFIED,&db.GetSchema());
-    delete[] args;
-    args = NULL;
 
     // if the converter fails, it should throw an exception, but it should never return NULL
+    std::unique_ptr<Object> o;
     try {
-        obj = proc(db,*conv_args);
+        o.reset(proc(db,*conv_args));
     }
     catch(const TypeError& t) {
         // augment line and entity information
         throw TypeError(t.what(),id);
     }
-    ++db.evaluated_count;
-    ai_assert(obj);
+    ai_assert(o);
 
     // store the original id in the object instance
-    obj->SetID(id);
+    o->SetID(id);
+
+    // another thread may have converted the same record in the meantime,
+    // in which case we drop our copy and take theirs.
+    Object* expected = NULL;
+    if (!obj.compare_exchange_strong(expected,o.get(),std::memory_order_acq_rel,std::memory_order_acquire)) {
+        return expected;
+    }
+    ++db.evaluated_count;
+    return o.release();
 }
 
@@ -54,11 +54,22 @@ namespace STEP {
     DB* ReadFileHeader(std::shared_ptr<IOStream> stream);
     // --------------------------------------------------------------------------
     // 2) read the actual file contents using a user-supplied set of
-    //    conversion functions to interpret the data.
-    void ReadFile(DB& db,const EXPRESS::ConversionSchema& scheme, const char* const* types_to_track, size_t len, const char* const* inverse_indices_to_track, size_t len2);
-    template <size_t N, size_t N2> inline void ReadFile(DB& db,const EXPRESS::ConversionSchema& scheme, const char* const (&arr)[N], const char* const (&arr2)[N2]) {
-        return ReadFile(db,scheme,arr,N,arr2,N2);
+    //    conversion functions to interpret the data. If a thread pool is
+    //    given, the DATA section is split into chunks of about chunk_size
+    //    bytes at entity boundaries, which are scanned in parallel.
+    void ReadFile(DB& db,const EXPRESS::ConversionSchema& scheme, const char* const* types_to_track, size_t len, const char* const* inverse_indices_to_track, size_t len2,
+        ThreadPool* pool = NULL, size_t chunk_size = 0);
+    template <size_t N, size_t N2> inline void ReadFile(DB& db,const EXPRESS::ConversionSchema& scheme, const char* const (&arr)[N], const char* const (&arr2)[N2],
+        ThreadPool* pool = NULL, size_t chunk_size = 0) {
+        return ReadFile(db,scheme,arr,N,arr2,N2,pool,chunk_size);
     }
+
+    // --------------------------------------------------------------------------
+    // Compute a hash of the arguments of an entity and, recursively, of all
+    // entities it references. Neither entity ids nor whitespace contribute, so
+    // entities which describe the same data get the same hash. memo receives
+    // the hashes of all visited entities and is used to look them up again.
+    uint64_t HashEntityContents(const DB& db, uint64_t id, std::map<uint64_t,uint64_t>& memo);
 } // ! STEP
 } // ! Assimp
 
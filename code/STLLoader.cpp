@@ -183,13 +183,20 @@ void STLImporter::InternReadFile( const std::string& pFile, aiScene* pScene, IOS
 
     fileSize = (unsigned int)file->FileSize();
 
-    // allocate storage and copy the contents of the file to a memory buffer
-    // (terminate it with zero)
+    // binary files are parsed directly out of the file view, if the
+    // IO system provides one. Otherwise allocate storage and copy the
+    // contents of the file to a memory buffer (terminate it with zero)
     std::vector<char> mBuffer2;
-    TextFileToBuffer(file.get(),mBuffer2);
+    const char* view = static_cast<const char*>(file->MapView());
+    if (view && IsBinarySTL(view, fileSize)) {
+        this->mBuffer = view;
+    }
+    else {
+        TextFileToBuffer(file.get(),mBuffer2);
+        this->mBuffer = &mBuffer2[0];
+    }
 
     this->pScene = pScene;
-    this->mBuffer = &mBuffer2[0];
 
     // the default vertex color is light gray.
     clrColorDefault.r = clrColorDefault.g = clrColorDefault.b = clrColorDefault.a = (ai_real) 0.6;
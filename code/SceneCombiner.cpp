@@ -1077,6 +1077,14 @@ void SceneCombiner::Copy     (aiMesh** _dest, const aiMesh* src)
         aiFace& f = dest->mFaces[i];
         GetArrayCopy(f.mIndices,f.mNumIndices);
     }
+
+    // and of the meshlets
+    if (src->mMeshlets) {
+        dest->mMeshlets = new aiMeshlet[dest->mNumMeshlets];
+        std::copy(src->mMeshlets,src->mMeshlets+src->mNumMeshlets,dest->mMeshlets);
+    }
+    GetArrayCopy(dest->mMeshletVertices,dest->mNumMeshletVertices);
+    GetArrayCopy(dest->mMeshletIndices,dest->mNumMeshletIndices);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -0,0 +1,356 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file Implementation of the uniform hash grid to quickly find vertices close to a given position */
+
+#include "SpatialHashGrid.h"
+#include <assimp/ai_assert.h>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+using namespace Assimp;
+
+namespace {
+
+    // Upper limit for the number of cells along one axis, keeps the cell coordinates
+    // well inside the range of an unsigned int even for degenerate bounding boxes.
+    const ai_real MaxCellsPerAxis = ai_real( 1 << 20 );
+
+    // Same tolerance SpatialSort::FindIdenticalPositions() applies to the squared distance.
+    const ai_int Distance3DToleranceInULPs = 6;
+
+    // --------------------------------------------------------------------------------------------
+    // Bit pattern of a non-negative floating-point value. It is ordered the same way the value is,
+    // so it can be used to compare values in units in the last place.
+    ai_int ToBinary( ai_real pValue) {
+        static_assert( sizeof(ai_int) >= sizeof(ai_real), "sizeof(ai_int) >= sizeof(ai_real)");
+
+        ai_int binValue = 0;
+        ::memcpy( &binValue, &pValue, sizeof(ai_real));
+        return binValue;
+    }
+
+    // --------------------------------------------------------------------------------------------
+    bool IsFinite( const aiVector3D& pVec) {
+        return std::isfinite( pVec.x) && std::isfinite( pVec.y) && std::isfinite( pVec.z);
+    }
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+SpatialHashGrid::SpatialHashGrid()
+: mBucketMask()
+, mCellSize( 1)
+, mInvCellSize( 1)
+{
+    mMaxCell[0] = mMaxCell[1] = mMaxCell[2] = 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Builds the grid from the given position array.
+SpatialHashGrid::SpatialHashGrid( const aiVector3D* pPositions, unsigned int pNumPositions,
+    unsigned int pElementOffset)
+: mBucketMask()
+, mCellSize( 1)
+, mInvCellSize( 1)
+{
+    mMaxCell[0] = mMaxCell[1] = mMaxCell[2] = 0;
+    Fill(pPositions,pNumPositions,pElementOffset);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Destructor
+SpatialHashGrid::~SpatialHashGrid()
+{
+    // nothing to do here, everything destructs automatically
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpatialHashGrid::Fill( const aiVector3D* pPositions, unsigned int pNumPositions,
+    unsigned int pElementOffset,
+    bool pFinalize /*= true */)
+{
+    mPositions.clear();
+    Append(pPositions,pNumPositions,pElementOffset,pFinalize);
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpatialHashGrid::Append( const aiVector3D* pPositions, unsigned int pNumPositions,
+    unsigned int pElementOffset,
+    bool pFinalize /*= true */)
+{
+    const size_t initial = mPositions.size();
+    mPositions.reserve(initial + pNumPositions);
+    for( unsigned int a = 0; a < pNumPositions; a++)
+    {
+        const char* tempPointer = reinterpret_cast<const char*> (pPositions);
+        const aiVector3D* vec   = reinterpret_cast<const aiVector3D*> (tempPointer + a * pElementOffset);
+        mPositions.push_back( Entry( static_cast<unsigned int>(a+initial), *vec));
+    }
+
+    if (pFinalize) {
+        Finalize();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpatialHashGrid::Finalize()
+{
+    const size_t numPositions = mPositions.size();
+
+    // bounding box of all finite positions, everything else ends up in the first cell
+    aiVector3D minVec( std::numeric_limits<ai_real>::max()), maxVec( -std::numeric_limits<ai_real>::max());
+    bool any = false;
+    for (size_t i = 0; i < numPositions; ++i) {
+        const aiVector3D& pos = mPositions[i].mPosition;
+        if (!IsFinite(pos)) {
+            continue;
+        }
+        minVec.x = std::min(minVec.x,pos.x); maxVec.x = std::max(maxVec.x,pos.x);
+        minVec.y = std::min(minVec.y,pos.y); maxVec.y = std::max(maxVec.y,pos.y);
+        minVec.z = std::min(minVec.z,pos.z); maxVec.z = std::max(maxVec.z,pos.z);
+        any = true;
+    }
+    if (!any) {
+        minVec = maxVec = aiVector3D();
+    }
+    mOrigin = minVec;
+
+    // Choose the cell size so there is about one position per cell. Only the axes the data
+    // actually spreads along count, so a flat mesh gets a 2D grid rather than a single layer
+    // of huge cells.
+    const aiVector3D extent = maxVec - minVec;
+    const ai_real maxExtent = std::max(extent.x,std::max(extent.y,extent.z));
+    mCellSize = 1;
+    if (maxExtent > 0) {
+        unsigned int dims = 0;
+        double volume = 1.0;
+        for (unsigned int axis = 0; axis < 3; ++axis) {
+            if (extent[axis] > maxExtent * ai_real( 1e-3 )) {
+                volume *= extent[axis];
+                ++dims;
+            }
+        }
+        mCellSize = static_cast<ai_real>( std::pow(volume / numPositions, 1.0 / dims) );
+        mCellSize = std::max(mCellSize, maxExtent / MaxCellsPerAxis);
+    }
+    mInvCellSize = 1 / mCellSize;
+    for (unsigned int axis = 0; axis < 3; ++axis) {
+        mMaxCell[axis] = static_cast<unsigned int>( std::min(extent[axis] * mInvCellSize, MaxCellsPerAxis) );
+    }
+
+    // hash the cells into a power-of-two sized table and group the entries by bucket
+    unsigned int numBuckets = 1;
+    while (numBuckets < numPositions && numBuckets < (1u << 31)) {
+        numBuckets <<= 1;
+    }
+    mBucketMask = numBuckets - 1;
+
+    std::vector<unsigned int> buckets(numPositions);
+    mBucketStart.assign(numBuckets + 1, 0);
+    for (size_t i = 0; i < numPositions; ++i) {
+        const aiVector3D& pos = mPositions[i].mPosition;
+        buckets[i] = BucketOf(CellCoord(pos.x,0), CellCoord(pos.y,1), CellCoord(pos.z,2));
+        ++mBucketStart[buckets[i] + 1];
+    }
+    for (unsigned int b = 0; b < numBuckets; ++b) {
+        mBucketStart[b + 1] += mBucketStart[b];
+    }
+
+    std::vector<unsigned int> next(mBucketStart.begin(), mBucketStart.end() - 1);
+    std::vector<Entry> sorted(numPositions);
+    for (size_t i = 0; i < numPositions; ++i) {
+        sorted[next[buckets[i]]++] = mPositions[i];
+    }
+    mPositions.swap(sorted);
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int SpatialHashGrid::CellCoord( ai_real pValue, unsigned int pAxis) const
+{
+    const ai_real t = (pValue - mOrigin[pAxis]) * mInvCellSize;
+
+    // written this way so that NaNs end up in the first cell
+    if (!(t > 0)) {
+        return 0;
+    }
+    if (t >= mMaxCell[pAxis]) {
+        return mMaxCell[pAxis];
+    }
+    return static_cast<unsigned int>(t);
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int SpatialHashGrid::BucketOf( unsigned int x, unsigned int y, unsigned int z) const
+{
+    return ((x * 73856093u) ^ (y * 19349663u) ^ (z * 83492791u)) & mBucketMask;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename Fn>
+void SpatialHashGrid::ForEachCandidate( const aiVector3D& pMin, const aiVector3D& pMax, Fn fn) const
+{
+    if (mPositions.empty()) {
+        return;
+    }
+
+    unsigned int lo[3], hi[3];
+    uint64_t numCells = 1;
+    for (unsigned int axis = 0; axis < 3; ++axis) {
+        lo[axis] = CellCoord(pMin[axis],axis);
+        hi[axis] = CellCoord(pMax[axis],axis);
+        numCells *= hi[axis] - lo[axis] + 1;
+    }
+
+    // huge search radius, looking at everything is cheaper than walking the cells
+    if (numCells > mPositions.size()) {
+        for (size_t i = 0; i < mPositions.size(); ++i) {
+            fn(mPositions[i]);
+        }
+        return;
+    }
+
+    // Distinct cells may share a bucket, visit every bucket only once. Almost all queries
+    // cover no more than 3x3x3 cells, so usually no allocation is needed.
+    unsigned int stackBuckets[64];
+    std::vector<unsigned int> heapBuckets;
+    unsigned int* buckets = stackBuckets;
+    if (numCells > 64) {
+        heapBuckets.resize(static_cast<size_t>(numCells));
+        buckets = &heapBuckets[0];
+    }
+
+    unsigned int numBuckets = 0;
+    for (unsigned int z = lo[2]; z <= hi[2]; ++z) {
+        for (unsigned int y = lo[1]; y <= hi[1]; ++y) {
+            for (unsigned int x = lo[0]; x <= hi[0]; ++x) {
+                buckets[numBuckets++] = BucketOf(x,y,z);
+            }
+        }
+    }
+    if (numBuckets > 1) {
+        std::sort(buckets, buckets + numBuckets);
+        numBuckets = static_cast<unsigned int>(std::unique(buckets, buckets + numBuckets) - buckets);
+    }
+
+    for (unsigned int b = 0; b < numBuckets; ++b) {
+        for (unsigned int i = mBucketStart[buckets[b]], end = mBucketStart[buckets[b] + 1]; i < end; ++i) {
+            fn(mPositions[i]);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns all positions within the given radius around the given position.
+void SpatialHashGrid::FindPositions( const aiVector3D& pPosition,
+    ai_real pRadius, std::vector<unsigned int>& poResults) const
+{
+    poResults.clear();
+
+    const aiVector3D radius(pRadius,pRadius,pRadius);
+    const ai_real pSquared = pRadius*pRadius;
+    ForEachCandidate(pPosition - radius, pPosition + radius, [&](const Entry& e) {
+        if ((e.mPosition - pPosition).SquareLength() < pSquared) {
+            poResults.push_back(e.mIndex);
+        }
+    });
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns all positions identical to the given position, up to a few floating-point units.
+// See SpatialSort::FindIdenticalPositions() for the reasoning behind the tolerance.
+void SpatialHashGrid::FindIdenticalPositions( const aiVector3D& pPosition,
+    std::vector<unsigned int>& poResults) const
+{
+    poResults.resize( 0 );
+
+    // the largest distance the tolerance still accepts, so that positions which straddle a
+    // cell boundary are found as well
+    static const ai_real maxDistance = std::sqrt(std::numeric_limits<ai_real>::denorm_min() * Distance3DToleranceInULPs);
+
+    const aiVector3D radius(maxDistance,maxDistance,maxDistance);
+    ForEachCandidate(pPosition - radius, pPosition + radius, [&](const Entry& e) {
+        if (Distance3DToleranceInULPs >= ToBinary((e.mPosition - pPosition).SquareLength())) {
+            poResults.push_back(e.mIndex);
+        }
+    });
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int SpatialHashGrid::GenerateMappingTable(std::vector<unsigned int>& fill, ai_real pRadius) const
+{
+    fill.assign(mPositions.size(),UINT_MAX);
+
+    // every position not yet mapped starts a new output ID, which all unmapped positions
+    // within the radius around it receive as well
+    unsigned int t=0;
+    std::vector<unsigned int> found;
+    for (size_t i = 0; i < mPositions.size(); ++i) {
+        const Entry& e = mPositions[i];
+        if (fill[e.mIndex] != UINT_MAX) {
+            continue;
+        }
+        fill[e.mIndex] = t;
+
+        FindPositions(e.mPosition, pRadius, found);
+        for (size_t n = 0; n < found.size(); ++n) {
+            if (fill[found[n]] == UINT_MAX) {
+                fill[found[n]] = t;
+            }
+        }
+        ++t;
+    }
+
+#ifdef ASSIMP_BUILD_DEBUG
+
+    // debug invariant: mPositions[i].mIndex values must range from 0 to mPositions.size()-1
+    for (size_t i = 0; i < fill.size(); ++i) {
+        ai_assert(fill[i]<mPositions.size());
+    }
+
+#endif
+    return t;
+}
@@ -0,0 +1,161 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** Uniform hash grid to find vertices close to a given location */
+#ifndef AI_SPATIALHASHGRID_H_INC
+#define AI_SPATIALHASHGRID_H_INC
+
+#include <vector>
+#include <assimp/types.h>
+
+namespace Assimp
+{
+
+// ------------------------------------------------------------------------------------------------
+/** Alternative to #SpatialSort with the same interface. Positions are sorted into the cells of a
+ * uniform grid laid over their bounding box, and the cells are hashed into a table of about as
+ * many buckets as there are positions. A query only visits the cells overlapping its search
+ * radius, so it takes O(1) on average regardless of how the data is laid out. This avoids the
+ * worst case of #SpatialSort, which has to scan long runs of vertices for flat or axis-aligned
+ * geometry where many positions project to the same distance from its reference plane. */
+// ------------------------------------------------------------------------------------------------
+class ASSIMP_API SpatialHashGrid
+{
+public:
+
+    SpatialHashGrid();
+
+    // ------------------------------------------------------------------------------------
+    /** Constructs the grid from the given position array.
+     * @param pPositions Pointer to the first position vector of the array.
+     * @param pNumPositions Number of vectors to expect in that array.
+     * @param pElementOffset Offset in bytes from the beginning of one vector in memory
+     *   to the beginning of the next vector. */
+    SpatialHashGrid( const aiVector3D* pPositions, unsigned int pNumPositions,
+        unsigned int pElementOffset);
+
+    /** Destructor */
+    ~SpatialHashGrid();
+
+public:
+
+    // ------------------------------------------------------------------------------------
+    /** Sets the input data for the grid. This replaces existing data, if any.
+     *  The new data receives new indices in ascending order. See SpatialSort::Fill().*/
+    void Fill( const aiVector3D* pPositions, unsigned int pNumPositions,
+        unsigned int pElementOffset,
+        bool pFinalize = true);
+
+    // ------------------------------------------------------------------------------------
+    /** Same as #Fill(), except the method appends to existing data in the grid. */
+    void Append( const aiVector3D* pPositions, unsigned int pNumPositions,
+        unsigned int pElementOffset,
+        bool pFinalize = true);
+
+    // ------------------------------------------------------------------------------------
+    /** Chooses the cell size and builds the hash table. Required before the grid can be
+     *  queried, after one or more calls to #Append() with pFinalize set to false. */
+    void Finalize();
+
+    // ------------------------------------------------------------------------------------
+    /** Fills an array with the indices of all positions within the given radius around
+     *  a position. See SpatialSort::FindPositions(). */
+    void FindPositions( const aiVector3D& pPosition, ai_real pRadius,
+        std::vector<unsigned int>& poResults) const;
+
+    // ------------------------------------------------------------------------------------
+    /** Fills an array with the indices of all positions identical to the given position,
+     *  using the same tolerance of a few floating-point units as
+     *  SpatialSort::FindIdenticalPositions(). */
+    void FindIdenticalPositions( const aiVector3D& pPosition,
+        std::vector<unsigned int>& poResults) const;
+
+    // ------------------------------------------------------------------------------------
+    /** Compute a table that maps each vertex ID referring to a spatially close
+     *  enough position to the same output ID. See SpatialSort::GenerateMappingTable().
+     *  @return Number of unique vertices. */
+    unsigned int GenerateMappingTable(std::vector<unsigned int>& fill,
+        ai_real pRadius) const;
+
+protected:
+
+    /** Cell coordinate of a value along one axis, clamped to the grid */
+    unsigned int CellCoord( ai_real pValue, unsigned int pAxis) const;
+
+    /** Bucket a cell is hashed to */
+    unsigned int BucketOf( unsigned int x, unsigned int y, unsigned int z) const;
+
+    /** Calls a function for every entry in a bucket of the cells overlapping the given box */
+    template <typename Fn>
+    void ForEachCandidate( const aiVector3D& pMin, const aiVector3D& pMax, Fn fn) const;
+
+    /** A position and the index of the vertex it belongs to */
+    struct Entry
+    {
+        unsigned int mIndex; ///< The vertex referred by this entry
+        aiVector3D mPosition; ///< Position
+
+        Entry() { /** intentionally not initialized.*/ }
+        Entry( unsigned int pIndex, const aiVector3D& pPosition)
+            : mIndex( pIndex), mPosition( pPosition)
+        {   }
+    };
+
+    // all positions, grouped by bucket once the grid has been finalized
+    std::vector<Entry> mPositions;
+
+    // first entry of each bucket, plus one past the last entry
+    std::vector<unsigned int> mBucketStart;
+
+    // bucket count minus one, the bucket count is a power of two
+    unsigned int mBucketMask;
+
+    // grid origin, edge length of a cell and its reciprocal
+    aiVector3D mOrigin;
+    ai_real mCellSize, mInvCellSize;
+
+    // highest cell coordinate along each axis
+    unsigned int mMaxCell[3];
+};
+
+} // end of namespace Assimp
+
+#endif // AI_SPATIALHASHGRID_H_INC
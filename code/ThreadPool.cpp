@@ -0,0 +1,223 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file ThreadPool.cpp
+ *  @brief Implementation of the ThreadPool helper
+ */
+
+#include "ThreadPool.h"
+#include <limits>
+
+using namespace Assimp;
+
+// ------------------------------------------------------------------------------------------------
+unsigned int ThreadPool::GetHardwareConcurrency()
+{
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    const unsigned int num = std::thread::hardware_concurrency();
+    return num ? num : 1;
+#else
+    return 1;
+#endif
+}
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+
+// ------------------------------------------------------------------------------------------------
+ThreadPool::ThreadPool(unsigned int numThreads)
+: mJob()
+, mJobSize()
+, mNextIndex()
+, mGeneration()
+, mActive()
+, mShutdown(false)
+, mErrorIndex(std::numeric_limits<size_t>::max())
+, mNumThreads(numThreads ? numThreads : GetHardwareConcurrency())
+{
+    // the calling thread is the first member of the team
+    mWorkers.reserve(mNumThreads - 1);
+    for (unsigned int i = 1; i < mNumThreads; ++i) {
+        mWorkers.push_back(std::thread(&ThreadPool::WorkerMain, this));
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mShutdown = true;
+    }
+    mWakeUp.notify_all();
+    for (std::vector<std::thread>::iterator it = mWorkers.begin(); it != mWorkers.end(); ++it) {
+        (*it).join();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)>& fn)
+{
+    if (!count) {
+        return;
+    }
+
+    // nested or concurrent loops are not queued but executed in place
+    std::unique_lock<std::mutex> jobLock(mJobMutex, std::defer_lock);
+    if (mWorkers.empty() || count == 1 || !jobLock.try_lock()) {
+        for (size_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mJob = &fn;
+        mJobSize = count;
+        mNextIndex = 0;
+        mErrorIndex = std::numeric_limits<size_t>::max();
+        mError = std::exception_ptr();
+        mActive = static_cast<unsigned int>(mWorkers.size());
+        ++mGeneration;
+    }
+    mWakeUp.notify_all();
+
+    RunJob();
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        while (mActive) {
+            mDone.wait(lock);
+        }
+        mJob = NULL;
+        std::swap(error, mError);
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ThreadPool::RunJob()
+{
+    for (;;) {
+        size_t index;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (mNextIndex >= mJobSize) {
+                return;
+            }
+            index = mNextIndex++;
+        }
+
+        try {
+            (*mJob)(index);
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (index < mErrorIndex) {
+                mErrorIndex = index;
+                mError = std::current_exception();
+            }
+            // all lower indices have already been handed out, so stopping
+            // here still reports the same exception as a serial loop would.
+            mNextIndex = mJobSize;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ThreadPool::WorkerMain()
+{
+    unsigned int generation = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            while (!mShutdown && generation == mGeneration) {
+                mWakeUp.wait(lock);
+            }
+            if (mShutdown) {
+                return;
+            }
+            generation = mGeneration;
+        }
+
+        RunJob();
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (!--mActive) {
+            mDone.notify_one();
+        }
+    }
+}
+
+#else // ASSIMP_BUILD_SINGLETHREADED
+
+// ------------------------------------------------------------------------------------------------
+ThreadPool::ThreadPool(unsigned int /*numThreads*/)
+: mNumThreads(1)
+{
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+ThreadPool::~ThreadPool()
+{
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)>& fn)
+{
+    for (size_t i = 0; i < count; ++i) {
+        fn(i);
+    }
+}
+
+#endif // ASSIMP_BUILD_SINGLETHREADED
+
+// ------------------------------------------------------------------------------------------------
+unsigned int ThreadPool::GetNumThreads() const
+{
+    return mNumThreads;
+}
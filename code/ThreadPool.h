@@ -0,0 +1,143 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file ThreadPool.h
+ *  @brief A minimal worker pool used to run independent jobs in parallel
+ */
+#ifndef INCLUDED_AI_THREADPOOL_H
+#define INCLUDED_AI_THREADPOOL_H
+
+#include <assimp/defs.h>
+#include <stddef.h>
+#include <functional>
+#include <vector>
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+#   include <thread>
+#   include <mutex>
+#   include <condition_variable>
+#   include <exception>
+#endif
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** @brief Fixed-size pool of worker threads.
+ *
+ *  The pool only knows a single kind of job: a parallel for-loop over an
+ *  index range. The calling thread takes part in the work and blocks until
+ *  all indices have been processed, so results written per index are
+ *  available (and deterministic) as soon as ParallelFor() returns.
+ *
+ *  Jobs are not queued: if the pool is already busy (i.e. ParallelFor() is
+ *  called from within a job or from a second user thread), the loop is
+ *  executed serially on the calling thread. If Assimp was built with
+ *  ASSIMP_BUILD_SINGLETHREADED, all loops are executed serially.
+ */
+class ASSIMP_API ThreadPool
+{
+public:
+    // -------------------------------------------------------------------
+    /** @brief Construct the pool.
+     *  @param numThreads Total number of threads to use for a loop,
+     *    including the calling thread. 0 uses all hardware threads,
+     *    1 spawns no workers at all. */
+    explicit ThreadPool(unsigned int numThreads = 0);
+
+    ~ThreadPool();
+
+    // -------------------------------------------------------------------
+    /** @brief Get the number of threads the pool runs a loop on,
+     *  including the calling thread. */
+    unsigned int GetNumThreads() const;
+
+    // -------------------------------------------------------------------
+    /** @brief Invoke a function for each index in [0,count).
+     *
+     *  Indices are handed out dynamically, thus callers must not rely
+     *  on any execution order. If one or more invocations throw, the
+     *  exception of the lowest failing index is rethrown on the calling
+     *  thread after all other indices have been processed.
+     *  @param count Number of indices to process
+     *  @param fn Function to be invoked for each index */
+    void ParallelFor(size_t count, const std::function<void(size_t)>& fn);
+
+    // -------------------------------------------------------------------
+    /** @brief Get the number of concurrent threads supported by the
+     *  hardware, at least 1. */
+    static unsigned int GetHardwareConcurrency();
+
+private:
+    // no copying
+    ThreadPool(const ThreadPool&);
+    ThreadPool& operator = (const ThreadPool&);
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    void WorkerMain();
+    void RunJob();
+
+    std::vector<std::thread> mWorkers;
+
+    // taken for the whole duration of a ParallelFor() call
+    std::mutex mJobMutex;
+
+    // guards all members below
+    std::mutex mMutex;
+    std::condition_variable mWakeUp;
+    std::condition_variable mDone;
+
+    const std::function<void(size_t)>* mJob;
+    size_t mJobSize;
+    size_t mNextIndex;
+    unsigned int mGeneration;
+    unsigned int mActive;
+    bool mShutdown;
+
+    size_t mErrorIndex;
+    std::exception_ptr mError;
+#endif
+    unsigned int mNumThreads;
+};
+
+} // end of namespace Assimp
+
+#endif // INCLUDED_AI_THREADPOOL_H
@@ -101,10 +101,15 @@ void TriangulateProcess::Execute( aiScene* pScene)
 {
     DefaultLogger::get()->debug("TriangulateProcess begin");
 
+    std::vector<char> triangulated( pScene->mNumMeshes, 0 );
+    ExecutePerMesh( pScene, [&]( unsigned int a ) {
+        triangulated[ a ] = TriangulateMesh( pScene->mMeshes[ a ] );
+    });
+
     bool bHas = false;
     for( unsigned int a = 0; a < pScene->mNumMeshes; a++)
     {
-        if ( TriangulateMesh( pScene->mMeshes[ a ] ) ) {
+        if ( triangulated[ a ] ) {
             bHas = true;
         }
     }
@@ -507,6 +507,45 @@ void ValidateDSProcess::Validate( const aiMesh* pMesh)
     {
         ReportError("aiMesh::mBones is non-null although there are no bones");
     }
+
+    // and the meshlets
+    if (pMesh->mNumMeshlets)
+    {
+        if (!pMesh->mMeshlets || !pMesh->mMeshletVertices || !pMesh->mMeshletIndices)
+        {
+            ReportError("aiMesh::mMeshlets, mMeshletVertices or mMeshletIndices is NULL "
+                "(aiMesh::mNumMeshlets is %i)",pMesh->mNumMeshlets);
+        }
+        for (unsigned int i = 0; i < pMesh->mNumMeshlets;++i)
+        {
+            const aiMeshlet& meshlet = pMesh->mMeshlets[i];
+            if (meshlet.mNumVertices > 256 ||
+                meshlet.mVertexOffset + meshlet.mNumVertices > pMesh->mNumMeshletVertices ||
+                meshlet.mIndexOffset + meshlet.mNumTriangles*3 > pMesh->mNumMeshletIndices)
+            {
+                ReportError("aiMesh::mMeshlets[%i] is out of range",i);
+            }
+            for (unsigned int a = 0; a < meshlet.mNumVertices;++a)
+            {
+                if (pMesh->mMeshletVertices[meshlet.mVertexOffset+a] >= pMesh->mNumVertices)
+                {
+                    ReportError("aiMesh::mMeshlets[%i] references vertex %i which is out of range",
+                        i,pMesh->mMeshletVertices[meshlet.mVertexOffset+a]);
+                }
+            }
+            for (unsigned int a = 0; a < meshlet.mNumTriangles*3;++a)
+            {
+                if (pMesh->mMeshletIndices[meshlet.mIndexOffset+a] >= meshlet.mNumVertices)
+                {
+                    ReportError("aiMesh::mMeshlets[%i] has an index out of range",i);
+                }
+            }
+        }
+    }
+    else if (pMesh->mMeshlets)
+    {
+        ReportError("aiMesh::mMeshlets is non-null although there are no meshlets");
+    }
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -0,0 +1,180 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  VertexQuantization.h
+ *  @brief Conversion of vertex components to and from compact integer encodings
+ *
+ *  The quantization step and the exporters writing compact vertex data share
+ *  these, so data which has been quantized by the step is written losslessly.
+ */
+#ifndef AI_VERTEXQUANTIZATION_H_INC
+#define AI_VERTEXQUANTIZATION_H_INC
+
+#include <assimp/types.h>
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+
+namespace Assimp {
+namespace Quantization {
+
+// ------------------------------------------------------------------------------------------------
+/** Maps a value in [0,1] to 0..65535, values outside are clamped */
+inline uint16_t EncodeUnorm16(ai_real v)
+{
+    v = std::min(std::max(v,(ai_real)0.),(ai_real)1.);
+    return (uint16_t)(v * 65535 + (ai_real)0.5);
+}
+
+inline ai_real DecodeUnorm16(uint16_t v)
+{
+    return v / (ai_real)65535.;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Maps a value in [-1,1] to -32767..32767, values outside are clamped */
+inline int16_t EncodeSnorm16(ai_real v)
+{
+    v = std::min(std::max(v,(ai_real)-1.),(ai_real)1.);
+    return (int16_t)std::floor(v * 32767 + (ai_real)0.5);
+}
+
+inline ai_real DecodeSnorm16(int16_t v)
+{
+    return std::max(v / (ai_real)32767.,(ai_real)-1.);
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Maps a value in [0,1] to 0..255, values outside are clamped */
+inline uint8_t EncodeUnorm8(ai_real v)
+{
+    v = std::min(std::max(v,(ai_real)0.),(ai_real)1.);
+    return (uint8_t)(v * 255 + (ai_real)0.5);
+}
+
+inline ai_real DecodeUnorm8(uint8_t v)
+{
+    return v / (ai_real)255.;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Range of a set of vectors, values are quantized relative to it */
+struct Bounds
+{
+    aiVector3D mMin, mMax;
+
+    Bounds() {}
+
+    Bounds(const aiVector3D* v, unsigned int num)
+    {
+        if (!num) {
+            return;
+        }
+        mMin = mMax = v[0];
+        for (unsigned int i = 1; i < num; ++i) {
+            mMin.x = std::min(mMin.x,v[i].x); mMax.x = std::max(mMax.x,v[i].x);
+            mMin.y = std::min(mMin.y,v[i].y); mMax.y = std::max(mMax.y,v[i].y);
+            mMin.z = std::min(mMin.z,v[i].z); mMax.z = std::max(mMax.z,v[i].z);
+        }
+    }
+
+    /** Maps each component linearly from [mMin,mMax] to 0..65535 */
+    void Encode(const aiVector3D& v, uint16_t out[3]) const
+    {
+        for (unsigned int i = 0; i < 3; ++i) {
+            const ai_real extent = mMax[i] - mMin[i];
+            out[i] = extent > 0 ? EncodeUnorm16((v[i] - mMin[i]) / extent) : 0;
+        }
+    }
+
+    aiVector3D Decode(const uint16_t in[3]) const
+    {
+        aiVector3D v;
+        for (unsigned int i = 0; i < 3; ++i) {
+            v[i] = mMin[i] + DecodeUnorm16(in[i]) * (mMax[i] - mMin[i]);
+        }
+        return v;
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Octahedral encoding of a unit vector in two snorm16 values. The upper
+ *  hemisphere is projected onto the inner diamond of the square [-1,1]^2,
+ *  the lower one is folded onto the corners. Zero and invalid (qNaN) vectors
+ *  are stored as (-32768,0), which no unit vector encodes to. */
+inline void EncodeOctahedral(const aiVector3D& n, int16_t out[2])
+{
+    const ai_real l1 = std::fabs(n.x) + std::fabs(n.y) + std::fabs(n.z);
+    if (!(l1 > 0)) {
+        out[0] = INT16_MIN;
+        out[1] = 0;
+        return;
+    }
+    ai_real x = n.x / l1, y = n.y / l1;
+    if (n.z < 0) {
+        const ai_real fx = (1 - std::fabs(y)) * (x >= 0 ? 1 : -1);
+        const ai_real fy = (1 - std::fabs(x)) * (y >= 0 ? 1 : -1);
+        x = fx;
+        y = fy;
+    }
+    out[0] = EncodeSnorm16(x);
+    out[1] = EncodeSnorm16(y);
+}
+
+inline aiVector3D DecodeOctahedral(const int16_t in[2])
+{
+    if (in[0] == INT16_MIN) {
+        return aiVector3D();
+    }
+    aiVector3D n(DecodeSnorm16(in[0]),DecodeSnorm16(in[1]),0);
+    n.z = 1 - std::fabs(n.x) - std::fabs(n.y);
+    if (n.z < 0) {
+        const ai_real x = n.x;
+        n.x = (1 - std::fabs(n.y)) * (x >= 0 ? 1 : -1);
+        n.y = (1 - std::fabs(x)) * (n.y >= 0 ? 1 : -1);
+    }
+    return n.Normalize();
+}
+
+} // end of namespace Quantization
+} // end of namespace Assimp
+
+#endif // AI_VERTEXQUANTIZATION_H_INC
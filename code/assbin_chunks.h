@@ -2,7 +2,7 @@
 #define INCLUDED_ASSBIN_CHUNKS_H
 
 #define ASSBIN_VERSION_MAJOR 1
-#define ASSBIN_VERSION_MINOR 0
+#define ASSBIN_VERSION_MINOR 2
 
 /**
 @page assfile .ASS File formats
@@ -81,10 +81,22 @@ integer     Assimp compile flags
 short       0 for normal files, 1 for shortened dumps for regression tests
                 these should have the file extension assbin.regress
 
-short       1 if the data after the header is compressed with the DEFLATE algorithm,
-            0 for uncompressed files.
+short       0 for uncompressed files (ASSBIN_COMPRESSION_NONE)
+            1 if the data after the header is compressed with the DEFLATE algorithm
+              (ASSBIN_COMPRESSION_DEFLATE).
                    For compressed files, the first integer after the header is
                    always the uncompressed data size
+            2 if the contents of the scene chunk are compressed in independent
+              DEFLATE blocks (ASSBIN_COMPRESSION_DEFLATE_BLOCKS, since version 1.2).
+                   The scene chunk's ID and data length follow the header
+                   uncompressed. Then follow the blocks, each one being
+
+                   integer  Uncompressed size of the block
+                   integer  Compressed size of the block
+                   byte[n]  Compressed data of the block
+
+                   The last block is empty, i.e. both sizes are zero.
+                   Concatenating the uncompressed blocks yields the chunk data.
 
 byte[256]   Zero-terminated source file name, UTF-8
 byte[128]   Zero-terminated command line parameters passed to assimp_cmd, UTF-8
@@ -146,6 +158,13 @@ The general 'rule' to get from Assimp headers to the serialized layout is:
      the kinds of vertex components actually present in the mesh. This is a
      bitwise combination of the ASSBIN_MESH_HAS_xxx constants.
 
+   - If ASSBIN_MESH_QUANTIZED is set (since version 1.1), the vertex components
+     are stored in a compact encoding: positions and texture coordinates as the
+     bounds of the array (2 aiVector3D) followed by 3 unsigned shorts per element,
+     mapping linearly between the bounds. Normals, tangents and bitangents are
+     stored as 2 shorts in octahedral encoding, (-32768,0) being a zero vector.
+     Colors are stored as 4 unsigned bytes.
+
 [[aiFace]]
 
    - mNumIndices is stored as short
@@ -170,6 +189,11 @@ The general 'rule' to get from Assimp headers to the serialized layout is:
 
 #define ASSBIN_HEADER_LENGTH 512
 
+// possible values of the compression field in the file header
+#define ASSBIN_COMPRESSION_NONE                 0
+#define ASSBIN_COMPRESSION_DEFLATE              1
+#define ASSBIN_COMPRESSION_DEFLATE_BLOCKS       2
+
 // these are the magic chunk identifiers for the binary ASS file format
 #define ASSBIN_CHUNK_AICAMERA                   0x1234
 #define ASSBIN_CHUNK_AILIGHT                    0x1235
@@ -186,6 +210,7 @@ The general 'rule' to get from Assimp headers to the serialized layout is:
 #define ASSBIN_MESH_HAS_POSITIONS                   0x1
 #define ASSBIN_MESH_HAS_NORMALS                     0x2
 #define ASSBIN_MESH_HAS_TANGENTS_AND_BITANGENTS     0x4
+#define ASSBIN_MESH_QUANTIZED                       0x8
 #define ASSBIN_MESH_HAS_TEXCOORD_BASE               0x100
 #define ASSBIN_MESH_HAS_COLOR_BASE                  0x10000
 
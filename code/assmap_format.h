@@ -0,0 +1,170 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  assmap_format.h
+ *  @brief Layout of the memory-mappable scene cache format (.assmap)
+ *
+ *  An .assmap file is a byte image of an aiScene. It is only meant to be a
+ *  cache, read back by the very same build of Assimp which wrote it - the
+ *  structs are stored in their native in-memory layout:
+
+@verbatim
+
+-------------------------------------------------------------------------------
+1. File structure:
+-------------------------------------------------------------------------------
+
+----------------------------
+| Header (64 bytes)        |
+----------------------------
+| Struct region            |  aiScene, aiNode, aiMesh, ... and pointer tables
+----------------------------
+| Data region              |  vertex data, indices, keys, texels, ...
+----------------------------
+
+Both regions start at a multiple of 64 bytes. Everything is stored in native
+byte order, with native struct layout and pointer size. The layout hash in
+the header identifies these, a reader rejects files with a different hash.
+
+-------------------------------------------------------------------------------
+2. Header:
+-------------------------------------------------------------------------------
+
+byte[16]    'ASSIMP.map', zero-padded
+integer     Format version, ASSMAP_VERSION
+integer     Layout hash, see AssmapLayoutHash()
+int64       Offset and size of the struct region
+int64       Offset and size of the data region
+byte[8]     Reserved, zero
+
+-------------------------------------------------------------------------------
+3. Regions:
+-------------------------------------------------------------------------------
+
+The aiScene is stored at the beginning of the struct region. All pointers in
+the struct region are replaced by references:
+
+    0                               NULL
+    ((offset + 1) << 1)             offset into the struct region
+    ((offset + 1) << 1) | 1         offset into the data region
+
+A reader copies the struct region into writable memory and resolves all
+references. Data is never copied, pointers into the data region point into
+the file mapping. The data region contains no references and thus stays
+read-only. Structs which contain pointers (i.e. aiFace, aiMaterialProperty,
+aiMetadataEntry) are always stored in the struct region, even if they are
+array elements.
+
+aiScene::mPrivate is always NULL, aiMaterial::mNumAllocated always equals
+aiMaterial::mNumProperties.
+
+@endverbatim */
+#ifndef INCLUDED_ASSMAP_FORMAT_H
+#define INCLUDED_ASSMAP_FORMAT_H
+
+#include <assimp/scene.h>
+#include <stddef.h>
+
+#define ASSMAP_VERSION 1
+
+#define ASSMAP_MAGIC "ASSIMP.map"
+#define ASSMAP_HEADER_LENGTH 64
+#define ASSMAP_REGION_ALIGNMENT 64
+
+namespace Assimp    {
+
+// ---------------------------------------------------------------------------
+/** Header of an .assmap file */
+struct AssmapHeader
+{
+    char mMagic[16];
+    uint32_t mVersion;
+    uint32_t mLayoutHash;
+    uint64_t mStructOffset;
+    uint64_t mStructSize;
+    uint64_t mDataOffset;
+    uint64_t mDataSize;
+    uint8_t mReserved[8];
+};
+
+// ---------------------------------------------------------------------------
+/** Get a hash of the in-memory layout of all structs stored in .assmap
+ *  files. Files written by builds with a different hash can't be read. */
+inline uint32_t AssmapLayoutHash()
+{
+    const uint16_t endianness = 0x0102;
+    const size_t sizes[] = {
+        *reinterpret_cast<const uint8_t*>(&endianness),
+        sizeof(void*), sizeof(ai_real),
+        AI_MAX_NUMBER_OF_COLOR_SETS, AI_MAX_NUMBER_OF_TEXTURECOORDS,
+        sizeof(aiScene), sizeof(aiNode), sizeof(aiMetadata), sizeof(aiMetadataEntry),
+        sizeof(aiMesh), sizeof(aiFace), sizeof(aiBone), sizeof(aiAnimMesh), sizeof(aiMeshlet),
+        sizeof(aiMaterial), sizeof(aiMaterialProperty), sizeof(aiTexture), sizeof(aiTexel),
+        sizeof(aiAnimation), sizeof(aiNodeAnim), sizeof(aiMeshAnim), sizeof(aiMeshMorphAnim),
+        sizeof(aiMeshMorphKey), sizeof(aiVectorKey), sizeof(aiQuatKey), sizeof(aiMeshKey),
+        sizeof(aiLight), sizeof(aiCamera), sizeof(aiString)
+    };
+
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        hash = (hash ^ static_cast<uint32_t>(sizes[i])) * 16777619u;
+    }
+    return hash;
+}
+
+// ---------------------------------------------------------------------------
+/** Build a reference to an offset into the struct region */
+inline uintptr_t AssmapStructRef(size_t offset)
+{
+    return static_cast<uintptr_t>(offset + 1) << 1;
+}
+
+// ---------------------------------------------------------------------------
+/** Build a reference to an offset into the data region */
+inline uintptr_t AssmapDataRef(size_t offset)
+{
+    return (static_cast<uintptr_t>(offset + 1) << 1) | 1;
+}
+
+} // end of namespace Assimp
+
+#endif // INCLUDED_ASSMAP_FORMAT_H
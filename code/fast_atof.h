@@ -18,6 +18,7 @@
 #define __FAST_A_TO_F_H_INCLUDED__
 
 #include <cmath>
+#include <cstring>
 #include <limits>
 #include <stdint.h>
 #include <stdexcept>
@@ -237,6 +238,117 @@ inline uint64_t strtoul10_64( const char* in, const char** out=0, unsigned int*
     return value;
 }
 
+#ifndef AI_BUILD_BIG_ENDIAN
+// ------------------------------------------------------------------------------------
+// Helpers for strtoul10_64 on ranges, which converts eight digits at once: the eight
+// characters are loaded into one little-endian word, first character in the lowest
+// byte.
+// ------------------------------------------------------------------------------------
+// Returns the number of leading decimal digits in the word.
+inline unsigned int strtoul10_count_digits8(uint64_t chunk)
+{
+    // Subtracting '0' yields 0..9 for the digit bytes, bytes outside of 0..9 have the
+    // high bit set either themselves or after adding 0x76. Borrows and carries only
+    // propagate upwards from non-digit bytes, so the leading digits stay intact.
+    const uint64_t val = chunk - 0x3030303030303030ull;
+    const uint64_t mask = (val | (val + 0x7676767676767676ull)) & 0x8080808080808080ull;
+    if (!mask) {
+        return 8;
+    }
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned int>(__builtin_ctzll(mask)) >> 3;
+#else
+    unsigned int num = 0;
+    while (!(mask & (0x80ull << (num * 8)))) {
+        ++num;
+    }
+    return num;
+#endif
+}
+
+// Returns the value of the num (1 to 8) leading decimal digits in the word.
+inline uint64_t strtoul10_convert_digits8(uint64_t chunk, unsigned int num)
+{
+    // move the digits to the top, the zero bytes below act as leading zeros
+    uint64_t val = (chunk - 0x3030303030303030ull) << ((8 - num) * 8);
+    val = (val * 10 + (val >> 8)) & 0x00FF00FF00FF00FFull;
+    val = (val * 100 + (val >> 16)) & 0x0000FFFF0000FFFFull;
+    val = (val * 10000 + (val >> 32)) & 0x00000000FFFFFFFFull;
+    return val;
+}
+#endif // !AI_BUILD_BIG_ENDIAN
+
+// ------------------------------------------------------------------------------------
+// Variant of strtoul10_64 for the range [in, end). It never reads at or behind end
+// and returns exactly the same results. The leading eight digits are converted at
+// once.
+// ------------------------------------------------------------------------------------
+inline uint64_t strtoul10_64( const char* in, const char* end, const char** out, unsigned int* max_inout=0)
+{
+    if ( in == end || *in < '0' || *in > '9' )
+        throw std::invalid_argument(std::string("The string \"") + std::string(in, end) + "\" cannot be converted into a value.");
+
+    // a maximum of 0 is never reached, see strtoul10_64
+    const unsigned int max = max_inout && *max_inout ? *max_inout : UINT_MAX;
+    unsigned int cur = 0;
+    uint64_t value = 0;
+
+#ifndef AI_BUILD_BIG_ENDIAN
+    // test the first eight characters at once. Most numbers are shorter and are
+    // converted right here, longer ones continue digit by digit. A full loop over
+    // 8-byte chunks is slower for the fixed-precision data exporters write, because
+    // the scalar loop predicts well and the chunk load depends on the previous one.
+    if ( end - in >= 8 && max >= 8 )
+    {
+        uint64_t chunk;
+        ::memcpy( &chunk, in, 8 );
+        const unsigned int num = strtoul10_count_digits8( chunk );
+        value = strtoul10_convert_digits8( chunk, num );
+        if ( num < 8 ) {
+            if ( out )
+                *out = in + num;
+            if ( max_inout )
+                *max_inout = num;
+            return value;
+        }
+        in += 8;
+        cur = 8;
+    }
+#endif
+
+    while ( cur != max )
+    {
+        if ( in == end || *in < '0' || *in > '9' )
+        {
+            if ( out )
+                *out = in;
+            if ( max_inout )
+                *max_inout = cur;
+            return value;
+        }
+
+        const uint64_t new_value = ( value * 10 ) + ( *in - '0' );
+
+        // numeric overflow, we rely on you
+        if ( new_value < value ) {
+            DefaultLogger::get()->warn( std::string( "Converting the string \"" ) + std::string( in, end ) + "\" into a value resulted in overflow." );
+            return 0;
+        }
+
+        value = new_value;
+        ++in;
+        ++cur;
+    }
+
+    // the maximum number of digits was read, skip the rest
+    if ( out ) {
+        while ( in != end && *in >= '0' && *in <= '9' )
+            ++in;
+        *out = in;
+    }
+    return value;
+}
+
 // ------------------------------------------------------------------------------------
 // signed variant of strtoul10_64
 // ------------------------------------------------------------------------------------
@@ -356,6 +468,114 @@ inline const char* fast_atoreal_move(const char* c, Real& out, bool check_comma
     return c;
 }
 
+// ------------------------------------------------------------------------------------
+// Variant of fast_atoreal_move for the range [c, end). It never reads at or behind
+// end, the results are identical.
+// ------------------------------------------------------------------------------------
+template <typename Real>
+inline const char* fast_atoreal_move(const char* c, const char* end, Real& out, bool check_comma = true)
+{
+    Real f = 0;
+
+    bool inv = (c != end && *c == '-');
+    if (inv || (c != end && *c == '+')) {
+        ++c;
+    }
+
+    if (end - c >= 3 && (c[0] == 'N' || c[0] == 'n') && ASSIMP_strincmp(c, "nan", 3) == 0)
+    {
+        out = std::numeric_limits<Real>::quiet_NaN();
+        c += 3;
+        return c;
+    }
+
+    if (end - c >= 3 && (c[0] == 'I' || c[0] == 'i') && ASSIMP_strincmp(c, "inf", 3) == 0)
+    {
+        out = std::numeric_limits<Real>::infinity();
+        if (inv) {
+            out = -out;
+        }
+        c += 3;
+        if (end - c >= 5 && (c[0] == 'I' || c[0] == 'i') && ASSIMP_strincmp(c, "inity", 5) == 0)
+        {
+            c += 5;
+        }
+        return c;
+    }
+
+    const bool point = c != end && (*c == '.' || (check_comma && *c == ','));
+    if (!(c != end && c[0] >= '0' && c[0] <= '9') &&
+        !(point && end - c >= 2 && c[1] >= '0' && c[1] <= '9'))
+    {
+        throw std::invalid_argument("Cannot parse string "
+                                    "as real number: does not start with digit "
+                                    "or decimal point followed by digit.");
+    }
+
+    if (!point)
+    {
+        f = static_cast<Real>( strtoul10_64 ( c, end, &c) );
+    }
+
+    if (c != end && (*c == '.' || (check_comma && c[0] == ',')) && end - c >= 2 && c[1] >= '0' && c[1] <= '9')
+    {
+        ++c;
+
+        // see fast_atoreal_move
+        unsigned int diff = AI_FAST_ATOF_RELAVANT_DECIMALS;
+        double pl = static_cast<double>( strtoul10_64 ( c, end, &c, &diff ));
+
+        pl *= fast_atof_table[diff];
+        f += static_cast<Real>( pl );
+    }
+    // For backwards compatibility: eat trailing dots, but not trailing commas.
+    else if (c != end && *c == '.') {
+        ++c;
+    }
+
+    if (c != end && (*c == 'e' || *c == 'E')) {
+
+        ++c;
+        const bool einv = (c != end && *c=='-');
+        if (einv || (c != end && *c=='+')) {
+            ++c;
+        }
+
+        Real exp = static_cast<Real>( strtoul10_64(c, end, &c) );
+        if (einv) {
+            exp = -exp;
+        }
+        f *= std::pow(static_cast<Real>(10.0), exp);
+    }
+
+    if (inv) {
+        f = -f;
+    }
+    out = f;
+    return c;
+}
+
+// ------------------------------------------------------------------------------------
+// Parse up to count real numbers separated by spaces, tabs or line ends from the
+// range [c, end) into out. c is moved behind the last number. Returns the number
+// of values read, which is less than count if the range ended before.
+// ------------------------------------------------------------------------------------
+template <typename Real>
+inline size_t fast_atoreal_array(const char*& c, const char* end, Real* out, size_t count, bool check_comma = true)
+{
+    size_t num = 0;
+    for (; num < count; ++num) {
+        while (c != end && (*c == ' ' || *c == '\t' || *c == '\r' || *c == '\n' || *c == '\f')) {
+            ++c;
+        }
+        if (c == end) {
+            break;
+        }
+        c = fast_atoreal_move<Real>(c, end, out[num], check_comma);
+    }
+    return num;
+}
+
 // ------------------------------------------------------------------------------------
 // The same but more human.
 inline ai_real fast_atof(const char* c)
@@ -113,6 +113,7 @@ namespace glTF2
         size_t Write(const void* b, size_t sz, size_t n) { return fwrite(b, sz, n, f); }
         int    Seek(size_t off, aiOrigin orig) { return fseek(f, off, int(orig)); }
         size_t Tell() const { return ftell(f); }
+        const void* MapView() { return 0; }
 
         size_t FileSize() {
             long p = Tell(), len = (Seek(0, aiOrigin_END), Tell());
@@ -190,6 +191,21 @@ namespace glTF2
         #include "./../include/assimp/Compiler/pushpack1.h"
     #endif
 
+    //! 12-byte header of a binary glTF 2.0 file (.glb), followed by the chunks
+    struct GLB_Header
+    {
+        uint8_t magic[4];     //!< Magic number: "glTF"
+        uint32_t version;     //!< Version number (always 2 for glTF 2.0)
+        uint32_t length;      //!< Total length of the Binary glTF, including header and all chunks, in bytes
+    } PACK_STRUCT;
+
+    //! 8-byte header of each chunk in a .glb file, followed by the (4-byte aligned) chunk data
+    struct GLB_Chunk
+    {
+        uint32_t chunkLength; //!< Length of the chunk data, in bytes
+        uint32_t chunkType;   //!< Type of the chunk (see the ChunkType enum)
+    } PACK_STRUCT;
+
     #ifdef ASSIMP_API
         #include "./../include/assimp/Compiler/poppack1.h"
     #endif
@@ -201,6 +217,13 @@ namespace glTF2
         SceneFormat_JSON = 0
     };
 
+    //! Values for the GLB_Chunk::chunkType field
+    enum ChunkType
+    {
+        ChunkType_JSON = 0x4E4F534A,
+        ChunkType_BIN = 0x004E4942
+    };
+
     //! Values for the mesh primitive modes
     enum PrimitiveMode
     {
@@ -422,18 +445,25 @@ namespace glTF2
         ComponentType componentType; //!< The datatype of components in the attribute. (required)
         unsigned int count;          //!< The number of attributes referenced by this accessor. (required)
         AttribType::Value type;      //!< Specifies if the attribute is a scalar, vector, or matrix. (required)
+        bool normalized;             //!< Whether integer data values are mapped to [0,1] or [-1,1]. (default: false)
         std::vector<float> max;      //!< Maximum value of each component in this attribute.
         std::vector<float> min;      //!< Minimum value of each component in this attribute.
 
         unsigned int GetNumComponents();
         unsigned int GetBytesPerComponent();
         unsigned int GetElementSize();
+        unsigned int GetStride();
 
         inline uint8_t* GetPointer();
 
         template<class T>
         bool ExtractData(T*& outData);
 
+        //! Extracts float vectors, integer components are converted (and
+        //! normalized) as allowed by KHR_mesh_quantization
+        template<class T>
+        bool ExtractFloatData(T*& outData);
+
         void WriteData(size_t count, const void* src_buffer, size_t src_stride);
 
         //! Helper class to iterate the data
@@ -470,7 +500,7 @@ namespace glTF2
             return Indexer(*this);
         }
 
-        Accessor() {}
+        Accessor() : normalized(false) {}
         void Read(Value& obj, Asset& r);
     };
 
@@ -545,7 +575,10 @@ namespace glTF2
 	private:
 
 		shared_ptr<uint8_t> mData; //!< Pointer to the data
+		size_t mCapacity; //!< Allocated size of mData, if it was allocated by Grow()
 		bool mIsSpecial; //!< Set to true for special cases (e.g. the body buffer)
+		bool mIsStreamed; //!< Set to true if appended data isn't kept in memory (see StreamTo())
+		shared_ptr<IOStream> mStream; //!< Receives the appended data of streamed buffers
 
 		/// \var EncodedRegion_List
 		/// List of encoded regions.
@@ -560,7 +593,10 @@ namespace glTF2
 
 		void Read(Value& obj, Asset& r);
 
-        bool LoadFromStream(IOStream& stream, size_t length = 0, size_t baseOffset = 0);
+        //! Serves the buffer from the stream. Streams which support mapping
+        //! are referenced in place (the buffer keeps the stream alive then),
+        //! all others are read into memory.
+        bool LoadFromStream(shared_ptr<IOStream> stream, size_t length = 0, size_t baseOffset = 0);
 
 		/// \fn void EncodedRegion_Mark(const size_t pOffset, const size_t pEncodedData_Length, uint8_t* pDecodedData, const size_t pDecodedData_Length, const std::string& pID)
 		/// Mark region of "bufferView" as encoded. When data is request from such region then "bufferView" use decoded data.
@@ -585,9 +621,17 @@ namespace glTF2
 		/// \return true - if successfully replaced, false if input arguments is out of range.
 		bool ReplaceData(const size_t pBufferData_Offset, const size_t pBufferData_Count, const uint8_t* pReplace_Data, const size_t pReplace_Count);
 
-        size_t AppendData(uint8_t* data, size_t length);
+        size_t AppendData(const uint8_t* data, size_t length);
         void Grow(size_t amount);
 
+        //! Stops keeping the data in memory. Data appended from now on is
+        //! written to the stream, or only counted if the stream is NULL.
+        //! GetPointer() returns NULL for streamed buffers.
+        void StreamTo(shared_ptr<IOStream> stream);
+
+        bool IsStreamed() const
+            { return mIsStreamed; }
+
         uint8_t* GetPointer()
             { return mData.get(); }
 
@@ -609,9 +653,11 @@ namespace glTF2
         Ref<Buffer> buffer; //! The ID of the buffer. (required)
         size_t byteOffset; //! The offset into the buffer in bytes. (required)
         size_t byteLength; //! The length of the bufferView in bytes. (default: 0)
+        size_t byteStride; //! The stride, in bytes, between vertex attributes. 0 if tightly packed. (default: 0)
 
         BufferViewTarget target; //! The target that the WebGL buffer should be bound to.
 
+        BufferView() : byteOffset(0), byteLength(0), byteStride(0) {}
         void Read(Value& obj, Asset& r);
     };
 
@@ -1023,6 +1069,9 @@ namespace glTF2
         size_t mSceneLength;
         size_t mBodyOffset, mBodyLength;
 
+        //! The .glb file while it's being loaded, serves the BIN chunk
+        shared_ptr<IOStream> mBodyStream;
+
         std::vector<LazyDictBase*> mDicts;
 
         IdMap mUsedIds;
@@ -1038,6 +1087,7 @@ namespace glTF2
         struct Extensions
         {
             bool KHR_materials_pbrSpecularGlossiness;
+            bool KHR_mesh_quantization;
 
         } extensionsUsed;
 
@@ -1084,7 +1134,10 @@ namespace glTF2
         }
 
         //! Main function
-        void Load(const std::string& file);
+        void Load(const std::string& file, bool isBinary = false);
+
+        //! Creates the body buffer, which is stored in the BIN chunk of a .glb file
+        void SetAsBinary();
 
         //! Search for an available name, starting from the given strings
         std::string FindUniqueID(const std::string& str, const char* suffix);
@@ -1093,6 +1146,8 @@ namespace glTF2
             { return mBodyBuffer; }
 
     private:
+        void ReadBinaryHeader(IOStream& stream);
+
         void ReadExtensionsUsed(Document& doc);
 
         IOStream* OpenFile(std::string path, const char* mode, bool absolute = false);
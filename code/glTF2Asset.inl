@@ -40,6 +40,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "StringUtils.h"
+#include "ByteSwapper.h"
 
 // Header files, Assimp
 #include <assimp/DefaultLogger.hpp>
@@ -324,7 +325,7 @@ Ref<T> LazyDict<T>::Create(const char* id)
 
 
 inline Buffer::Buffer()
-	: byteLength(0), type(Type_arraybuffer), EncodedRegion_Current(nullptr), mIsSpecial(false)
+	: byteLength(0), type(Type_arraybuffer), EncodedRegion_Current(nullptr), mCapacity(0), mIsSpecial(false), mIsStreamed(false)
 { }
 
 inline Buffer::~Buffer()
@@ -344,6 +345,17 @@ inline void Buffer::Read(Value& obj, Asset& r)
 
     Value* it = FindString(obj, "uri");
     if (!it) {
+        // the first buffer of a .glb file refers to the BIN chunk
+        if (oIndex == 0 && r.mBodyStream) {
+            if (statedLength > r.mBodyLength) {
+                throw DeadlyImportError("GLTF: buffer \"" + id + "\", expected " + to_string(statedLength) +
+                    " bytes, but the binary chunk holds " + to_string(r.mBodyLength));
+            }
+            if (!LoadFromStream(r.mBodyStream, statedLength, r.mBodyOffset)) {
+                throw DeadlyImportError("GLTF: Unable to read gltf file");
+            }
+            return;
+        }
         if (statedLength > 0) {
             throw DeadlyImportError("GLTF: buffer with non-zero length missing the \"uri\" attribute");
         }
@@ -378,10 +390,9 @@ inline void Buffer::Read(Value& obj, Asset& r)
         if (byteLength > 0) {
             std::string dir = !r.mCurrentAssetDir.empty() ? (r.mCurrentAssetDir + "/") : "";
 
-            IOStream* file = r.OpenFile(dir + uri, "rb");
+            shared_ptr<IOStream> file(r.OpenFile(dir + uri, "rb"));
             if (file) {
-                bool ok = LoadFromStream(*file, byteLength);
-                delete file;
+                bool ok = LoadFromStream(file, byteLength);
 
                 if (!ok)
                     throw DeadlyImportError("GLTF: error while reading referenced file \"" + std::string(uri) + "\"" );
@@ -393,17 +404,28 @@ inline void Buffer::Read(Value& obj, Asset& r)
     }
 }
 
-inline bool Buffer::LoadFromStream(IOStream& stream, size_t length, size_t baseOffset)
+inline bool Buffer::LoadFromStream(shared_ptr<IOStream> stream, size_t length, size_t baseOffset)
 {
-    byteLength = length ? length : stream.FileSize();
+    const size_t fileSize = stream->FileSize();
+    byteLength = length ? length : fileSize;
 
-    if (baseOffset) {
-        stream.Seek(baseOffset, aiOrigin_SET);
+    if (baseOffset > fileSize || byteLength > fileSize - baseOffset) {
+        return false;
     }
 
+    // Reference mapped streams in place instead of copying them. The data
+    // is read-only then, but only buffers created for export are written to
+    // (AppendData() and friends copy the data before touching it).
+    if (const uint8_t* view = static_cast<const uint8_t*>(stream->MapView())) {
+        mData = shared_ptr<uint8_t>(stream, const_cast<uint8_t*>(view) + baseOffset);
+        return true;
+    }
+
+    stream->Seek(baseOffset, aiOrigin_SET);
+
     mData.reset(new uint8_t[byteLength], std::default_delete<uint8_t[]>());
 
-    if (stream.Read(mData.get(), byteLength, 1) != 1) {
+    if (stream->Read(mData.get(), byteLength, 1) != 1) {
         return false;
     }
     return true;
@@ -477,14 +499,21 @@ uint8_t* new_data;
 	memcpy(&new_data[pBufferData_Offset + pReplace_Count], &mData.get()[pBufferData_Offset + pBufferData_Count], pBufferData_Offset);
 	// Apply new data
 	mData.reset(new_data, std::default_delete<uint8_t[]>());
-	byteLength = new_data_size;
+	byteLength = mCapacity = new_data_size;
 
 	return true;
 }
 
-inline size_t Buffer::AppendData(uint8_t* data, size_t length)
+inline size_t Buffer::AppendData(const uint8_t* data, size_t length)
 {
     size_t offset = this->byteLength;
+    if (mIsStreamed) {
+        if (mStream && length > 0 && mStream->Write(data, length, 1) != 1) {
+            throw DeadlyExportError("GLTF: Failed to write the data of buffer \"" + id + "\"");
+        }
+        byteLength += length;
+        return offset;
+    }
     Grow(length);
     memcpy(mData.get() + offset, data, length);
     return offset;
@@ -493,12 +522,36 @@ inline size_t Buffer::AppendData(uint8_t* data, size_t length)
 inline void Buffer::Grow(size_t amount)
 {
     if (amount <= 0) return;
-    uint8_t* b = new uint8_t[byteLength + amount];
-    if (mData) memcpy(b, mData.get(), byteLength);
-    mData.reset(b, std::default_delete<uint8_t[]>());
+
+    if (mIsStreamed) { // append zeros
+        static const uint8_t zeros[64] = {};
+        while (amount > 0) {
+            const size_t n = std::min(amount, sizeof(zeros));
+            AppendData(zeros, n);
+            amount -= n;
+        }
+        return;
+    }
+
+    // grow geometrically, so appending runs in amortized linear time
+    if (byteLength + amount > mCapacity) {
+        const size_t capacity = std::max(byteLength + amount, mCapacity * 2);
+        uint8_t* b = new uint8_t[capacity];
+        if (mData) memcpy(b, mData.get(), byteLength);
+        mData.reset(b, std::default_delete<uint8_t[]>());
+        mCapacity = capacity;
+    }
     byteLength += amount;
 }
 
+inline void Buffer::StreamTo(shared_ptr<IOStream> stream)
+{
+    mData.reset();
+    mCapacity = 0;
+    mIsStreamed = true;
+    mStream = stream;
+}
+
 //
 // struct BufferView
 //
@@ -512,6 +565,7 @@ inline void BufferView::Read(Value& obj, Asset& r)
 
     byteOffset = MemberOrDefault(obj, "byteOffset", 0u);
     byteLength = MemberOrDefault(obj, "byteLength", 0u);
+    byteStride = MemberOrDefault(obj, "byteStride", 0u);
 }
 
 //
@@ -529,6 +583,7 @@ inline void Accessor::Read(Value& obj, Asset& r)
     byteStride = MemberOrDefault(obj, "byteStride", 0u);
     componentType = MemberOrDefault(obj, "componentType", ComponentType_BYTE);
     count = MemberOrDefault(obj, "count", 0u);
+    normalized = MemberOrDefault(obj, "normalized", false);
 
     const char* typestr;
     type = ReadMember(obj, "type", typestr) ? AttribType::FromString(typestr) : AttribType::SCALAR;
@@ -549,6 +604,14 @@ inline unsigned int Accessor::GetElementSize()
     return GetNumComponents() * GetBytesPerComponent();
 }
 
+inline unsigned int Accessor::GetStride()
+{
+    // the stride is a property of the buffer view in glTF 2.0
+    if (byteStride) return byteStride;
+    if (bufferView && bufferView->byteStride) return unsigned(bufferView->byteStride);
+    return GetElementSize();
+}
+
 inline uint8_t* Accessor::GetPointer()
 {
     if (!bufferView || !bufferView->buffer) return 0;
@@ -601,7 +664,7 @@ bool Accessor::ExtractData(T*& outData)
     const size_t elemSize = GetElementSize();
     const size_t totalSize = elemSize * count;
 
-    const size_t stride = byteStride ? byteStride : elemSize;
+    const size_t stride = GetStride();
 
     const size_t targetElemSize = sizeof(T);
     ai_assert(elemSize <= targetElemSize);
@@ -621,6 +684,64 @@ bool Accessor::ExtractData(T*& outData)
     return true;
 }
 
+template<class T>
+bool Accessor::ExtractFloatData(T*& outData)
+{
+    if (componentType == ComponentType_FLOAT) {
+        return ExtractData(outData);
+    }
+
+    uint8_t* data = GetPointer();
+    if (!data) return false;
+
+    const unsigned int numComps = GetNumComponents();
+    const unsigned int targetComps = sizeof(T) / sizeof(ai_real);
+    ai_assert(numComps <= targetComps);
+
+    const size_t stride = GetStride();
+    ai_assert(count*stride <= bufferView->byteLength);
+
+    outData = new T[count];
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t* src = data + i*stride;
+        ai_real* dst = reinterpret_cast<ai_real*>(outData + i);
+        for (unsigned int c = 0; c < targetComps; ++c) {
+            ai_real v = 0;
+            if (c < numComps) {
+                switch (componentType) {
+                case ComponentType_BYTE: {
+                    const int8_t s = reinterpret_cast<const int8_t*>(src)[c];
+                    v = normalized ? std::max(s / (ai_real)127., (ai_real)-1.) : s;
+                    break;
+                }
+                case ComponentType_UNSIGNED_BYTE:
+                    v = normalized ? src[c] / (ai_real)255. : src[c];
+                    break;
+                case ComponentType_SHORT: {
+                    int16_t s;
+                    memcpy(&s, src + c*2, 2);
+                    v = normalized ? std::max(s / (ai_real)32767., (ai_real)-1.) : s;
+                    break;
+                }
+                case ComponentType_UNSIGNED_SHORT: {
+                    uint16_t s;
+                    memcpy(&s, src + c*2, 2);
+                    v = normalized ? s / (ai_real)65535. : s;
+                    break;
+                }
+                default: {
+                    uint32_t s;
+                    memcpy(&s, src + c*4, 4);
+                    v = (ai_real)s;
+                }
+                }
+            }
+            dst[c] = v;
+        }
+    }
+    return true;
+}
+
 inline void Accessor::WriteData(size_t count, const void* src_buffer, size_t src_stride)
 {
     uint8_t* buffer_ptr = bufferView->buffer->GetPointer();
@@ -641,7 +762,7 @@ inline Accessor::Indexer::Indexer(Accessor& acc)
     : accessor(acc)
     , data(acc.GetPointer())
     , elemSize(acc.GetElementSize())
-    , stride(acc.byteStride ? acc.byteStride : elemSize)
+    , stride(acc.GetStride())
 {
 
 }
@@ -667,7 +788,7 @@ inline Image::Image()
 
 }
 
-inline void Image::Read(Value& obj, Asset& /*r*/)
+inline void Image::Read(Value& obj, Asset& r)
 {
     if (!mDataLength) {
         if (Value* uri = FindString(obj, "uri")) {
@@ -684,6 +805,21 @@ inline void Image::Read(Value& obj, Asset& /*r*/)
                 this->uri = uristr;
             }
         }
+        else if (Value* bufferViewVal = FindUInt(obj, "bufferView")) { // typically from a .glb file
+            this->bufferView = r.bufferViews.Retrieve(bufferViewVal->GetUint());
+            ReadMember(obj, "mimeType", mimeType);
+
+            Ref<Buffer> buffer = this->bufferView->buffer;
+            const size_t offset = this->bufferView->byteOffset, length = this->bufferView->byteLength;
+            if (!buffer || !buffer->GetPointer() || offset + length > buffer->byteLength) {
+                throw DeadlyImportError("GLTF: image \"" + id + "\" refers to data out of range");
+            }
+
+            // the data is handed over to the aiTexture, so copy it
+            mData = new uint8_t[length];
+            memcpy(mData, buffer->GetPointer() + offset, length);
+            mDataLength = length;
+        }
     }
 }
 
@@ -1037,7 +1173,65 @@ inline void AssetMetadata::Read(Document& doc)
 // Asset methods implementation
 //
 
-inline void Asset::Load(const std::string& pFile)
+inline void Asset::ReadBinaryHeader(IOStream& stream)
+{
+    GLB_Header header;
+    if (stream.Read(&header, sizeof(header), 1) != 1) {
+        throw DeadlyImportError("GLTF: Unable to read the file header");
+    }
+
+    if (strncmp((char*)header.magic, AI_GLB_MAGIC_NUMBER, sizeof(header.magic)) != 0) {
+        throw DeadlyImportError("GLTF: Invalid binary glTF file");
+    }
+
+    AI_SWAP4(header.version);
+    asset.version = to_string(header.version);
+    if (header.version != 2) {
+        throw DeadlyImportError("GLTF: Unsupported binary glTF version");
+    }
+
+    AI_SWAP4(header.length);
+    const size_t fileLength = std::min(size_t(header.length), stream.FileSize());
+
+    // the JSON chunk always comes first
+    GLB_Chunk chunk;
+    if (stream.Read(&chunk, sizeof(chunk), 1) != 1) {
+        throw DeadlyImportError("GLTF: Unable to read JSON chunk");
+    }
+
+    AI_SWAP4(chunk.chunkLength);
+    AI_SWAP4(chunk.chunkType);
+    if (chunk.chunkType != ChunkType_JSON) {
+        throw DeadlyImportError("GLTF: JSON chunk missing");
+    }
+
+    mSceneLength = chunk.chunkLength;
+    if (sizeof(header) + sizeof(chunk) + mSceneLength > fileLength) {
+        throw DeadlyImportError("GLTF: JSON chunk exceeds the file size");
+    }
+
+    // an optional BIN chunk follows, chunks are 4-byte aligned
+    mBodyOffset = sizeof(header) + sizeof(chunk) + ((mSceneLength + 3) & ~size_t(3));
+    mBodyLength = 0;
+
+    if (mBodyOffset + sizeof(chunk) <= fileLength) {
+        stream.Seek(mBodyOffset, aiOrigin_SET);
+        if (stream.Read(&chunk, sizeof(chunk), 1) != 1) {
+            throw DeadlyImportError("GLTF: Unable to read BIN chunk");
+        }
+
+        AI_SWAP4(chunk.chunkLength);
+        AI_SWAP4(chunk.chunkType);
+        if (chunk.chunkType == ChunkType_BIN) {
+            mBodyOffset += sizeof(chunk);
+            mBodyLength = std::min(size_t(chunk.chunkLength), fileLength - mBodyOffset);
+        }
+
+        stream.Seek(sizeof(header) + sizeof(chunk), aiOrigin_SET);
+    }
+}
+
+inline void Asset::Load(const std::string& pFile, bool isBinary)
 {
     mCurrentAssetDir.clear();
     int pos = std::max(int(pFile.rfind('/')), int(pFile.rfind('\\')));
@@ -1048,8 +1242,14 @@ inline void Asset::Load(const std::string& pFile)
         throw DeadlyImportError("GLTF: Could not open file for reading");
     }
 
-    mSceneLength = stream->FileSize();
-    mBodyLength = 0;
+    // is binary? then read the header
+    if (isBinary) {
+        ReadBinaryHeader(*stream);
+    }
+    else {
+        mSceneLength = stream->FileSize();
+        mBodyLength = 0;
+    }
 
     // read the scene data
 
@@ -1077,11 +1277,9 @@ inline void Asset::Load(const std::string& pFile)
         throw DeadlyImportError("GLTF: JSON document root must be a JSON object");
     }
 
-    // Fill the buffer instance for the current file embedded contents
+    // The BIN chunk is served to the first buffer when it is read
     if (mBodyLength > 0) {
-        if (!mBodyBuffer->LoadFromStream(*stream, mBodyLength, mBodyOffset)) {
-            throw DeadlyImportError("GLTF: Unable to read gltf file");
-        }
+        mBodyStream = stream;
     }
 
 
@@ -1108,6 +1306,7 @@ inline void Asset::Load(const std::string& pFile)
     for (size_t i = 0; i < mDicts.size(); ++i) {
         mDicts[i]->DetachFromDocument();
     }
+    mBodyStream.reset();
 }
 
 inline void Asset::ReadExtensionsUsed(Document& doc)
@@ -1127,6 +1326,7 @@ inline void Asset::ReadExtensionsUsed(Document& doc)
         if (exts.find(#EXT) != exts.end()) extensionsUsed.EXT = true;
 
     CHECK_EXT(KHR_materials_pbrSpecularGlossiness);
+    CHECK_EXT(KHR_mesh_quantization);
 
     #undef CHECK_EXT
 }
@@ -1145,6 +1345,13 @@ inline IOStream* Asset::OpenFile(std::string path, const char* mode, bool /*abso
     #endif
 }
 
+inline void Asset::SetAsBinary()
+{
+    if (!mBodyBuffer) {
+        mBodyBuffer = buffers.Create("binary_glTF");
+    }
+}
+
 inline std::string Asset::FindUniqueID(const std::string& str, const char* suffix)
 {
     std::string id = str;
@@ -1243,11 +1450,12 @@ namespace Util {
     template<bool B>
     struct DATA
     {
-        static const uint8_t tableDecodeBase64[128];
+        static const uint8_t tableDecodeBase64[256];
     };
 
+    //! Maps each byte to its 6-bit value, '=' to 64 and all other characters to 0
     template<bool B>
-    const uint8_t DATA<B>::tableDecodeBase64[128] = {
+    const uint8_t DATA<B>::tableDecodeBase64[256] = {
          0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
          0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
          0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 62,  0,  0,  0, 63,
@@ -1255,7 +1463,15 @@ namespace Util {
          0,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
         15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25,  0,  0,  0,  0,  0,
          0, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
-        41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51,  0,  0,  0,  0,  0
+        41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51,  0,  0,  0,  0,  0,
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0
     };
 
     inline char EncodeCharBase64(uint8_t b)
@@ -1265,13 +1481,7 @@ namespace Util {
 
     inline uint8_t DecodeCharBase64(char c)
     {
-        return DATA<true>::tableDecodeBase64[size_t(c)]; // TODO faster with lookup table or ifs?
-        /*if (c >= 'A' && c <= 'Z') return c - 'A';
-        if (c >= 'a' && c <= 'z') return c - 'a' + 26;
-        if (c >= '0' && c <= '9') return c - '0' + 52;
-        if (c == '+') return 62;
-        if (c == '/') return 63;
-        return 64; // '-' */
+        return DATA<true>::tableDecodeBase64[uint8_t(c)];
     }
 
     inline size_t DecodeBase64(const char* in, size_t inLength, uint8_t*& out)
@@ -1288,30 +1498,31 @@ namespace Util {
 
         size_t outLength = (inLength * 3) / 4 - nEquals;
         out = new uint8_t[outLength];
-        memset(out, 0, outLength);
 
-        size_t i, j = 0;
+        const uint8_t* table = DATA<true>::tableDecodeBase64;
+        const uint8_t* src = reinterpret_cast<const uint8_t*>(in);
+        uint8_t* dst = out;
 
-        for (i = 0; i + 4 < inLength; i += 4) {
-            uint8_t b0 = DecodeCharBase64(in[i]);
-            uint8_t b1 = DecodeCharBase64(in[i + 1]);
-            uint8_t b2 = DecodeCharBase64(in[i + 2]);
-            uint8_t b3 = DecodeCharBase64(in[i + 3]);
+        // all full groups: assemble the 24 bits of each quad at once
+        const uint8_t* end = src + inLength - 4;
+        for (; src < end; src += 4, dst += 3) {
+            const uint32_t v = (uint32_t(table[src[0]]) << 18) | (uint32_t(table[src[1]]) << 12) |
+                               (uint32_t(table[src[2]]) << 6) | uint32_t(table[src[3]]);
 
-            out[j++] = (uint8_t)((b0 << 2) | (b1 >> 4));
-            out[j++] = (uint8_t)((b1 << 4) | (b2 >> 2));
-            out[j++] = (uint8_t)((b2 << 6) | b3);
+            dst[0] = uint8_t(v >> 16);
+            dst[1] = uint8_t(v >> 8);
+            dst[2] = uint8_t(v);
         }
 
         {
-            uint8_t b0 = DecodeCharBase64(in[i]);
-            uint8_t b1 = DecodeCharBase64(in[i + 1]);
-            uint8_t b2 = DecodeCharBase64(in[i + 2]);
-            uint8_t b3 = DecodeCharBase64(in[i + 3]);
-
-            out[j++] = (uint8_t)((b0 << 2) | (b1 >> 4));
-            if (b2 < 64) out[j++] = (uint8_t)((b1 << 4) | (b2 >> 2));
-            if (b3 < 64) out[j++] = (uint8_t)((b2 << 6) | b3);
+            uint8_t b0 = table[src[0]];
+            uint8_t b1 = table[src[1]];
+            uint8_t b2 = table[src[2]];
+            uint8_t b3 = table[src[3]];
+
+            *dst++ = (uint8_t)((b0 << 2) | (b1 >> 4));
+            if (b2 < 64) *dst++ = (uint8_t)((b1 << 4) | (b2 >> 2));
+            if (b3 < 64) *dst++ = (uint8_t)((b2 << 6) | b3);
         }
 
         return outLength;
@@ -52,11 +52,42 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "glTF2Asset.h"
 
+#include <rapidjson/writer.h>
+#include <rapidjson/prettywriter.h>
+
 namespace glTF2
 {
 
 using rapidjson::MemoryPoolAllocator;
 
+//! rapidjson output stream which writes to an IOStream through a small
+//! buffer. Without a stream, it only counts the bytes.
+class JsonOutputStream
+{
+public:
+    typedef char Ch;
+
+    JsonOutputStream(IOStream* stream)
+        : mStream(stream), mPos(0), mWritten(0) {}
+
+    void Put(char c)
+    {
+        if (mPos == sizeof(mBuffer)) Flush();
+        mBuffer[mPos++] = c;
+    }
+
+    void Flush();
+
+    //! Number of bytes put so far
+    size_t Tell() const
+        { return mWritten + mPos; }
+
+private:
+    IOStream* mStream;
+    char mBuffer[4096];
+    size_t mPos, mWritten;
+};
+
 class AssetWriter
 {
     template<class T>
@@ -64,7 +95,8 @@ class AssetWriter
 
 private:
 
-    void WriteBinaryData(IOStream* outfile, size_t sceneLength);
+    void WriteDocument(JsonOutputStream& out, bool pretty);
+    void WriteContents();
 
     void WriteMetadata();
     void WriteExtensionsUsed();
@@ -72,7 +104,25 @@ private:
     template<class T>
     void WriteObjects(LazyDict<T>& d);
 
+    void WriteMember(const char* key, Value& value);
+
+    // forward to whichever of the writers is in use
+    void Key(const char* key);
+    void StartObject();
+    void EndObject();
+    void StartArray();
+    void EndArray();
+    void WriteValue(Value& value);
+
+    //! Set while writing a document: .gltf files are indented, the JSON
+    //! chunk of .glb files is compact
+    rapidjson::PrettyWriter<JsonOutputStream>* mPrettyWriter;
+    rapidjson::Writer<JsonOutputStream>* mCompactWriter;
+    bool mWritingExtensions, mExtensionsOpen;
+
 public:
+    //! Holds the values of the object being written. The document is written
+    //! out object by object, so it is never built in memory as a whole.
     Document mDoc;
     Asset& mAsset;
 
@@ -80,7 +130,14 @@ public:
 
     AssetWriter(Asset& asset);
 
+    //! Writes a .gltf file, and a .bin file for each buffer which wasn't
+    //! streamed while exporting
     void WriteFile(const char* path);
+
+    //! Writes the header and the JSON chunk of a .glb file and the header
+    //! of the BIN chunk. The data of the body buffer must follow; its
+    //! byteLength must be final and a multiple of 4.
+    void WriteGLBHeader(IOStream& outfile);
 };
 
 }
@@ -43,6 +43,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <rapidjson/writer.h>
 #include <rapidjson/prettywriter.h>
 
+#include <limits>
+
 namespace glTF2 {
 
     using rapidjson::StringBuffer;
@@ -106,6 +108,10 @@ namespace glTF2 {
         obj.AddMember("count", a.count, w.mAl);
         obj.AddMember("type", StringRef(AttribType::ToString(a.type)), w.mAl);
 
+        if (a.normalized) {
+            obj.AddMember("normalized", true, w.mAl);
+        }
+
         Value vTmpMax, vTmpMin;
         obj.AddMember("max", MakeValue(vTmpMax, a.max, w.mAl), w.mAl);
         obj.AddMember("min", MakeValue(vTmpMin, a.min, w.mAl), w.mAl);
@@ -160,7 +166,12 @@ namespace glTF2 {
     inline void Write(Value& obj, Buffer& b, AssetWriter& w)
     {
         obj.AddMember("byteLength", static_cast<uint64_t>(b.byteLength), w.mAl);
-        obj.AddMember("uri", Value(b.GetURI(), w.mAl).Move(), w.mAl);
+
+        // the body buffer is stored in the BIN chunk of the .glb file
+        Ref<Buffer> body = w.mAsset.GetBodyBuffer();
+        if (!body || &*body != &b) {
+            obj.AddMember("uri", Value(b.GetURI(), w.mAl).Move(), w.mAl);
+        }
     }
 
     inline void Write(Value& obj, BufferView& bv, AssetWriter& w)
@@ -168,6 +179,9 @@ namespace glTF2 {
         obj.AddMember("buffer", bv.buffer->index, w.mAl);
         obj.AddMember("byteOffset", static_cast<uint64_t>(bv.byteOffset), w.mAl);
         obj.AddMember("byteLength", static_cast<uint64_t>(bv.byteLength), w.mAl);
+        if (bv.byteStride != 0) {
+            obj.AddMember("byteStride", static_cast<uint64_t>(bv.byteStride), w.mAl);
+        }
         obj.AddMember("target", int(bv.target), w.mAl);
     }
 
@@ -178,6 +192,12 @@ namespace glTF2 {
 
     inline void Write(Value& obj, Image& img, AssetWriter& w)
     {
+        if (img.bufferView) { // stored in the body buffer
+            obj.AddMember("bufferView", img.bufferView->index, w.mAl);
+            obj.AddMember("mimeType", Value(img.mimeType, w.mAl).Move(), w.mAl);
+            return;
+        }
+
         std::string uri;
         if (img.HasData()) {
             uri = "data:" + (img.mimeType.empty() ? "application/octet-stream" : img.mimeType);
@@ -504,25 +524,114 @@ namespace glTF2 {
     }
 
 
+    inline void JsonOutputStream::Flush()
+    {
+        if (mStream && mPos > 0 && mStream->Write(mBuffer, mPos, 1) != 1) {
+            throw DeadlyExportError("Failed to write scene data!");
+        }
+        mWritten += mPos;
+        mPos = 0;
+    }
+
     inline AssetWriter::AssetWriter(Asset& a)
-        : mDoc()
+        : mPrettyWriter(0)
+        , mCompactWriter(0)
+        , mWritingExtensions(false)
+        , mExtensionsOpen(false)
+        , mDoc()
         , mAsset(a)
         , mAl(mDoc.GetAllocator())
     {
         mDoc.SetObject();
+    }
+
+    inline void AssetWriter::WriteDocument(JsonOutputStream& out, bool pretty)
+    {
+        if (pretty) {
+            PrettyWriter<JsonOutputStream> writer(out);
+            mPrettyWriter = &writer;
+            WriteContents();
+            mPrettyWriter = 0;
+        }
+        else {
+            Writer<JsonOutputStream> writer(out);
+            mCompactWriter = &writer;
+            WriteContents();
+            mCompactWriter = 0;
+        }
+        out.Flush();
+    }
+
+    inline void AssetWriter::WriteContents()
+    {
+        StartObject();
 
         WriteMetadata();
         WriteExtensionsUsed();
 
-        // Dump the contents of the dictionaries
-        for (size_t i = 0; i < a.mDicts.size(); ++i) {
-            a.mDicts[i]->WriteObjects(*this);
+        // Dump the contents of the dictionaries, those defined by extensions go last
+        for (size_t i = 0; i < mAsset.mDicts.size(); ++i) {
+            mAsset.mDicts[i]->WriteObjects(*this);
+        }
+
+        mWritingExtensions = true;
+        for (size_t i = 0; i < mAsset.mDicts.size(); ++i) {
+            mAsset.mDicts[i]->WriteObjects(*this);
         }
+        if (mExtensionsOpen) {
+            EndObject();
+        }
+        mWritingExtensions = mExtensionsOpen = false;
 
         // Add the target scene field
         if (mAsset.scene) {
-            mDoc.AddMember("scene", mAsset.scene->index, mAl);
+            Value scene(mAsset.scene->index);
+            WriteMember("scene", scene);
         }
+
+        EndObject();
+    }
+
+    inline void AssetWriter::WriteMember(const char* key, Value& value)
+    {
+        Key(key);
+        WriteValue(value);
+    }
+
+    inline void AssetWriter::Key(const char* key)
+    {
+        if (mPrettyWriter) mPrettyWriter->Key(key);
+        else mCompactWriter->Key(key);
+    }
+
+    inline void AssetWriter::StartObject()
+    {
+        if (mPrettyWriter) mPrettyWriter->StartObject();
+        else mCompactWriter->StartObject();
+    }
+
+    inline void AssetWriter::EndObject()
+    {
+        if (mPrettyWriter) mPrettyWriter->EndObject();
+        else mCompactWriter->EndObject();
+    }
+
+    inline void AssetWriter::StartArray()
+    {
+        if (mPrettyWriter) mPrettyWriter->StartArray();
+        else mCompactWriter->StartArray();
+    }
+
+    inline void AssetWriter::EndArray()
+    {
+        if (mPrettyWriter) mPrettyWriter->EndArray();
+        else mCompactWriter->EndArray();
+    }
+
+    inline void AssetWriter::WriteValue(Value& value)
+    {
+        if (mPrettyWriter) value.Accept(*mPrettyWriter);
+        else value.Accept(*mCompactWriter);
     }
 
     inline void AssetWriter::WriteFile(const char* path)
@@ -533,18 +642,13 @@ namespace glTF2 {
             throw DeadlyExportError("Could not open output file: " + std::string(path));
         }
 
-        StringBuffer docBuffer;
-
-        PrettyWriter<StringBuffer> writer(docBuffer);
-        mDoc.Accept(writer);
+        JsonOutputStream out(jsonOutFile.get());
+        WriteDocument(out, true);
 
-        if (jsonOutFile->Write(docBuffer.GetString(), docBuffer.GetSize(), 1) != 1) {
-            throw DeadlyExportError("Failed to write scene data!");
-        }
-
-        // Write buffer data to separate .bin files
+        // Write buffer data to separate .bin files, streamed buffers have been written already
         for (unsigned int i = 0; i < mAsset.buffers.Size(); ++i) {
             Ref<Buffer> b = mAsset.buffers.Get(i);
+            if (b->IsStreamed()) continue;
 
             std::string binPath = b->GetURI();
 
@@ -562,13 +666,69 @@ namespace glTF2 {
         }
     }
 
+    inline void AssetWriter::WriteGLBHeader(IOStream& outfile)
+    {
+        Ref<Buffer> body = mAsset.GetBodyBuffer();
+        const size_t bodyLength = body ? body->byteLength : 0;
+        ai_assert(bodyLength % 4 == 0);
+
+        // measure the JSON first, the header holds the lengths
+        JsonOutputStream counter(0);
+        WriteDocument(counter, false);
+
+        const size_t sceneLength = counter.Tell();
+        const size_t padding = (4 - sceneLength % 4) % 4; // chunks are 4-byte aligned
+        const size_t length = sizeof(GLB_Header) + sizeof(GLB_Chunk) + sceneLength + padding +
+            (bodyLength > 0 ? sizeof(GLB_Chunk) + bodyLength : 0);
+
+        if (length > std::numeric_limits<uint32_t>::max()) {
+            throw DeadlyExportError("GLTF: the binary file exceeds 4 GB");
+        }
+
+        GLB_Header header;
+        memcpy(header.magic, AI_GLB_MAGIC_NUMBER, sizeof(header.magic));
+        header.version = 2;
+        AI_SWAP4(header.version);
+        header.length = uint32_t(length);
+        AI_SWAP4(header.length);
+
+        GLB_Chunk chunk;
+        chunk.chunkLength = uint32_t(sceneLength + padding);
+        AI_SWAP4(chunk.chunkLength);
+        chunk.chunkType = ChunkType_JSON;
+        AI_SWAP4(chunk.chunkType);
+
+        if (outfile.Write(&header, sizeof(header), 1) != 1 || outfile.Write(&chunk, sizeof(chunk), 1) != 1) {
+            throw DeadlyExportError("Failed to write the file header!");
+        }
+
+        JsonOutputStream out(&outfile);
+        WriteDocument(out, false);
+        ai_assert(out.Tell() == sceneLength);
+
+        if (padding > 0 && outfile.Write("   ", padding, 1) != 1) {
+            throw DeadlyExportError("Failed to write scene data!");
+        }
+
+        if (bodyLength > 0) {
+            chunk.chunkLength = uint32_t(bodyLength);
+            AI_SWAP4(chunk.chunkLength);
+            chunk.chunkType = ChunkType_BIN;
+            AI_SWAP4(chunk.chunkType);
+
+            if (outfile.Write(&chunk, sizeof(chunk), 1) != 1) {
+                throw DeadlyExportError("Failed to write the binary chunk header!");
+            }
+        }
+    }
+
     inline void AssetWriter::WriteMetadata()
     {
         Value asset;
         asset.SetObject();
         asset.AddMember("version", Value(mAsset.asset.version, mAl).Move(), mAl);
         asset.AddMember("generator", Value(mAsset.asset.generator, mAl).Move(), mAl);
-        mDoc.AddMember("asset", asset, mAl);
+        WriteMember("asset", asset);
     }
 
     inline void AssetWriter::WriteExtensionsUsed()
@@ -582,49 +742,65 @@ namespace glTF2 {
             }
         }
 
+        Value required;
+        required.SetArray();
+        if (this->mAsset.extensionsUsed.KHR_mesh_quantization) {
+            exts.PushBack(StringRef("KHR_mesh_quantization"), mAl);
+            // the vertex data can't be read without the extension
+            required.PushBack(StringRef("KHR_mesh_quantization"), mAl);
+        }
+
         if (!exts.Empty())
-            mDoc.AddMember("extensionsUsed", exts, mAl);
+            WriteMember("extensionsUsed", exts);
+        if (!required.Empty())
+            WriteMember("extensionsRequired", required);
     }
 
     template<class T>
     void AssetWriter::WriteObjects(LazyDict<T>& d)
     {
-        if (d.mObjs.empty()) return;
-
-        Value* container = &mDoc;
+        if (d.mObjs.empty() || mWritingExtensions != (d.mExtId != 0)) return;
 
+        // dictionaries defined by extensions go to the "extensions" object (one per extension)
         if (d.mExtId) {
-            Value* exts = FindObject(mDoc, "extensions");
-            if (!exts) {
-                mDoc.AddMember("extensions", Value().SetObject().Move(), mDoc.GetAllocator());
-                exts = FindObject(mDoc, "extensions");
-            }
-
-            if (!(container = FindObject(*exts, d.mExtId))) {
-                exts->AddMember(StringRef(d.mExtId), Value().SetObject().Move(), mDoc.GetAllocator());
-                container = FindObject(*exts, d.mExtId);
+            if (!mExtensionsOpen) {
+                Key("extensions");
+                StartObject();
+                mExtensionsOpen = true;
             }
+            Key(d.mExtId);
+            StartObject();
         }
 
-        Value* dict;
-        if (!(dict = FindArray(*container, d.mDictId))) {
-            container->AddMember(StringRef(d.mDictId), Value().SetArray().Move(), mDoc.GetAllocator());
-            dict = FindArray(*container, d.mDictId);
-        }
+        Key(d.mDictId);
+        StartArray();
 
         for (size_t i = 0; i < d.mObjs.size(); ++i) {
             if (d.mObjs[i]->IsSpecial()) continue;
 
-            Value obj;
-            obj.SetObject();
+            {
+                Value obj;
+                obj.SetObject();
+
+                if (!d.mObjs[i]->name.empty()) {
+                    obj.AddMember("name", StringRef(d.mObjs[i]->name.c_str()), mAl);
+                }
+
+                Write(obj, *d.mObjs[i], *this);
 
-            if (!d.mObjs[i]->name.empty()) {
-                obj.AddMember("name", StringRef(d.mObjs[i]->name.c_str()), mAl);
+                WriteValue(obj);
             }
 
-            Write(obj, *d.mObjs[i], *this);
+            // the values are written, so release their memory now and then
+            if (mAl.Size() > (1u << 20)) {
+                mAl.Clear();
+            }
+        }
 
-            dict->PushBack(obj, mAl);
+        EndArray();
+
+        if (d.mExtId) {
+            EndObject();
         }
     }
 
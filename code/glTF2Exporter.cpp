@@ -48,16 +48,19 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ByteSwapper.h"
 
 #include "SplitLargeMeshes.h"
+#include "VertexQuantization.h"
 
 #include <assimp/SceneCombiner.h>
 #include <assimp/version.h>
 #include <assimp/IOSystem.hpp>
 #include <assimp/Exporter.hpp>
+#include <assimp/config.h>
 #include <assimp/material.h>
 #include <assimp/scene.h>
 
 // Header files, standard library.
 #include <memory>
+#include <limits>
 #include <inttypes.h>
 
 #include "glTF2AssetWriter.h"
@@ -77,10 +80,18 @@ namespace Assimp {
         glTF2Exporter exporter(pFile, pIOSystem, pScene, pProperties, false);
     }
 
+    // ------------------------------------------------------------------------------------------------
+    // Worker function for exporting a scene to GLB. Prototyped and registered in Exporter.cpp
+    void ExportSceneGLB2(const char* pFile, IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* pProperties)
+    {
+        // invoke the exporter
+        glTF2Exporter exporter(pFile, pIOSystem, pScene, pProperties, true);
+    }
+
 } // end of namespace Assimp
 
 glTF2Exporter::glTF2Exporter(const char* filename, IOSystem* pIOSystem, const aiScene* pScene,
-                           const ExportProperties* pProperties, bool /*isBinary*/)
+                           const ExportProperties* pProperties, bool isBinary)
     : mFilename(filename)
     , mIOSystem(pIOSystem)
     , mProperties(pProperties)
@@ -99,7 +110,59 @@ glTF2Exporter::glTF2Exporter(const char* filename, IOSystem* pIOSystem, const ai
 
     mScene = sceneCopy.get();
 
-    mAsset.reset( new Asset( pIOSystem ) );
+    // Flip UV y coords
+    for (unsigned int idx_mesh = 0; idx_mesh < mScene->mNumMeshes; ++idx_mesh) {
+        aiMesh* aim = mScene->mMeshes[idx_mesh];
+        for (int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+            if (aim->mNumUVComponents[i] > 1) {
+                for (unsigned int j = 0; j < aim->mNumVertices; ++j) {
+                    aim->mTextureCoords[i][j].y = 1 - aim->mTextureCoords[i][j].y;
+                }
+            }
+        }
+    }
+
+    if (!isBinary) {
+        // the buffers are streamed to their .bin files while exporting
+        ExportAsset(false, std::shared_ptr<IOStream>());
+
+        AssetWriter writer(*mAsset);
+        writer.WriteFile(filename);
+        return;
+    }
+
+    // The BIN chunk follows the JSON chunk, which can't be written before all
+    // data is exported. So a layout pass exports the scene only measuring the
+    // body buffer, then the header and the JSON are written, and a data pass
+    // exports the scene again, streaming the very same data behind them.
+    ExportAsset(true, std::shared_ptr<IOStream>());
+    const size_t bodyLength = mAsset->GetBodyBuffer()->byteLength;
+
+    std::shared_ptr<IOStream> outfile(pIOSystem->Open(filename, "wb"));
+    if (!outfile) {
+        throw DeadlyExportError("Could not open output file: " + std::string(filename));
+    }
+
+    {
+        AssetWriter writer(*mAsset);
+        writer.WriteGLBHeader(*outfile);
+    }
+
+    ExportAsset(true, outfile);
+    if (mAsset->GetBodyBuffer()->byteLength != bodyLength) {
+        throw DeadlyExportError("GLTF: the binary data changed between the layout and the data pass");
+    }
+}
+
+void glTF2Exporter::ExportAsset(bool binary, std::shared_ptr<IOStream> body)
+{
+    mAsset.reset( new Asset( mIOSystem ) );
+    mTexturesByPath.clear();
+
+    if (binary) {
+        mAsset->SetAsBinary();
+        mAsset->GetBodyBuffer()->StreamTo(body);
+    }
 
     ExportMetadata();
 
@@ -116,9 +179,10 @@ glTF2Exporter::glTF2Exporter(const char* filename, IOSystem* pIOSystem, const ai
 
     ExportAnimations();
 
-    AssetWriter writer(*mAsset);
-
-    writer.WriteFile(filename);
+    if (binary) { // chunks are 4-byte aligned
+        Ref<Buffer> b = mAsset->GetBodyBuffer();
+        b->Grow((4 - b->byteLength % 4) % 4);
+    }
 }
 
 /*
@@ -149,6 +213,14 @@ static void IdentityMatrix4(mat4& o)
     o[12] = 0; o[13] = 0; o[14] = 0; o[15] = 1;
 }
 
+// Pads the buffer, so the data appended next starts at a multiple of alignment.
+// Returns the offset of that data.
+inline size_t AlignBuffer(Ref<Buffer>& buffer, size_t alignment)
+{
+    buffer->Grow((alignment - buffer->byteLength % alignment) % alignment);
+    return buffer->byteLength;
+}
+
 inline Ref<Accessor> ExportData(Asset& a, std::string& meshName, Ref<Buffer>& buffer,
     unsigned int count, void* data, AttribType::Value typeIn, AttribType::Value typeOut, ComponentType compType, bool isIndices = false)
 {
@@ -158,12 +230,9 @@ inline Ref<Accessor> ExportData(Asset& a, std::string& meshName, Ref<Buffer>& bu
     unsigned int numCompsOut = AttribType::GetNumComponents(typeOut);
     unsigned int bytesPerComp = ComponentTypeSize(compType);
 
-    size_t offset = buffer->byteLength;
     // make sure offset is correctly byte-aligned, as required by spec
-    size_t padding = offset % bytesPerComp;
-    offset += padding;
+    size_t offset = AlignBuffer(buffer, bytesPerComp);
     size_t length = count * numCompsOut * bytesPerComp;
-    buffer->Grow(length + padding);
 
     // bufferView
     Ref<BufferView> bv = a.bufferViews.Create(a.FindUniqueID(meshName, "view"));
@@ -210,12 +279,101 @@ inline Ref<Accessor> ExportData(Asset& a, std::string& meshName, Ref<Buffer>& bu
         }
     }
 
-    // copy the data
-    acc->WriteData(count, data, numCompsIn*bytesPerComp);
+    // copy the data, the buffer may write it to the output right away
+    const size_t srcStride = numCompsIn*bytesPerComp, dstStride = numCompsOut*bytesPerComp;
+    if (srcStride == dstStride) {
+        buffer->AppendData(static_cast<const uint8_t*>(data), length);
+    }
+    else {
+        std::vector<uint8_t> converted(length);
+        CopyData(count, static_cast<const uint8_t*>(data), srcStride, &converted[0], dstStride);
+        buffer->AppendData(&converted[0], length);
+    }
 
     return acc;
 }
 
+// Writes integer vertex data for KHR_mesh_quantization. The elements hold numComps
+// values each and are padded to multiples of 4 bytes, as the spec requires.
+template <typename T>
+inline Ref<Accessor> ExportQuantizedData(Asset& a, std::string& meshName, Ref<Buffer>& buffer,
+    unsigned int count, const std::vector<T>& data, unsigned int numComps, AttribType::Value type,
+    ComponentType compType)
+{
+    if (!count) return Ref<Accessor>();
+
+    const unsigned int elemComps = static_cast<unsigned int>(data.size() / count);
+    const size_t stride = elemComps * sizeof(T);
+    ai_assert(stride % 4 == 0);
+
+    const size_t offset = AlignBuffer(buffer, 4);
+    const size_t length = count * stride;
+    buffer->AppendData(reinterpret_cast<const uint8_t*>(&data[0]), length);
+
+    Ref<BufferView> bv = a.bufferViews.Create(a.FindUniqueID(meshName, "view"));
+    bv->buffer = buffer;
+    bv->byteOffset = unsigned(offset);
+    bv->byteLength = length;
+    bv->byteStride = elemComps != numComps ? stride : 0;
+    bv->target = BufferViewTarget_ARRAY_BUFFER;
+
+    Ref<Accessor> acc = a.accessors.Create(a.FindUniqueID(meshName, "accessor"));
+    acc->bufferView = bv;
+    acc->byteOffset = 0;
+    acc->byteStride = 0;
+    acc->componentType = compType;
+    acc->count = count;
+    acc->type = type;
+    acc->normalized = true;
+
+    // bounds are given in the stored, unnormalized values
+    acc->min.assign(numComps, std::numeric_limits<float>::max());
+    acc->max.assign(numComps, -std::numeric_limits<float>::max());
+    for (unsigned int i = 0; i < count; ++i) {
+        for (unsigned int j = 0; j < numComps; ++j) {
+            const float v = data[i*elemComps + j];
+            acc->min[j] = std::min(acc->min[j], v);
+            acc->max[j] = std::max(acc->max[j], v);
+        }
+    }
+
+    a.extensionsUsed.KHR_mesh_quantization = true;
+    return acc;
+}
+
+// Writes normals as normalized shorts, padded to 8 bytes per element
+inline Ref<Accessor> ExportQuantizedNormals(Asset& a, std::string& meshName, Ref<Buffer>& buffer,
+    unsigned int count, const aiVector3D* normals)
+{
+    if (!normals) return Ref<Accessor>();
+
+    std::vector<int16_t> data(count * 4, 0);
+    for (unsigned int i = 0; i < count; ++i) {
+        const aiVector3D& n = normals[i];
+        const bool valid = n.x == n.x && n.y == n.y && n.z == n.z;
+        for (unsigned int j = 0; j < 3; ++j) {
+            data[i*4 + j] = valid ? Quantization::EncodeSnorm16(n[j]) : 0;
+        }
+    }
+    return ExportQuantizedData(a, meshName, buffer, count, data, 3, AttribType::VEC3, ComponentType_SHORT);
+}
+
+// Writes 2D texture coordinates within [0,1] as normalized unsigned shorts,
+// returns an empty reference if they don't fit
+inline Ref<Accessor> ExportQuantizedTexCoords(Asset& a, std::string& meshName, Ref<Buffer>& buffer,
+    unsigned int count, const aiVector3D* uvs)
+{
+    std::vector<uint16_t> data(count * 2);
+    for (unsigned int i = 0; i < count; ++i) {
+        if (!(uvs[i].x >= 0 && uvs[i].x <= 1 && uvs[i].y >= 0 && uvs[i].y <= 1)) {
+            return Ref<Accessor>();
+        }
+        data[i*2]     = Quantization::EncodeUnorm16(uvs[i].x);
+        data[i*2 + 1] = Quantization::EncodeUnorm16(uvs[i].y);
+    }
+    return ExportQuantizedData(a, meshName, buffer, count, data, 2, AttribType::VEC2, ComponentType_UNSIGNED_SHORT);
+}
+
 inline void SetSamplerWrap(SamplerWrap& wrap, aiTextureMapMode map)
 {
     switch (map) {
@@ -650,9 +808,19 @@ void glTF2Exporter::ExportMeshes()
 
     Ref<Buffer> b = mAsset->GetBodyBuffer();
     if (!b) {
-       b = mAsset->buffers.Create(bufferId);
+        b = mAsset->buffers.Create(bufferId);
+
+        // write the data straight to the .bin file instead of collecting it
+        std::shared_ptr<IOStream> binOutFile(mIOSystem->Open(b->GetURI(), "wb"));
+        if (!binOutFile) {
+            throw DeadlyExportError("Could not open output file: " + b->GetURI());
+        }
+        b->StreamTo(binOutFile);
     }
 
+    // positions stay floats, dequantizing them would require node transforms
+    const bool quantize = mProperties && mProperties->GetPropertyBool(AI_CONFIG_EXPORT_GLTF_QUANTIZE, false);
+
     //----------------------------------------
     // Initialize variables for the skin
     bool createSkin = false;
@@ -692,22 +860,22 @@ void glTF2Exporter::ExportMeshes()
 		if (v) p.attributes.position.push_back(v);
 
 		/******************** Normals ********************/
-		Ref<Accessor> n = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mNormals, AttribType::VEC3, AttribType::VEC3, ComponentType_FLOAT);
+		Ref<Accessor> n = quantize ? ExportQuantizedNormals(*mAsset, meshId, b, aim->mNumVertices, aim->mNormals) :
+			ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mNormals, AttribType::VEC3, AttribType::VEC3, ComponentType_FLOAT);
 		if (n) p.attributes.normal.push_back(n);
 
 		/************** Texture coordinates **************/
         for (int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
-            // Flip UV y coords
-            if (aim -> mNumUVComponents[i] > 1) {
-                for (unsigned int j = 0; j < aim->mNumVertices; ++j) {
-                    aim->mTextureCoords[i][j].y = 1 - aim->mTextureCoords[i][j].y;
-                }
-            }
-
             if (aim->mNumUVComponents[i] > 0) {
                 AttribType::Value type = (aim->mNumUVComponents[i] == 2) ? AttribType::VEC2 : AttribType::VEC3;
 
-				Ref<Accessor> tc = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mTextureCoords[i], AttribType::VEC3, type, ComponentType_FLOAT, false);
+				Ref<Accessor> tc;
+				if (quantize && type == AttribType::VEC2) {
+					tc = ExportQuantizedTexCoords(*mAsset, meshId, b, aim->mNumVertices, aim->mTextureCoords[i]);
+				}
+				if (!tc) {
+					tc = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mTextureCoords[i], AttribType::VEC3, type, ComponentType_FLOAT, false);
+				}
 				if (tc) p.attributes.texcoord.push_back(tc);
 			}
 		}
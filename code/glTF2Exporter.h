@@ -117,6 +117,7 @@ namespace Assimp
         void GetMatTex(const aiMaterial* mat, glTF2::OcclusionTextureInfo& prop, aiTextureType tt, unsigned int slot);
         aiReturn GetMatColor(const aiMaterial* mat, glTF2::vec4& prop, const char* propName, int type, int idx);
         aiReturn GetMatColor(const aiMaterial* mat, glTF2::vec3& prop, const char* propName, int type, int idx);
+        void ExportAsset(bool binary, std::shared_ptr<IOStream> body);
         void ExportMetadata();
         void ExportMaterials();
         void ExportMeshes();
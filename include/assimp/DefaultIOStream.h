@@ -105,6 +105,10 @@ public:
     /// Flush file contents
     void Flush();
 
+    // -------------------------------------------------------------------
+    /// Map the file into memory, see IOStream::MapView()
+    const void* MapView();
+
 private:
     //  File data-structure, using clib
     FILE* mFile;
@@ -113,13 +117,25 @@ private:
 
     // Cached file size
     mutable size_t mCachedSize;
+
+    // Read-only mapping of the file, created on demand by MapView()
+    void* mMappedView;
+    size_t mMappedSize;
+#ifdef _WIN32
+    void* mMappingHandle;
+#endif
 };
 
 // ----------------------------------------------------------------------------------
 inline DefaultIOStream::DefaultIOStream () :
     mFile       (NULL),
     mFilename   (""),
-    mCachedSize(SIZE_MAX)
+    mCachedSize(SIZE_MAX),
+    mMappedView(NULL),
+    mMappedSize(0)
+#ifdef _WIN32
+    , mMappingHandle(NULL)
+#endif
 {
     // empty
 }
@@ -129,7 +145,12 @@ inline DefaultIOStream::DefaultIOStream (FILE* pFile,
         const std::string &strFilename) :
     mFile(pFile),
     mFilename(strFilename),
-    mCachedSize(SIZE_MAX)
+    mCachedSize(SIZE_MAX),
+    mMappedView(NULL),
+    mMappedSize(0)
+#ifdef _WIN32
+    , mMappingHandle(NULL)
+#endif
 {
     // empty
 }
@@ -121,6 +121,19 @@ public:
      *  See fflush() for more details.
      */
     virtual void Flush() = 0;
+
+    // -------------------------------------------------------------------
+    /** @brief Get a read-only view of the entire file contents.
+     *
+     *  Streams which can provide the complete file in memory without
+     *  copying it (i.e. memory-mapped files or memory buffers) return a
+     *  pointer to the first of FileSize() bytes here. Importers use this
+     *  to parse directly out of the view instead of reading the file into
+     *  a buffer first. The view is independent of the read cursor, is not
+     *  zero-terminated and stays valid until the stream is closed.
+     *  @return Pointer to the file contents, NULL if not supported (the
+     *    default). Callers must fall back to Read() then. */
+    virtual const void* MapView();
 }; //! class IOStream
 
 // ----------------------------------------------------------------------------------
@@ -134,6 +147,12 @@ inline IOStream::~IOStream()
 {
     // empty
 }
+
+// ----------------------------------------------------------------------------------
+inline const void* IOStream::MapView()
+{
+    return NULL;
+}
 // ----------------------------------------------------------------------------------
 } //!namespace Assimp
 
@@ -0,0 +1,121 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file ImportStatistics.hpp
+ *  @brief Profiling data collected by #Importer while reading a file.
+ */
+#pragma once
+#ifndef AI_IMPORTSTATISTICS_H_INC
+#define AI_IMPORTSTATISTICS_H_INC
+
+#include "types.h"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+
+namespace Assimp    {
+
+// ------------------------------------------------------------------------------------
+/** @brief CPP-API: One region of the profiling tree returned by
+ *  #Importer::GetLastImportStatistics().
+ *
+ *  The root node covers the whole ReadFile() call. Its children are
+ *  'import', 'preprocess' and 'postprocess'. The 'import' node holds the
+ *  phases reported by the importer (e.g. 'read', 'tokenize', 'parse',
+ *  'convert'), the 'postprocess' node one child per executed step, named
+ *  after the class implementing it (e.g. 'JoinVerticesProcess').
+ *  Steps which report per-mesh counters get one 'mesh <index>' child for
+ *  each mesh. */
+struct ImportStatistics
+{
+    //! Name of the region
+    std::string mName;
+
+    //! Wall clock time spent in the region, in seconds
+    double mSeconds;
+
+    //! Number of allocations made while the region was active. Only
+    //! valid if an allocation counter has been installed using
+    //! #Importer::SetAllocationCounter(), zero otherwise.
+    uint64_t mAllocations;
+
+    //! Number of bytes allocated while the region was active, see
+    //! #mAllocations.
+    uint64_t mAllocatedBytes;
+
+    //! Named counters reported by the region, e.g. 'vertices_in'
+    std::map<std::string, double> mCounters;
+
+    //! Nested regions, in execution order
+    std::vector<ImportStatistics> mChildren;
+
+    ImportStatistics()
+        : mSeconds()
+        , mAllocations()
+        , mAllocatedBytes()
+    {}
+
+    // -------------------------------------------------------------------
+    /** Find a direct child region by name.
+     *  @return NULL if there is no child with this name */
+    const ImportStatistics* FindChild(const std::string& name) const {
+        for (std::vector<ImportStatistics>::const_iterator it = mChildren.begin(); it != mChildren.end(); ++it) {
+            if ((*it).mName == name) {
+                return &*it;
+            }
+        }
+        return NULL;
+    }
+
+    // -------------------------------------------------------------------
+    /** Get the value of a counter, or a default if it wasn't reported */
+    double GetCounter(const std::string& name, double def = 0.0) const {
+        std::map<std::string, double>::const_iterator it = mCounters.find(name);
+        return it == mCounters.end() ? def : (*it).second;
+    }
+};
+
+} // Namespace Assimp
+
+#endif // AI_IMPORTSTATISTICS_H_INC
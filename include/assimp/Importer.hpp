@@ -53,6 +53,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // Public ASSIMP data structures
 #include <assimp/types.h>
+#include <stdint.h>
 
 namespace Assimp    {
     // =======================================================================
@@ -61,6 +62,14 @@ namespace Assimp    {
     class IOStream;
     class IOSystem;
     class ProgressHandler;
+    struct ImportStatistics;
+
+    // -------------------------------------------------------------------
+    /** Callback to sample the application's allocation counters, see
+     *  #Importer::SetAllocationCounter().
+     *  @param numAllocations Receives the total number of allocations so far
+     *  @param numBytes Receives the total number of bytes allocated so far */
+    typedef void (*AllocationCounter)(uint64_t* numAllocations, uint64_t* numBytes);
 
     // =======================================================================
     // Plugin development
@@ -615,6 +624,29 @@ public:
      * intended for use in production environments. */
     void SetExtraVerbose(bool bDo);
 
+    // -------------------------------------------------------------------
+    /** Returns the profiling tree of the last ReadFile() call.
+     *
+     * Statistics are only collected if #AI_CONFIG_GLOB_MEASURE_TIME is
+     * set. Subsequent calls to ApplyPostProcessing() append their steps
+     * to the tree of the scene they work at.
+     * @return NULL if no statistics have been collected. The pointer
+     *   is valid until the next call to ReadFile() or FreeScene().
+     * @see ImportStatistics.hpp for the layout of the tree. */
+    const ImportStatistics* GetLastImportStatistics() const;
+
+    // -------------------------------------------------------------------
+    /** Installs a callback to sample the application's allocation
+     *  counters while statistics are collected.
+     *
+     * Assimp doesn't hook the heap itself. Applications which count
+     * their allocations (e.g. by replacing the global operator new)
+     * can report the totals here to get allocation counts and bytes
+     * for each profiling region. The callback must return monotonically
+     * increasing totals and may be invoked from the importing thread only.
+     * @param counter Callback to install, NULL to disable sampling. */
+    void SetAllocationCounter(AllocationCounter counter);
+
     // -------------------------------------------------------------------
     /** Private, do not use. */
     ImporterPimpl* Pimpl() { return pimpl; }
@@ -0,0 +1,149 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file MappedScene.hpp
+ *  @brief Zero-copy loader for the .assmap scene cache format.
+ */
+#pragma once
+#ifndef AI_MAPPEDSCENE_HPP_INC
+#define AI_MAPPEDSCENE_HPP_INC
+
+#include "types.h"
+#include <string>
+#include <vector>
+
+struct aiScene;
+
+namespace Assimp    {
+
+class IOSystem;
+class IOStream;
+
+// ------------------------------------------------------------------------------------
+/** @brief CPP-API: Loads scenes from .assmap cache files without copying them.
+ *
+ *  .assmap files are written by the "assmap" exporter. They hold an image of
+ *  the aiScene data structure, so loading one merely maps the file into
+ *  memory and resolves the pointers of the scene's structs. Vertex data,
+ *  indices, animation keys and textures are not copied, they point directly
+ *  into the mapped file.
+ *
+ *  The scene is owned by the MappedScene and is valid until Free() is
+ *  called, another scene is loaded or the MappedScene is destroyed. It must
+ *  not be modified, nor passed to functions which modify or delete scenes
+ *  (e.g. aiApplyPostProcessing) - import the file through Assimp::Importer
+ *  to get a regular, modifiable copy instead.
+ *
+ *  .assmap files are a cache: they can only be read by builds of Assimp with
+ *  the same data structure layout (i.e. the same version, pointer size and
+ *  #ai_real type) on the same platform as the build which wrote them. The
+ *  loader detects truncated files and files written by incompatible builds,
+ *  but it is not hardened against deliberately forged files. */
+class ASSIMP_API MappedScene
+{
+public:
+    MappedScene();
+    ~MappedScene();
+
+    // -------------------------------------------------------------------
+    /** @brief Map an .assmap file and return the scene stored in it.
+     *
+     *  The file is memory-mapped if the stream returned by the IO system
+     *  supports IOStream::MapView(), otherwise it is read into memory.
+     *  @param pFile Path of the file to be loaded.
+     *  @param pIOHandler IO system to open the file, NULL for the default
+     *    one. Must stay alive as long as the scene is loaded.
+     *  @return The scene or NULL if the file can't be read. Call
+     *    GetErrorString() to find out why. */
+    const aiScene* Load(const char* pFile, IOSystem* pIOHandler = NULL);
+
+    // -------------------------------------------------------------------
+    /** @brief Load the scene from an .assmap file in memory.
+     *
+     *  The buffer is used in place if it is aligned to 8 bytes, it must
+     *  then stay alive as long as the scene is loaded. Otherwise it is
+     *  copied.
+     *  @param pBuffer Contents of the file.
+     *  @param pLength Size of the buffer, in bytes.
+     *  @return The scene or NULL if the buffer can't be read. */
+    const aiScene* Load(const void* pBuffer, size_t pLength);
+
+    // -------------------------------------------------------------------
+    /** @brief Release the loaded scene and unmap the file. */
+    void Free();
+
+    // -------------------------------------------------------------------
+    /** @brief Get the loaded scene, NULL if there is none. */
+    const aiScene* GetScene() const {
+        return mScene;
+    }
+
+    // -------------------------------------------------------------------
+    /** @brief Get a description of the last error, empty if the last
+     *  call to Load() succeeded. */
+    const char* GetErrorString() const {
+        return mErrorString.c_str();
+    }
+
+private:
+    // no copying
+    MappedScene(const MappedScene&);
+    MappedScene& operator = (const MappedScene&);
+
+    const aiScene* Setup(const uint8_t* pData, size_t pLength);
+
+    IOSystem* mIOHandler;
+    bool mOwnIOHandler;
+    IOStream* mStream;
+
+    // the struct region of the file with resolved pointers
+    std::vector<uint64_t> mStructs;
+
+    // copy of the file if it can't be mapped
+    std::vector<uint64_t> mFileCopy;
+
+    const aiScene* mScene;
+    std::string mErrorString;
+};
+
+} // !namespace Assimp
+
+#endif // AI_MAPPEDSCENE_HPP_INC
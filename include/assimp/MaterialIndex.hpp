@@ -0,0 +1,131 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file MaterialIndex.hpp
+ *  @brief Optional hash index for fast material property lookups.
+ */
+#pragma once
+#ifndef AI_MATERIALINDEX_HPP_INC
+#define AI_MATERIALINDEX_HPP_INC
+
+#include "material.h"
+#include <vector>
+
+namespace Assimp    {
+
+// ------------------------------------------------------------------------------------
+/** @brief CPP-API: Hash index over the properties of a single material.
+ *
+ *  aiMaterial stores its properties in a plain array, so aiMaterial::Get(),
+ *  AddProperty() and RemoveProperty() search it linearly. This is fine for
+ *  the usual couple of dozens of properties but adds up if the same
+ *  material is queried over and over again, e.g. while binding materials
+ *  in a renderer.
+ *
+ *  The index hashes the property keys once. Get() and AddBinaryProperty()
+ *  then run in constant time on average and give exactly the same results
+ *  as the aiMaterial functions. The index does not own the material and
+ *  does not notice changes made to it by other means than this class -
+ *  call Rebuild() after modifying the material directly. */
+class ASSIMP_API MaterialIndex
+{
+public:
+    // -------------------------------------------------------------------
+    /** @brief Build the index for a material.
+     *  @param material Material to be indexed, must outlive the index. */
+    explicit MaterialIndex(aiMaterial* material);
+
+    ~MaterialIndex();
+
+    // -------------------------------------------------------------------
+    /** @brief Rebuild the index after the material was modified directly. */
+    void Rebuild();
+
+    // -------------------------------------------------------------------
+    /** @brief Get a material property, see #aiGetMaterialProperty.
+     *  @return The first matching property or NULL. */
+    const aiMaterialProperty* Get(const char* pKey,
+        unsigned int type, unsigned int idx) const;
+
+    // -------------------------------------------------------------------
+    /** @brief Add or replace a property, see aiMaterial::AddBinaryProperty. */
+    aiReturn AddBinaryProperty(const void* pInput,
+        unsigned int pSizeInBytes,
+        const char* pKey,
+        unsigned int type,
+        unsigned int index,
+        aiPropertyTypeInfo pType);
+
+    // -------------------------------------------------------------------
+    /** @brief Remove a property, see aiMaterial::RemoveProperty.
+     *
+     *  The following properties move up in the property array, thus this
+     *  takes linear time like the aiMaterial function. */
+    aiReturn RemoveProperty(const char* pKey,
+        unsigned int type = 0, unsigned int index = 0);
+
+    // -------------------------------------------------------------------
+    /** @brief Get the indexed material. */
+    aiMaterial* GetMaterial() const {
+        return mMaterial;
+    }
+
+private:
+    // no copying
+    MaterialIndex(const MaterialIndex&);
+    MaterialIndex& operator = (const MaterialIndex&);
+
+    unsigned int Find(const char* pKey, unsigned int type,
+        unsigned int index) const;
+    void Insert(uint32_t hash, unsigned int position);
+
+    struct Slot {
+        uint32_t mHash;
+        unsigned int mPosition;
+    };
+
+    aiMaterial* mMaterial;
+    std::vector<Slot> mSlots;
+};
+
+} // !namespace Assimp
+
+#endif // AI_MATERIALINDEX_HPP_INC
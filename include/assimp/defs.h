@@ -215,16 +215,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // "W8059 Packgröße der Struktur geändert"
 
-#endif
-
-
-    //////////////////////////////////////////////////////////////////////////
-    /* Define ASSIMP_BUILD_SINGLETHREADED to compile assimp
-     * without threading support. The library doesn't utilize
-     * threads then and is itself not threadsafe. */
-    //////////////////////////////////////////////////////////////////////////
-#ifndef ASSIMP_BUILD_SINGLETHREADED
-#   define ASSIMP_BUILD_SINGLETHREADED
 #endif
 
 #if defined(_DEBUG) || ! defined(NDEBUG)
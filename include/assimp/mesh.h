@@ -278,6 +278,56 @@ struct aiBone
 };
 
 
+// ---------------------------------------------------------------------------
+/** @brief A small cluster of triangles of a mesh, see #aiMesh::mMeshlets.
+ *
+ *  Meshlets are generated by the #aiProcess_GenerateMeshlets step. Each one
+ *  references up to a configurable number of mesh vertices through its own
+ *  slice of #aiMesh::mMeshletVertices, its triangles index into that slice
+ *  with 8 bit indices stored in #aiMesh::mMeshletIndices.
+ */
+struct aiMeshlet
+{
+    //! Index of the first entry of the meshlet in aiMesh::mMeshletVertices
+    unsigned int mVertexOffset;
+
+    //! Number of vertices referenced by the meshlet
+    unsigned int mNumVertices;
+
+    //! Index of the first entry of the meshlet in aiMesh::mMeshletIndices
+    unsigned int mIndexOffset;
+
+    //! Number of triangles of the meshlet, each takes 3 indices
+    unsigned int mNumTriangles;
+
+    //! Bounding sphere of the vertices of the meshlet
+    C_STRUCT aiVector3D mCenter;
+    ai_real mRadius;
+
+    //! Normal cone of the triangles of the meshlet. The meshlet is
+    //! backfacing for a viewer at position p if
+    //! dot(normalize(mConeApex - p), mConeAxis) >= mConeCutoff.
+    //! mConeCutoff is 1 if the triangles face too many directions.
+    C_STRUCT aiVector3D mConeApex;
+    C_STRUCT aiVector3D mConeAxis;
+    ai_real mConeCutoff;
+
+#ifdef __cplusplus
+
+    //! Default constructor
+    aiMeshlet()
+        : mVertexOffset( 0 )
+        , mNumVertices( 0 )
+        , mIndexOffset( 0 )
+        , mNumTriangles( 0 )
+        , mRadius( 0 )
+        , mConeCutoff( 1 )
+    { /* nothing to do here */ }
+
+#endif // __cplusplus
+};
+
+
 // ---------------------------------------------------------------------------
 /** @brief Enumerates the types of geometric primitives supported by Assimp.
  *
@@ -640,7 +690,29 @@ struct aiMesh
      *  Method of morphing when animeshes are specified. 
      */
     unsigned int mMethod;
-	
+
+    /** The number of meshlets of this mesh. 0 unless the
+     *  #aiProcess_GenerateMeshlets step has been executed. */
+    unsigned int mNumMeshlets;
+
+    /** The meshlets the triangles of this mesh are partitioned into,
+     *  NULL if not present. The array is mNumMeshlets in size. */
+    C_STRUCT aiMeshlet* mMeshlets;
+
+    /** The number of entries in mMeshletVertices. */
+    unsigned int mNumMeshletVertices;
+
+    /** Mesh vertex indices referenced by the meshlets. Each meshlet owns
+     *  the range aiMeshlet::mVertexOffset to mVertexOffset+mNumVertices. */
+    unsigned int* mMeshletVertices;
+
+    /** The number of entries in mMeshletIndices. */
+    unsigned int mNumMeshletIndices;
+
+    /** Triangles of the meshlets, three entries per triangle. The indices
+     *  are relative to the vertex range of the meshlet in mMeshletVertices. */
+    unsigned char* mMeshletIndices;
+
 #ifdef __cplusplus
 
     //! Default constructor. Initializes all members to 0
@@ -659,6 +731,12 @@ struct aiMesh
         , mNumAnimMeshes( 0 )
         , mAnimMeshes( NULL )
         , mMethod( 0 )
+        , mNumMeshlets( 0 )
+        , mMeshlets( NULL )
+        , mNumMeshletVertices( 0 )
+        , mMeshletVertices( NULL )
+        , mNumMeshletIndices( 0 )
+        , mMeshletIndices( NULL )
     {
         for( unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; a++)
         {
@@ -700,6 +778,9 @@ struct aiMesh
         }
 
         delete [] mFaces;
+        delete [] mMeshlets;
+        delete [] mMeshletVertices;
+        delete [] mMeshletIndices;
     }
 
     //! Check whether the mesh contains positions. Provided no special
@@ -763,6 +844,10 @@ struct aiMesh
     inline bool HasBones() const
         { return mBones != NULL && mNumBones > 0; }
 
+    //! Check whether the mesh has been partitioned into meshlets
+    inline bool HasMeshlets() const
+        { return mMeshlets != NULL && mNumMeshlets > 0; }
+
 #endif // __cplusplus
 };
 
@@ -535,7 +535,61 @@ enum aiPostProcessSteps
     *
     *  Use <tt>#AI_CONFIG_GLOBAL_SCALE_FACTOR_KEY</tt> to control this.
     */
-    aiProcess_GlobalScale = 0x8000000
+    aiProcess_GlobalScale = 0x8000000,
+
+    // -------------------------------------------------------------------------
+    /** <hr>This step generates simplified copies (levels of detail) of all
+     *  triangle meshes.
+     *
+     *  The meshes are simplified by quadric error metric edge collapses. Vertices
+     *  on UV or normal seams and on open borders are kept, as are the dominant
+     *  bones of the vertices. The simplified meshes are appended to
+     *  aiScene::mMeshes, named after their source mesh with a "_LOD<n>" suffix.
+     *  Every node referencing a source mesh gets a child node per level which
+     *  references the simplified meshes and holds the level in its "LOD" metadata
+     *  entry. Applications rendering the whole node graph need to pick one level
+     *  per node.
+     *
+     *  Use <tt>#AI_CONFIG_PP_GL_LOD_RATIOS</tt> to control the number of levels and
+     *  their target face counts. Levels which would not be smaller than the
+     *  previous one are left out. This step requires triangulated, indexed
+     *  meshes, so combine it with #aiProcess_Triangulate, #aiProcess_SortByPType
+     *  and #aiProcess_JoinIdenticalVertices (which is mandatory - without it,
+     *  every vertex sits on a seam and nothing can be simplified).
+    */
+    aiProcess_GenerateLODs = 0x10000000,
+
+    // -------------------------------------------------------------------------
+    /** <hr>This step partitions all triangle meshes into meshlets for
+     *  GPU-driven rendering.
+     *
+     *  A meshlet is a small cluster of adjacent triangles referencing a limited
+     *  number of vertices. Each one comes with a bounding sphere and a normal
+     *  cone for culling, see #aiMeshlet. The meshlets are stored in
+     *  aiMesh::mMeshlets, the faces of the mesh are kept as they are. The step
+     *  runs after #aiProcess_ImproveCacheLocality, which helps to keep
+     *  the meshlets compact.
+     *
+     *  Use <tt>#AI_CONFIG_PP_GM_MAX_VERTICES</tt> and
+     *  <tt>#AI_CONFIG_PP_GM_MAX_TRIANGLES</tt> to control the meshlet size.
+     *  This step requires triangulated meshes, so combine it with
+     *  #aiProcess_Triangulate and #aiProcess_SortByPType.
+    */
+    aiProcess_GenerateMeshlets = 0x20000000,
+
+    // -------------------------------------------------------------------------
+    /** <hr>This step rounds the vertex components of all meshes to the
+     *  precision of compact integer encodings.
+     *
+     *  Positions and texture coordinates are quantized to 16 bit relative to
+     *  their bounding box, normals, tangents and bitangents to 16 bit
+     *  octahedral vectors and vertex colors to 8 bit per channel. The data
+     *  is still stored as floats, so this is useful mainly together with an
+     *  exporter writing quantized data (see <tt>#AI_CONFIG_EXPORT_ASSBIN_QUANTIZE</tt>
+     *  and <tt>#AI_CONFIG_EXPORT_GLTF_QUANTIZE</tt>), which then writes exactly
+     *  what the application sees after the import.
+    */
+    aiProcess_QuantizeVertices = 0x40000000
 
     // aiProcess_GenEntityMeshes = 0x100000,
     // aiProcess_OptimizeAnimations = 0x200000
@@ -0,0 +1,132 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+#include "AbstractImportExportBase.h"
+#include "assbin_chunks.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/Exporter.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <string.h>
+
+using namespace Assimp;
+
+class utAssbinImportExport : public AbstractImportExportBase {
+public:
+    virtual bool importerTest() {
+        Assimp::Importer importer;
+        const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/OBJ/spider_out.assbin", aiProcess_ValidateDataStructure );
+        return nullptr != scene;
+    }
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+    virtual bool exporterTest() {
+        Assimp::Importer importer;
+        const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_ValidateDataStructure );
+        if ( nullptr == scene ) {
+            return false;
+        }
+
+        Assimp::Exporter exporter;
+        return AI_SUCCESS == exporter.Export( scene, "assbin", ASSIMP_TEST_MODELS_DIR "/OBJ/spider_out.assbin" );
+    }
+
+    // Export the spider to a blob and import it again, using the given properties
+    static void RoundTrip( const ExportProperties* props, size_t& blobSize, uint16_t& compression, unsigned int& numVertices ) {
+        Assimp::Importer importer;
+        const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_ValidateDataStructure );
+        ASSERT_NE( nullptr, scene );
+
+        Assimp::Exporter exporter;
+        const aiExportDataBlob *blob = exporter.ExportToBlob( scene, "assbin", 0, props );
+        ASSERT_NE( nullptr, blob );
+        ASSERT_GT( blob->size, size_t( ASSBIN_HEADER_LENGTH ) );
+        blobSize = blob->size;
+        memcpy( &compression, static_cast<const char*>( blob->data ) + 62, sizeof( uint16_t ) );
+
+        Assimp::Importer reimporter;
+        const aiScene *copy = reimporter.ReadFileFromMemory( blob->data, blob->size, aiProcess_ValidateDataStructure, "assbin" );
+        ASSERT_NE( nullptr, copy );
+        ASSERT_EQ( scene->mNumMeshes, copy->mNumMeshes );
+        ASSERT_EQ( scene->mNumMaterials, copy->mNumMaterials );
+
+        numVertices = 0;
+        for ( unsigned int i = 0; i < scene->mNumMeshes; ++i ) {
+            const aiMesh *a = scene->mMeshes[ i ], *b = copy->mMeshes[ i ];
+            ASSERT_EQ( a->mNumVertices, b->mNumVertices );
+            ASSERT_EQ( a->mNumFaces, b->mNumFaces );
+            EXPECT_EQ( 0, memcmp( a->mVertices, b->mVertices, a->mNumVertices * sizeof( aiVector3D ) ) );
+            numVertices += b->mNumVertices;
+        }
+    }
+#endif
+};
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+
+TEST_F( utAssbinImportExport, exportAssbinTest ) {
+    EXPECT_TRUE( exporterTest() );
+    EXPECT_TRUE( importerTest() );
+}
+
+TEST_F( utAssbinImportExport, compressedRoundTripTest ) {
+    size_t plainSize = 0, packedSize = 0;
+    uint16_t compression = 0;
+    unsigned int plainVertices = 0, packedVertices = 0;
+
+    RoundTrip( nullptr, plainSize, compression, plainVertices );
+    EXPECT_EQ( ASSBIN_COMPRESSION_NONE, compression );
+
+    // small blocks and several threads to get more blocks than threads
+    ExportProperties props;
+    props.SetPropertyInteger( AI_CONFIG_EXPORT_ASSBIN_COMPRESSION_LEVEL, 1 );
+    props.SetPropertyInteger( AI_CONFIG_EXPORT_ASSBIN_BLOCK_SIZE, 4096 );
+    props.SetPropertyInteger( AI_CONFIG_GLOB_MULTITHREADING, 4 );
+    RoundTrip( &props, packedSize, compression, packedVertices );
+    EXPECT_EQ( ASSBIN_COMPRESSION_DEFLATE_BLOCKS, compression );
+    EXPECT_LT( packedSize, plainSize );
+    EXPECT_EQ( plainVertices, packedVertices );
+}
+
+#endif // ASSIMP_BUILD_NO_EXPORT
@@ -80,3 +80,33 @@ TEST_F( utDefaultIOStream, FileSizeTest ) {
     }
     remove(fpath);
 }
+
+TEST_F( utDefaultIOStream, MapViewTest ) {
+    char fpath[] = { TMP_PATH"rndfp.XXXXXX" };
+    auto* fs = MakeTmpFile(fpath);
+    ASSERT_NE(nullptr, fs);
+    {
+        auto written = std::fwrite(data, sizeof(*data), sizeof(data), fs );
+        EXPECT_EQ( sizeof(data), written );
+        std::fclose(fs);
+        fs = std::fopen(fpath, "rb");
+        ASSERT_NE(nullptr, fs);
+
+        TestDefaultIOStream myStream( fs, fpath);
+        const char* view = static_cast<const char*>( myStream.MapView() );
+        ASSERT_NE( nullptr, view );
+        EXPECT_EQ( 0, memcmp( view, data, sizeof(data) ) );
+
+        // mapping is cached and doesn't affect the read cursor
+        EXPECT_EQ( view, myStream.MapView() );
+        char first[5];
+        EXPECT_EQ( 1U, myStream.Read( first, sizeof(first), 1 ) );
+        EXPECT_EQ( 0, memcmp( first, data, sizeof(first) ) );
+    }
+    remove(fpath);
+}
+
+TEST_F( utDefaultIOStream, MapViewWithoutFileTest ) {
+    TestDefaultIOStream myStream;
+    EXPECT_EQ( nullptr, myStream.MapView() );
+}
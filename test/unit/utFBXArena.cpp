@@ -0,0 +1,127 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+#include "UnitTestPCH.h"
+
+#include "FBXArena.h"
+
+#include <vector>
+
+using namespace Assimp;
+using namespace Assimp::FBX;
+
+class utFBXArena : public ::testing::Test {
+    // empty
+};
+
+namespace {
+
+struct Tracked {
+    Tracked(std::vector<int>& log, int id)
+    : log(log), id(id) {
+    }
+    ~Tracked() {
+        log.push_back(id);
+    }
+    std::vector<int>& log;
+    int id;
+};
+
+}
+
+TEST_F( utFBXArena, allocateTest ) {
+    Arena arena;
+    EXPECT_EQ( 0U, arena.GetReservedBytes() );
+
+    char* last = NULL;
+    for ( size_t i = 1; i < 2000; ++i ) {
+        const size_t align = size_t(1) << ( i % 5 );
+        char* p = static_cast<char*>( arena.Allocate( i % 37 + 1, align ) );
+        ASSERT_TRUE( NULL != p );
+        EXPECT_EQ( 0U, reinterpret_cast<uintptr_t>( p ) % align );
+        EXPECT_NE( last, p );
+        ::memset( p, 0xcd, i % 37 + 1 );
+        last = p;
+    }
+
+    // larger than a block
+    char* big = static_cast<char*>( arena.Allocate( 4 * 1024 * 1024, 16 ) );
+    ASSERT_TRUE( NULL != big );
+    ::memset( big, 0xcd, 4 * 1024 * 1024 );
+    EXPECT_LE( size_t( 4 * 1024 * 1024 ), arena.GetReservedBytes() );
+
+    // the current block is still used after a large allocation
+    char* a = static_cast<char*>( arena.Allocate( 8, 8 ) );
+    char* b = static_cast<char*>( arena.Allocate( 8, 8 ) );
+    EXPECT_EQ( a + 8, b );
+}
+
+TEST_F( utFBXArena, destructorTest ) {
+    std::vector<int> log;
+    {
+        Arena arena;
+        for ( int i = 0; i < 100; ++i ) {
+            Tracked* t = arena.New<Tracked>( log, i );
+            EXPECT_EQ( i, t->id );
+        }
+        EXPECT_TRUE( log.empty() );
+    }
+
+    // reverse order of creation
+    ASSERT_EQ( 100U, log.size() );
+    for ( int i = 0; i < 100; ++i ) {
+        EXPECT_EQ( 99 - i, log[ i ] );
+    }
+}
+
+TEST_F( utFBXArena, allocatorTest ) {
+    Arena arena;
+    std::vector<int, ArenaAllocator<int> > onArena( ( ArenaAllocator<int>( arena ) ) );
+    std::vector<int, ArenaAllocator<int> > onHeap;
+    for ( int i = 0; i < 10000; ++i ) {
+        onArena.push_back( i );
+        onHeap.push_back( i );
+    }
+    EXPECT_TRUE( onArena == onHeap );
+    EXPECT_TRUE( onArena.get_allocator() != onHeap.get_allocator() );
+    EXPECT_LT( 0U, arena.GetReservedBytes() );
+}
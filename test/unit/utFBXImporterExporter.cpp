@@ -45,6 +45,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AbstractImportExportBase.h"
 
 #include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+#include <assimp/config.h>
 
 using namespace Assimp;
 
@@ -60,3 +63,29 @@ public:
 TEST_F( utFBXImporterExporter, importXFromFileTest ) {
     EXPECT_TRUE( importerTest() );
 }
+
+TEST_F( utFBXImporterExporter, parallelDecodeTest ) {
+    Assimp::Importer serial;
+    const aiScene *expected = serial.ReadFile( ASSIMP_TEST_MODELS_DIR "/FBX/spider.fbx", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, expected );
+
+    Assimp::Importer parallel;
+    parallel.SetPropertyInteger( AI_CONFIG_GLOB_MULTITHREADING, 4 );
+    const aiScene *scene = parallel.ReadFile( ASSIMP_TEST_MODELS_DIR "/FBX/spider.fbx", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, scene );
+
+    ASSERT_EQ( expected->mNumMeshes, scene->mNumMeshes );
+    EXPECT_EQ( expected->mNumMaterials, scene->mNumMaterials );
+    EXPECT_EQ( expected->mNumAnimations, scene->mNumAnimations );
+    for ( unsigned int i = 0; i < expected->mNumMeshes; ++i ) {
+        const aiMesh *expMesh = expected->mMeshes[ i ];
+        const aiMesh *mesh = scene->mMeshes[ i ];
+        EXPECT_EQ( expMesh->mName, mesh->mName );
+        EXPECT_EQ( expMesh->mNumBones, mesh->mNumBones );
+        ASSERT_EQ( expMesh->mNumVertices, mesh->mNumVertices );
+        for ( unsigned int v = 0; v < expMesh->mNumVertices; ++v ) {
+            EXPECT_EQ( expMesh->mVertices[ v ], mesh->mVertices[ v ] );
+        }
+        EXPECT_EQ( expMesh->mNumFaces, mesh->mNumFaces );
+    }
+}
@@ -187,3 +187,92 @@ TEST_F(FastAtofTest, FastAtof)
 {
     RunTest<ai_real>(FastAtofWrapper());
 }
+
+struct FastAtofRangeWrapper {
+    ai_real operator()(const char* str) {
+        ai_real ret;
+        Assimp::fast_atoreal_move<ai_real>(str, str + strlen(str), ret);
+        return ret;
+    }
+};
+
+TEST_F(FastAtofTest, FastAtofRange)
+{
+    RunTest<ai_real>(FastAtofRangeWrapper());
+}
+
+TEST_F(FastAtofTest, FastAtofRangeMatchesScalar)
+{
+    static const char* const values[] = {
+        "0", "7", "12345678", "123456789", "-0.5", "+3.25", "1.", "1.e2", ".5",
+        "0.000123456789012345678", "1234567890123456789", "98765432109876543210",
+        "12345678901234567890123", "3.14159265358979323846264338327950288",
+        "-1.17549435e-38", "6.02214076E+23", "4294967296.4294967296", "1,5",
+        "00000000000000000000001", "9.99999999999999999999e-5", "123456.7x", "5e3 "
+    };
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i) {
+        // use exactly sized heap copies, so reads behind the range are detected
+        const std::string str(values[i]);
+        std::vector<char> buffer(str.begin(), str.end());
+
+        for (int comma = 0; comma < 2; ++comma) {
+            double expected, value;
+            const char* expectedEnd = Assimp::fast_atoreal_move<double>(str.c_str(), expected, comma != 0);
+            const char* end = Assimp::fast_atoreal_move<double>(&buffer[0], &buffer[0] + buffer.size(), value, comma != 0);
+            EXPECT_EQ(0, memcmp(&expected, &value, sizeof(double))) << values[i];
+            EXPECT_EQ(expectedEnd - str.c_str(), end - &buffer[0]) << values[i];
+        }
+    }
+}
+
+TEST_F(FastAtofTest, Strtoul10_64Range)
+{
+    static const char digits[] = "123456789012345678901234";
+    for (size_t len = 1; len < sizeof(digits); ++len) {
+        for (unsigned int max = 0; max < 24; ++max) {
+            const std::string str(digits, len);
+            std::vector<char> buffer(str.begin(), str.end());
+            const char* expectedEnd = NULL;
+            const char* end = NULL;
+            unsigned int expectedMax = max, maxInOut = max;
+            const uint64_t expected = Assimp::strtoul10_64(str.c_str(), &expectedEnd, &expectedMax);
+            const uint64_t value = Assimp::strtoul10_64(&buffer[0], &buffer[0] + buffer.size(), &end, &maxInOut);
+            EXPECT_EQ(expected, value);
+            EXPECT_EQ(expectedMax, maxInOut);
+            if (expectedEnd) {
+                EXPECT_EQ(expectedEnd - str.c_str(), end - &buffer[0]);
+            } else {
+                // overflow, the end is not written
+                EXPECT_EQ(NULL, end);
+            }
+        }
+    }
+
+    const char* empty = "";
+    EXPECT_THROW(Assimp::strtoul10_64(empty, empty, NULL), std::invalid_argument);
+    const char* letters = "a1";
+    EXPECT_THROW(Assimp::strtoul10_64(letters, letters + 2, NULL), std::invalid_argument);
+}
+
+TEST_F(FastAtofTest, FastAtofArray)
+{
+    const std::string str = " 1 -2.5\t3e2\r\n .25\n\n7";
+    const char* cur = str.c_str();
+    float values[8];
+    EXPECT_EQ(5u, Assimp::fast_atoreal_array<float>(cur, str.c_str() + str.size(), values, 8));
+    EXPECT_EQ(str.c_str() + str.size(), cur);
+    EXPECT_FLOAT_EQ(1.f, values[0]);
+    EXPECT_FLOAT_EQ(-2.5f, values[1]);
+    EXPECT_FLOAT_EQ(300.f, values[2]);
+    EXPECT_FLOAT_EQ(.25f, values[3]);
+    EXPECT_FLOAT_EQ(7.f, values[4]);
+
+    // stops after the requested number of values
+    cur = str.c_str();
+    EXPECT_EQ(2u, Assimp::fast_atoreal_array<float>(cur, str.c_str() + str.size(), values, 2));
+    EXPECT_EQ('\t', *cur);
+
+    const std::string bad = "1 x";
+    cur = bad.c_str();
+    EXPECT_THROW(Assimp::fast_atoreal_array<float>(cur, bad.c_str() + bad.size(), values, 2), std::invalid_argument);
+}
@@ -0,0 +1,157 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <assimp/scene.h>
+#include <FindInstancesProcess.h>
+#include <ThreadPool.h>
+
+using namespace Assimp;
+
+class FindInstancesProcessTest : public ::testing::Test
+{
+    // empty
+};
+
+// ------------------------------------------------------------------------------------------------
+// a strip of triangles in verbose format, shifted by 'offset'
+static aiMesh* makeMesh(float offset, unsigned int numFaces = 4)
+{
+    aiMesh* mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = numFaces * 3;
+    mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+    mesh->mNumFaces = numFaces;
+    mesh->mFaces = new aiFace[numFaces];
+    for (unsigned int i = 0; i < numFaces; ++i) {
+        aiFace& face = mesh->mFaces[i];
+        face.mNumIndices = 3;
+        face.mIndices = new unsigned int[3];
+        for (unsigned int n = 0; n < 3; ++n) {
+            face.mIndices[n] = i * 3 + n;
+            mesh->mVertices[i * 3 + n] = aiVector3D(offset + i + n, static_cast<float>(n & 1), 0.0f);
+        }
+    }
+    return mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+static aiScene* makeScene(const std::vector<aiMesh*>& meshes)
+{
+    aiScene* scene = new aiScene();
+    scene->mNumMeshes = static_cast<unsigned int>(meshes.size());
+    scene->mMeshes = new aiMesh*[meshes.size()];
+    std::copy(meshes.begin(), meshes.end(), scene->mMeshes);
+
+    scene->mRootNode = new aiNode();
+    scene->mRootNode->mNumMeshes = scene->mNumMeshes;
+    scene->mRootNode->mMeshes = new unsigned int[scene->mNumMeshes];
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        scene->mRootNode->mMeshes[i] = i;
+    }
+    return scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(FindInstancesProcessTest, testInstances)
+{
+    // the epsilon is 1e-4 of the bounding box diagonal (~6)
+    std::vector<aiMesh*> meshes;
+    meshes.push_back(makeMesh(0.0f));
+    meshes.push_back(makeMesh(0.0f));       // instance of 0
+    meshes.push_back(makeMesh(10.0f));
+    meshes.push_back(makeMesh(0.00001f));   // instance of 0, within epsilon
+    meshes.push_back(makeMesh(10.0f));      // instance of 2
+    meshes.push_back(makeMesh(0.01f));      // not within epsilon
+    meshes.push_back(makeMesh(0.01f));      // instance of 5
+    meshes.push_back(makeMesh(0.0f, 5));    // different layout
+
+    aiScene* scene = makeScene(meshes);
+    FindInstancesProcess process;
+    process.Execute(scene);
+
+    ASSERT_EQ(4U, scene->mNumMeshes);
+    const unsigned int expected[] = { 0, 0, 1, 0, 1, 2, 2, 3 };
+    for (unsigned int i = 0; i < 8; ++i) {
+        EXPECT_EQ(expected[i], scene->mRootNode->mMeshes[i]);
+    }
+    EXPECT_EQ(meshes[0], scene->mMeshes[0]);
+    EXPECT_EQ(meshes[2], scene->mMeshes[1]);
+    EXPECT_EQ(meshes[5], scene->mMeshes[2]);
+    EXPECT_EQ(meshes[7], scene->mMeshes[3]);
+    delete scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(FindInstancesProcessTest, testParallelMatchesSerial)
+{
+    // lots of meshes with the same layout, a few of them repeated
+    std::vector<float> offsets;
+    for (unsigned int i = 0; i < 2000; ++i) {
+        offsets.push_back(static_cast<float>((i * 7919) % 613) * 0.5f);
+    }
+
+    std::vector<aiMesh*> serialMeshes, parallelMeshes;
+    for (unsigned int i = 0; i < offsets.size(); ++i) {
+        serialMeshes.push_back(makeMesh(offsets[i], 1 + i % 3));
+        parallelMeshes.push_back(makeMesh(offsets[i], 1 + i % 3));
+    }
+
+    aiScene* serial = makeScene(serialMeshes);
+    FindInstancesProcess serialProcess;
+    serialProcess.Execute(serial);
+
+    ThreadPool pool(4);
+    aiScene* parallel = makeScene(parallelMeshes);
+    FindInstancesProcess parallelProcess;
+    parallelProcess.SetThreadPool(&pool);
+    parallelProcess.Execute(parallel);
+
+    // 613 distinct offsets, each with three layouts
+    EXPECT_EQ(613U * 3U, serial->mNumMeshes);
+    ASSERT_EQ(serial->mNumMeshes, parallel->mNumMeshes);
+    for (unsigned int i = 0; i < offsets.size(); ++i) {
+        EXPECT_EQ(serial->mRootNode->mMeshes[i], parallel->mRootNode->mMeshes[i]);
+    }
+    delete serial;
+    delete parallel;
+}
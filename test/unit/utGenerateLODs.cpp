@@ -0,0 +1,304 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+#include "UnitTestPCH.h"
+
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+#include <GenerateLODsProcess.h>
+
+#include <cmath>
+
+using namespace Assimp;
+
+class GenerateLODsTest : public ::testing::Test
+{
+public:
+    virtual void SetUp();
+    virtual void TearDown();
+
+protected:
+    // Runs the step with the given LOD ratios
+    void Process(const char* ratios);
+
+    // Checks whether the mesh contains a vertex at the given position
+    static bool HasPosition(const aiMesh* mesh, const aiVector3D& pos);
+
+    static const unsigned int size = 30;
+
+    aiScene* pcScene;
+    aiMesh* pcMesh;
+};
+
+// ------------------------------------------------------------------------------------------------
+void GenerateLODsTest::SetUp()
+{
+    // A bumpy 30x30 quad grid. The column at x=15 is a UV seam, i.e. its vertices
+    // are duplicated for the left and right half. Each half is bound to its own bone.
+    const unsigned int row = size+2;
+    pcMesh = new aiMesh();
+    pcMesh->mName.Set("grid");
+    pcMesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    pcMesh->mNumVertices = (size+1)*row;
+    pcMesh->mVertices = new aiVector3D[pcMesh->mNumVertices];
+    pcMesh->mNormals = new aiVector3D[pcMesh->mNumVertices];
+    pcMesh->mTextureCoords[0] = new aiVector3D[pcMesh->mNumVertices];
+    pcMesh->mNumUVComponents[0] = 2;
+    for (unsigned int y = 0; y <= size; ++y) {
+        for (unsigned int i = 0; i < row; ++i) {
+            const unsigned int x = i <= size/2 ? i : i-1;
+            const unsigned int v = y*row+i;
+            pcMesh->mVertices[v] = aiVector3D((float)x,(float)y,std::sin(x*0.3f)*std::cos(y*0.2f));
+            pcMesh->mNormals[v] = aiVector3D(0.f,0.f,1.f);
+            pcMesh->mTextureCoords[0][v] = aiVector3D(i <= size/2 ? x*0.01f : x*0.02f,y*0.01f,0.f);
+        }
+    }
+
+    pcMesh->mNumFaces = size*size*2;
+    pcMesh->mFaces = new aiFace[pcMesh->mNumFaces];
+    aiFace* face = pcMesh->mFaces;
+    for (unsigned int y = 0; y < size; ++y) {
+        for (unsigned int x = 0; x < size; ++x) {
+            const unsigned int v = y*row + (x < size/2 ? x : x+1);
+            const unsigned int quad[6] = { v,v+1,v+row+1, v,v+row+1,v+row };
+            for (unsigned int i = 0; i < 6; i += 3, ++face) {
+                face->mIndices = new unsigned int[face->mNumIndices = 3];
+                std::copy(quad+i,quad+i+3,face->mIndices);
+            }
+        }
+    }
+
+    pcMesh->mNumBones = 2;
+    pcMesh->mBones = new aiBone*[2];
+    for (unsigned int b = 0; b < 2; ++b) {
+        aiBone* bone = pcMesh->mBones[b] = new aiBone();
+        bone->mName.Set(b ? "right" : "left");
+        bone->mNumWeights = pcMesh->mNumVertices/2;
+        bone->mWeights = new aiVertexWeight[bone->mNumWeights];
+        for (unsigned int y = 0, w = 0; y <= size; ++y) {
+            for (unsigned int i = 0; i < row/2; ++i, ++w) {
+                bone->mWeights[w] = aiVertexWeight(y*row + b*row/2 + i,1.f);
+            }
+        }
+    }
+
+    pcScene = new aiScene();
+    pcScene->mNumMeshes = 1;
+    pcScene->mMeshes = new aiMesh*[1];
+    pcScene->mMeshes[0] = pcMesh;
+    pcScene->mRootNode = new aiNode("root");
+    pcScene->mRootNode->mNumMeshes = 1;
+    pcScene->mRootNode->mMeshes = new unsigned int[1];
+    pcScene->mRootNode->mMeshes[0] = 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenerateLODsTest::TearDown()
+{
+    delete pcScene;
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenerateLODsTest::Process(const char* ratios)
+{
+    Importer importer;
+    importer.SetPropertyString(AI_CONFIG_PP_GL_LOD_RATIOS, ratios);
+
+    GenerateLODsProcess process;
+    process.SetupProperties(&importer);
+    process.Execute(pcScene);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenerateLODsTest::HasPosition(const aiMesh* mesh, const aiVector3D& pos)
+{
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        if (mesh->mVertices[i] == pos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenerateLODsTest, testRatios)
+{
+    GenerateLODsProcess process;
+    Importer importer;
+    importer.SetPropertyString(AI_CONFIG_PP_GL_LOD_RATIOS, "0.25 abc 0.5 2 0.25");
+    process.SetupProperties(&importer);
+
+    ASSERT_EQ(2u, process.GetRatios().size());
+    EXPECT_FLOAT_EQ(0.5f, process.GetRatios()[0]);
+    EXPECT_FLOAT_EQ(0.25f, process.GetRatios()[1]);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenerateLODsTest, testMeshesAndNodes)
+{
+    Process("0.5 0.25");
+
+    ASSERT_EQ(3u, pcScene->mNumMeshes);
+    EXPECT_EQ(pcMesh, pcScene->mMeshes[0]);
+    EXPECT_STREQ("grid_LOD1", pcScene->mMeshes[1]->mName.C_Str());
+    EXPECT_STREQ("grid_LOD2", pcScene->mMeshes[2]->mName.C_Str());
+
+    unsigned int lastFaces = pcMesh->mNumFaces;
+    for (unsigned int m = 1; m < 3; ++m) {
+        const aiMesh* lod = pcScene->mMeshes[m];
+        EXPECT_LT(lod->mNumFaces, lastFaces);
+        EXPECT_LE(lod->mNumFaces, (unsigned int)(pcMesh->mNumFaces * (m == 1 ? 0.5f : 0.25f)));
+        lastFaces = lod->mNumFaces;
+
+        EXPECT_TRUE(lod->HasNormals());
+        EXPECT_TRUE(lod->HasTextureCoords(0));
+        for (unsigned int f = 0; f < lod->mNumFaces; ++f) {
+            ASSERT_EQ(3u, lod->mFaces[f].mNumIndices);
+            for (unsigned int i = 0; i < 3; ++i) {
+                EXPECT_LT(lod->mFaces[f].mIndices[i], lod->mNumVertices);
+            }
+        }
+    }
+
+    const aiNode* root = pcScene->mRootNode;
+    ASSERT_EQ(2u, root->mNumChildren);
+    for (unsigned int l = 0; l < 2; ++l) {
+        const aiNode* child = root->mChildren[l];
+        EXPECT_EQ(root, child->mParent);
+        EXPECT_STREQ(l ? "root_LOD2" : "root_LOD1", child->mName.C_Str());
+        ASSERT_EQ(1u, child->mNumMeshes);
+        EXPECT_EQ(l+1, child->mMeshes[0]);
+
+        int32_t level = 0;
+        ASSERT_TRUE(child->mMetaData != NULL);
+        EXPECT_TRUE(child->mMetaData->Get("LOD", level));
+        EXPECT_EQ((int32_t)(l+1), level);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenerateLODsTest, testSeamsAndBordersAreKept)
+{
+    Process("0.25");
+    ASSERT_EQ(2u, pcScene->mNumMeshes);
+    const aiMesh* lod = pcScene->mMeshes[1];
+
+    for (unsigned int v = 0; v < pcMesh->mNumVertices; ++v) {
+        const aiVector3D& p = pcMesh->mVertices[v];
+        if (p.x == 0.f || p.y == 0.f || p.x == size || p.y == size || p.x == size/2) {
+            EXPECT_TRUE(HasPosition(lod, p));
+        }
+    }
+
+    // every vertex is still weighted by the bone of its half
+    ASSERT_EQ(2u, lod->mNumBones);
+    std::vector<unsigned int> bone(lod->mNumVertices, 2);
+    for (unsigned int b = 0; b < 2; ++b) {
+        EXPECT_EQ(pcMesh->mBones[b]->mName, lod->mBones[b]->mName);
+        for (unsigned int w = 0; w < lod->mBones[b]->mNumWeights; ++w) {
+            const aiVertexWeight& weight = lod->mBones[b]->mWeights[w];
+            ASSERT_LT(weight.mVertexId, lod->mNumVertices);
+            EXPECT_EQ(2u, bone[weight.mVertexId]);
+            bone[weight.mVertexId] = b;
+        }
+    }
+    for (unsigned int v = 0; v < lod->mNumVertices; ++v) {
+        const float x = lod->mVertices[v].x;
+        EXPECT_NE(2u, bone[v]);
+        if (x != size/2) {
+            EXPECT_EQ(x < size/2 ? 0u : 1u, bone[v]);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenerateLODsTest, testNonTriangleMeshesAreSkipped)
+{
+    for (unsigned int f = 0; f < pcMesh->mNumFaces; ++f) {
+        pcMesh->mFaces[f].mNumIndices = 2;
+    }
+    pcMesh->mPrimitiveTypes = aiPrimitiveType_LINE;
+    Process("0.5");
+
+    EXPECT_EQ(1u, pcScene->mNumMeshes);
+    EXPECT_EQ(0u, pcScene->mRootNode->mNumChildren);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenerateLODsTest, testUnindexedMeshesAreSkipped)
+{
+    // give every face its own vertices, as if JoinIdenticalVertices had not run
+    const aiVector3D* src = pcMesh->mVertices;
+    aiVector3D* verts = new aiVector3D[pcMesh->mNumFaces*3];
+    for (unsigned int f = 0; f < pcMesh->mNumFaces; ++f) {
+        for (unsigned int i = 0; i < 3; ++i) {
+            verts[f*3+i] = src[pcMesh->mFaces[f].mIndices[i]];
+            pcMesh->mFaces[f].mIndices[i] = f*3+i;
+        }
+    }
+    delete[] pcMesh->mVertices;
+    pcMesh->mVertices = verts;
+    pcMesh->mNumVertices = pcMesh->mNumFaces*3;
+    delete[] pcMesh->mNormals;
+    pcMesh->mNormals = NULL;
+    delete[] pcMesh->mTextureCoords[0];
+    pcMesh->mTextureCoords[0] = NULL;
+    for (unsigned int b = 0; b < pcMesh->mNumBones; ++b) {
+        delete pcMesh->mBones[b];
+    }
+    delete[] pcMesh->mBones;
+    pcMesh->mBones = NULL;
+    pcMesh->mNumBones = 0;
+    Process("0.5 0.25");
+
+    // all vertices are locked, so there are no levels which would be smaller
+    EXPECT_EQ(1u, pcScene->mNumMeshes);
+    EXPECT_EQ(0u, pcScene->mRootNode->mNumChildren);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenerateLODsTest, testRequiresJoinIdenticalVertices)
+{
+    Importer importer;
+    EXPECT_FALSE(importer.ValidateFlags(aiProcess_Triangulate | aiProcess_GenerateLODs));
+    EXPECT_TRUE(importer.ValidateFlags(aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_GenerateLODs));
+}
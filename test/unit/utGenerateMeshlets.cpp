@@ -0,0 +1,201 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+#include "UnitTestPCH.h"
+
+#include <assimp/scene.h>
+#include <GenerateMeshletsProcess.h>
+
+#include <algorithm>
+
+using namespace Assimp;
+
+class GenerateMeshletsTest : public ::testing::Test
+{
+public:
+    virtual void SetUp();
+    virtual void TearDown();
+
+protected:
+    // Runs the step with the given limits on the test mesh
+    bool Process(int maxVertices, int maxTriangles);
+
+    static const unsigned int size = 20;
+
+    aiMesh* pcMesh;
+};
+
+// ------------------------------------------------------------------------------------------------
+void GenerateMeshletsTest::SetUp()
+{
+    // A flat 20x20 quad grid in the xy plane, facing +z
+    const unsigned int row = size+1;
+    pcMesh = new aiMesh();
+    pcMesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    pcMesh->mNumVertices = row*row;
+    pcMesh->mVertices = new aiVector3D[pcMesh->mNumVertices];
+    for (unsigned int y = 0; y < row; ++y) {
+        for (unsigned int x = 0; x < row; ++x) {
+            pcMesh->mVertices[y*row+x] = aiVector3D((float)x,(float)y,0.f);
+        }
+    }
+
+    pcMesh->mNumFaces = size*size*2;
+    pcMesh->mFaces = new aiFace[pcMesh->mNumFaces];
+    aiFace* face = pcMesh->mFaces;
+    for (unsigned int y = 0; y < size; ++y) {
+        for (unsigned int x = 0; x < size; ++x) {
+            const unsigned int v = y*row+x;
+            const unsigned int quad[6] = { v,v+1,v+row+1, v,v+row+1,v+row };
+            for (unsigned int i = 0; i < 6; i += 3, ++face) {
+                face->mIndices = new unsigned int[face->mNumIndices = 3];
+                std::copy(quad+i,quad+i+3,face->mIndices);
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenerateMeshletsTest::TearDown()
+{
+    delete pcMesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenerateMeshletsTest::Process(int maxVertices, int maxTriangles)
+{
+    Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_PP_GM_MAX_VERTICES, maxVertices);
+    importer.SetPropertyInteger(AI_CONFIG_PP_GM_MAX_TRIANGLES, maxTriangles);
+
+    GenerateMeshletsProcess process;
+    process.SetupProperties(&importer);
+    return process.ProcessMesh(pcMesh);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenerateMeshletsTest, testPartition)
+{
+    ASSERT_TRUE(Process(32, 40));
+    ASSERT_TRUE(pcMesh->HasMeshlets());
+    EXPECT_EQ(pcMesh->mNumFaces*3, pcMesh->mNumMeshletIndices);
+
+    // every face is covered exactly once
+    std::vector<std::vector<unsigned int> > expected, found;
+    for (unsigned int f = 0; f < pcMesh->mNumFaces; ++f) {
+        std::vector<unsigned int> tri(pcMesh->mFaces[f].mIndices, pcMesh->mFaces[f].mIndices+3);
+        std::rotate(tri.begin(), std::min_element(tri.begin(), tri.end()), tri.end());
+        expected.push_back(tri);
+    }
+
+    unsigned int numVertices = 0;
+    for (unsigned int m = 0; m < pcMesh->mNumMeshlets; ++m) {
+        const aiMeshlet& meshlet = pcMesh->mMeshlets[m];
+        EXPECT_LE(meshlet.mNumVertices, 32u);
+        EXPECT_LE(meshlet.mNumTriangles, 40u);
+        EXPECT_EQ(numVertices, meshlet.mVertexOffset);
+        numVertices += meshlet.mNumVertices;
+
+        const unsigned int* verts = pcMesh->mMeshletVertices + meshlet.mVertexOffset;
+        for (unsigned int t = 0; t < meshlet.mNumTriangles; ++t) {
+            std::vector<unsigned int> tri;
+            for (unsigned int i = 0; i < 3; ++i) {
+                const unsigned char idx = pcMesh->mMeshletIndices[meshlet.mIndexOffset + t*3 + i];
+                ASSERT_LT(idx, meshlet.mNumVertices);
+                tri.push_back(verts[idx]);
+            }
+            std::rotate(tri.begin(), std::min_element(tri.begin(), tri.end()), tri.end());
+            found.push_back(tri);
+        }
+
+        // the bounding sphere contains all vertices
+        for (unsigned int i = 0; i < meshlet.mNumVertices; ++i) {
+            EXPECT_LE((pcMesh->mVertices[verts[i]] - meshlet.mCenter).Length(), meshlet.mRadius * 1.0001f);
+        }
+    }
+    EXPECT_EQ(numVertices, pcMesh->mNumMeshletVertices);
+
+    std::sort(expected.begin(), expected.end());
+    std::sort(found.begin(), found.end());
+    EXPECT_EQ(expected, found);
+
+    // adjacent faces are grouped, so vertices are shared by few meshlets only
+    EXPECT_LT(pcMesh->mNumMeshletVertices, pcMesh->mNumVertices * 2);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenerateMeshletsTest, testNormalCone)
+{
+    ASSERT_TRUE(Process(64, 126));
+
+    for (unsigned int m = 0; m < pcMesh->mNumMeshlets; ++m) {
+        const aiMeshlet& meshlet = pcMesh->mMeshlets[m];
+        EXPECT_NEAR(1.f, meshlet.mConeAxis.z, 1e-5f);
+        EXPECT_LT(meshlet.mConeCutoff, 1e-3f);
+
+        // a viewer behind the plane sees the back of all faces, one in front doesn't
+        aiVector3D dir = meshlet.mConeApex - (meshlet.mCenter - aiVector3D(0.f,0.f,10.f));
+        EXPECT_GE(dir.Normalize() * meshlet.mConeAxis, meshlet.mConeCutoff);
+        dir = meshlet.mConeApex - (meshlet.mCenter + aiVector3D(0.f,0.f,10.f));
+        EXPECT_LT(dir.Normalize() * meshlet.mConeAxis, meshlet.mConeCutoff);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenerateMeshletsTest, testLimitsAreClamped)
+{
+    ASSERT_TRUE(Process(1000, 0));
+
+    for (unsigned int m = 0; m < pcMesh->mNumMeshlets; ++m) {
+        EXPECT_LE(pcMesh->mMeshlets[m].mNumVertices, 256u);
+        EXPECT_EQ(1u, pcMesh->mMeshlets[m].mNumTriangles);
+    }
+    EXPECT_EQ(pcMesh->mNumFaces, pcMesh->mNumMeshlets);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenerateMeshletsTest, testNonTriangleMeshesAreSkipped)
+{
+    pcMesh->mFaces[0].mNumIndices = 2;
+    EXPECT_FALSE(Process(64, 126));
+    EXPECT_FALSE(pcMesh->HasMeshlets());
+}
@@ -43,6 +43,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AbstractImportExportBase.h"
 
 #include <assimp/Importer.hpp>
+#include <assimp/config.h>
+#include <assimp/scene.h>
 
 using namespace Assimp;
 
@@ -60,3 +62,139 @@ public:
 TEST_F( utIFCImportExport, importIFCFromFileTest ) {
     EXPECT_TRUE( importerTest() );
 }
+
+TEST_F( utIFCImportExport, importIFCParallelTest ) {
+    Assimp::Importer serial;
+    const aiScene *expected = serial.ReadFile( ASSIMP_TEST_MODELS_DIR "/IFC/AC14-FZK-Haus.ifc", 0 );
+    ASSERT_NE( nullptr, expected );
+
+    // small chunks, so the entities are indexed by many jobs
+    Assimp::Importer parallel;
+    parallel.SetPropertyInteger( AI_CONFIG_GLOB_MULTITHREADING, 4 );
+    parallel.SetPropertyInteger( AI_CONFIG_IMPORT_IFC_PARALLEL_CHUNK_SIZE, 64 * 1024 );
+    const aiScene *scene = parallel.ReadFile( ASSIMP_TEST_MODELS_DIR "/IFC/AC14-FZK-Haus.ifc", 0 );
+    ASSERT_NE( nullptr, scene );
+
+    ASSERT_EQ( expected->mNumMeshes, scene->mNumMeshes );
+    ASSERT_EQ( expected->mNumMaterials, scene->mNumMaterials );
+    for ( unsigned int i = 0; i < expected->mNumMeshes; ++i ) {
+        ASSERT_EQ( expected->mMeshes[ i ]->mNumVertices, scene->mMeshes[ i ]->mNumVertices );
+        EXPECT_EQ( 0, memcmp( expected->mMeshes[ i ]->mVertices, scene->mMeshes[ i ]->mVertices,
+            expected->mMeshes[ i ]->mNumVertices * sizeof( aiVector3D ) ) );
+    }
+    EXPECT_STREQ( expected->mRootNode->mName.C_Str(), scene->mRootNode->mName.C_Str() );
+    EXPECT_EQ( expected->mRootNode->mNumChildren, scene->mRootNode->mNumChildren );
+}
+
+static void compareNodes( const aiNode *expected, const aiNode *node ) {
+    EXPECT_STREQ( expected->mName.C_Str(), node->mName.C_Str() );
+    EXPECT_TRUE( expected->mTransformation.Equal( node->mTransformation ) );
+    ASSERT_EQ( expected->mNumMeshes, node->mNumMeshes );
+    for ( unsigned int i = 0; i < expected->mNumMeshes; ++i ) {
+        EXPECT_EQ( expected->mMeshes[ i ], node->mMeshes[ i ] );
+    }
+    ASSERT_EQ( expected->mNumChildren, node->mNumChildren );
+    for ( unsigned int i = 0; i < expected->mNumChildren; ++i ) {
+        EXPECT_EQ( node, node->mChildren[ i ]->mParent );
+        compareNodes( expected->mChildren[ i ], node->mChildren[ i ] );
+    }
+}
+
+TEST_F( utIFCImportExport, importIFCParallelGeometryTest ) {
+    Assimp::Importer serial;
+    const aiScene *expected = serial.ReadFile( ASSIMP_TEST_MODELS_DIR "/IFC/AC14-FZK-Haus.ifc", 0 );
+    ASSERT_NE( nullptr, expected );
+
+    // the file reuses mapped representations, so some products are converted twice
+    Assimp::Importer parallel;
+    parallel.SetPropertyInteger( AI_CONFIG_GLOB_MULTITHREADING, 4 );
+    const aiScene *scene = parallel.ReadFile( ASSIMP_TEST_MODELS_DIR "/IFC/AC14-FZK-Haus.ifc", 0 );
+    ASSERT_NE( nullptr, scene );
+
+    ASSERT_EQ( expected->mNumMeshes, scene->mNumMeshes );
+    for ( unsigned int i = 0; i < expected->mNumMeshes; ++i ) {
+        const aiMesh *a = expected->mMeshes[ i ], *b = scene->mMeshes[ i ];
+        EXPECT_EQ( a->mMaterialIndex, b->mMaterialIndex );
+        ASSERT_EQ( a->mNumVertices, b->mNumVertices );
+        EXPECT_EQ( 0, memcmp( a->mVertices, b->mVertices, a->mNumVertices * sizeof( aiVector3D ) ) );
+        ASSERT_EQ( a->mNumFaces, b->mNumFaces );
+        for ( unsigned int f = 0; f < a->mNumFaces; ++f ) {
+            ASSERT_EQ( a->mFaces[ f ].mNumIndices, b->mFaces[ f ].mNumIndices );
+            EXPECT_EQ( 0, memcmp( a->mFaces[ f ].mIndices, b->mFaces[ f ].mIndices, a->mFaces[ f ].mNumIndices * sizeof( unsigned int ) ) );
+        }
+    }
+
+    ASSERT_EQ( expected->mNumMaterials, scene->mNumMaterials );
+    for ( unsigned int i = 0; i < expected->mNumMaterials; ++i ) {
+        aiString a, b;
+        expected->mMaterials[ i ]->Get( AI_MATKEY_NAME, a );
+        scene->mMaterials[ i ]->Get( AI_MATKEY_NAME, b );
+        EXPECT_STREQ( a.C_Str(), b.C_Str() );
+    }
+
+    compareNodes( expected->mRootNode, scene->mRootNode );
+}
+
+// two proxies with separate, but identical extruded solids
+static const std::string IfcRepeatedGeometry =
+    "ISO-10303-21;\n"
+    "HEADER;\n"
+    "FILE_DESCRIPTION(('ViewDefinition [CoordinationView]'),'2;1');\n"
+    "FILE_NAME('repeated.ifc','2017-01-01T00:00:00',(''),(''),'','','');\n"
+    "FILE_SCHEMA(('IFC2X3'));\n"
+    "ENDSEC;\n"
+    "DATA;\n"
+    "#1=IFCPROJECT('0001',#2,'Project',$,$,$,$,(#20),#10);\n"
+    "#2=IFCOWNERHISTORY($,$,$,.NOCHANGE.,$,$,$,0);\n"
+    "#10=IFCUNITASSIGNMENT((#11));\n"
+    "#11=IFCSIUNIT(*,.LENGTHUNIT.,$,.METRE.);\n"
+    "#20=IFCGEOMETRICREPRESENTATIONCONTEXT($,'Model',3,1.E-05,#21,$);\n"
+    "#21=IFCAXIS2PLACEMENT3D(#22,$,$);\n"
+    "#22=IFCCARTESIANPOINT((0.,0.,0.));\n"
+    "#30=IFCSITE('0002',#2,'Site',$,$,#31,$,$,.ELEMENT.,$,$,$,$,$);\n"
+    "#31=IFCLOCALPLACEMENT($,#21);\n"
+    "#40=IFCRELAGGREGATES('0003',#2,$,$,#1,(#30));\n"
+    "#41=IFCRELCONTAINEDINSPATIALSTRUCTURE('0004',#2,$,$,(#50,#70),#30);\n"
+    "#50=IFCBUILDINGELEMENTPROXY('0005',#2,'A',$,$,#51,#60,$,$);\n"
+    "#51=IFCLOCALPLACEMENT(#31,#52);\n"
+    "#52=IFCAXIS2PLACEMENT3D(#53,$,$);\n"
+    "#53=IFCCARTESIANPOINT((5.,0.,0.));\n"
+    "#60=IFCPRODUCTDEFINITIONSHAPE($,$,(#61));\n"
+    "#61=IFCSHAPEREPRESENTATION(#20,'Body','SweptSolid',(#62));\n"
+    "#62=IFCEXTRUDEDAREASOLID(#63,#66,#68,2.);\n"
+    "#63=IFCRECTANGLEPROFILEDEF(.AREA.,$,#64,1.,1.);\n"
+    "#64=IFCAXIS2PLACEMENT2D(#65,$);\n"
+    "#65=IFCCARTESIANPOINT((0.,0.));\n"
+    "#66=IFCAXIS2PLACEMENT3D(#67,$,$);\n"
+    "#67=IFCCARTESIANPOINT((0.,0.,0.));\n"
+    "#68=IFCDIRECTION((0.,0.,1.));\n"
+    "#70=IFCBUILDINGELEMENTPROXY('0006',#2,'B',$,$,#71,#80,$,$);\n"
+    "#71=IFCLOCALPLACEMENT(#31,#72);\n"
+    "#72=IFCAXIS2PLACEMENT3D(#73,$,$);\n"
+    "#73=IFCCARTESIANPOINT((10.,0.,0.));\n"
+    "#80=IFCPRODUCTDEFINITIONSHAPE($,$,(#81));\n"
+    "#81=IFCSHAPEREPRESENTATION(#20,'Body','SweptSolid',(#82));\n"
+    "#82=IFCEXTRUDEDAREASOLID(#83,#86,#88,2.);\n"
+    "#83=IFCRECTANGLEPROFILEDEF(.AREA.,$,#84,1.,1.);\n"
+    "#84=IFCAXIS2PLACEMENT2D(#85,$);\n"
+    "#85=IFCCARTESIANPOINT((0., 0.));\n"
+    "#86=IFCAXIS2PLACEMENT3D(#87,$,$);\n"
+    "#87=IFCCARTESIANPOINT((0.,0.,0.));\n"
+    "#88=IFCDIRECTION((0.,0.,1.));\n"
+    "ENDSEC;\n"
+    "END-ISO-10303-21;\n";
+
+TEST_F( utIFCImportExport, importIFCRepeatedGeometryTest ) {
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFileFromMemory( IfcRepeatedGeometry.c_str(), IfcRepeatedGeometry.size(), 0, "ifc" );
+    ASSERT_NE( nullptr, scene );
+
+    // both proxies reference the same mesh
+    EXPECT_EQ( 1u, scene->mNumMeshes );
+    ASSERT_EQ( 2u, scene->mRootNode->mNumChildren );
+    for ( unsigned int i = 0; i < 2; ++i ) {
+        const aiNode *nd = scene->mRootNode->mChildren[ i ];
+        ASSERT_EQ( 1u, nd->mNumMeshes );
+        EXPECT_EQ( 0u, nd->mMeshes[ 0 ] );
+    }
+}
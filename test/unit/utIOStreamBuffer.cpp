@@ -44,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "IOStreamBuffer.h"
 #include "TestIOStream.h"
 #include "UnitTestFileGenerator.h"
+#include "MemoryIOWrapper.h"
 
 class IOStreamBufferTest : public ::testing::Test {
     // empty
@@ -143,3 +144,58 @@ TEST_F( IOStreamBufferTest, accessBlockIndexTest ) {
 
 }
 
+static std::vector<std::string> readDataLineViews( const std::string &text, size_t cacheSize ) {
+    MemoryIOStream stream( reinterpret_cast<const uint8_t*>( text.c_str() ), text.size() );
+    IOStreamBuffer<char> myBuffer( cacheSize );
+    EXPECT_TRUE( myBuffer.open( &stream ) );
+
+    std::vector<std::string> lines;
+    const char *line = nullptr;
+    size_t length = 0;
+    while ( myBuffer.getNextDataLineView( line, length, '\\' ) ) {
+        EXPECT_EQ( '\n', line[ length ] );
+        lines.push_back( std::string( line, length ) );
+    }
+    myBuffer.close();
+    return lines;
+}
+
+TEST_F( IOStreamBufferTest, dataLineViewTest ) {
+    const std::string text( "v 1 2 3\nvn 0 0 1\r\nf 1 \\\n2 3\nusemtl a\\b\nlast" );
+
+    // block sizes from a single byte to the whole file, so lines start,
+    // end and continue on block boundaries
+    for ( size_t cacheSize = 1; cacheSize <= text.size() + 1; ++cacheSize ) {
+        const std::vector<std::string> lines = readDataLineViews( text, cacheSize );
+        ASSERT_EQ( 6U, lines.size() ) << "cache size " << cacheSize;
+        EXPECT_EQ( "v 1 2 3", lines[ 0 ] );
+        EXPECT_EQ( "vn 0 0 1", lines[ 1 ] );
+        EXPECT_EQ( "", lines[ 2 ] );
+        EXPECT_EQ( "f 1 2 3", lines[ 3 ] );
+        EXPECT_EQ( "usemtl a\\b", lines[ 4 ] );
+        EXPECT_EQ( "last", lines[ 5 ] );
+    }
+}
+
+TEST_F( IOStreamBufferTest, lineViewTest ) {
+    const std::string text( "ply\r\nformat ascii 1.0\n1 2 3\n" );
+
+    for ( size_t cacheSize = 1; cacheSize <= text.size() + 1; ++cacheSize ) {
+        MemoryIOStream stream( reinterpret_cast<const uint8_t*>( text.c_str() ), text.size() );
+        IOStreamBuffer<char> myBuffer( cacheSize );
+        EXPECT_TRUE( myBuffer.open( &stream ) );
+
+        std::vector<std::string> lines;
+        const char *line = nullptr;
+        size_t length = 0;
+        while ( myBuffer.getNextLineView( line, length ) ) {
+            EXPECT_EQ( '\n', line[ length ] );
+            lines.push_back( std::string( line, length ) );
+        }
+        ASSERT_EQ( 3U, lines.size() ) << "cache size " << cacheSize;
+        EXPECT_EQ( "ply", lines[ 0 ] );
+        EXPECT_EQ( "format ascii 1.0", lines[ 1 ] );
+        EXPECT_EQ( "1 2 3", lines[ 2 ] );
+    }
+}
+
@@ -0,0 +1,219 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/config.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <stdio.h>
+#ifdef _WIN32
+#   include <direct.h>
+#else
+#   include <sys/stat.h>
+#endif
+
+using namespace Assimp;
+
+#ifndef ASSIMP_BUILD_NO_ASSMAP_EXPORTER
+
+class utImportCache : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        MakeDirectory( "importcache_test" );
+        MakeDirectory( "importcache_test/cache" );
+        ClearCache();
+
+        std::ifstream in( ASSIMP_TEST_MODELS_DIR "/OBJ/cube_usemtl.obj", std::ios::binary );
+        std::ostringstream obj;
+        obj << in.rdbuf();
+        WriteFile( "importcache_test/cube_usemtl.obj", obj.str() );
+        WriteMaterial( 1.f );
+    }
+
+    static void MakeDirectory( const char* path ) {
+#ifdef _WIN32
+        ::_mkdir( path );
+#else
+        ::mkdir( path, 0755 );
+#endif
+    }
+
+    // Remove all entries recorded in the index of the cache and the index itself
+    static void ClearCache() {
+        std::ifstream in( "importcache_test/cache/index.txt" );
+        std::string line;
+        std::getline( in, line );
+        while ( std::getline( in, line ) ) {
+            const std::string key = line.substr( 0, line.find( ' ' ) );
+            ::remove( ( "importcache_test/cache/" + key + ".assmap" ).c_str() );
+            ::remove( ( "importcache_test/cache/" + key + ".deps" ).c_str() );
+        }
+        in.close();
+        ::remove( "importcache_test/cache/index.txt" );
+    }
+
+    static void WriteFile( const char* path, const std::string& contents ) {
+        std::ofstream out( path, std::ios::binary );
+        out << contents;
+    }
+
+    static void WriteMaterial( float diffuse ) {
+        std::ostringstream mtl;
+        mtl << "newmtl mtl\nKd " << diffuse << " " << diffuse << " " << diffuse << "\n\n"
+            << "newmtl mtl2\nKd 1 1 1\n";
+        WriteFile( "importcache_test/cube_usemtl.mtl", mtl.str() );
+    }
+
+    // Number of entries recorded in the index of the cache
+    static unsigned int CountEntries() {
+        std::ifstream in( "importcache_test/cache/index.txt" );
+        std::string line;
+        unsigned int lines = 0;
+        while ( std::getline( in, line ) ) {
+            ++lines;
+        }
+        return lines ? lines - 1 : 0;
+    }
+
+    const aiScene* Import( Importer& importer, unsigned int flags, int maxSize = 1024 ) {
+        importer.SetPropertyString( AI_CONFIG_IMPORT_CACHE_DIRECTORY, "importcache_test/cache" );
+        importer.SetPropertyInteger( AI_CONFIG_IMPORT_CACHE_MAX_SIZE, maxSize );
+        return importer.ReadFile( "importcache_test/cube_usemtl.obj", flags );
+    }
+
+    static float GetDiffuse( const aiScene* scene ) {
+        for ( unsigned int i = 0; i < scene->mNumMaterials; ++i ) {
+            aiString name;
+            scene->mMaterials[ i ]->Get( AI_MATKEY_NAME, name );
+            aiColor3D color;
+            if ( name == aiString( "mtl" ) && AI_SUCCESS == scene->mMaterials[ i ]->Get( AI_MATKEY_COLOR_DIFFUSE, color ) ) {
+                return color.r;
+            }
+        }
+        return -1.f;
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F( utImportCache, hitReturnsSameSceneTest ) {
+    Importer first, second;
+    const aiScene* imported = Import( first, aiProcess_Triangulate | aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, imported );
+    EXPECT_EQ( 1u, CountEntries() );
+
+    const aiScene* cached = Import( second, aiProcess_Triangulate | aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, cached );
+    EXPECT_EQ( 1u, CountEntries() );
+
+    ASSERT_EQ( imported->mNumMeshes, cached->mNumMeshes );
+    ASSERT_EQ( imported->mNumMaterials, cached->mNumMaterials );
+    for ( unsigned int i = 0; i < imported->mNumMeshes; ++i ) {
+        ASSERT_EQ( imported->mMeshes[ i ]->mNumVertices, cached->mMeshes[ i ]->mNumVertices );
+        ASSERT_EQ( imported->mMeshes[ i ]->mNumFaces, cached->mMeshes[ i ]->mNumFaces );
+        EXPECT_EQ( 0, memcmp( imported->mMeshes[ i ]->mVertices, cached->mMeshes[ i ]->mVertices,
+            imported->mMeshes[ i ]->mNumVertices * sizeof( aiVector3D ) ) );
+    }
+    EXPECT_FLOAT_EQ( 1.f, GetDiffuse( cached ) );
+
+    // the cached scene is a regular one, post processing can still be applied
+    EXPECT_NE( nullptr, second.ApplyPostProcessing( aiProcess_GenNormals ) );
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F( utImportCache, keyCoversFlagsTest ) {
+    Importer importer;
+    ASSERT_NE( nullptr, Import( importer, aiProcess_Triangulate ) );
+    const aiScene* scene = Import( importer, aiProcess_Triangulate | aiProcess_GenNormals );
+    ASSERT_NE( nullptr, scene );
+    EXPECT_EQ( 2u, CountEntries() );
+    EXPECT_TRUE( scene->mMeshes[ 0 ]->HasNormals() );
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F( utImportCache, changedDependencyTest ) {
+    Importer importer;
+    const aiScene* scene = Import( importer, aiProcess_Triangulate );
+    ASSERT_NE( nullptr, scene );
+    EXPECT_FLOAT_EQ( 1.f, GetDiffuse( scene ) );
+
+    // the .mtl file is not part of the key, but the entry must not be used anymore
+    WriteMaterial( 0.5f );
+    scene = Import( importer, aiProcess_Triangulate );
+    ASSERT_NE( nullptr, scene );
+    EXPECT_FLOAT_EQ( 0.5f, GetDiffuse( scene ) );
+    EXPECT_EQ( 1u, CountEntries() );
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F( utImportCache, missingDependencyTest ) {
+    ::remove( "importcache_test/cube_usemtl.mtl" );
+    Importer importer;
+    const aiScene* scene = Import( importer, aiProcess_Triangulate );
+    ASSERT_NE( nullptr, scene );
+    EXPECT_NE( 0.5f, GetDiffuse( scene ) );
+
+    // the entry was made without the .mtl file, creating it invalidates the entry
+    WriteMaterial( 0.5f );
+    scene = Import( importer, aiProcess_Triangulate );
+    ASSERT_NE( nullptr, scene );
+    EXPECT_FLOAT_EQ( 0.5f, GetDiffuse( scene ) );
+    EXPECT_EQ( 1u, CountEntries() );
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F( utImportCache, evictionTest ) {
+    Importer importer;
+    ASSERT_NE( nullptr, Import( importer, aiProcess_Triangulate, 0 ) );
+    ASSERT_NE( nullptr, Import( importer, aiProcess_Triangulate | aiProcess_GenNormals, 0 ) );
+
+    // only the most recently used entry is kept
+    EXPECT_EQ( 1u, CountEntries() );
+    ASSERT_NE( nullptr, Import( importer, aiProcess_Triangulate, 0 ) );
+    EXPECT_EQ( 1u, CountEntries() );
+}
+
+#endif // ASSIMP_BUILD_NO_ASSMAP_EXPORTER
@@ -40,4 +40,194 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ---------------------------------------------------------------------------
 */
 
-#include "UnitTestPCH.h"
\ No newline at end of file
+#include "UnitTestPCH.h"
+
+#include <assimp/scene.h>
+#include <ImproveCacheLocality.h>
+
+#include <algorithm>
+#include <array>
+
+using namespace Assimp;
+
+class ImproveCacheLocalityTest : public ::testing::Test
+{
+public:
+    virtual void SetUp();
+    virtual void TearDown();
+
+protected:
+    typedef std::array<aiVector3D,3> Triangle;
+
+    // Runs the step with the given configuration on the test mesh
+    void Process(int algorithm, float overdrawThreshold, bool reorderVertices);
+
+    // All triangles of the test mesh by position, rotated to start with the smallest index
+    std::vector<Triangle> GetTriangles() const;
+
+    // Number of cache misses per triangle for a FIFO cache of the default size
+    float GetACMR() const;
+
+    aiScene* pcScene;
+    aiMesh* pcMesh;
+};
+
+// ------------------------------------------------------------------------------------------------
+void ImproveCacheLocalityTest::SetUp()
+{
+    // a 40x40 quad grid with its triangles in random order
+    const unsigned int size = 40;
+    pcMesh = new aiMesh();
+    pcMesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    pcMesh->mNumVertices = (size+1)*(size+1);
+    pcMesh->mVertices = new aiVector3D[pcMesh->mNumVertices];
+    pcMesh->mTextureCoords[0] = new aiVector3D[pcMesh->mNumVertices];
+    pcMesh->mNumUVComponents[0] = 2;
+    for (unsigned int y = 0; y <= size; ++y) {
+        for (unsigned int x = 0; x <= size; ++x) {
+            const unsigned int v = y*(size+1)+x;
+            pcMesh->mVertices[v] = aiVector3D((float)x,(float)y,(float)((x*y)%7));
+            pcMesh->mTextureCoords[0][v] = pcMesh->mVertices[v];
+        }
+    }
+
+    std::vector<std::array<unsigned int,3> > tris;
+    for (unsigned int y = 0; y < size; ++y) {
+        for (unsigned int x = 0; x < size; ++x) {
+            const unsigned int v = y*(size+1)+x;
+            tris.push_back(std::array<unsigned int,3>{{v,v+1,v+size+2}});
+            tris.push_back(std::array<unsigned int,3>{{v,v+size+2,v+size+1}});
+        }
+    }
+    unsigned int seed = 1234;
+    for (size_t i = tris.size()-1; i > 0; --i) {
+        seed = seed * 1103515245 + 12345;
+        std::swap(tris[i],tris[(seed >> 8) % (i+1)]);
+    }
+
+    pcMesh->mNumFaces = (unsigned int)tris.size();
+    pcMesh->mFaces = new aiFace[pcMesh->mNumFaces];
+    for (unsigned int i = 0; i < pcMesh->mNumFaces; ++i) {
+        aiFace& face = pcMesh->mFaces[i];
+        face.mIndices = new unsigned int[face.mNumIndices = 3];
+        std::copy(tris[i].begin(),tris[i].end(),face.mIndices);
+    }
+
+    pcScene = new aiScene();
+    pcScene->mNumMeshes = 1;
+    pcScene->mMeshes = new aiMesh*[1];
+    pcScene->mMeshes[0] = pcMesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImproveCacheLocalityTest::TearDown()
+{
+    delete pcScene;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImproveCacheLocalityTest::Process(int algorithm, float overdrawThreshold, bool reorderVertices)
+{
+    Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_PP_ICL_ALGORITHM, algorithm);
+    importer.SetPropertyFloat(AI_CONFIG_PP_ICL_OVERDRAW_THRESHOLD, overdrawThreshold);
+    importer.SetPropertyBool(AI_CONFIG_PP_ICL_REORDER_VERTICES, reorderVertices);
+
+    ImproveCacheLocalityProcess process;
+    process.SetupProperties(&importer);
+    process.Execute(pcScene);
+}
+
+// ------------------------------------------------------------------------------------------------
+std::vector<ImproveCacheLocalityTest::Triangle> ImproveCacheLocalityTest::GetTriangles() const
+{
+    std::vector<Triangle> out;
+    for (unsigned int i = 0; i < pcMesh->mNumFaces; ++i) {
+        const unsigned int* idx = pcMesh->mFaces[i].mIndices;
+        Triangle tri = {{ pcMesh->mVertices[idx[0]], pcMesh->mVertices[idx[1]], pcMesh->mVertices[idx[2]] }};
+        std::rotate(tri.begin(), std::min_element(tri.begin(), tri.end()), tri.end());
+        out.push_back(tri);
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+float ImproveCacheLocalityTest::GetACMR() const
+{
+    std::vector<unsigned int> fifo;
+    unsigned int misses = 0;
+    for (unsigned int i = 0; i < pcMesh->mNumFaces; ++i) {
+        for (unsigned int a = 0; a < 3; ++a) {
+            const unsigned int v = pcMesh->mFaces[i].mIndices[a];
+            if (std::find(fifo.begin(), fifo.end(), v) == fifo.end()) {
+                ++misses;
+                fifo.push_back(v);
+                if (fifo.size() > PP_ICL_PTCACHE_SIZE) {
+                    fifo.erase(fifo.begin());
+                }
+            }
+        }
+    }
+    return (float)misses / pcMesh->mNumFaces;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImproveCacheLocalityTest, testTipsify)
+{
+    const std::vector<Triangle> before = GetTriangles();
+    const float acmrBefore = GetACMR();
+    Process(AI_ICL_ALGORITHM_TIPSIFY, 0.f, false);
+
+    EXPECT_EQ(before, GetTriangles());
+    EXPECT_LT(GetACMR(), acmrBefore);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImproveCacheLocalityTest, testLRU)
+{
+    const std::vector<Triangle> before = GetTriangles();
+    const float acmrBefore = GetACMR();
+    Process(AI_ICL_ALGORITHM_LRU, 0.f, false);
+
+    EXPECT_EQ(before, GetTriangles());
+    EXPECT_LT(GetACMR(), 1.f);
+    EXPECT_LT(GetACMR(), acmrBefore);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImproveCacheLocalityTest, testOverdraw)
+{
+    const std::vector<Triangle> before = GetTriangles();
+    Process(AI_ICL_ALGORITHM_LRU, 1.05f, false);
+
+    EXPECT_EQ(before, GetTriangles());
+    EXPECT_LT(GetACMR(), 1.5f);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImproveCacheLocalityTest, testReorderVertices)
+{
+    const std::vector<Triangle> before = GetTriangles();
+    Process(AI_ICL_ALGORITHM_LRU, 0.f, true);
+
+    EXPECT_EQ(before, GetTriangles());
+
+    // vertices must be numbered in the order of their first use
+    unsigned int next = 0;
+    for (unsigned int i = 0; i < pcMesh->mNumFaces; ++i) {
+        for (unsigned int a = 0; a < 3; ++a) {
+            const unsigned int v = pcMesh->mFaces[i].mIndices[a];
+            ASSERT_LE(v, next);
+            if (v == next) {
+                ++next;
+            }
+        }
+    }
+    EXPECT_EQ(pcMesh->mNumVertices, next);
+
+    // other vertex components must have moved along
+    for (unsigned int v = 0; v < pcMesh->mNumVertices; ++v) {
+        EXPECT_EQ(pcMesh->mVertices[v], pcMesh->mTextureCoords[0][v]);
+    }
+}
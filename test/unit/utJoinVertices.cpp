@@ -142,3 +142,65 @@ TEST_F(JoinVerticesTest, testProcess)
     EXPECT_EQ(150.f*299.f*3.f, fSum); // gaussian sum equation
 }
 
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(JoinVerticesTest, testProcessWithSpatialHashGrid)
+{
+    Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_PP_USE_SPATIAL_HASH_GRID, true);
+    piProcess->SetupProperties(&importer);
+    piProcess->ProcessMesh(pcMesh,0);
+
+    ASSERT_EQ(300U, pcMesh->mNumFaces);
+    ASSERT_EQ(300U, pcMesh->mNumVertices);
+
+    float fSum = 0.f;
+    for (unsigned int i = 0; i < 300;++i)
+    {
+        aiVector3D& v = pcMesh->mVertices[i];
+        fSum += v.x + v.y + v.z;
+    }
+    EXPECT_EQ(150.f*299.f*3.f, fSum);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(JoinVerticesTest, testProcessExactMatch)
+{
+    // a normal which is only slightly off is joined by default, but not in exact mode
+    pcMesh->mNormals[300] = aiVector3D( 1e-7f, 0.f, 0.f);
+
+    Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_PP_JIV_EXACT_MATCH, true);
+    piProcess->SetupProperties(&importer);
+    piProcess->ProcessMesh(pcMesh,0);
+
+    ASSERT_EQ(300U, pcMesh->mNumFaces);
+    ASSERT_EQ(301U, pcMesh->mNumVertices);
+
+    // faces must still refer to the same positions, only the outlier keeps its own vertex
+    unsigned int numOutliers = 0;
+    for (unsigned int i = 0, p = 0; i < 300;++i)
+    {
+        const aiFace& face = pcMesh->mFaces[i];
+        for (unsigned int a = 0; a < 3; ++a, ++p)
+        {
+            const unsigned int idx = face.mIndices[a];
+            ASSERT_LT(idx, pcMesh->mNumVertices);
+            EXPECT_EQ((float)(p % 300), pcMesh->mVertices[idx].x);
+            if (pcMesh->mNormals[idx].x != 0.f) {
+                EXPECT_EQ(300U, p);
+                ++numOutliers;
+            }
+        }
+    }
+    EXPECT_EQ(1U, numOutliers);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(JoinVerticesTest, testProcessEpsilonMatch)
+{
+    pcMesh->mNormals[300] = aiVector3D( 1e-7f, 0.f, 0.f);
+    piProcess->ProcessMesh(pcMesh,0);
+
+    ASSERT_EQ(300U, pcMesh->mNumVertices);
+}
@@ -0,0 +1,160 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/Exporter.hpp>
+#include <assimp/MappedScene.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <string.h>
+#include <vector>
+
+using namespace Assimp;
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+
+class utMappedScene : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        mScene = mImporter.ReadFile( ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj",
+            aiProcess_ValidateDataStructure | aiProcess_GenSmoothNormals | aiProcess_Triangulate );
+        ASSERT_NE( nullptr, mScene );
+    }
+
+    // Check the copy against the imported scene
+    void CompareScene( const aiScene* copy ) {
+        ASSERT_NE( nullptr, copy );
+        ASSERT_EQ( mScene->mNumMeshes, copy->mNumMeshes );
+        ASSERT_EQ( mScene->mNumMaterials, copy->mNumMaterials );
+        for ( unsigned int i = 0; i < mScene->mNumMeshes; ++i ) {
+            const aiMesh *a = mScene->mMeshes[ i ], *b = copy->mMeshes[ i ];
+            ASSERT_EQ( a->mNumVertices, b->mNumVertices );
+            ASSERT_EQ( a->mNumFaces, b->mNumFaces );
+            EXPECT_EQ( a->mMaterialIndex, b->mMaterialIndex );
+            EXPECT_STREQ( a->mName.C_Str(), b->mName.C_Str() );
+            EXPECT_EQ( 0, memcmp( a->mVertices, b->mVertices, a->mNumVertices * sizeof( aiVector3D ) ) );
+            EXPECT_EQ( 0, memcmp( a->mNormals, b->mNormals, a->mNumVertices * sizeof( aiVector3D ) ) );
+            EXPECT_EQ( a->HasTextureCoords( 0 ), b->HasTextureCoords( 0 ) );
+            for ( unsigned int f = 0; f < a->mNumFaces; ++f ) {
+                ASSERT_EQ( a->mFaces[ f ].mNumIndices, b->mFaces[ f ].mNumIndices );
+                EXPECT_EQ( 0, memcmp( a->mFaces[ f ].mIndices, b->mFaces[ f ].mIndices, a->mFaces[ f ].mNumIndices * sizeof( unsigned int ) ) );
+            }
+        }
+        for ( unsigned int i = 0; i < mScene->mNumMaterials; ++i ) {
+            aiString a, b;
+            mScene->mMaterials[ i ]->Get( AI_MATKEY_NAME, a );
+            EXPECT_EQ( AI_SUCCESS, copy->mMaterials[ i ]->Get( AI_MATKEY_NAME, b ) );
+            EXPECT_STREQ( a.C_Str(), b.C_Str() );
+        }
+        ASSERT_NE( nullptr, copy->mRootNode );
+        ASSERT_EQ( mScene->mRootNode->mNumChildren, copy->mRootNode->mNumChildren );
+        for ( unsigned int i = 0; i < mScene->mRootNode->mNumChildren; ++i ) {
+            const aiNode* child = copy->mRootNode->mChildren[ i ];
+            EXPECT_EQ( copy->mRootNode, child->mParent );
+            EXPECT_STREQ( mScene->mRootNode->mChildren[ i ]->mName.C_Str(), child->mName.C_Str() );
+        }
+    }
+
+    Assimp::Importer mImporter;
+    const aiScene* mScene;
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F( utMappedScene, loadFromMemoryTest ) {
+    Assimp::Exporter exporter;
+    const aiExportDataBlob* blob = exporter.ExportToBlob( mScene, "assmap" );
+    ASSERT_NE( nullptr, blob );
+
+    // keep the buffer aligned, so it is used in place
+    std::vector<uint64_t> buffer( ( blob->size + 7 ) / 8 );
+    memcpy( &buffer[ 0 ], blob->data, blob->size );
+    const char* begin = reinterpret_cast<const char*>( &buffer[ 0 ] );
+
+    MappedScene mapped;
+    const aiScene* scene = mapped.Load( begin, blob->size );
+    CompareScene( scene );
+    EXPECT_STREQ( "", mapped.GetErrorString() );
+
+    // vertex data is not copied
+    const char* vertices = reinterpret_cast<const char*>( scene->mMeshes[ 0 ]->mVertices );
+    EXPECT_TRUE( vertices >= begin && vertices < begin + blob->size );
+
+    mapped.Free();
+    EXPECT_EQ( nullptr, mapped.GetScene() );
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F( utMappedScene, loadFromFileTest ) {
+    Assimp::Exporter exporter;
+    ASSERT_EQ( AI_SUCCESS, exporter.Export( mScene, "assmap", ASSIMP_TEST_MODELS_DIR "/OBJ/spider_out.assmap" ) );
+
+    MappedScene mapped;
+    CompareScene( mapped.Load( ASSIMP_TEST_MODELS_DIR "/OBJ/spider_out.assmap" ) );
+
+    // the importer returns a regular copy
+    Assimp::Importer importer;
+    CompareScene( importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/OBJ/spider_out.assmap", aiProcess_ValidateDataStructure ) );
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F( utMappedScene, rejectInvalidTest ) {
+    Assimp::Exporter exporter;
+    const aiExportDataBlob* blob = exporter.ExportToBlob( mScene, "assmap" );
+    ASSERT_NE( nullptr, blob );
+    std::vector<uint64_t> buffer( ( blob->size + 7 ) / 8 );
+    memcpy( &buffer[ 0 ], blob->data, blob->size );
+
+    MappedScene mapped;
+    EXPECT_EQ( nullptr, mapped.Load( &buffer[ 0 ], blob->size / 2 ) );
+    EXPECT_STRNE( "", mapped.GetErrorString() );
+
+    // different layout hash
+    reinterpret_cast<uint32_t*>( &buffer[ 0 ] )[ 5 ] ^= 1;
+    EXPECT_EQ( nullptr, mapped.Load( &buffer[ 0 ], blob->size ) );
+    reinterpret_cast<uint32_t*>( &buffer[ 0 ] )[ 5 ] ^= 1;
+
+    EXPECT_NE( nullptr, mapped.Load( &buffer[ 0 ], blob->size ) );
+}
+
+#endif // ASSIMP_BUILD_NO_EXPORT
@@ -43,6 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/scene.h>
 #include <MaterialSystem.h>
+#include <assimp/MaterialIndex.hpp>
 
 using namespace ::std;
 using namespace ::Assimp;
@@ -128,3 +129,60 @@ TEST_F(MaterialSystemTest, testStringProperty)
     EXPECT_EQ(AI_SUCCESS, pcMat->Get("testKey6",0,0,s));
     EXPECT_STREQ("Hello, this is a small test", s.data);
 }
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(MaterialSystemTest, testMaterialIndex)
+{
+    // enough properties to make the index grow a few times
+    for (int i = 0; i < 100; ++i) {
+        char key[32];
+        ::sprintf(key,"testKey%i",i % 25);
+        const float f = static_cast<float>(i);
+        this->pcMat->AddProperty(&f,1,key,i / 25,i % 3);
+    }
+
+    Assimp::MaterialIndex index(this->pcMat);
+    for (int i = 0; i < 30; ++i) {
+        char key[32];
+        ::sprintf(key,"testKey%i",i);
+        for (unsigned int type = 0; type < 5; ++type) {
+            for (unsigned int idx = 0; idx < 4; ++idx) {
+                const aiMaterialProperty* prop = NULL;
+                aiGetMaterialProperty(this->pcMat,key,type,idx,&prop);
+                EXPECT_EQ(prop, index.Get(key,type,idx));
+            }
+            // wildcards
+            const aiMaterialProperty* prop = NULL;
+            aiGetMaterialProperty(this->pcMat,key,type,UINT_MAX,&prop);
+            EXPECT_EQ(prop, index.Get(key,type,UINT_MAX));
+            aiGetMaterialProperty(this->pcMat,key,UINT_MAX,type,&prop);
+            EXPECT_EQ(prop, index.Get(key,UINT_MAX,type));
+        }
+    }
+
+    // replace and add through the index
+    const float f = 42.0f;
+    const unsigned int numProperties = this->pcMat->mNumProperties;
+    EXPECT_EQ(AI_SUCCESS, index.AddBinaryProperty(&f,sizeof(f),"testKey3",0,0,aiPTI_Float));
+    EXPECT_EQ(numProperties, this->pcMat->mNumProperties);
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_EQ(AI_SUCCESS, index.AddBinaryProperty(&f,sizeof(f),"newKey",i,0,aiPTI_Float));
+    }
+    EXPECT_EQ(numProperties + 50, this->pcMat->mNumProperties);
+
+    float out = 0.0f;
+    EXPECT_EQ(AI_SUCCESS, this->pcMat->Get("testKey3",0,0,out));
+    EXPECT_EQ(42.0f, out);
+    EXPECT_EQ(AI_SUCCESS, this->pcMat->Get("newKey",49,0,out));
+    EXPECT_TRUE(NULL != index.Get("newKey",49,0));
+
+    // remove through the index, positions behind move up
+    EXPECT_EQ(AI_SUCCESS, index.RemoveProperty("testKey0",0,0));
+    EXPECT_EQ(AI_FAILURE, index.RemoveProperty("testKey0",0,0));
+    EXPECT_TRUE(NULL == index.Get("testKey0",0,0));
+    EXPECT_EQ(numProperties + 49, this->pcMat->mNumProperties);
+    for (unsigned int i = 0; i < this->pcMat->mNumProperties; ++i) {
+        const aiMaterialProperty* prop = this->pcMat->mProperties[i];
+        EXPECT_EQ(prop, index.Get(prop->mKey.data,prop->mSemantic,prop->mIndex));
+    }
+}
@@ -341,3 +341,79 @@ TEST_F(utObjImportExport, 0based_array_Test) {
     const aiScene *scene = myimporter.ReadFileFromMemory(ObjModel.c_str(), ObjModel.size(), 0);
     EXPECT_EQ(nullptr, scene);
 }
+
+static void expectSameMeshes( const aiScene *expected, const aiScene *scene ) {
+    ASSERT_NE( nullptr, expected );
+    ASSERT_NE( nullptr, scene );
+    ASSERT_EQ( expected->mNumMeshes, scene->mNumMeshes );
+    EXPECT_EQ( expected->mNumMaterials, scene->mNumMaterials );
+    for ( unsigned int i = 0; i < expected->mNumMeshes; ++i ) {
+        const aiMesh *expMesh = expected->mMeshes[ i ];
+        const aiMesh *mesh = scene->mMeshes[ i ];
+        EXPECT_EQ( expMesh->mName, mesh->mName );
+        EXPECT_EQ( expMesh->mMaterialIndex, mesh->mMaterialIndex );
+        EXPECT_EQ( expMesh->HasNormals(), mesh->HasNormals() );
+        ASSERT_EQ( expMesh->mNumVertices, mesh->mNumVertices );
+        for ( unsigned int v = 0; v < expMesh->mNumVertices; ++v ) {
+            EXPECT_EQ( expMesh->mVertices[ v ], mesh->mVertices[ v ] );
+            if ( expMesh->HasNormals() ) {
+                EXPECT_EQ( expMesh->mNormals[ v ], mesh->mNormals[ v ] );
+            }
+        }
+        ASSERT_EQ( expMesh->mNumFaces, mesh->mNumFaces );
+        for ( unsigned int f = 0; f < expMesh->mNumFaces; ++f ) {
+            ASSERT_EQ( expMesh->mFaces[ f ].mNumIndices, mesh->mFaces[ f ].mNumIndices );
+            for ( unsigned int j = 0; j < expMesh->mFaces[ f ].mNumIndices; ++j ) {
+                EXPECT_EQ( expMesh->mFaces[ f ].mIndices[ j ], mesh->mFaces[ f ].mIndices[ j ] );
+            }
+        }
+    }
+}
+
+TEST_F(utObjImportExport, parallel_chunks_Test) {
+    static const std::string ObjModel =
+        "mtllib none.mtl\n"
+        "g first\n"
+        "usemtl a\n"
+        "v 0.0 0.0 0.0\n"
+        "v 1.0 0.0 0.0\n"
+        "v 1.0 1.0 0.0\n"
+        "vn 0.0 0.0 1.0\n"
+        "f 1//1 2//1 3//1\n"
+        "g second\r\n"
+        "v 0.0 1.0 0.0\r\n"
+        "v 0.0 0.0 \\\n"
+        "  1.0\n"
+        "usemtl b\n"
+        "f -5//-1 -2//1 \\\r\n"
+        "  -1//1\n"
+        "o third\n"
+        "usemtl a\n"
+        "f 3 4 5";
+
+    Assimp::Importer serial;
+    const aiScene *expected = serial.ReadFileFromMemory(ObjModel.c_str(), ObjModel.size(), aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, expected);
+    EXPECT_EQ(3u, expected->mNumMeshes);
+
+    // split the model into chunks of every size up to the entire file
+    for (int chunkSize = 1; chunkSize <= static_cast<int>(ObjModel.size() / 2); ++chunkSize) {
+        Assimp::Importer parallel;
+        parallel.SetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, 4);
+        parallel.SetPropertyInteger(AI_CONFIG_IMPORT_OBJ_PARALLEL_CHUNK_SIZE, chunkSize);
+        const aiScene *scene = parallel.ReadFileFromMemory(ObjModel.c_str(), ObjModel.size(), aiProcess_ValidateDataStructure);
+        expectSameMeshes(expected, scene);
+    }
+}
+
+TEST_F(utObjImportExport, parallel_chunks_spider_Test) {
+    Assimp::Importer serial;
+    const aiScene *expected = serial.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, expected);
+
+    Assimp::Importer parallel;
+    parallel.SetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, 4);
+    parallel.SetPropertyInteger(AI_CONFIG_IMPORT_OBJ_PARALLEL_CHUNK_SIZE, 4096);
+    const aiScene *scene = parallel.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_ValidateDataStructure);
+    expectSameMeshes(expected, scene);
+}
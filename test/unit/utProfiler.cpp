@@ -43,6 +43,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "UTLogStream.h"
 #include "code/Profiler.h"
 #include <assimp/DefaultLogger.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/ImportStatistics.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
 
 using namespace ::Assimp;
 using namespace ::Assimp::Profiling;
@@ -64,7 +68,8 @@ public:
 };
 
 TEST_F( utProfiler, addRegion_success ) {
-    Profiler myProfiler;
+    ImportStatistics stats;
+    Profiler myProfiler( stats );
     myProfiler.BeginRegion( "t1" );
     for ( int i=0; i<10; i++ ) {
         volatile int j=0;
@@ -73,4 +78,114 @@ TEST_F( utProfiler, addRegion_success ) {
     myProfiler.EndRegion( "t1" );
     //UTLogStream *stream( (UTLogStream*) m_stream );
     //EXPECT_FALSE( stream->m_messages.empty() );
+
+    ASSERT_EQ( 1U, stats.mChildren.size() );
+    EXPECT_EQ( "t1", stats.mChildren[ 0 ].mName );
+}
+
+TEST_F( utProfiler, nestedRegions_success ) {
+    ImportStatistics stats;
+    {
+        Profiler myProfiler( stats );
+        myProfiler.BeginRegion( "outer" );
+        myProfiler.BeginRegion( "inner" );
+        myProfiler.AddCounter( "c", 1.0 );
+        myProfiler.AddCounter( "c", 2.0 );
+        myProfiler.AddMeshCounter( 3, "m", 4.0 );
+
+        // ending the outer region ends the inner one, too
+        myProfiler.EndRegion( "outer" );
+        myProfiler.BeginRegion( "second" );
+        myProfiler.EndRegion( "unknown" );
+    }
+
+    ASSERT_EQ( 2U, stats.mChildren.size() );
+    const ImportStatistics* outer = stats.FindChild( "outer" );
+    ASSERT_NE( nullptr, outer );
+    const ImportStatistics* inner = outer->FindChild( "inner" );
+    ASSERT_NE( nullptr, inner );
+    EXPECT_EQ( 3.0, inner->GetCounter( "c" ) );
+    ASSERT_NE( nullptr, inner->FindChild( "mesh 3" ) );
+    EXPECT_EQ( 4.0, inner->FindChild( "mesh 3" )->GetCounter( "m" ) );
+    EXPECT_LE( inner->mSeconds, outer->mSeconds );
+    EXPECT_LE( outer->mSeconds, stats.mSeconds );
+    EXPECT_NE( nullptr, stats.FindChild( "second" ) );
+}
+
+TEST_F( utProfiler, importerWithoutMeasureTime_noStatistics ) {
+    Importer importer;
+    EXPECT_NE( nullptr, importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/OBJ/box.obj", 0 ) );
+    EXPECT_EQ( nullptr, importer.GetLastImportStatistics() );
+}
+
+TEST_F( utProfiler, importerCollectsPhasesAndSteps ) {
+    Importer importer;
+    importer.SetPropertyInteger( AI_CONFIG_GLOB_MEASURE_TIME, 1 );
+    const aiScene* scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj",
+        aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_ImproveCacheLocality );
+    ASSERT_NE( nullptr, scene );
+
+    const ImportStatistics* stats = importer.GetLastImportStatistics();
+    ASSERT_NE( nullptr, stats );
+    EXPECT_EQ( ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", stats->mName );
+    EXPECT_GT( stats->mSeconds, 0.0 );
+
+    const ImportStatistics* import = stats->FindChild( "import" );
+    ASSERT_NE( nullptr, import );
+    EXPECT_NE( nullptr, import->FindChild( "parse" ) );
+    EXPECT_NE( nullptr, import->FindChild( "convert" ) );
+
+    const ImportStatistics* postprocess = stats->FindChild( "postprocess" );
+    ASSERT_NE( nullptr, postprocess );
+    EXPECT_NE( nullptr, postprocess->FindChild( "TriangulateProcess" ) );
+
+    const ImportStatistics* join = postprocess->FindChild( "JoinVerticesProcess" );
+    ASSERT_NE( nullptr, join );
+    EXPECT_GT( join->GetCounter( "vertices_in" ), join->GetCounter( "vertices_out" ) );
+    ASSERT_EQ( scene->mNumMeshes, join->mChildren.size() );
+    for ( unsigned int i = 0; i < scene->mNumMeshes; ++i ) {
+        EXPECT_EQ( scene->mMeshes[ i ]->mNumVertices, join->mChildren[ i ].GetCounter( "vertices_out" ) );
+    }
+
+    const ImportStatistics* icl = postprocess->FindChild( "ImproveCacheLocalityProcess" );
+    ASSERT_NE( nullptr, icl );
+    ASSERT_FALSE( icl->mChildren.empty() );
+    for ( size_t i = 0; i < icl->mChildren.size(); ++i ) {
+        EXPECT_GT( icl->mChildren[ i ].GetCounter( "acmr_in" ), 0.0 );
+        EXPECT_GT( icl->mChildren[ i ].GetCounter( "acmr_out" ), 0.0 );
+    }
+
+    // a later ApplyPostProcessing() call appends to the same tree
+    ASSERT_NE( nullptr, importer.ApplyPostProcessing( aiProcess_FlipUVs ) );
+    stats = importer.GetLastImportStatistics();
+    ASSERT_NE( nullptr, stats );
+    ASSERT_EQ( "postprocess", stats->mChildren.back().mName );
+    EXPECT_NE( nullptr, stats->mChildren.back().FindChild( "FlipUVsProcess" ) );
+
+    importer.FreeScene();
+    EXPECT_EQ( nullptr, importer.GetLastImportStatistics() );
+}
+
+static uint64_t numSamples = 0;
+
+static void CountSamples( uint64_t* numAllocations, uint64_t* numBytes ) {
+    ++numSamples;
+    *numAllocations = numSamples;
+    *numBytes = numSamples * 16;
+}
+
+TEST_F( utProfiler, importerSamplesAllocationCounter ) {
+    Importer importer;
+    importer.SetPropertyInteger( AI_CONFIG_GLOB_MEASURE_TIME, 1 );
+    importer.SetAllocationCounter( &CountSamples );
+
+    numSamples = 0;
+    ASSERT_NE( nullptr, importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/OBJ/box.obj", 0 ) );
+    EXPECT_GT( numSamples, 0U );
+
+    // each sample counts as one allocation, the root sees all but its own first one
+    const ImportStatistics* stats = importer.GetLastImportStatistics();
+    ASSERT_NE( nullptr, stats );
+    EXPECT_EQ( numSamples - 1, stats->mAllocations );
+    EXPECT_EQ( ( numSamples - 1 ) * 16, stats->mAllocatedBytes );
 }
@@ -0,0 +1,264 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+#include "UnitTestPCH.h"
+
+#include <assimp/scene.h>
+#include <assimp/Exporter.hpp>
+#include <assimp/Importer.hpp>
+#include <QuantizeVerticesProcess.h>
+#include <VertexQuantization.h>
+
+#include <rapidjson/document.h>
+
+#include <cmath>
+#include <cstring>
+
+using namespace Assimp;
+
+class QuantizeVerticesTest : public ::testing::Test
+{
+public:
+    virtual void SetUp();
+    virtual void TearDown();
+
+protected:
+    static const unsigned int numVertices = 200;
+
+    aiScene* pcScene;
+    aiMesh* pcMesh;
+};
+
+const unsigned int QuantizeVerticesTest::numVertices;
+
+// ------------------------------------------------------------------------------------------------
+void QuantizeVerticesTest::SetUp()
+{
+    pcMesh = new aiMesh();
+    pcMesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    pcMesh->mNumVertices = numVertices;
+    pcMesh->mVertices = new aiVector3D[numVertices];
+    pcMesh->mNormals = new aiVector3D[numVertices];
+    pcMesh->mTextureCoords[0] = new aiVector3D[numVertices];
+    pcMesh->mNumUVComponents[0] = 2;
+    pcMesh->mColors[0] = new aiColor4D[numVertices];
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        const float a = i * 0.1f, b = i * 0.37f;
+        pcMesh->mVertices[i] = aiVector3D(std::sin(a) * 10.f, std::cos(b) * 3.f - 7.f, i * 0.05f);
+        pcMesh->mNormals[i] = aiVector3D(std::cos(a) * std::sin(b), std::sin(a) * std::sin(b), std::cos(b));
+        pcMesh->mTextureCoords[0][i] = aiVector3D(std::fabs(std::sin(b)), i / (float)numVertices, 0.f);
+        pcMesh->mColors[0][i] = aiColor4D(std::fabs(std::sin(a)), 0.5f, 0.25f, 1.f);
+    }
+
+    pcMesh->mNumFaces = numVertices / 3;
+    pcMesh->mFaces = new aiFace[pcMesh->mNumFaces];
+    for (unsigned int f = 0; f < pcMesh->mNumFaces; ++f) {
+        aiFace& face = pcMesh->mFaces[f];
+        face.mIndices = new unsigned int[face.mNumIndices = 3];
+        for (unsigned int i = 0; i < 3; ++i) {
+            face.mIndices[i] = f*3 + i;
+        }
+    }
+
+    pcScene = new aiScene();
+    pcScene->mNumMeshes = 1;
+    pcScene->mMeshes = new aiMesh*[1];
+    pcScene->mMeshes[0] = pcMesh;
+    pcScene->mNumMaterials = 1;
+    pcScene->mMaterials = new aiMaterial*[1];
+    pcScene->mMaterials[0] = new aiMaterial();
+    pcScene->mRootNode = new aiNode("root");
+    pcScene->mRootNode->mNumMeshes = 1;
+    pcScene->mRootNode->mMeshes = new unsigned int[1];
+    pcScene->mRootNode->mMeshes[0] = 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+void QuantizeVerticesTest::TearDown()
+{
+    delete pcScene;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(QuantizeVerticesTest, testOctahedralEncoding)
+{
+    int16_t q[2];
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        const aiVector3D& n = pcMesh->mNormals[i];
+        Quantization::EncodeOctahedral(n, q);
+        const aiVector3D d = Quantization::DecodeOctahedral(q);
+        EXPECT_NEAR(1.f, d.Length(), 1e-5f);
+        EXPECT_LT((d - n).Length(), 1e-4f);
+    }
+
+    // zero vectors survive, and so do the poles
+    Quantization::EncodeOctahedral(aiVector3D(), q);
+    EXPECT_EQ(aiVector3D(), Quantization::DecodeOctahedral(q));
+    Quantization::EncodeOctahedral(aiVector3D(0.f, 0.f, -1.f), q);
+    EXPECT_LT((Quantization::DecodeOctahedral(q) - aiVector3D(0.f, 0.f, -1.f)).Length(), 1e-5f);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(QuantizeVerticesTest, testProcessMesh)
+{
+    std::vector<aiVector3D> positions(pcMesh->mVertices, pcMesh->mVertices + numVertices);
+    std::vector<aiVector3D> normals(pcMesh->mNormals, pcMesh->mNormals + numVertices);
+
+    QuantizeVerticesProcess::ProcessMesh(pcMesh);
+
+    const Quantization::Bounds bounds(&positions[0], numVertices);
+    const aiVector3D step = (bounds.mMax - bounds.mMin) / 65535.f;
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        for (unsigned int k = 0; k < 3; ++k) {
+            EXPECT_LE(std::fabs(pcMesh->mVertices[i][k] - positions[i][k]), step[k] * 0.5f + 1e-5f);
+        }
+        EXPECT_LT((pcMesh->mNormals[i] - normals[i]).Length(), 1e-4f);
+
+        const float r = pcMesh->mColors[0][i].r * 255.f;
+        EXPECT_NEAR(std::floor(r + 0.5f), r, 1e-3f);
+    }
+
+    // quantizing again doesn't change anything
+    positions.assign(pcMesh->mVertices, pcMesh->mVertices + numVertices);
+    QuantizeVerticesProcess::ProcessMesh(pcMesh);
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        EXPECT_LT((pcMesh->mVertices[i] - positions[i]).Length(), 1e-5f);
+    }
+}
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+// ------------------------------------------------------------------------------------------------
+TEST_F(QuantizeVerticesTest, testAssbinRoundTrip)
+{
+    QuantizeVerticesProcess::ProcessMesh(pcMesh);
+
+    Exporter exporter;
+    const aiExportDataBlob* blob = exporter.ExportToBlob(pcScene, "assbin");
+    ASSERT_TRUE(blob != NULL);
+    const size_t plainSize = blob->size;
+
+    ExportProperties props;
+    props.SetPropertyBool(AI_CONFIG_EXPORT_ASSBIN_QUANTIZE, true);
+    blob = exporter.ExportToBlob(pcScene, "assbin", 0, &props);
+    ASSERT_TRUE(blob != NULL);
+    EXPECT_LT(blob->size, plainSize);
+
+    Importer importer;
+    const aiScene* scene = importer.ReadFileFromMemory(blob->data, blob->size, 0, "assbin");
+    ASSERT_TRUE(scene != NULL);
+    ASSERT_EQ(1u, scene->mNumMeshes);
+    const aiMesh* mesh = scene->mMeshes[0];
+    ASSERT_EQ(numVertices, mesh->mNumVertices);
+    ASSERT_TRUE(mesh->HasNormals() && mesh->HasTextureCoords(0) && mesh->HasVertexColors(0));
+    EXPECT_EQ(2u, mesh->mNumUVComponents[0]);
+
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        EXPECT_LT((mesh->mVertices[i] - pcMesh->mVertices[i]).Length(), 1e-4f);
+        EXPECT_LT((mesh->mNormals[i] - pcMesh->mNormals[i]).Length(), 1e-5f);
+        EXPECT_LT((mesh->mTextureCoords[0][i] - pcMesh->mTextureCoords[0][i]).Length(), 1e-5f);
+        EXPECT_EQ(pcMesh->mColors[0][i], mesh->mColors[0][i]);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(QuantizeVerticesTest, testGltf2RoundTrip)
+{
+    ExportProperties props;
+    props.SetPropertyBool(AI_CONFIG_EXPORT_GLTF_QUANTIZE, true);
+
+    Exporter exporter;
+    const aiExportDataBlob* blob = exporter.ExportToBlob(pcScene, "glb2", 0, &props);
+    ASSERT_TRUE(blob != NULL);
+    ASSERT_GT(blob->size, 20u);
+
+    // check the accessors in the JSON chunk
+    uint32_t jsonLength;
+    memcpy(&jsonLength, static_cast<const char*>(blob->data) + 12, 4);
+    ASSERT_LE(20u + jsonLength, blob->size);
+    std::string json(static_cast<const char*>(blob->data) + 20, jsonLength);
+
+    rapidjson::Document doc;
+    doc.Parse(json.c_str());
+    ASSERT_FALSE(doc.HasParseError());
+    ASSERT_TRUE(doc.HasMember("extensionsRequired"));
+    EXPECT_STREQ("KHR_mesh_quantization", doc["extensionsRequired"][0].GetString());
+
+    const rapidjson::Value& attributes = doc["meshes"][0]["primitives"][0]["attributes"];
+    const rapidjson::Value& normal = doc["accessors"][attributes["NORMAL"].GetUint()];
+    const rapidjson::Value& uv = doc["accessors"][attributes["TEXCOORD_0"].GetUint()];
+    const rapidjson::Value& position = doc["accessors"][attributes["POSITION"].GetUint()];
+
+    EXPECT_EQ(5122, normal["componentType"].GetInt()); // SHORT
+    EXPECT_TRUE(normal["normalized"].GetBool());
+    EXPECT_STREQ("VEC3", normal["type"].GetString());
+    EXPECT_EQ(8, doc["bufferViews"][normal["bufferView"].GetUint()]["byteStride"].GetInt()); // 6 bytes padded to 8
+
+    EXPECT_EQ(5123, uv["componentType"].GetInt()); // UNSIGNED_SHORT
+    EXPECT_TRUE(uv["normalized"].GetBool());
+    EXPECT_STREQ("VEC2", uv["type"].GetString());
+    EXPECT_FALSE(doc["bufferViews"][uv["bufferView"].GetUint()].HasMember("byteStride")); // tightly packed
+
+    EXPECT_EQ(5126, position["componentType"].GetInt()); // FLOAT
+    EXPECT_FALSE(position.HasMember("normalized"));
+
+    // the importer dequantizes the values
+    Importer importer;
+    const aiScene* scene = importer.ReadFileFromMemory(blob->data, blob->size, 0, "glb");
+    ASSERT_TRUE(scene != NULL);
+    ASSERT_EQ(1u, scene->mNumMeshes);
+    const aiMesh* mesh = scene->mMeshes[0];
+    // the two trailing vertices are not referenced by any face and get dropped
+    ASSERT_EQ(pcMesh->mNumFaces * 3, mesh->mNumVertices);
+    ASSERT_TRUE(mesh->HasNormals() && mesh->HasTextureCoords(0));
+    EXPECT_EQ(2u, mesh->mNumUVComponents[0]);
+
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        EXPECT_EQ(pcMesh->mVertices[i], mesh->mVertices[i]);
+        for (unsigned int k = 0; k < 3; ++k) {
+            EXPECT_NEAR(pcMesh->mNormals[i][k], mesh->mNormals[i][k], 0.5f / 32767.f + 1e-6f);
+        }
+        for (unsigned int k = 0; k < 2; ++k) {
+            EXPECT_NEAR(pcMesh->mTextureCoords[0][i][k], mesh->mTextureCoords[0][i][k], 0.5f / 65535.f + 1e-6f);
+        }
+    }
+}
+#endif // ASSIMP_BUILD_NO_EXPORT
@@ -0,0 +1,162 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <SpatialHashGrid.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace Assimp;
+
+class SpatialHashGridTest : public ::testing::Test
+{
+public:
+    virtual void SetUp();
+
+protected:
+    // indices of all positions within the radius, found the slow way
+    std::vector<unsigned int> FindBruteForce( const aiVector3D& pos, ai_real radius) const;
+
+    // a flat 100x100 grid of vertices, every position stored twice
+    std::vector<aiVector3D> positions;
+};
+
+// ------------------------------------------------------------------------------------------------
+void SpatialHashGridTest::SetUp()
+{
+    positions.clear();
+    for (unsigned int n = 0; n < 2; ++n) {
+        for (unsigned int y = 0; y < 100; ++y) {
+            for (unsigned int x = 0; x < 100; ++x) {
+                positions.push_back(aiVector3D(x * 0.5f, y * 0.5f, 0.f));
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+std::vector<unsigned int> SpatialHashGridTest::FindBruteForce( const aiVector3D& pos, ai_real radius) const
+{
+    std::vector<unsigned int> result;
+    for (unsigned int i = 0; i < positions.size(); ++i) {
+        if ((positions[i] - pos).SquareLength() < radius * radius) {
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SpatialHashGridTest, testFindPositions)
+{
+    SpatialHashGrid grid(&positions[0], (unsigned int)positions.size(), sizeof(aiVector3D));
+
+    const aiVector3D queries[] = {
+        aiVector3D(0.f, 0.f, 0.f),
+        aiVector3D(10.f, 20.f, 0.f),
+        aiVector3D(10.2f, 20.3f, 0.1f),
+        aiVector3D(49.5f, 49.5f, 0.f),
+        aiVector3D(-5.f, 60.f, 3.f)
+    };
+    const ai_real radii[] = { 1e-3f, 0.6f, 2.f, 100.f };
+
+    std::vector<unsigned int> found;
+    for (unsigned int q = 0; q < sizeof(queries) / sizeof(queries[0]); ++q) {
+        for (unsigned int r = 0; r < sizeof(radii) / sizeof(radii[0]); ++r) {
+            grid.FindPositions(queries[q], radii[r], found);
+            std::sort(found.begin(), found.end());
+            EXPECT_EQ(FindBruteForce(queries[q], radii[r]), found);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SpatialHashGridTest, testFindIdenticalPositions)
+{
+    SpatialHashGrid grid(&positions[0], (unsigned int)positions.size(), sizeof(aiVector3D));
+
+    std::vector<unsigned int> found;
+    for (unsigned int i = 0; i < 10000; i += 97) {
+        grid.FindIdenticalPositions(positions[i], found);
+        std::sort(found.begin(), found.end());
+        ASSERT_EQ(2U, found.size());
+        EXPECT_EQ(i, found[0]);
+        EXPECT_EQ(i + 10000, found[1]);
+    }
+
+    grid.FindIdenticalPositions(aiVector3D(0.25f, 0.f, 0.f), found);
+    EXPECT_TRUE(found.empty());
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SpatialHashGridTest, testGenerateMappingTable)
+{
+    SpatialHashGrid grid;
+    grid.Fill(&positions[0], 10000, sizeof(aiVector3D), false);
+    grid.Append(&positions[10000], 10000, sizeof(aiVector3D));
+
+    std::vector<unsigned int> table;
+    EXPECT_EQ(10000U, grid.GenerateMappingTable(table, 0.1f));
+    ASSERT_EQ(positions.size(), table.size());
+    for (unsigned int i = 0; i < 10000; ++i) {
+        EXPECT_EQ(table[i], table[i + 10000]);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SpatialHashGridTest, testEmptyAndDegenerate)
+{
+    SpatialHashGrid grid;
+    std::vector<unsigned int> found(1, 42);
+    grid.FindPositions(aiVector3D(), 1.f, found);
+    EXPECT_TRUE(found.empty());
+
+    // all positions at the same spot, plus one which is not finite
+    std::vector<aiVector3D> same(50, aiVector3D(1.f, 2.f, 3.f));
+    same.push_back(aiVector3D(std::numeric_limits<ai_real>::quiet_NaN(), 0.f, 0.f));
+    grid.Fill(&same[0], (unsigned int)same.size(), sizeof(aiVector3D));
+    grid.FindIdenticalPositions(aiVector3D(1.f, 2.f, 3.f), found);
+    EXPECT_EQ(50U, found.size());
+    grid.FindPositions(aiVector3D(1.f, 2.f, 3.5f), 1.f, found);
+    EXPECT_EQ(50U, found.size());
+}
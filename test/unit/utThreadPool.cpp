@@ -0,0 +1,147 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <ThreadPool.h>
+
+#include <atomic>
+#include <stdexcept>
+
+using namespace Assimp;
+
+class utThreadPool : public ::testing::Test {
+    // empty
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F( utThreadPool, parallelForVisitsEachIndexOnce ) {
+    ThreadPool pool( 4 );
+    EXPECT_EQ( 4U, pool.GetNumThreads() );
+
+    std::vector<int> visits( 1000, 0 );
+    pool.ParallelFor( visits.size(), [&]( size_t i ) {
+        ++visits[ i ];
+    } );
+    for ( size_t i = 0; i < visits.size(); ++i ) {
+        EXPECT_EQ( 1, visits[ i ] );
+    }
+
+    // the pool must be reusable
+    std::atomic<size_t> sum( 0 );
+    pool.ParallelFor( 100, [&]( size_t i ) {
+        sum += i;
+    } );
+    EXPECT_EQ( 4950U, sum.load() );
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F( utThreadPool, nestedParallelForRunsInPlace ) {
+    ThreadPool pool( 3 );
+    std::atomic<unsigned int> count( 0 );
+    pool.ParallelFor( 8, [&]( size_t ) {
+        pool.ParallelFor( 8, [&]( size_t ) {
+            ++count;
+        } );
+    } );
+    EXPECT_EQ( 64U, count.load() );
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F( utThreadPool, exceptionOfLowestIndexIsRethrown ) {
+    ThreadPool pool( 4 );
+    bool caught = false;
+    try {
+        pool.ParallelFor( 200, [&]( size_t i ) {
+            if ( i == 17 || i == 150 ) {
+                throw std::runtime_error( i == 17 ? "17" : "150" );
+            }
+        } );
+    } catch ( const std::runtime_error &e ) {
+        caught = true;
+        EXPECT_STREQ( "17", e.what() );
+    }
+    EXPECT_TRUE( caught );
+}
+
+// ------------------------------------------------------------------------------------------------
+static void compareArrays( const aiVector3D *expected, const aiVector3D *actual, unsigned int num ) {
+    ASSERT_EQ( NULL == expected, NULL == actual );
+    if ( NULL != expected ) {
+        EXPECT_EQ( 0, memcmp( expected, actual, num * sizeof( aiVector3D ) ) );
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F( utThreadPool, parallelPostProcessingMatchesSerial ) {
+    const unsigned int flags = aiProcess_Triangulate | aiProcess_GenSmoothNormals |
+        aiProcess_CalcTangentSpace | aiProcess_JoinIdenticalVertices | aiProcess_ImproveCacheLocality;
+
+    Importer serialImporter;
+    const aiScene *serial = serialImporter.ReadFile( ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", flags );
+    ASSERT_NE( nullptr, serial );
+
+    Importer parallelImporter;
+    parallelImporter.SetPropertyInteger( AI_CONFIG_GLOB_MULTITHREADING, 4 );
+    const aiScene *parallel = parallelImporter.ReadFile( ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", flags );
+    ASSERT_NE( nullptr, parallel );
+
+    ASSERT_EQ( serial->mNumMeshes, parallel->mNumMeshes );
+    EXPECT_LT( 1U, serial->mNumMeshes );
+    for ( unsigned int i = 0; i < serial->mNumMeshes; ++i ) {
+        const aiMesh *expected = serial->mMeshes[ i ], *actual = parallel->mMeshes[ i ];
+        ASSERT_EQ( expected->mNumVertices, actual->mNumVertices );
+        ASSERT_EQ( expected->mNumFaces, actual->mNumFaces );
+
+        compareArrays( expected->mVertices, actual->mVertices, expected->mNumVertices );
+        compareArrays( expected->mNormals, actual->mNormals, expected->mNumVertices );
+        compareArrays( expected->mTangents, actual->mTangents, expected->mNumVertices );
+        compareArrays( expected->mTextureCoords[ 0 ], actual->mTextureCoords[ 0 ], expected->mNumVertices );
+        for ( unsigned int f = 0; f < expected->mNumFaces; ++f ) {
+            ASSERT_EQ( expected->mFaces[ f ].mNumIndices, actual->mFaces[ f ].mNumIndices );
+            EXPECT_EQ( 0, memcmp( expected->mFaces[ f ].mIndices, actual->mFaces[ f ].mIndices,
+                expected->mFaces[ f ].mNumIndices * sizeof( unsigned int ) ) );
+        }
+    }
+}
@@ -44,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/Importer.hpp>
 #include <assimp/Exporter.hpp>
+#include <assimp/scene.h>
 
 using namespace Assimp;
 
@@ -78,3 +79,67 @@ TEST_F( utglTF2ImportExport, exportglTF2FromFileTest ) {
     EXPECT_TRUE( exporterTest() );
 }
 #endif // ASSIMP_BUILD_NO_EXPORT
+
+TEST_F( utglTF2ImportExport, importglTF2BinaryFromFileTest ) {
+    Assimp::Importer textImporter, binaryImporter;
+    const aiScene *text = textImporter.ReadFile( ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured.gltf", 0 );
+    const aiScene *binary = binaryImporter.ReadFile( ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF-Binary/BoxTextured.glb", 0 );
+    ASSERT_NE( nullptr, text );
+    ASSERT_NE( nullptr, binary );
+
+    // the image is embedded in the BIN chunk
+    EXPECT_EQ( 0u, text->mNumTextures );
+    ASSERT_EQ( 1u, binary->mNumTextures );
+    EXPECT_EQ( 0u, binary->mTextures[ 0 ]->mHeight );
+    EXPECT_STREQ( "png", binary->mTextures[ 0 ]->achFormatHint );
+
+    ASSERT_EQ( text->mNumMeshes, binary->mNumMeshes );
+    for ( unsigned int i = 0; i < text->mNumMeshes; ++i ) {
+        const aiMesh *a = text->mMeshes[ i ], *b = binary->mMeshes[ i ];
+        ASSERT_EQ( a->mNumVertices, b->mNumVertices );
+        ASSERT_EQ( a->mNumFaces, b->mNumFaces );
+        for ( unsigned int v = 0; v < a->mNumVertices; ++v ) {
+            EXPECT_EQ( a->mVertices[ v ], b->mVertices[ v ] );
+            EXPECT_EQ( a->mNormals[ v ], b->mNormals[ v ] );
+            EXPECT_EQ( a->mTextureCoords[ 0 ][ v ], b->mTextureCoords[ 0 ][ v ] );
+        }
+        for ( unsigned int f = 0; f < a->mNumFaces; ++f ) {
+            ASSERT_EQ( a->mFaces[ f ].mNumIndices, b->mFaces[ f ].mNumIndices );
+            for ( unsigned int j = 0; j < a->mFaces[ f ].mNumIndices; ++j ) {
+                EXPECT_EQ( a->mFaces[ f ].mIndices[ j ], b->mFaces[ f ].mIndices[ j ] );
+            }
+        }
+    }
+}
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+TEST_F( utglTF2ImportExport, exportglTF2BinaryToBlobTest ) {
+    Assimp::Importer importer, reimporter;
+    Assimp::Exporter exporter;
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF-Binary/BoxTextured.glb", 0 );
+    ASSERT_NE( nullptr, scene );
+
+    const aiExportDataBlob *blob = exporter.ExportToBlob( scene, "glb2" );
+    ASSERT_NE( nullptr, blob );
+    EXPECT_EQ( nullptr, blob->next ); // a single file
+    EXPECT_EQ( 0u, blob->size % 4 );
+    EXPECT_EQ( 0, memcmp( blob->data, "glTF", 4 ) );
+
+    const aiScene *copy = reimporter.ReadFileFromMemory( blob->data, blob->size, 0, "glb" );
+    ASSERT_NE( nullptr, copy );
+    ASSERT_EQ( 1u, copy->mNumTextures );
+    EXPECT_EQ( scene->mTextures[ 0 ]->mWidth, copy->mTextures[ 0 ]->mWidth );
+    EXPECT_EQ( 0, memcmp( scene->mTextures[ 0 ]->pcData, copy->mTextures[ 0 ]->pcData, scene->mTextures[ 0 ]->mWidth ) );
+
+    ASSERT_EQ( scene->mNumMeshes, copy->mNumMeshes );
+    for ( unsigned int i = 0; i < scene->mNumMeshes; ++i ) {
+        const aiMesh *a = scene->mMeshes[ i ], *b = copy->mMeshes[ i ];
+        ASSERT_EQ( a->mNumVertices, b->mNumVertices );
+        ASSERT_EQ( a->mNumFaces, b->mNumFaces );
+        for ( unsigned int v = 0; v < a->mNumVertices; ++v ) {
+            EXPECT_EQ( a->mVertices[ v ], b->mVertices[ v ] );
+            EXPECT_EQ( a->mTextureCoords[ 0 ][ v ], b->mTextureCoords[ 0 ][ v ] );
+        }
+    }
+}
+#endif // ASSIMP_BUILD_NO_EXPORT
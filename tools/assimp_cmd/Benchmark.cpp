@@ -0,0 +1,658 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file  Benchmark.cpp
+ *  @brief Implementation of the 'assimp bench' utility  */
+
+#include "Main.h"
+
+#include <assimp/ImportStatistics.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <new>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#	ifndef WIN32_LEAN_AND_MEAN
+#		define WIN32_LEAN_AND_MEAN
+#	endif
+#	include <windows.h>
+#	include <psapi.h>
+#else
+#	include <dirent.h>
+#	include <sys/stat.h>
+#	include <sys/resource.h>
+#endif
+
+const char* AICMD_MSG_BENCH_HELP_E =
+"assimp bench <file|directory> [<file|directory> ...] [-n<count>] [-o<file>] [common parameters]\n"
+"\tImport each model repeatedly and report timings as JSON\n"
+"\t Directories are searched recursively for all supported file formats.\n"
+"\t-n<count>,--iterations=<count>: Number of imports per file and flag set, default 5\n"
+"\t-o<file>,--output=<file>: Write the JSON report to a file instead of stdout\n"
+"\t--profile: Add the per-phase and per-step profiling tree of the last\n"
+"\t import of each file to the report\n"
+"\t If no post-processing flags are given, each file is imported without\n"
+"\t post-processing and with the fast, default and full presets.\n"
+"\t Use -c<fast|default|full> or single flags to benchmark one flag set only.\n"
+"\t Allocation counts and heap peaks include the whole process, they are only\n"
+"\t complete on platforms where the tool's operator new also serves the library.\n"
+"\t The results are followed by totals per format and flag set, the peak\n"
+"\t resident set size is reported once for the whole run.\n";
+
+// Info.cpp
+unsigned int CountVertices(const aiScene* scene);
+unsigned int CountFaces(const aiScene* scene);
+
+// ------------------------------------------------------------------------------
+// Heap accounting. Global operator new/delete are replaced for the whole tool
+// so we can count allocations and track the live heap size during an import.
+// Counting is only switched on while 'assimp bench' runs, the other verbs just
+// pass through to malloc().
+namespace {
+
+	std::atomic<bool> gCounting(false);
+	std::atomic<size_t> gNumAllocations(0);
+	std::atomic<size_t> gAllocatedBytes(0);
+	std::atomic<size_t> gLiveBytes(0);
+	std::atomic<size_t> gPeakBytes(0);
+
+	// keeps the payload aligned for any fundamental type
+	const size_t AllocHeaderSize = 16;
+
+	void* CountedAlloc(size_t size) {
+		char* p = static_cast<char*>(::malloc(size + AllocHeaderSize));
+		if (!p) {
+			return NULL;
+		}
+
+		// a size of 0 marks blocks which weren't counted
+		if (!gCounting.load(std::memory_order_relaxed)) {
+			*reinterpret_cast<size_t*>(p) = 0;
+			return p + AllocHeaderSize;
+		}
+		*reinterpret_cast<size_t*>(p) = size;
+
+		++gNumAllocations;
+		gAllocatedBytes += size;
+		const size_t live = (gLiveBytes += size);
+		size_t peak = gPeakBytes.load();
+		while (live > peak && !gPeakBytes.compare_exchange_weak(peak, live)) {
+		}
+		return p + AllocHeaderSize;
+	}
+
+	void CountedFree(void* ptr) {
+		if (!ptr) {
+			return;
+		}
+		char* p = static_cast<char*>(ptr) - AllocHeaderSize;
+		if (const size_t size = *reinterpret_cast<size_t*>(p)) {
+			gLiveBytes -= size;
+		}
+		::free(p);
+	}
+
+	// Reports our counters to the importer's profiler
+	void SampleAllocations(uint64_t* numAllocations, uint64_t* numBytes) {
+		*numAllocations = gNumAllocations.load();
+		*numBytes = gAllocatedBytes.load();
+	}
+}
+
+void* operator new(size_t size) {
+	void* p = CountedAlloc(size ? size : 1);
+	if (!p) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void* operator new[](size_t size) {
+	return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) throw() {
+	return CountedAlloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) throw() {
+	return CountedAlloc(size ? size : 1);
+}
+
+void operator delete(void* ptr) throw() {
+	CountedFree(ptr);
+}
+
+void operator delete[](void* ptr) throw() {
+	CountedFree(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) throw() {
+	CountedFree(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) throw() {
+	CountedFree(ptr);
+}
+
+// ------------------------------------------------------------------------------
+// Peak resident set size of the process, in bytes
+static size_t GetPeakResidentSize()
+{
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if (::GetProcessMemoryInfo(::GetCurrentProcess(), &counters, sizeof(counters))) {
+		return counters.PeakWorkingSetSize;
+	}
+	return 0;
+#else
+	struct rusage usage;
+	if (::getrusage(RUSAGE_SELF, &usage)) {
+		return 0;
+	}
+#	ifdef __APPLE__
+	return static_cast<size_t>(usage.ru_maxrss);
+#	else
+	return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#	endif
+#endif
+}
+
+// ------------------------------------------------------------------------------
+static size_t GetFileSize(const std::string& path)
+{
+	FILE* file = ::fopen(path.c_str(), "rb");
+	if (!file) {
+		return 0;
+	}
+	::fseek(file, 0, SEEK_END);
+	const long size = ::ftell(file);
+	::fclose(file);
+	return size > 0 ? static_cast<size_t>(size) : 0;
+}
+
+// ------------------------------------------------------------------------------
+// Collect all files with a supported extension below a path
+static void CollectFiles(const std::string& path, std::vector<std::string>& out)
+{
+#ifdef _WIN32
+	const DWORD attribs = ::GetFileAttributesA(path.c_str());
+	if (attribs == INVALID_FILE_ATTRIBUTES) {
+		return;
+	}
+	if (!(attribs & FILE_ATTRIBUTE_DIRECTORY)) {
+		out.push_back(path);
+		return;
+	}
+	WIN32_FIND_DATAA data;
+	HANDLE h = ::FindFirstFileA((path + "\\*").c_str(), &data);
+	if (h == INVALID_HANDLE_VALUE) {
+		return;
+	}
+	do {
+		const std::string name = data.cFileName;
+		if (name != "." && name != "..") {
+			CollectFiles(path + "\\" + name, out);
+		}
+	}
+	while (::FindNextFileA(h, &data));
+	::FindClose(h);
+#else
+	struct stat st;
+	if (::stat(path.c_str(), &st)) {
+		return;
+	}
+	if (!S_ISDIR(st.st_mode)) {
+		out.push_back(path);
+		return;
+	}
+	DIR* dir = ::opendir(path.c_str());
+	if (!dir) {
+		return;
+	}
+	while (struct dirent* entry = ::readdir(dir)) {
+		const std::string name = entry->d_name;
+		if (name != "." && name != "..") {
+			CollectFiles(path + "/" + name, out);
+		}
+	}
+	::closedir(dir);
+#endif
+}
+
+// ------------------------------------------------------------------------------
+static std::string GetExtension(const std::string& path)
+{
+	const std::string::size_type dot = path.find_last_of('.');
+	const std::string::size_type sep = path.find_last_of("/\\");
+	if (dot == std::string::npos || (sep != std::string::npos && sep > dot)) {
+		return "";
+	}
+	std::string ext = path.substr(dot + 1);
+	std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+	return ext;
+}
+
+// ------------------------------------------------------------------------------
+static std::string JsonEscape(const std::string& in)
+{
+	std::string out;
+	out.reserve(in.length());
+	for (std::string::const_iterator it = in.begin(); it != in.end(); ++it) {
+		const char c = *it;
+		if (c == '\"' || c == '\\') {
+			out += '\\';
+			out += c;
+		}
+		else if (static_cast<unsigned char>(c) < 0x20) {
+			char buff[8];
+			::sprintf(buff, "\\u%04x", c);
+			out += buff;
+		}
+		else {
+			out += c;
+		}
+	}
+	return out;
+}
+
+// ------------------------------------------------------------------------------
+struct FlagSet
+{
+	const char* name;
+	unsigned int flags;
+};
+
+// ------------------------------------------------------------------------------
+struct BenchResult
+{
+	BenchResult()
+		:	success (false)
+		,	fileSize (0)
+		,	vertices (0)
+		,	faces (0)
+		,	meshes (0)
+		,	allocations (0)
+		,	peakHeap (0)
+	{}
+
+	bool success;
+	std::string error;
+	size_t fileSize;
+	unsigned int vertices, faces, meshes;
+
+	// wall time of each iteration, in seconds
+	std::vector<double> times;
+
+	// averaged over all iterations
+	size_t allocations;
+
+	// maximum over all iterations
+	size_t peakHeap;
+
+	// profiling tree of the last iteration, if requested
+	Assimp::ImportStatistics profile;
+};
+
+// ------------------------------------------------------------------------------
+static BenchResult RunBenchmark(const std::string& path, unsigned int flags, unsigned int iterations)
+{
+	BenchResult res;
+	res.fileSize = GetFileSize(path);
+
+	size_t allocations = 0;
+	for (unsigned int i = 0; i < iterations; ++i) {
+		globalImporter->FreeScene();
+
+		const size_t allocsBefore = gNumAllocations.load();
+		const size_t liveBefore = gLiveBytes.load();
+		gPeakBytes.store(liveBefore);
+
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		const aiScene* scene = globalImporter->ReadFile(path, flags);
+		const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+		if (!scene) {
+			res.error = globalImporter->GetErrorString();
+			return res;
+		}
+		res.times.push_back(elapsed.count());
+		allocations += gNumAllocations.load() - allocsBefore;
+		res.peakHeap = std::max(res.peakHeap, gPeakBytes.load() - liveBefore);
+
+		res.vertices = CountVertices(scene);
+		res.faces = CountFaces(scene);
+		res.meshes = scene->mNumMeshes;
+
+		const Assimp::ImportStatistics* stats = globalImporter->GetLastImportStatistics();
+		if (stats) {
+			res.profile = *stats;
+		}
+	}
+	globalImporter->FreeScene();
+
+	res.success = true;
+	res.allocations = iterations ? allocations / iterations : 0;
+	return res;
+}
+
+// ------------------------------------------------------------------------------
+static void WriteProfile(FILE* out, const Assimp::ImportStatistics& node, unsigned int depth)
+{
+	const std::string indent(depth * 2, ' ');
+	::fprintf(out, "{\n");
+	::fprintf(out, "%s  \"name\": \"%s\",\n", indent.c_str(), JsonEscape(node.mName).c_str());
+	::fprintf(out, "%s  \"time_ms\": %.3f,\n", indent.c_str(), node.mSeconds * 1e3);
+	::fprintf(out, "%s  \"allocations\": %llu,\n", indent.c_str(), static_cast<unsigned long long>(node.mAllocations));
+	::fprintf(out, "%s  \"allocated_bytes\": %llu", indent.c_str(), static_cast<unsigned long long>(node.mAllocatedBytes));
+
+	if (!node.mCounters.empty()) {
+		::fprintf(out, ",\n%s  \"counters\": {", indent.c_str());
+		for (std::map<std::string, double>::const_iterator it = node.mCounters.begin(); it != node.mCounters.end(); ++it) {
+			::fprintf(out, "%s \"%s\": %g", it == node.mCounters.begin() ? "" : ",",
+				JsonEscape((*it).first).c_str(), (*it).second);
+		}
+		::fprintf(out, " }");
+	}
+	if (!node.mChildren.empty()) {
+		::fprintf(out, ",\n%s  \"children\": [\n", indent.c_str());
+		for (size_t i = 0; i < node.mChildren.size(); ++i) {
+			::fprintf(out, "%s    ", indent.c_str());
+			WriteProfile(out, node.mChildren[i], depth + 2);
+			::fprintf(out, "%s\n", i + 1 == node.mChildren.size() ? "" : ",");
+		}
+		::fprintf(out, "%s  ]", indent.c_str());
+	}
+	::fprintf(out, "\n%s}", indent.c_str());
+}
+
+// ------------------------------------------------------------------------------
+// Totals of all files of one format imported with one flag set
+struct FormatSummary
+{
+	FormatSummary()
+		:	files (0)
+		,	failed (0)
+		,	fileSize (0)
+		,	vertices (0)
+		,	allocations (0)
+		,	time (0.0)
+	{}
+
+	unsigned int files, failed;
+	unsigned long long fileSize, vertices, allocations;
+
+	// sum of the median import times, in seconds
+	double time;
+};
+
+// format and index of the flag set
+typedef std::map<std::pair<std::string, size_t>, FormatSummary> FormatSummaries;
+
+// ------------------------------------------------------------------------------
+static double GetMedian(std::vector<double> times)
+{
+	std::sort(times.begin(), times.end());
+	return times.size() % 2 ? times[times.size() / 2] :
+		0.5 * (times[times.size() / 2 - 1] + times[times.size() / 2]);
+}
+
+// ------------------------------------------------------------------------------
+static void AddToSummary(FormatSummary& summary, const BenchResult& res)
+{
+	if (!res.success) {
+		++summary.failed;
+		return;
+	}
+	++summary.files;
+	summary.fileSize += res.fileSize;
+	summary.vertices += res.vertices;
+	summary.allocations += res.allocations;
+	summary.time += GetMedian(res.times);
+}
+
+// ------------------------------------------------------------------------------
+static void WriteSummaries(FILE* out, const FormatSummaries& summaries, const std::vector<FlagSet>& sets)
+{
+	::fprintf(out, "  \"formats\": [\n");
+	for (FormatSummaries::const_iterator it = summaries.begin(); it != summaries.end(); ++it) {
+		const FormatSummary& sum = (*it).second;
+		::fprintf(out, "    {\n");
+		::fprintf(out, "      \"format\": \"%s\",\n", JsonEscape((*it).first.first).c_str());
+		::fprintf(out, "      \"postprocess\": \"%s\",\n", sets[(*it).first.second].name);
+		::fprintf(out, "      \"files\": %u,\n", sum.files);
+		::fprintf(out, "      \"failed\": %u,\n", sum.failed);
+		::fprintf(out, "      \"size_bytes\": %llu,\n", sum.fileSize);
+		::fprintf(out, "      \"vertices\": %llu,\n", sum.vertices);
+		::fprintf(out, "      \"allocations\": %llu,\n", sum.allocations);
+		::fprintf(out, "      \"time_ms\": %.3f,\n", sum.time * 1e3);
+		::fprintf(out, "      \"throughput_mb_s\": %.3f,\n", sum.time > 0.0 ? sum.fileSize / (1024.0 * 1024.0) / sum.time : 0.0);
+		::fprintf(out, "      \"vertices_per_s\": %.1f\n", sum.time > 0.0 ? sum.vertices / sum.time : 0.0);
+		FormatSummaries::const_iterator next = it;
+		::fprintf(out, "    }%s\n", ++next == summaries.end() ? "" : ",");
+	}
+	::fprintf(out, "  ],\n");
+}
+
+// ------------------------------------------------------------------------------
+static void WriteResult(FILE* out, const std::string& path, const FlagSet& set, const BenchResult& res, bool last)
+{
+	::fprintf(out, "    {\n");
+	::fprintf(out, "      \"file\": \"%s\",\n", JsonEscape(path).c_str());
+	::fprintf(out, "      \"format\": \"%s\",\n", JsonEscape(GetExtension(path)).c_str());
+	::fprintf(out, "      \"size_bytes\": %llu,\n", static_cast<unsigned long long>(res.fileSize));
+	::fprintf(out, "      \"postprocess\": \"%s\",\n", set.name);
+	::fprintf(out, "      \"flags\": %u,\n", set.flags);
+	::fprintf(out, "      \"success\": %s", res.success ? "true" : "false");
+
+	if (!res.success) {
+		::fprintf(out, ",\n      \"error\": \"%s\"\n    }%s\n", JsonEscape(res.error).c_str(), last ? "" : ",");
+		return;
+	}
+
+	std::vector<double> sorted = res.times;
+	std::sort(sorted.begin(), sorted.end());
+	double total = 0.0;
+	for (std::vector<double>::const_iterator it = sorted.begin(); it != sorted.end(); ++it) {
+		total += *it;
+	}
+	const double mean = total / sorted.size();
+	const double median = GetMedian(sorted);
+
+	::fprintf(out, ",\n");
+	::fprintf(out, "      \"iterations\": %u,\n", static_cast<unsigned int>(sorted.size()));
+	::fprintf(out, "      \"time_ms\": { \"min\": %.3f, \"mean\": %.3f, \"median\": %.3f, \"max\": %.3f },\n",
+		sorted.front() * 1e3, mean * 1e3, median * 1e3, sorted.back() * 1e3);
+	::fprintf(out, "      \"allocations\": %llu,\n", static_cast<unsigned long long>(res.allocations));
+	::fprintf(out, "      \"peak_heap_bytes\": %llu,\n", static_cast<unsigned long long>(res.peakHeap));
+	::fprintf(out, "      \"meshes\": %u,\n", res.meshes);
+	::fprintf(out, "      \"vertices\": %u,\n", res.vertices);
+	::fprintf(out, "      \"faces\": %u,\n", res.faces);
+	::fprintf(out, "      \"throughput_mb_s\": %.3f,\n", median > 0.0 ? res.fileSize / (1024.0 * 1024.0) / median : 0.0);
+	::fprintf(out, "      \"vertices_per_s\": %.1f", median > 0.0 ? res.vertices / median : 0.0);
+	if (!res.profile.mName.empty()) {
+		::fprintf(out, ",\n      \"profile\": ");
+		WriteProfile(out, res.profile, 3);
+	}
+	::fprintf(out, "\n");
+	::fprintf(out, "    }%s\n", last ? "" : ",");
+}
+
+// ------------------------------------------------------------------------------
+int Assimp_Benchmark (
+	const char* const* params,
+	unsigned int num)
+{
+	if (num < 1) {
+		printf("assimp bench: Invalid number of arguments. "
+			"See \'assimp bench --help\'\n");
+		return 1;
+	}
+
+	// --help
+	if (!strcmp( params[0],"-h")||!strcmp( params[0],"--help")||!strcmp( params[0],"-?") ) {
+		printf("%s",AICMD_MSG_BENCH_HELP_E);
+		return 0;
+	}
+
+	ImportData import;
+	ProcessStandardArguments(import,params,num);
+
+	unsigned int iterations = 5;
+	std::string output;
+	bool profile = false;
+	std::vector<std::string> inputs;
+	for (unsigned int i = 0; i < num; ++i) {
+		if (!strncmp(params[i], "--iterations=", 13)) {
+			iterations = static_cast<unsigned int>(::strtoul(params[i] + 13, NULL, 10));
+		}
+		else if (!strncmp(params[i], "-n", 2)) {
+			iterations = static_cast<unsigned int>(::strtoul(params[i] + 2, NULL, 10));
+		}
+		else if (!strcmp(params[i], "--profile")) {
+			profile = true;
+		}
+		else if (!strncmp(params[i], "--output=", 9)) {
+			output = params[i] + 9;
+		}
+		else if (!strncmp(params[i], "-o", 2) && strcmp(params[i], "-om") && strcmp(params[i], "-og")) {
+			output = params[i] + 2;
+		}
+		else if (params[i][0] != '-') {
+			inputs.push_back(params[i]);
+		}
+	}
+	if (!iterations || inputs.empty()) {
+		printf("assimp bench: Expected at least one input and one iteration. "
+			"See \'assimp bench --help\'\n");
+		return 1;
+	}
+
+	// gather all files we can import, in a stable order
+	std::vector<std::string> files;
+	for (std::vector<std::string>::const_iterator it = inputs.begin(); it != inputs.end(); ++it) {
+		std::vector<std::string> found;
+		CollectFiles(*it, found);
+		for (std::vector<std::string>::const_iterator f = found.begin(); f != found.end(); ++f) {
+			const std::string ext = GetExtension(*f);
+			if (ext.length() && globalImporter->IsExtensionSupported(ext.c_str())) {
+				files.push_back(*f);
+			}
+		}
+	}
+	std::sort(files.begin(), files.end());
+	if (files.empty()) {
+		printf("assimp bench: No supported files found\n");
+		return 2;
+	}
+
+	std::vector<FlagSet> sets;
+	if (import.ppFlags) {
+		const FlagSet custom = { "custom", import.ppFlags };
+		sets.push_back(custom);
+	}
+	else {
+		const FlagSet defaults[] = {
+			{ "none", 0 },
+			{ "fast", aiProcessPreset_TargetRealtime_Fast },
+			{ "default", aiProcessPreset_TargetRealtime_Quality },
+			{ "full", aiProcessPreset_TargetRealtime_MaxQuality }
+		};
+		sets.assign(defaults, defaults + sizeof(defaults) / sizeof(defaults[0]));
+	}
+
+	FILE* out = stdout;
+	if (output.length()) {
+		out = ::fopen(output.c_str(), "wt");
+		if (!out) {
+			printf("assimp bench: Unable to open file for writing: %s\n", output.c_str());
+			return 3;
+		}
+	}
+	if (import.log) {
+		SetLogStreams(import);
+	}
+	if (profile) {
+		globalImporter->SetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME, 1);
+		globalImporter->SetAllocationCounter(&SampleAllocations);
+	}
+	gCounting = true;
+
+	::fprintf(out, "{\n");
+	::fprintf(out, "  \"version\": \"%u.%u\",\n", aiGetVersionMajor(), aiGetVersionMinor());
+	::fprintf(out, "  \"revision\": \"%x\",\n", aiGetVersionRevision());
+	::fprintf(out, "  \"iterations\": %u,\n", iterations);
+	::fprintf(out, "  \"results\": [\n");
+	FormatSummaries summaries;
+	for (size_t f = 0; f < files.size(); ++f) {
+		for (size_t s = 0; s < sets.size(); ++s) {
+			const BenchResult res = RunBenchmark(files[f], sets[s].flags, iterations);
+			AddToSummary(summaries[std::make_pair(GetExtension(files[f]), s)], res);
+			WriteResult(out, files[f], sets[s], res, f + 1 == files.size() && s + 1 == sets.size());
+			::fflush(out);
+		}
+	}
+	::fprintf(out, "  ],\n");
+	WriteSummaries(out, summaries, sets);
+
+	// the resident set only ever grows, so it is reported for the whole run
+	::fprintf(out, "  \"process_peak_rss_bytes\": %llu\n", static_cast<unsigned long long>(GetPeakResidentSize()));
+	::fprintf(out, "}\n");
+	gCounting = false;
+
+	if (profile) {
+		globalImporter->SetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME, 0);
+		globalImporter->SetAllocationCounter(NULL);
+	}
+	if (import.log) {
+		FreeLogStreams();
+	}
+	if (out != stdout) {
+		::fclose(out);
+	}
+	return 0;
+}
@@ -128,6 +128,15 @@ int ProcessStandardArguments(ImportData& fill,
 	const char* const* params,
 	unsigned int num);
 
+// ------------------------------------------------------------------------------
+/** Attach the log streams requested by the import configuration
+ *  @param imp Import configuration to be used */
+void SetLogStreams(const ImportData& imp);
+
+// ------------------------------------------------------------------------------
+/** Detach all log streams again */
+void FreeLogStreams();
+
 // ------------------------------------------------------------------------------
 /** Import a specific model file
  *  @param imp Import configuration to be used
@@ -195,6 +204,15 @@ int Assimp_Info (
 	const char* const* params, 
 	unsigned int num);
 
+// ------------------------------------------------------------------------------
+/** @brief assimp bench utility
+ *  @param params Command line parameters to 'assimp bench'
+ *  @param Number of params
+ *  @return 0 for success */
+int Assimp_Benchmark (
+	const char* const* params,
+	unsigned int num);
+
 // ------------------------------------------------------------------------------
 /** @brief assimp testbatchload utility
  *  @param params Command line parameters to 'assimp testbatchload'